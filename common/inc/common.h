@@ -16,6 +16,7 @@
 #include <string.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <stddef.h>
 
 
 /* Basic type for copying memory */
@@ -34,6 +35,14 @@ typedef void (*destructor_f)(void *);
 typedef void (*data_print_f)(void *);
 
 
+/* Chunk consumer function (chunk, number of entries in chunk, user argument), non zero return value stops export */
+typedef int (*chunk_f)(const void *, size_t, void *);
+
+
+/* Hash function */
+typedef uint64_t (*hash_f)(const void *);
+
+
 /* 
     Check types casting to pointers and cast return value to void.
     Pointers arithmetins of different types doesn't exist.
@@ -95,6 +104,18 @@ typedef void (*data_print_f)(void *);
 #define ARRAY_SIZE(array) (sizeof(array) / sizeof(array[0]))
 
 
+/* Size of CPU cache line in bytes */
+#define CACHE_LINE_SIZE ((size_t)64)
+
+
+/* Size of transparent huge page in bytes */
+#define HUGE_PAGE_SIZE ((size_t)(2UL << 20))
+
+
+/* Round up @x to multiple of @align (@align has to be power of 2) */
+#define ALIGN_UP(x, align) (((x) + (align) - 1) & ~((align) - 1))
+
+
 /* Assign dst and src if type is the same */
 #define __ASSIGN__(dst, src, size) \
     do { \
@@ -154,4 +175,13 @@ typedef void (*data_print_f)(void *);
     })
 
 
+
+/* get pointer to struct which contains @member pointed by @ptr */
+#define container_of(ptr, type, member) \
+    __extension__ \
+    ({ \
+        const typeof(((type *)0)->member) *__mptr = (ptr); \
+        (type *)(void *)((BYTE *)__mptr - offsetof(type, member)); \
+    })
+
 #endif /* _COMMON_H_ */
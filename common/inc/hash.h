@@ -0,0 +1,294 @@
+#ifndef _HASH_H_
+#define _HASH_H_
+
+
+/*
+    Built-in hash functions
+
+    hash_bytes is wyhash-like: 8 bytes are read at once and mixed by 64x64 -> 128
+    bit multiplication, so long keys are hashed at several GB/s and short keys
+    need only a few instructions. hash_mix32 / hash_mix64 are cheap mixers for
+    integer keys.
+
+    Functions with hash_f signature (hash_int32, hash_int64, hash_ptr,
+    hash_string) can be passed directly to hash based containers.
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include <string.h> /* memcpy, strlen */
+#include <common.h> /* hash_f */
+
+
+/* default seed of hash_bytes */
+#define HASH_DEFAULT_SEED ((uint64_t)0)
+
+
+/*
+    Hash bytes.
+
+    PARAMS:
+    @IN data - pointer to bytes.
+    @IN len - number of bytes.
+    @IN seed - seed (different seeds give independent hashes).
+
+    RETURN:
+    %Hash of bytes.
+*/
+static inline uint64_t hash_bytes(const void *data, size_t len, uint64_t seed);
+
+
+/*
+    Mix 32 bit integer (bijection, every bit of input changes about half of output bits).
+
+    PARAMS:
+    @IN x - integer.
+
+    RETURN:
+    %Hash of integer.
+*/
+static inline uint32_t hash_mix32(uint32_t x);
+
+
+/*
+    Mix 64 bit integer (bijection, every bit of input changes about half of output bits).
+
+    PARAMS:
+    @IN x - integer.
+
+    RETURN:
+    %Hash of integer.
+*/
+static inline uint64_t hash_mix64(uint64_t x);
+
+
+/*
+    hash_f for 32 bit integer keys (int32_t, uint32_t).
+
+    PARAMS:
+    @IN key - pointer to key.
+
+    RETURN:
+    %Hash of key.
+*/
+static inline uint64_t hash_int32(const void *key);
+
+
+/*
+    hash_f for 64 bit integer keys (int64_t, uint64_t).
+
+    PARAMS:
+    @IN key - pointer to key.
+
+    RETURN:
+    %Hash of key.
+*/
+static inline uint64_t hash_int64(const void *key);
+
+
+/*
+    hash_f for pointer keys (address is hashed, not pointed data).
+
+    PARAMS:
+    @IN key - pointer to key (pointer).
+
+    RETURN:
+    %Hash of key.
+*/
+static inline uint64_t hash_ptr(const void *key);
+
+
+/*
+    hash_f for string keys (key is char *, characters up to '\0' are hashed).
+
+    PARAMS:
+    @IN key - pointer to key (pointer to string).
+
+    RETURN:
+    %Hash of key.
+*/
+static inline uint64_t hash_string(const void *key);
+
+
+#define HASH_P0 ((uint64_t)0xa0761d6478bd642fULL)
+#define HASH_P1 ((uint64_t)0xe7037ed1a0b428dbULL)
+#define HASH_P2 ((uint64_t)0x8ebc6af09c88c6e3ULL)
+#define HASH_P3 ((uint64_t)0x589965cc75374cc3ULL)
+
+
+/* 64 x 64 -> 128 bit multiplication, low part goes to @a, high part to @b */
+static ___inline___ void __hash_mul128(uint64_t *a, uint64_t *b)
+{
+    __extension__ typedef unsigned __int128 __hash_u128;
+    const __hash_u128 r = (__hash_u128)*a * *b;
+
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+}
+
+
+/* 64 x 64 -> 128 bit multiplication, high and low part are folded */
+static ___inline___ uint64_t __hash_mum(uint64_t a, uint64_t b)
+{
+    __hash_mul128(&a, &b);
+
+    return a ^ b;
+}
+
+
+static ___inline___ uint64_t __hash_read64(const uint8_t *p)
+{
+    uint64_t v;
+    (void)memcpy(&v, p, sizeof(v));
+
+    return v;
+}
+
+
+static ___inline___ uint64_t __hash_read32(const uint8_t *p)
+{
+    uint32_t v;
+    (void)memcpy(&v, p, sizeof(v));
+
+    return v;
+}
+
+
+static inline uint64_t hash_bytes(const void *data, size_t len, uint64_t seed)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint64_t a;
+    uint64_t b;
+
+    seed ^= __hash_mum(seed ^ HASH_P0, HASH_P1);
+
+    if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            /* 2 overlapping reads from each end cover 4 .. 16 bytes */
+            const size_t off = (len >> 3) << 2;
+
+            a = (__hash_read32(p) << 32) | __hash_read32(p + off);
+            b = (__hash_read32(p + len - 4) << 32) | __hash_read32(p + len - 4 - off);
+        }
+        else if (len > 0)
+        {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | (uint64_t)p[len - 1];
+            b = 0;
+        }
+        else
+        {
+            a = 0;
+            b = 0;
+        }
+    }
+    else
+    {
+        size_t i = len;
+
+        if (i > 48)
+        {
+            /* 3 independent lanes, multiplications run in parallel */
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+
+            do
+            {
+                seed = __hash_mum(__hash_read64(p) ^ HASH_P1, __hash_read64(p + 8) ^ seed);
+                see1 = __hash_mum(__hash_read64(p + 16) ^ HASH_P2, __hash_read64(p + 24) ^ see1);
+                see2 = __hash_mum(__hash_read64(p + 32) ^ HASH_P3, __hash_read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16)
+        {
+            seed = __hash_mum(__hash_read64(p) ^ HASH_P1, __hash_read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+
+        /* last 16 bytes (may overlap with already hashed ones) */
+        a = __hash_read64(p + i - 16);
+        b = __hash_read64(p + i - 8);
+    }
+
+    a ^= HASH_P1;
+    b ^= seed;
+    __hash_mul128(&a, &b);
+
+    return __hash_mum(a ^ HASH_P0 ^ (uint64_t)len, b ^ HASH_P1);
+}
+
+
+static inline uint32_t hash_mix32(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+
+    return x;
+}
+
+
+static inline uint64_t hash_mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+
+    return x;
+}
+
+
+static inline uint64_t hash_int32(const void *key)
+{
+    uint32_t x;
+    (void)memcpy(&x, key, sizeof(x));
+
+    return hash_mix64((uint64_t)x);
+}
+
+
+static inline uint64_t hash_int64(const void *key)
+{
+    uint64_t x;
+    (void)memcpy(&x, key, sizeof(x));
+
+    return hash_mix64(x);
+}
+
+
+static inline uint64_t hash_ptr(const void *key)
+{
+    uintptr_t x;
+    (void)memcpy(&x, key, sizeof(x));
+
+    return hash_mix64((uint64_t)x);
+}
+
+
+static inline uint64_t hash_string(const void *key)
+{
+    const char *str;
+    (void)memcpy(&str, key, sizeof(str));
+
+    return hash_bytes(str, strlen(str), HASH_DEFAULT_SEED);
+}
+
+
+#endif /* _HASH_H_ */
@@ -7,6 +7,27 @@
 #include <sys/types.h> /* ssize_t */
 
 
+/*
+    Copies (and memsets) of at least this many bytes use non-temporal stores,
+    so huge transfers do not evict the working set from cache.
+*/
+#ifndef ARRAY_STREAM_THRESHOLD
+#define ARRAY_STREAM_THRESHOLD ((size_t)(4UL << 20))
+#endif
+
+
+/* Arrays created with ARRAY_HUGEPAGE of at least this many bytes are backed by huge pages */
+#ifndef ARRAY_HUGEPAGE_THRESHOLD
+#define ARRAY_HUGEPAGE_THRESHOLD HUGE_PAGE_SIZE
+#endif
+
+
+/* array_copy_parallel splits copies of at least this many bytes between threads */
+#ifndef ARRAY_PARALLEL_THRESHOLD
+#define ARRAY_PARALLEL_THRESHOLD ((size_t)(64UL << 20))
+#endif
+
+
 /*
     Create new array with @len of members with size @size_of. 
     Each of member will be set to 0.
@@ -22,6 +43,33 @@
 void *array_create(const size_t len, const size_t size_of);
 
 
+typedef enum ARRAY_FLAGS
+{
+    ARRAY_DEFAULT = 0,          /* plain calloc */
+    ARRAY_ALIGNED = 1 << 0,     /* array aligned to CACHE_LINE_SIZE (SIMD friendly) */
+    ARRAY_HUGEPAGE = 1 << 1     /* big array aligned to HUGE_PAGE_SIZE and advised as huge page */
+} ARRAY_FLAGS;
+
+
+/*
+    Create new array with @len of members with size @size_of using allocation @flags.
+    Each of member will be set to 0. Array has to be destroyed by array_destroy.
+
+    With ARRAY_HUGEPAGE arrays smaller than ARRAY_HUGEPAGE_THRESHOLD
+    are only cache line aligned.
+
+    PARAMS:
+    @IN len - array length.
+    @IN size_of - size of each member.
+    @IN flags - ARRAY_FLAGS ored together.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to the new array if success.
+*/
+void *array_create_with_flags(const size_t len, const size_t size_of, const int flags);
+
+
 /*
     Destroy array.
 
@@ -64,6 +112,24 @@ void array_destroy_with_entries(void *array, const destructor_f destroy_f, const
 void array_copy(void * __restrict__ dst, const void * __restrict__ const src, const size_t len, const size_t size_of);
 
 
+/*
+    Copy array from @src to @dst using @threads threads.
+    Copies smaller than ARRAY_PARALLEL_THRESHOLD are done by the calling thread.
+
+    PARAMS:
+    @IN dst - pointer to destination array.
+    @IN src - pointer to source array.
+    @IN len - array length.
+    @IN size_of - size of each member.
+    @IN threads - number of threads (0 means number of online CPUs).
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure.
+*/
+int array_copy_parallel(void * __restrict__ dst, const void * __restrict__ const src, const size_t len, const size_t size_of, const size_t threads);
+
+
 /*
     Clone @array to another array. This function will allocate memory for new array.
 
@@ -1,6 +1,23 @@
 #include <array.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <unistd.h> /* sysconf */
+#include <stdbool.h>
+#include <sys/mman.h> /* madvise */
+
+#ifdef __SSE2__
+#include <emmintrin.h> /* _mm_stream_si128 */
+#endif
+
+
+/* Work description for one thread of array_copy_parallel */
+typedef struct Array_copy_chunk
+{
+    BYTE *dst;              /* destination of this chunk */
+    const BYTE *src;        /* source of this chunk */
+    size_t bytes;           /* number of bytes to copy */
+} Array_copy_chunk;
 
 
 /*
@@ -38,6 +55,133 @@ static int __array_insert_pos(void * __restrict__ array, const size_t len, const
 static int __array_delete_pos(void * __restrict__ array, const size_t len, const size_t size_of, const size_t pos, const destructor_f destroy_f);
 
 
+/*
+    Copy @bytes from @src to @dst. Big copies use non-temporal stores.
+
+    PARAMS:
+    @IN dst - pointer to destination.
+    @IN src - pointer to source.
+    @IN bytes - number of bytes to copy.
+
+    RETURN:
+    %This is void function.
+*/
+static void __array_copy_bytes(void * __restrict__ dst, const void * __restrict__ const src, const size_t bytes);
+
+
+/*
+    Set @bytes of @dst to 0. Big memsets use non-temporal stores.
+
+    PARAMS:
+    @IN dst - pointer to destination.
+    @IN bytes - number of bytes to set.
+
+    RETURN:
+    %This is void function.
+*/
+static void __array_zero_bytes(void *dst, const size_t bytes);
+
+
+/*
+    Thread routine of array_copy_parallel.
+
+    PARAMS:
+    @IN arg - pointer to Array_copy_chunk.
+
+    RETURN:
+    %NULL.
+*/
+static void *__array_copy_thread(void *arg);
+
+
+static void __array_copy_bytes(void * __restrict__ dst, const void * __restrict__ const src, const size_t bytes)
+{
+#ifdef __SSE2__
+    if (bytes < ARRAY_STREAM_THRESHOLD)
+    {
+        (void)memcpy(dst, src, bytes);
+        return;
+    }
+
+    BYTE *d = (BYTE *)dst;
+    const BYTE *s = (const BYTE *)src;
+
+    /* streaming stores need 16 bytes aligned destination */
+    const size_t head = (size_t)(-(uintptr_t)d & 15);
+    size_t left = bytes - head;
+
+    (void)memcpy(d, s, head);
+    d += head;
+    s += head;
+
+    for (; left >= 64; left -= 64, d += 64, s += 64)
+    {
+        const __m128i x0 = _mm_loadu_si128((const __m128i *)(s + 0));
+        const __m128i x1 = _mm_loadu_si128((const __m128i *)(s + 16));
+        const __m128i x2 = _mm_loadu_si128((const __m128i *)(s + 32));
+        const __m128i x3 = _mm_loadu_si128((const __m128i *)(s + 48));
+
+        _mm_stream_si128((__m128i *)(d + 0), x0);
+        _mm_stream_si128((__m128i *)(d + 16), x1);
+        _mm_stream_si128((__m128i *)(d + 32), x2);
+        _mm_stream_si128((__m128i *)(d + 48), x3);
+    }
+
+    /* make streaming stores visible before anybody reads the array */
+    _mm_sfence();
+
+    (void)memcpy(d, s, left);
+#else
+    (void)memcpy(dst, src, bytes);
+#endif
+}
+
+
+static void __array_zero_bytes(void *dst, const size_t bytes)
+{
+#ifdef __SSE2__
+    if (bytes < ARRAY_STREAM_THRESHOLD)
+    {
+        (void)memset(dst, 0, bytes);
+        return;
+    }
+
+    BYTE *d = (BYTE *)dst;
+
+    const size_t head = (size_t)(-(uintptr_t)d & 15);
+    size_t left = bytes - head;
+    const __m128i zero = _mm_setzero_si128();
+
+    (void)memset(d, 0, head);
+    d += head;
+
+    for (; left >= 64; left -= 64, d += 64)
+    {
+        _mm_stream_si128((__m128i *)(d + 0), zero);
+        _mm_stream_si128((__m128i *)(d + 16), zero);
+        _mm_stream_si128((__m128i *)(d + 32), zero);
+        _mm_stream_si128((__m128i *)(d + 48), zero);
+    }
+
+    _mm_sfence();
+
+    (void)memset(d, 0, left);
+#else
+    (void)memset(dst, 0, bytes);
+#endif
+}
+
+
+static void *__array_copy_thread(void *arg)
+{
+    Array_copy_chunk *chunk = (Array_copy_chunk *)arg;
+
+    __array_copy_bytes(chunk->dst, chunk->src, chunk->bytes);
+
+    return NULL;
+}
+
+
 static int __array_insert_pos(void * __restrict__ array, const size_t len, const size_t size_of, const size_t pos, const void * __restrict__ const data)
 {
     if (array == NULL)
@@ -119,6 +263,43 @@ void *array_create(const size_t len, const size_t size_of)
 }
 
 
+void *array_create_with_flags(const size_t len, const size_t size_of, const int flags)
+{
+    /* preconditions */
+    if (len == 0)
+        ERROR("len == 0\n", NULL);
+
+    if (size_of == 0)
+        ERROR("size_of == 0\n", NULL);
+
+    if ((flags & (ARRAY_ALIGNED | ARRAY_HUGEPAGE)) == 0)
+        return array_create(len, size_of);
+
+    const size_t bytes = len * size_of;
+    size_t alignment = CACHE_LINE_SIZE;
+
+    if ((flags & ARRAY_HUGEPAGE) && bytes >= ARRAY_HUGEPAGE_THRESHOLD)
+        alignment = HUGE_PAGE_SIZE;
+
+    const size_t size = ALIGN_UP(bytes, alignment);
+    void *arr = NULL;
+
+    /* posix_memalign memory can be released by free, so array_destroy still works */
+    if (posix_memalign(&arr, alignment, size) != 0)
+        ERROR("posix_memalign error\n", NULL);
+
+#ifdef MADV_HUGEPAGE
+    /* only a hint, kernel without THP just ignores it */
+    if (alignment == HUGE_PAGE_SIZE)
+        (void)madvise(arr, size, MADV_HUGEPAGE);
+#endif
+
+    __array_zero_bytes(arr, size);
+
+    return arr;
+}
+
+
 void array_destroy(void *array)
 {
     /* preconditions */
@@ -168,7 +349,90 @@ void array_copy(void * __restrict__ dst, const void * __restrict__ const src, co
     if (size_of == 0)
         VERROR("size_of == 0\n");
 
-    (void)memcpy(dst, src, len * size_of);
+    __array_copy_bytes(dst, src, len * size_of);
+}
+
+
+int array_copy_parallel(void * __restrict__ dst, const void * __restrict__ const src, const size_t len, const size_t size_of, const size_t threads)
+{
+    /* preconditions */
+    if (dst == NULL)
+        ERROR("dst == NULL\n", -1);
+
+    if (src == NULL)
+        ERROR("src == NULL\n", -1);
+
+    if (len == 0)
+        ERROR("len == 0\n", -1);
+
+    if (size_of == 0)
+        ERROR("size_of == 0\n", -1);
+
+    const size_t bytes = len * size_of;
+    size_t num_threads = threads;
+
+    if (num_threads == 0)
+    {
+        const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    if (num_threads == 1 || bytes < ARRAY_PARALLEL_THRESHOLD)
+    {
+        __array_copy_bytes(dst, src, bytes);
+        return 0;
+    }
+
+    pthread_t *tids = (pthread_t *)malloc(num_threads * sizeof(*tids));
+    Array_copy_chunk *chunks = (Array_copy_chunk *)malloc(num_threads * sizeof(*chunks));
+    bool *started = (bool *)calloc(num_threads, sizeof(*started));
+
+    if (tids == NULL || chunks == NULL || started == NULL)
+    {
+        FREE(tids);
+        FREE(chunks);
+        FREE(started);
+
+        __array_copy_bytes(dst, src, bytes);
+        return 0;
+    }
+
+    /* chunk boundaries on cache lines, so threads never share destination line */
+    const size_t chunk_bytes = ((bytes / num_threads) + 63) & ~(size_t)63;
+    size_t offset = 0;
+
+    for (size_t i = 0; i < num_threads; ++i)
+    {
+        chunks[i].dst = (BYTE *)dst + offset;
+        chunks[i].src = (const BYTE *)src + offset;
+        chunks[i].bytes = MIN(chunk_bytes, bytes - offset);
+
+        offset += chunks[i].bytes;
+    }
+
+    /* calling thread takes the first chunk itself */
+    for (size_t i = 1; i < num_threads; ++i)
+    {
+        if (chunks[i].bytes == 0)
+            continue;
+
+        started[i] = pthread_create(&tids[i], NULL, __array_copy_thread, (void *)&chunks[i]) == 0;
+
+        if (!started[i])
+            __array_copy_bytes(chunks[i].dst, chunks[i].src, chunks[i].bytes);
+    }
+
+    __array_copy_bytes(chunks[0].dst, chunks[0].src, chunks[0].bytes);
+
+    for (size_t i = 1; i < num_threads; ++i)
+        if (started[i])
+            (void)pthread_join(tids[i], NULL);
+
+    FREE(tids);
+    FREE(chunks);
+    FREE(started);
+
+    return 0;
 }
 
 
@@ -184,13 +448,14 @@ void *array_clone(const void * const array, const size_t len, const size_t size_
     if (size_of == 0)
         ERROR("size_of == 0\n", NULL);
 
-    void *arr = array_create(len, size_of);
+    /* whole array is overwritten, so do not pay for calloc zeroing */
+    void *arr = malloc(len * size_of);
 
     /* assert */
     if (arr == NULL)
-        ERROR("array_create error\n", NULL);
+        ERROR("malloc error\n", NULL);
 
-    array_copy(arr, array, len, size_of);
+    __array_copy_bytes(arr, array, len * size_of);
 
     return arr;
 }
@@ -211,7 +476,15 @@ void array_move(void * dst, void * src, const size_t len, const size_t size_of)
     if (size_of == 0)
         VERROR("size_of == 0\n");
 
-    (void)memmove(dst, src, len * size_of);
+    const size_t bytes = len * size_of;
+    const BYTE *d = (const BYTE *)dst;
+    const BYTE *s = (const BYTE *)src;
+
+    /* only disjoint arrays can be streamed, overlapped ones need memmove */
+    if (d + bytes <= s || s + bytes <= d)
+        __array_copy_bytes(dst, src, bytes);
+    else
+        (void)memmove(dst, src, bytes);
 }
 
 
@@ -227,7 +500,7 @@ void array_zeros(void *array, const size_t len, const size_t size_of)
     if (size_of == 0)
         VERROR("size_of == 0\n");
 
-    (void)memset(array, 0, len * size_of);
+    __array_zero_bytes(array, len * size_of);
 }
 
 
@@ -92,6 +92,42 @@ static void test_array_create(void)
 }
 
 
+static void test_array_create_with_flags(void)
+{
+    const size_t len = 1000;
+    const size_t big_len = (ARRAY_HUGEPAGE_THRESHOLD / sizeof(int64_t)) + 1;
+
+    int64_t *ptr = (int64_t *)array_create_with_flags(len, sizeof(int64_t), ARRAY_ALIGNED);
+    T_ERROR(ptr == NULL);
+    T_ASSERT((size_t)((uintptr_t)ptr % CACHE_LINE_SIZE), (size_t)0);
+
+    for (size_t i = 0; i < len; ++i)
+        T_ASSERT(ptr[i], (int64_t)0);
+
+    array_destroy(ptr);
+
+    /* small array with huge page flag is only cache line aligned */
+    ptr = (int64_t *)array_create_with_flags(len, sizeof(int64_t), ARRAY_HUGEPAGE);
+    T_ERROR(ptr == NULL);
+    T_ASSERT((size_t)((uintptr_t)ptr % CACHE_LINE_SIZE), (size_t)0);
+    array_destroy(ptr);
+
+    ptr = (int64_t *)array_create_with_flags(big_len, sizeof(int64_t), ARRAY_ALIGNED | ARRAY_HUGEPAGE);
+    T_ERROR(ptr == NULL);
+    T_ASSERT((size_t)((uintptr_t)ptr % HUGE_PAGE_SIZE), (size_t)0);
+    T_ASSERT(ptr[0], (int64_t)0);
+    T_ASSERT(ptr[big_len - 1], (int64_t)0);
+    array_destroy(ptr);
+
+    ptr = (int64_t *)array_create_with_flags(len, sizeof(int64_t), ARRAY_DEFAULT);
+    T_ERROR(ptr == NULL);
+    array_destroy(ptr);
+
+    T_ASSERT(array_create_with_flags(0, sizeof(int64_t), ARRAY_ALIGNED), NULL);
+    T_ASSERT(array_create_with_flags(len, 0, ARRAY_ALIGNED), NULL);
+}
+
+
 static void test_destroy_with_entries(void)
 {
     const size_t len = 1000;
@@ -148,6 +184,56 @@ static void test_array_copy(void)
 }
 
 
+static void test_array_copy_big(void)
+{
+    /* big enough for streaming stores and for splitting between threads */
+    const size_t len = (ARRAY_PARALLEL_THRESHOLD / sizeof(int64_t)) + 13;
+
+    int64_t *ptr1;
+    int64_t *ptr2;
+    int64_t *ptr3;
+
+    ptr1 = (int64_t *)array_create(len, sizeof(int64_t));
+    T_ERROR(ptr1 == NULL);
+
+    for (size_t i = 0; i < len; ++i)
+        ptr1[i] = (int64_t)(i + 1);
+
+    ptr2 = (int64_t *)array_create(len, sizeof(int64_t));
+    T_ERROR(ptr2 == NULL);
+
+    /* unaligned destination and odd length */
+    array_copy((BYTE *)ptr2 + 3, ptr1, len * sizeof(int64_t) - 7, sizeof(BYTE));
+    T_EXPECT(memcmp((const void *)((BYTE *)ptr2 + 3), (const void *)&ptr1[0], len * sizeof(int64_t) - 7), 0);
+
+    array_zeros(ptr2, len, sizeof(int64_t));
+    T_EXPECT(array_copy_parallel(ptr2, ptr1, len, sizeof(int64_t), 0), 0);
+    T_EXPECT(memcmp((const void *)&ptr1[0], (const void *)&ptr2[0], len * sizeof(int64_t)), 0);
+
+    array_zeros(ptr2, len, sizeof(int64_t));
+    T_EXPECT(array_copy_parallel(ptr2, ptr1, len, sizeof(int64_t), 3), 0);
+    T_EXPECT(memcmp((const void *)&ptr1[0], (const void *)&ptr2[0], len * sizeof(int64_t)), 0);
+
+    ptr3 = (int64_t *)array_clone(ptr1, len, sizeof(int64_t));
+    T_ERROR(ptr3 == NULL);
+    T_EXPECT(memcmp((const void *)&ptr1[0], (const void *)&ptr3[0], len * sizeof(int64_t)), 0);
+
+    array_zeros(ptr3, len, sizeof(int64_t));
+
+    for (size_t i = 0; i < len; ++i)
+        T_ASSERT(ptr3[i], (int64_t)0);
+
+    T_EXPECT(array_copy_parallel(NULL, ptr1, len, sizeof(int64_t), 0), -1);
+    T_EXPECT(array_copy_parallel(ptr2, NULL, len, sizeof(int64_t), 0), -1);
+    T_EXPECT(array_copy_parallel(ptr2, ptr1, 0, sizeof(int64_t), 0), -1);
+    T_EXPECT(array_copy_parallel(ptr2, ptr1, len, 0, 0), -1);
+
+    array_destroy(ptr1);
+    array_destroy(ptr2);
+    array_destroy(ptr3);
+}
+
+
 #define TEST_ARRAY_CLONE(type, len) \
     do { \
         type *ptr1; \
@@ -890,8 +976,10 @@ int main(void)
 {
     TEST_INIT("ARRAY TESTING");
     TEST(test_array_create());
+    TEST(test_array_create_with_flags());
     TEST(test_destroy_with_entries());
     TEST(test_array_copy());
+    TEST(test_array_copy_big());
     TEST(test_array_clone());
     TEST(test_array_move());
     TEST(test_array_zeros());
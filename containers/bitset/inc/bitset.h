@@ -0,0 +1,333 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+/*
+    Bitset (dynamic bit array) implementation
+
+    One bit per flag in array of 64 bit words, 8x less memory than darray of
+    bool. Set, clear and test are inlined (index check and one word access).
+    Bulk operations (and, or, xor, andnot, count) work on whole words in
+    simple loops, which compiler vectorises. Rank and select use index with
+    number of set bits before every 512 bits block, index is rebuilt on first
+    rank / select after bitset was changed.
+
+    Arguments of inlined functions are checked (NULL) only in debug build,
+    compile with -DBITSET_DEBUG to enable checks.
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+#include <common.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t */
+#include <stdbool.h> /* bool */
+#include <sys/types.h> /* ssize_t */
+
+
+/* number of bits in one word */
+#define BITSET_WORD_BITS ((size_t)64)
+
+/* number of words in one block of rank index (512 bits, one cache line) */
+#define BITSET_BLOCK_WORDS ((size_t)8)
+
+
+typedef struct Bitset
+{
+    uint64_t *words;          /* bits, bits after num_bits are always 0 */
+    uint64_t *rank_index;     /* number of set bits before each block */
+
+    size_t num_bits;          /* number of bits */
+    size_t num_words;         /* number of used words */
+    size_t size;              /* number of allocated words */
+
+    bool rank_valid;          /* rank index is up to date */
+} Bitset;
+
+
+/*
+    Create new instance of bitset, all bits are cleared.
+
+    PARAMS:
+    @IN num_bits - number of bits.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to bitset if success.
+*/
+Bitset *bitset_create(const size_t num_bits);
+
+
+/*
+    Deallocate bitset.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+
+    RETURN:
+    %This is void function.
+*/
+void bitset_destroy(Bitset *bitset);
+
+
+/*
+    Change number of bits, new bits are cleared.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+    @IN num_bits - new number of bits.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int bitset_resize(Bitset *bitset, const size_t num_bits);
+
+
+/*
+    Set bit.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+    @IN pos - index of bit.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static inline int bitset_set(Bitset *bitset, const size_t pos);
+
+
+/*
+    Clear bit.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+    @IN pos - index of bit.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static inline int bitset_clear(Bitset *bitset, const size_t pos);
+
+
+/*
+    Test bit.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+    @IN pos - index of bit.
+
+    RETURN:
+    %1 if bit is set.
+    %0 if bit is cleared.
+    %negative value if failure.
+*/
+static inline int bitset_test(const Bitset *bitset, const size_t pos);
+
+
+/*
+    Set or clear all bits.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+    @IN value - true to set all bits, false to clear.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int bitset_fill(Bitset *bitset, const bool value);
+
+
+/*
+    dst = dst & src (bitsets have to have the same number of bits).
+
+    PARAMS:
+    @IN dst - pointer to destination bitset.
+    @IN src - pointer to source bitset.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int bitset_and(Bitset *dst, const Bitset *src);
+
+
+/*
+    dst = dst | src (bitsets have to have the same number of bits).
+
+    PARAMS:
+    @IN dst - pointer to destination bitset.
+    @IN src - pointer to source bitset.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int bitset_or(Bitset *dst, const Bitset *src);
+
+
+/*
+    dst = dst ^ src (bitsets have to have the same number of bits).
+
+    PARAMS:
+    @IN dst - pointer to destination bitset.
+    @IN src - pointer to source bitset.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int bitset_xor(Bitset *dst, const Bitset *src);
+
+
+/*
+    dst = dst & ~src (bitsets have to have the same number of bits).
+
+    PARAMS:
+    @IN dst - pointer to destination bitset.
+    @IN src - pointer to source bitset.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int bitset_andnot(Bitset *dst, const Bitset *src);
+
+
+/*
+    Count set bits.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+
+    RETURN:
+    %number of set bits if success.
+    %-1 if failure.
+*/
+ssize_t bitset_count(const Bitset *bitset);
+
+
+/*
+    Find first set bit not before @pos.
+    Iterate over set bits:
+    for (ssize_t i = bitset_find_next(b, 0); i >= 0; i = bitset_find_next(b, (size_t)i + 1))
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+    @IN pos - index of first checked bit.
+
+    RETURN:
+    %index of set bit if success.
+    %-1 if there is no set bit or failure.
+*/
+ssize_t bitset_find_next(const Bitset *bitset, const size_t pos);
+
+
+/*
+    Count set bits before @pos (in [0, pos)). O(1) with up to date rank index.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+    @IN pos - index of bit (can be equal to number of bits).
+
+    RETURN:
+    %number of set bits before @pos if success.
+    %-1 if failure.
+*/
+ssize_t bitset_rank(Bitset *bitset, const size_t pos);
+
+
+/*
+    Find index of @k-th set bit (counted from 0). O(log n) with up to date rank index.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+    @IN k - number of set bits before wanted bit.
+
+    RETURN:
+    %index of bit if success.
+    %-1 if there is less than @k + 1 set bits or failure.
+*/
+ssize_t bitset_select(Bitset *bitset, const size_t k);
+
+
+/*
+    Get number of bits.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+
+    RETURN:
+    %number of bits if success.
+    %-1 if failure.
+*/
+ssize_t bitset_get_num_bits(const Bitset *bitset);
+
+
+/*
+    Get array of words (bit i is bit i % 64 of word i / 64).
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+
+    RETURN:
+    %pointer to words if success.
+    %NULL if failure.
+*/
+uint64_t *bitset_get_words(const Bitset *bitset);
+
+
+static inline int bitset_set(Bitset *bitset, const size_t pos)
+{
+#ifdef BITSET_DEBUG
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+#endif
+
+    if (pos >= bitset->num_bits)
+        ERROR("pos >= num_bits\n", -1);
+
+    bitset->words[pos / BITSET_WORD_BITS] |= (uint64_t)1 << (pos % BITSET_WORD_BITS);
+    bitset->rank_valid = false;
+
+    return 0;
+}
+
+
+static inline int bitset_clear(Bitset *bitset, const size_t pos)
+{
+#ifdef BITSET_DEBUG
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+#endif
+
+    if (pos >= bitset->num_bits)
+        ERROR("pos >= num_bits\n", -1);
+
+    bitset->words[pos / BITSET_WORD_BITS] &= ~((uint64_t)1 << (pos % BITSET_WORD_BITS));
+    bitset->rank_valid = false;
+
+    return 0;
+}
+
+
+static inline int bitset_test(const Bitset *bitset, const size_t pos)
+{
+#ifdef BITSET_DEBUG
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+#endif
+
+    if (pos >= bitset->num_bits)
+        ERROR("pos >= num_bits\n", -1);
+
+    return (int)((bitset->words[pos / BITSET_WORD_BITS] >> (pos % BITSET_WORD_BITS)) & 1);
+}
+
+
+#endif /* BITSET_H */
@@ -0,0 +1,437 @@
+#include <bitset.h>
+#include <common.h>
+#include <stdlib.h> /* posix_memalign, malloc, free */
+#include <string.h> /* memcpy, memset */
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+
+/*
+    Count set bits in word.
+
+    PARAMS:
+    @IN x - word.
+
+    RETURN:
+    %Number of set bits.
+*/
+static ___inline___ size_t __bitset_popcount(uint64_t x);
+
+
+/*
+    Find index of @k-th set bit in word.
+
+    PARAMS:
+    @IN x - word (with more than @k set bits).
+    @IN k - number of set bits before wanted bit.
+
+    RETURN:
+    %Index of bit in word.
+*/
+static ___inline___ size_t __bitset_select_word(uint64_t x, size_t k);
+
+
+/*
+    Allocate cleared words (aligned to cache line).
+
+    PARAMS:
+    @IN num_words - number of words.
+    @OUT size - number of allocated words (at least @num_words).
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to words if success.
+*/
+static uint64_t *__bitset_alloc_words(size_t num_words, size_t *size);
+
+
+/*
+    Rebuild rank index, if bitset was changed after last build.
+
+    PARAMS:
+    @IN bitset - pointer to bitset.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __bitset_build_rank(Bitset *bitset);
+
+
+static ___inline___ size_t __bitset_popcount(uint64_t x)
+{
+#ifdef __POPCNT__
+    return (size_t)__builtin_popcountll(x);
+#else
+    /* without popcnt instruction, this version is vectorised in loops */
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    return (size_t)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+
+static ___inline___ size_t __bitset_select_word(uint64_t x, size_t k)
+{
+#ifdef __BMI2__
+    return (size_t)__builtin_ctzll(_pdep_u64((uint64_t)1 << k, x));
+#else
+    for (size_t i = 0; i < k; ++i)
+        x &= x - 1;
+
+    return (size_t)__builtin_ctzll(x);
+#endif
+}
+
+
+static uint64_t *__bitset_alloc_words(size_t num_words, size_t *size)
+{
+    /* at least one cache line, so pointer is never NULL */
+    const size_t bytes = ALIGN_UP(MAX(num_words, (size_t)1) * sizeof(uint64_t), CACHE_LINE_SIZE);
+    void *ptr = NULL;
+
+    if (posix_memalign(&ptr, CACHE_LINE_SIZE, bytes) != 0)
+        ERROR("posix_memalign error\n", NULL);
+
+    (void)memset(ptr, 0, bytes);
+    *size = bytes / sizeof(uint64_t);
+
+    return (uint64_t *)ptr;
+}
+
+
+static int __bitset_build_rank(Bitset *bitset)
+{
+    if (bitset->rank_valid)
+        return 0;
+
+    /* index is allocated for all allocated words, so it is reallocated only when bitset grows */
+    if (bitset->rank_index == NULL)
+    {
+        bitset->rank_index = (uint64_t *)malloc((bitset->size / BITSET_BLOCK_WORDS + 2) * sizeof(uint64_t));
+
+        if (bitset->rank_index == NULL)
+            ERROR("malloc error\n", -1);
+    }
+
+    const size_t num_blocks = (bitset->num_words + BITSET_BLOCK_WORDS - 1) / BITSET_BLOCK_WORDS;
+    uint64_t sum = 0;
+
+    for (size_t b = 0; b < num_blocks; ++b)
+    {
+        bitset->rank_index[b] = sum;
+
+        /* words after num_words are 0, so the last block can be counted whole */
+        for (size_t i = 0; i < BITSET_BLOCK_WORDS && b * BITSET_BLOCK_WORDS + i < bitset->size; ++i)
+            sum += __bitset_popcount(bitset->words[b * BITSET_BLOCK_WORDS + i]);
+    }
+
+    bitset->rank_index[num_blocks] = sum;
+    bitset->rank_valid = true;
+
+    return 0;
+}
+
+
+Bitset *bitset_create(const size_t num_bits)
+{
+    if (num_bits > SIZE_MAX - BITSET_WORD_BITS)
+        ERROR("num_bits is too big\n", NULL);
+
+    Bitset *bitset = (Bitset *)malloc(sizeof(Bitset));
+
+    if (bitset == NULL)
+        ERROR("malloc error\n", NULL);
+
+    bitset->num_bits = num_bits;
+    bitset->num_words = (num_bits + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+    bitset->words = __bitset_alloc_words(bitset->num_words, &bitset->size);
+
+    if (bitset->words == NULL)
+    {
+        FREE(bitset);
+        ERROR("__bitset_alloc_words error\n", NULL);
+    }
+
+    bitset->rank_index = NULL;
+    bitset->rank_valid = false;
+
+    return bitset;
+}
+
+
+void bitset_destroy(Bitset *bitset)
+{
+    if (bitset == NULL)
+        return;
+
+    FREE(bitset->words);
+    FREE(bitset->rank_index);
+    FREE(bitset);
+}
+
+
+int bitset_resize(Bitset *bitset, const size_t num_bits)
+{
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+
+    if (num_bits > SIZE_MAX - BITSET_WORD_BITS)
+        ERROR("num_bits is too big\n", -1);
+
+    const size_t num_words = (num_bits + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS;
+
+    if (num_words > bitset->size)
+    {
+        /* grow at least twice, so growing bit by bit is amortized O(1) */
+        size_t size;
+        uint64_t *words = __bitset_alloc_words(MAX(num_words, bitset->size * 2), &size);
+
+        if (words == NULL)
+            ERROR("__bitset_alloc_words error\n", -1);
+
+        (void)memcpy(words, bitset->words, bitset->num_words * sizeof(uint64_t));
+
+        FREE(bitset->words);
+        FREE(bitset->rank_index);
+
+        bitset->words = words;
+        bitset->size = size;
+    }
+    else if (num_bits < bitset->num_bits)
+    {
+        /* bits after num_bits have to be 0 */
+        (void)memset(bitset->words + num_words, 0, (bitset->num_words - num_words) * sizeof(uint64_t));
+
+        if (num_bits % BITSET_WORD_BITS != 0)
+            bitset->words[num_words - 1] &= ((uint64_t)1 << (num_bits % BITSET_WORD_BITS)) - 1;
+    }
+
+    bitset->num_bits = num_bits;
+    bitset->num_words = num_words;
+    bitset->rank_valid = false;
+
+    return 0;
+}
+
+
+int bitset_fill(Bitset *bitset, const bool value)
+{
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+
+    (void)memset(bitset->words, value ? 0xFF : 0, bitset->num_words * sizeof(uint64_t));
+
+    if (value && bitset->num_bits % BITSET_WORD_BITS != 0)
+        bitset->words[bitset->num_words - 1] = ((uint64_t)1 << (bitset->num_bits % BITSET_WORD_BITS)) - 1;
+
+    bitset->rank_valid = false;
+
+    return 0;
+}
+
+
+int bitset_and(Bitset *dst, const Bitset *src)
+{
+    if (dst == NULL || src == NULL)
+        ERROR("dst == NULL || src == NULL\n", -1);
+
+    if (dst->num_bits != src->num_bits)
+        ERROR("dst->num_bits != src->num_bits\n", -1);
+
+    uint64_t *d = dst->words;
+    const uint64_t *s = src->words;
+
+    for (size_t i = 0; i < dst->num_words; ++i)
+        d[i] &= s[i];
+
+    dst->rank_valid = false;
+
+    return 0;
+}
+
+
+int bitset_or(Bitset *dst, const Bitset *src)
+{
+    if (dst == NULL || src == NULL)
+        ERROR("dst == NULL || src == NULL\n", -1);
+
+    if (dst->num_bits != src->num_bits)
+        ERROR("dst->num_bits != src->num_bits\n", -1);
+
+    uint64_t *d = dst->words;
+    const uint64_t *s = src->words;
+
+    for (size_t i = 0; i < dst->num_words; ++i)
+        d[i] |= s[i];
+
+    dst->rank_valid = false;
+
+    return 0;
+}
+
+
+int bitset_xor(Bitset *dst, const Bitset *src)
+{
+    if (dst == NULL || src == NULL)
+        ERROR("dst == NULL || src == NULL\n", -1);
+
+    if (dst->num_bits != src->num_bits)
+        ERROR("dst->num_bits != src->num_bits\n", -1);
+
+    uint64_t *d = dst->words;
+    const uint64_t *s = src->words;
+
+    for (size_t i = 0; i < dst->num_words; ++i)
+        d[i] ^= s[i];
+
+    dst->rank_valid = false;
+
+    return 0;
+}
+
+
+int bitset_andnot(Bitset *dst, const Bitset *src)
+{
+    if (dst == NULL || src == NULL)
+        ERROR("dst == NULL || src == NULL\n", -1);
+
+    if (dst->num_bits != src->num_bits)
+        ERROR("dst->num_bits != src->num_bits\n", -1);
+
+    uint64_t *d = dst->words;
+    const uint64_t *s = src->words;
+
+    for (size_t i = 0; i < dst->num_words; ++i)
+        d[i] &= ~s[i];
+
+    dst->rank_valid = false;
+
+    return 0;
+}
+
+
+ssize_t bitset_count(const Bitset *bitset)
+{
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+
+    size_t sum = 0;
+
+    for (size_t i = 0; i < bitset->num_words; ++i)
+        sum += __bitset_popcount(bitset->words[i]);
+
+    return (ssize_t)sum;
+}
+
+
+ssize_t bitset_find_next(const Bitset *bitset, const size_t pos)
+{
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+
+    if (pos >= bitset->num_bits)
+        return -1;
+
+    size_t w = pos / BITSET_WORD_BITS;
+    uint64_t word = bitset->words[w] & (~(uint64_t)0 << (pos % BITSET_WORD_BITS));
+
+    /* bits after num_bits are 0, so found bit is always in range */
+    while (word == 0)
+    {
+        if (++w == bitset->num_words)
+            return -1;
+
+        word = bitset->words[w];
+    }
+
+    return (ssize_t)(w * BITSET_WORD_BITS + (size_t)__builtin_ctzll(word));
+}
+
+
+ssize_t bitset_rank(Bitset *bitset, const size_t pos)
+{
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+
+    if (pos > bitset->num_bits)
+        ERROR("pos > num_bits\n", -1);
+
+    if (__bitset_build_rank(bitset) != 0)
+        ERROR("__bitset_build_rank error\n", -1);
+
+    const size_t w = pos / BITSET_WORD_BITS;
+    const size_t block = w / BITSET_BLOCK_WORDS;
+    size_t sum = (size_t)bitset->rank_index[block];
+
+    for (size_t i = block * BITSET_BLOCK_WORDS; i < w; ++i)
+        sum += __bitset_popcount(bitset->words[i]);
+
+    if (pos % BITSET_WORD_BITS != 0)
+        sum += __bitset_popcount(bitset->words[w] & (((uint64_t)1 << (pos % BITSET_WORD_BITS)) - 1));
+
+    return (ssize_t)sum;
+}
+
+
+ssize_t bitset_select(Bitset *bitset, const size_t k)
+{
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+
+    if (__bitset_build_rank(bitset) != 0)
+        ERROR("__bitset_build_rank error\n", -1);
+
+    const size_t num_blocks = (bitset->num_words + BITSET_BLOCK_WORDS - 1) / BITSET_BLOCK_WORDS;
+
+    if (k >= bitset->rank_index[num_blocks])
+        return -1;
+
+    /* the last block with less than k set bits before it */
+    size_t low = 0;
+    size_t high = num_blocks - 1;
+
+    while (low < high)
+    {
+        const size_t mid = low + (high - low + 1) / 2;
+
+        if (bitset->rank_index[mid] <= k)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    size_t left = k - (size_t)bitset->rank_index[low];
+
+    for (size_t w = low * BITSET_BLOCK_WORDS; ; ++w)
+    {
+        const size_t count = __bitset_popcount(bitset->words[w]);
+
+        if (left < count)
+            return (ssize_t)(w * BITSET_WORD_BITS + __bitset_select_word(bitset->words[w], left));
+
+        left -= count;
+    }
+}
+
+
+ssize_t bitset_get_num_bits(const Bitset *bitset)
+{
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", -1);
+
+    return (ssize_t)bitset->num_bits;
+}
+
+
+uint64_t *bitset_get_words(const Bitset *bitset)
+{
+    if (bitset == NULL)
+        ERROR("bitset == NULL\n", NULL);
+
+    return bitset->words;
+}
@@ -0,0 +1,346 @@
+#include <bitset.h>
+#include <common.h>
+#include <ctest.h>
+#include <stdint.h> /* uint64_t */
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/* functions needed for testing */
+static void random_fill(Bitset *bitset, bool *ref, size_t len, int density);
+
+
+/* unit tests function declaraions */
+static void test_bitset_create(void);
+static void test_bitset_set_clear_test(void);
+static void test_bitset_bulk_ops(void);
+static void test_bitset_count_find_next(void);
+static void test_bitset_rank_select(void);
+static void test_bitset_resize_fill(void);
+
+
+/* implementation */
+static void random_fill(Bitset *bitset, bool *ref, size_t len, int density)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        ref[i] = rand() % 100 < density;
+
+        if (ref[i])
+            (void)bitset_set(bitset, i);
+        else
+            (void)bitset_clear(bitset, i);
+    }
+}
+
+
+static void test_bitset_create(void)
+{
+    Bitset *bitset = bitset_create(100);
+    T_ERROR(bitset == NULL);
+
+    T_EXPECT(bitset_get_num_bits(bitset), (ssize_t)100);
+    T_EXPECT(bitset_count(bitset), (ssize_t)0);
+    T_ASSERT(bitset_get_words(bitset) == NULL, false);
+
+    /* words are aligned to cache line */
+    const uint64_t *words = bitset_get_words(bitset);
+    T_EXPECT((uintptr_t)words % CACHE_LINE_SIZE, (uintptr_t)0);
+
+    bitset_destroy(bitset);
+
+    /* empty bitset */
+    bitset = bitset_create(0);
+    T_ERROR(bitset == NULL);
+
+    T_EXPECT(bitset_count(bitset), (ssize_t)0);
+    T_EXPECT(bitset_find_next(bitset, 0), (ssize_t)-1);
+    T_EXPECT(bitset_rank(bitset, 0), (ssize_t)0);
+    T_EXPECT(bitset_select(bitset, 0), (ssize_t)-1);
+    T_EXPECT(bitset_set(bitset, 0), -1);
+
+    bitset_destroy(bitset);
+
+    T_EXPECT(bitset_count(NULL), (ssize_t)-1);
+    T_EXPECT(bitset_get_num_bits(NULL), (ssize_t)-1);
+    T_ASSERT(bitset_get_words(NULL) == NULL, true);
+    T_EXPECT(bitset_resize(NULL, 10), -1);
+    T_EXPECT(bitset_fill(NULL, true), -1);
+}
+
+
+static void test_bitset_set_clear_test(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    bool ref[ARRAY_TEST_SIZE];
+
+    Bitset *bitset = bitset_create(ARRAY_TEST_SIZE);
+    T_ERROR(bitset == NULL);
+
+    random_fill(bitset, ref, ARRAY_TEST_SIZE, 50);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(bitset_test(bitset, i), (int)ref[i]);
+
+    /* set and clear are idempotent */
+    T_EXPECT(bitset_set(bitset, 5), 0);
+    T_EXPECT(bitset_set(bitset, 5), 0);
+    T_EXPECT(bitset_test(bitset, 5), 1);
+    T_EXPECT(bitset_clear(bitset, 5), 0);
+    T_EXPECT(bitset_clear(bitset, 5), 0);
+    T_EXPECT(bitset_test(bitset, 5), 0);
+
+    /* last bit */
+    T_EXPECT(bitset_set(bitset, ARRAY_TEST_SIZE - 1), 0);
+    T_EXPECT(bitset_test(bitset, ARRAY_TEST_SIZE - 1), 1);
+
+    /* out of range */
+    T_EXPECT(bitset_set(bitset, ARRAY_TEST_SIZE), -1);
+    T_EXPECT(bitset_clear(bitset, ARRAY_TEST_SIZE), -1);
+    T_EXPECT(bitset_test(bitset, ARRAY_TEST_SIZE), -1);
+
+    bitset_destroy(bitset);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_bitset_bulk_ops(void)
+{
+    #define ARRAY_TEST_SIZE 1234
+
+    bool ref_a[ARRAY_TEST_SIZE];
+    bool ref_b[ARRAY_TEST_SIZE];
+
+    Bitset *a = bitset_create(ARRAY_TEST_SIZE);
+    T_ERROR(a == NULL);
+
+    Bitset *b = bitset_create(ARRAY_TEST_SIZE);
+    T_ERROR(b == NULL);
+
+    Bitset *c = bitset_create(ARRAY_TEST_SIZE);
+    T_ERROR(c == NULL);
+
+    Bitset *other = bitset_create(ARRAY_TEST_SIZE + 1);
+    T_ERROR(other == NULL);
+
+    random_fill(a, ref_a, ARRAY_TEST_SIZE, 50);
+    random_fill(b, ref_b, ARRAY_TEST_SIZE, 30);
+
+    /* c = a & b */
+    T_EXPECT(bitset_fill(c, false), 0);
+    T_EXPECT(bitset_or(c, a), 0);
+    T_EXPECT(bitset_and(c, b), 0);
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(bitset_test(c, i), (int)(ref_a[i] && ref_b[i]));
+
+    /* c = a | b */
+    T_EXPECT(bitset_fill(c, false), 0);
+    T_EXPECT(bitset_or(c, a), 0);
+    T_EXPECT(bitset_or(c, b), 0);
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(bitset_test(c, i), (int)(ref_a[i] || ref_b[i]));
+
+    /* c = a ^ b */
+    T_EXPECT(bitset_fill(c, false), 0);
+    T_EXPECT(bitset_or(c, a), 0);
+    T_EXPECT(bitset_xor(c, b), 0);
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(bitset_test(c, i), (int)(ref_a[i] != ref_b[i]));
+
+    /* c = a & ~b */
+    T_EXPECT(bitset_fill(c, false), 0);
+    T_EXPECT(bitset_or(c, a), 0);
+    T_EXPECT(bitset_andnot(c, b), 0);
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(bitset_test(c, i), (int)(ref_a[i] && !ref_b[i]));
+
+    /* ~0 & ~b keeps bits after num_bits cleared */
+    T_EXPECT(bitset_fill(c, true), 0);
+    T_EXPECT(bitset_andnot(c, b), 0);
+    T_EXPECT(bitset_xor(c, b), 0);
+    T_EXPECT(bitset_count(c), (ssize_t)ARRAY_TEST_SIZE);
+
+    /* the same bitset as dst and src */
+    T_EXPECT(bitset_xor(c, c), 0);
+    T_EXPECT(bitset_count(c), (ssize_t)0);
+
+    /* different sizes */
+    T_EXPECT(bitset_and(a, other), -1);
+    T_EXPECT(bitset_or(a, other), -1);
+    T_EXPECT(bitset_xor(a, other), -1);
+    T_EXPECT(bitset_andnot(a, other), -1);
+    T_EXPECT(bitset_and(a, NULL), -1);
+
+    bitset_destroy(a);
+    bitset_destroy(b);
+    bitset_destroy(c);
+    bitset_destroy(other);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_bitset_count_find_next(void)
+{
+    #define ARRAY_TEST_SIZE 2000
+
+    bool ref[ARRAY_TEST_SIZE];
+
+    Bitset *bitset = bitset_create(ARRAY_TEST_SIZE);
+    T_ERROR(bitset == NULL);
+
+    /* sparse bits, so there are empty words between them */
+    random_fill(bitset, ref, ARRAY_TEST_SIZE, 2);
+
+    ssize_t expected_count = 0;
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        expected_count += ref[i];
+
+    T_EXPECT(bitset_count(bitset), expected_count);
+
+    /* iterate over set bits */
+    size_t next = 0;
+    ssize_t found = 0;
+    for (ssize_t i = bitset_find_next(bitset, 0); i >= 0; i = bitset_find_next(bitset, (size_t)i + 1))
+    {
+        while (!ref[next])
+            ++next;
+
+        T_EXPECT((size_t)i, next);
+        ++next;
+        ++found;
+    }
+
+    T_EXPECT(found, expected_count);
+
+    T_EXPECT(bitset_clear(bitset, ARRAY_TEST_SIZE - 1), 0);
+    T_EXPECT(bitset_find_next(bitset, ARRAY_TEST_SIZE - 1), (ssize_t)-1);
+    T_EXPECT(bitset_find_next(bitset, ARRAY_TEST_SIZE), (ssize_t)-1);
+
+    T_EXPECT(bitset_set(bitset, ARRAY_TEST_SIZE - 1), 0);
+    T_EXPECT(bitset_find_next(bitset, ARRAY_TEST_SIZE - 1), (ssize_t)(ARRAY_TEST_SIZE - 1));
+
+    T_EXPECT(bitset_find_next(NULL, 0), (ssize_t)-1);
+
+    bitset_destroy(bitset);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_bitset_rank_select(void)
+{
+    #define ARRAY_TEST_SIZE 5000
+
+    bool ref[ARRAY_TEST_SIZE];
+    size_t positions[ARRAY_TEST_SIZE];
+
+    Bitset *bitset = bitset_create(ARRAY_TEST_SIZE);
+    T_ERROR(bitset == NULL);
+
+    const int densities[] = {1, 50, 99};
+
+    for (size_t d = 0; d < ARRAY_SIZE(densities); ++d)
+    {
+        random_fill(bitset, ref, ARRAY_TEST_SIZE, densities[d]);
+
+        size_t count = 0;
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            T_EXPECT(bitset_rank(bitset, i), (ssize_t)count);
+
+            if (ref[i])
+                positions[count++] = i;
+        }
+
+        T_EXPECT(bitset_rank(bitset, ARRAY_TEST_SIZE), (ssize_t)count);
+        T_EXPECT(bitset_rank(bitset, ARRAY_TEST_SIZE + 1), (ssize_t)-1);
+
+        for (size_t k = 0; k < count; ++k)
+            T_EXPECT(bitset_select(bitset, k), (ssize_t)positions[k]);
+
+        T_EXPECT(bitset_select(bitset, count), (ssize_t)-1);
+    }
+
+    /* index is rebuilt after change */
+    T_EXPECT(bitset_fill(bitset, false), 0);
+    T_EXPECT(bitset_rank(bitset, ARRAY_TEST_SIZE), (ssize_t)0);
+    T_EXPECT(bitset_set(bitset, 4321), 0);
+    T_EXPECT(bitset_rank(bitset, ARRAY_TEST_SIZE), (ssize_t)1);
+    T_EXPECT(bitset_rank(bitset, 4321), (ssize_t)0);
+    T_EXPECT(bitset_rank(bitset, 4322), (ssize_t)1);
+    T_EXPECT(bitset_select(bitset, 0), (ssize_t)4321);
+
+    T_EXPECT(bitset_rank(NULL, 0), (ssize_t)-1);
+    T_EXPECT(bitset_select(NULL, 0), (ssize_t)-1);
+
+    bitset_destroy(bitset);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_bitset_resize_fill(void)
+{
+    Bitset *bitset = bitset_create(10);
+    T_ERROR(bitset == NULL);
+
+    T_EXPECT(bitset_fill(bitset, true), 0);
+    T_EXPECT(bitset_count(bitset), (ssize_t)10);
+
+    /* new bits are cleared */
+    T_EXPECT(bitset_resize(bitset, 1000), 0);
+    T_EXPECT(bitset_get_num_bits(bitset), (ssize_t)1000);
+    T_EXPECT(bitset_count(bitset), (ssize_t)10);
+    T_EXPECT(bitset_test(bitset, 9), 1);
+    T_EXPECT(bitset_test(bitset, 10), 0);
+    T_EXPECT(bitset_select(bitset, 9), (ssize_t)9);
+
+    T_EXPECT(bitset_fill(bitset, true), 0);
+    T_EXPECT(bitset_count(bitset), (ssize_t)1000);
+    T_EXPECT(bitset_rank(bitset, 1000), (ssize_t)1000);
+
+    /* bits after new size are dropped, also in the middle of word */
+    T_EXPECT(bitset_resize(bitset, 70), 0);
+    T_EXPECT(bitset_count(bitset), (ssize_t)70);
+    T_EXPECT(bitset_rank(bitset, 70), (ssize_t)70);
+
+    T_EXPECT(bitset_resize(bitset, 700), 0);
+    T_EXPECT(bitset_count(bitset), (ssize_t)70);
+    T_EXPECT(bitset_find_next(bitset, 70), (ssize_t)-1);
+
+    /* grow bit by bit */
+    for (size_t i = 700; i < 5000; ++i)
+    {
+        T_EXPECT(bitset_resize(bitset, i + 1), 0);
+        T_EXPECT(bitset_set(bitset, i), 0);
+    }
+
+    T_EXPECT(bitset_count(bitset), (ssize_t)(70 + 5000 - 700));
+    T_EXPECT(bitset_find_next(bitset, 70), (ssize_t)700);
+
+    T_EXPECT(bitset_resize(bitset, 0), 0);
+    T_EXPECT(bitset_count(bitset), (ssize_t)0);
+
+    T_EXPECT(bitset_resize(bitset, 64), 0);
+    T_EXPECT(bitset_count(bitset), (ssize_t)0);
+
+    bitset_destroy(bitset);
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING BITSET");
+    TEST(test_bitset_create());
+    TEST(test_bitset_set_clear_test());
+    TEST(test_bitset_bulk_ops());
+    TEST(test_bitset_count_find_next());
+    TEST(test_bitset_rank_select());
+    TEST(test_bitset_resize_fill());
+    TEST_SUMMARY();
+
+    return 0;
+}
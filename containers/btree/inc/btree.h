@@ -0,0 +1,297 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+/*
+    Generic B+ Tree implementation.
+
+    Entries are kept only in leaves, internal nodes keep copies of entries as
+    separators and pointers to children. Node has BTREE_NODE_SIZE bytes (few
+    cache lines), so with small entries one node holds tens of entries and
+    lookup touches only height (3 - 5 for millions of entries) nodes instead of
+    one node per level of binary tree. Leaves are linked, so range scan is
+    sequential walk over leaves.
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+#include <stddef.h>     /* size_t */
+#include <common.h>     /* BYTE, compare_f, destructor_f, chunk_f */
+#include <sys/types.h>  /* ssize_t */
+#include <stdbool.h>    /* bool */
+
+
+/* size of node in bytes, nodes with big entries are bigger (at least BTREE_MIN_CAPACITY entries) */
+#define BTREE_NODE_SIZE ((size_t)(8 * CACHE_LINE_SIZE))
+
+/* minimal number of entries in leaf and keys in internal node */
+#define BTREE_MIN_CAPACITY ((size_t)4)
+
+/* max height of tree (every node has at least 3 children) */
+#define BTREE_MAX_HEIGHT ((size_t)64)
+
+
+typedef struct Btree_node
+{
+    struct Btree_node *next;        /* pointer to next leaf (only leaf)           */
+    struct Btree_node *prev;        /* pointer to previous leaf (only leaf)       */
+    size_t num_keys;                /* entries in leaf, keys in internal node     */
+    size_t level;                   /* 0 for leaf, height of subtree - 1 otherwise */
+
+    BYTE data[];                    /* leaf: entries, internal: children, keys    */
+} Btree_node;
+
+typedef struct Btree
+{
+    Btree_node *root;               /* pointer to root                            */
+    Btree_node *first_leaf;         /* pointer to leaf with min entry             */
+    Btree_node *last_leaf;          /* pointer to leaf with max entry             */
+    void *tmp;                      /* separator moved to parent during split     */
+
+    size_t num_entries;             /* number of entries                          */
+    size_t size_of;                 /* size of each entry                         */
+    size_t leaf_capacity;           /* max number of entries in leaf              */
+    size_t inner_capacity;          /* max number of keys in internal node        */
+
+    compare_f cmp_f;                /* compare function                           */
+    destructor_f destroy_f;         /* destroy function                           */
+} Btree;
+
+
+/*
+    Create B+ Tree.
+
+    PARAMS:
+    @IN size_of - size_of data in tree.
+    @IN cmp_f - compare function.
+    @IN destroy_f - your data destructor function.
+
+    RETURN:
+    %NULL iff failure.
+    %Pointer to B+ Tree iff success.
+*/
+Btree *btree_create(const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f);
+
+
+/*
+    Destroy B+ Tree.
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+
+    RETURN:
+    %This is void function.
+*/
+void btree_destroy(Btree *tree);
+
+
+/*
+    Destroy B+ Tree with all entries (call destructor for each entries).
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+
+    RETURN:
+    %This is void function.
+*/
+void btree_destroy_with_entries(Btree *tree);
+
+
+/*
+    Insert data to B+ Tree using compare function, if data is not actually in tree.
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+    @IN data - pointer to entry data.
+
+    RETURN:
+    %0 if success.
+    %1 if key exists in tree.
+    %-1 if failure.
+*/
+int btree_insert(Btree * __restrict__ tree, const void * __restrict__ const data);
+
+
+/*
+    Delete data from B+ Tree using compare function, if data is actually in tree.
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+    @IN data_key - addr of data with key do delete.
+
+    RETURN:
+    %0 if success.
+    %1 if key doesn't exists in tree.
+    %-1 if failure.
+*/
+int btree_delete(Btree * __restrict__ tree, const void * __restrict__ const data_key);
+
+
+/*
+    Delete data from B+ Tree using compare function, if data is actually in tree.
+    (Destructor will be called).
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+    @IN data_key - addr of data with key do delete.
+
+    RETURN:
+    %0 if success.
+    %1 if key doesn't exists in tree.
+    %-1 if failure.
+*/
+int btree_delete_with_entry(Btree * __restrict__ tree, const void * __restrict__ const data_key);
+
+
+/*
+    Getter of min value using compare function in tree.
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+    @OUT data - pointer to data.
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure (or tree is empty).
+*/
+int btree_min(const Btree * __restrict__ const tree, void * __restrict__ data);
+
+
+/*
+    Getter of max value using compare function in tree.
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+    @OUT data - pointer to data.
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure (or tree is empty).
+*/
+int btree_max(const Btree * __restrict__ const tree, void * __restrict__ data);
+
+
+/*
+    Search the data in B+ Tree using compare function (data_key equals key in tree).
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+    @IN data_key - addr of data with search key.
+    @OUT data_out - returned data with addr.
+
+    RETURN:
+    %0 if success.
+    %1 if key doesn't exists in tree.
+    %Negative value if failure.
+*/
+int btree_search(const Btree * __restrict__ const tree, const void * const data_key, void * data_out);
+
+
+/*
+    Check if key existing in B+ Tree.
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+    @IN data_key - addr of data with search key.
+
+    RETURN:
+    %true if key exist.
+    %false if key doesn't exist or failure.
+*/
+bool btree_key_exist(const Btree * __restrict__ const tree, const void * __restrict__ const data_key);
+
+
+/*
+    Convert B+ Tree to sorted array.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @OUT array - pointer to array.
+    @OUT size - size of array;
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure (or tree is empty).
+*/
+int btree_to_array(const Btree * __restrict__ const tree, void * __restrict__ array, size_t * __restrict__ size);
+
+
+/*
+    Export entries from range [@data_from, @data_to] in order in chunks of @chunk_len entries.
+    Chunk buffer is filled and passed to @consume_f, last chunk can be shorter.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN data_from - addr of data with first key of range (NULL means from min).
+    @IN data_to - addr of data with last key of range (NULL means to max).
+    @IN chunk - pointer to chunk buffer provided by caller.
+    @IN chunk_len - number of entries which fit in chunk.
+    @IN consume_f - chunk consumer function.
+    @IN arg - user argument passed to consume_f.
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure.
+    %Value returned by consume_f if it stopped export.
+*/
+int btree_range_chunks(const Btree * __restrict__ const tree, const void *data_from, const void *data_to,
+                       void * __restrict__ chunk, const size_t chunk_len, const chunk_f consume_f, void *arg);
+
+
+/*
+    Build B+ Tree from sorted array (without duplicates) in O(n).
+    Tree has to be empty, nodes are filled almost full.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN array - sorted array of entries.
+    @IN len - number of entries.
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure (or array is not sorted).
+*/
+int btree_bulk_load(Btree * __restrict__ tree, const void * __restrict__ array, const size_t len);
+
+
+/*
+    Get number of entries.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+
+    RETURN:
+    %Number of entires if success.
+    %-1 if failure.
+*/
+ssize_t btree_get_num_entries(const Btree * const tree);
+
+
+/*
+    Get size of B+ Tree data.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+
+    RETURN:
+    %Size of data if success.
+    %-1 if failure.
+*/
+ssize_t btree_get_data_size(const Btree * const tree);
+
+
+/*
+    Get height of B+ Tree (tree with only one leaf has height 1).
+
+    PARAMS:
+    @IN tree - pointer to tree.
+
+    RETURN:
+    %Height of tree if success.
+    %-1 if failure.
+*/
+int btree_get_height(const Btree * const tree);
+
+#endif /* BTREE_H */
@@ -0,0 +1,1054 @@
+#include <btree.h>
+#include <common.h>
+#include <stdlib.h> /* posix_memalign, malloc, free */
+#include <string.h> /* memcpy, memmove */
+
+
+/*
+    Create new node.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN level - level of node (0 for leaf).
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to node if success.
+*/
+static Btree_node *__btree_node_create(const Btree *tree, size_t level);
+
+
+/*
+    Destroy node with all its subtree (entries are not destroyed).
+
+    PARAMS:
+    @IN node - pointer to node.
+
+    RETURN:
+    %This is void function.
+*/
+static void __btree_node_destroy(Btree_node *node);
+
+
+/*
+    Get pointer to i-th entry in leaf.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN node - pointer to leaf.
+    @IN i - index of entry.
+
+    RETURN:
+    %Pointer to entry.
+*/
+static ___inline___ BYTE *__btree_entry(const Btree *tree, Btree_node *node, size_t i);
+
+
+/*
+    Get pointer to i-th key in internal node.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN node - pointer to internal node.
+    @IN i - index of key.
+
+    RETURN:
+    %Pointer to key.
+*/
+static ___inline___ BYTE *__btree_key(const Btree *tree, Btree_node *node, size_t i);
+
+
+/*
+    Get array of children of internal node.
+
+    PARAMS:
+    @IN node - pointer to internal node.
+
+    RETURN:
+    %Pointer to array of children.
+*/
+static ___inline___ Btree_node **__btree_children(Btree_node *node);
+
+
+/*
+    Find first key not less than @key.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN keys - pointer to sorted keys.
+    @IN num_keys - number of keys.
+    @IN key - pointer to key.
+
+    RETURN:
+    %Index of first key >= @key (@num_keys if there is no such key).
+*/
+static size_t __btree_lower_bound(const Btree *tree, const BYTE *keys, size_t num_keys, const void *key);
+
+
+/*
+    Find first key greater than @key.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN keys - pointer to sorted keys.
+    @IN num_keys - number of keys.
+    @IN key - pointer to key.
+
+    RETURN:
+    %Index of first key > @key (@num_keys if there is no such key).
+*/
+static size_t __btree_upper_bound(const Btree *tree, const BYTE *keys, size_t num_keys, const void *key);
+
+
+/*
+    Go from root to leaf which can contain @key.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN key - pointer to key.
+    @OUT path - internal nodes on the way from root (can be NULL).
+    @OUT pos - index of child chosen in each node from path (can be NULL).
+
+    RETURN:
+    %Pointer to leaf.
+*/
+static Btree_node *__btree_find_leaf(const Btree *tree, const void *key, Btree_node **path, size_t *pos);
+
+
+/*
+    Get min entry of subtree.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN node - pointer to root of subtree.
+
+    RETURN:
+    %Pointer to min entry.
+*/
+static BYTE *__btree_subtree_min(const Btree *tree, Btree_node *node);
+
+
+/*
+    Move upper half of overfull leaf to new leaf @right, first entry of @right goes to tree->tmp.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN left - pointer to overfull leaf.
+    @IN right - pointer to new empty leaf.
+
+    RETURN:
+    %This is void function.
+*/
+static void __btree_split_leaf(Btree *tree, Btree_node *left, Btree_node *right);
+
+
+/*
+    Move upper half of overfull internal node to new node @right, middle key goes to tree->tmp.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN left - pointer to overfull internal node.
+    @IN right - pointer to new empty internal node.
+
+    RETURN:
+    %This is void function.
+*/
+static void __btree_split_inner(Btree *tree, Btree_node *left, Btree_node *right);
+
+
+/*
+    Move one entry (key) from left sibling to @node through parent.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN parent - pointer to parent.
+    @IN i - index of @node in parent.
+    @IN left - pointer to left sibling.
+    @IN node - pointer to node.
+
+    RETURN:
+    %This is void function.
+*/
+static void __btree_borrow_left(const Btree *tree, Btree_node *parent, size_t i, Btree_node *left, Btree_node *node);
+
+
+/*
+    Move one entry (key) from right sibling to @node through parent.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN parent - pointer to parent.
+    @IN i - index of @node in parent.
+    @IN node - pointer to node.
+    @IN right - pointer to right sibling.
+
+    RETURN:
+    %This is void function.
+*/
+static void __btree_borrow_right(const Btree *tree, Btree_node *parent, size_t i, Btree_node *node, Btree_node *right);
+
+
+/*
+    Merge @right into @left, key @i and child @i + 1 are removed from parent.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN parent - pointer to parent.
+    @IN i - index of @left in parent.
+    @IN left - pointer to left node.
+    @IN right - pointer to right node (will be freed).
+
+    RETURN:
+    %This is void function.
+*/
+static void __btree_merge(Btree *tree, Btree_node *parent, size_t i, Btree_node *left, Btree_node *right);
+
+
+/*
+    Delete data from B+ Tree.
+
+    PARAMS:
+    @IN tree - pointer to B+ Tree.
+    @IN data_key - addr of data with key do delete.
+    @IN destroy - call destructor for deleted entry.
+
+    RETURN:
+    %0 if success.
+    %1 if key doesn't exists in tree.
+    %-1 if failure.
+*/
+static int __btree_delete(Btree * __restrict__ tree, const void * __restrict__ const data_key, bool destroy);
+
+
+static Btree_node *__btree_node_create(const Btree *tree, size_t level)
+{
+    size_t size = offsetof(Btree_node, data);
+
+    if (level == 0)
+        size += (tree->leaf_capacity + 1) * tree->size_of;
+    else
+        size += (tree->inner_capacity + 2) * sizeof(Btree_node *) + (tree->inner_capacity + 1) * tree->size_of;
+
+    /* node starts on cache line, so it takes the least number of cache lines */
+    void *ptr = NULL;
+
+    if (posix_memalign(&ptr, CACHE_LINE_SIZE, size) != 0)
+        ERROR("posix_memalign error\n", NULL);
+
+    Btree_node *node = (Btree_node *)ptr;
+
+    node->next = NULL;
+    node->prev = NULL;
+    node->num_keys = 0;
+    node->level = level;
+
+    return node;
+}
+
+
+static void __btree_node_destroy(Btree_node *node)
+{
+    if (node->level > 0)
+    {
+        Btree_node **children = __btree_children(node);
+
+        for (size_t i = 0; i <= node->num_keys; ++i)
+            __btree_node_destroy(children[i]);
+    }
+
+    free(node);
+}
+
+
+static ___inline___ BYTE *__btree_entry(const Btree *tree, Btree_node *node, size_t i)
+{
+    return node->data + i * tree->size_of;
+}
+
+
+static ___inline___ BYTE *__btree_key(const Btree *tree, Btree_node *node, size_t i)
+{
+    return node->data + (tree->inner_capacity + 2) * sizeof(Btree_node *) + i * tree->size_of;
+}
+
+
+static ___inline___ Btree_node **__btree_children(Btree_node *node)
+{
+    return (Btree_node **)(void *)node->data;
+}
+
+
+static size_t __btree_lower_bound(const Btree *tree, const BYTE *keys, size_t num_keys, const void *key)
+{
+    size_t low = 0;
+    size_t high = num_keys;
+
+    while (low < high)
+    {
+        const size_t mid = low + (high - low) / 2;
+
+        if (tree->cmp_f(keys + mid * tree->size_of, key) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+
+static size_t __btree_upper_bound(const Btree *tree, const BYTE *keys, size_t num_keys, const void *key)
+{
+    size_t low = 0;
+    size_t high = num_keys;
+
+    while (low < high)
+    {
+        const size_t mid = low + (high - low) / 2;
+
+        if (tree->cmp_f(keys + mid * tree->size_of, key) <= 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+
+static Btree_node *__btree_find_leaf(const Btree *tree, const void *key, Btree_node **path, size_t *pos)
+{
+    Btree_node *node = tree->root;
+    size_t depth = 0;
+
+    /* child i keeps entries from [key[i - 1], key[i]) */
+    while (node->level > 0)
+    {
+        const size_t i = __btree_upper_bound(tree, __btree_key(tree, node, 0), node->num_keys, key);
+
+        if (path != NULL)
+        {
+            path[depth] = node;
+            pos[depth] = i;
+        }
+
+        ++depth;
+        node = __btree_children(node)[i];
+    }
+
+    return node;
+}
+
+
+static BYTE *__btree_subtree_min(const Btree *tree, Btree_node *node)
+{
+    while (node->level > 0)
+        node = __btree_children(node)[0];
+
+    return __btree_entry(tree, node, 0);
+}
+
+
+static void __btree_split_leaf(Btree *tree, Btree_node *left, Btree_node *right)
+{
+    const size_t num_right = left->num_keys / 2;
+    const size_t num_left = left->num_keys - num_right;
+
+    (void)memcpy(__btree_entry(tree, right, 0), __btree_entry(tree, left, num_left), num_right * tree->size_of);
+    right->num_keys = num_right;
+    left->num_keys = num_left;
+
+    right->prev = left;
+    right->next = left->next;
+
+    if (left->next != NULL)
+        left->next->prev = right;
+    else
+        tree->last_leaf = right;
+
+    left->next = right;
+
+    (void)memcpy(tree->tmp, __btree_entry(tree, right, 0), tree->size_of);
+}
+
+
+static void __btree_split_inner(Btree *tree, Btree_node *left, Btree_node *right)
+{
+    const size_t mid = left->num_keys / 2;
+    const size_t num_right = left->num_keys - mid - 1;
+
+    /* middle key goes up, it isn't kept in any of nodes */
+    (void)memcpy(tree->tmp, __btree_key(tree, left, mid), tree->size_of);
+    (void)memcpy(__btree_key(tree, right, 0), __btree_key(tree, left, mid + 1), num_right * tree->size_of);
+    (void)memcpy(__btree_children(right), __btree_children(left) + mid + 1, (num_right + 1) * sizeof(Btree_node *));
+
+    right->num_keys = num_right;
+    left->num_keys = mid;
+}
+
+
+static void __btree_borrow_left(const Btree *tree, Btree_node *parent, size_t i, Btree_node *left, Btree_node *node)
+{
+    const size_t size_of = tree->size_of;
+
+    if (node->level == 0)
+    {
+        (void)memmove(__btree_entry(tree, node, 1), __btree_entry(tree, node, 0), node->num_keys * size_of);
+        (void)memcpy(__btree_entry(tree, node, 0), __btree_entry(tree, left, left->num_keys - 1), size_of);
+        (void)memcpy(__btree_key(tree, parent, i - 1), __btree_entry(tree, node, 0), size_of);
+    }
+    else
+    {
+        Btree_node **children = __btree_children(node);
+
+        (void)memmove(__btree_key(tree, node, 1), __btree_key(tree, node, 0), node->num_keys * size_of);
+        (void)memmove(children + 1, children, (node->num_keys + 1) * sizeof(Btree_node *));
+
+        (void)memcpy(__btree_key(tree, node, 0), __btree_key(tree, parent, i - 1), size_of);
+        children[0] = __btree_children(left)[left->num_keys];
+        (void)memcpy(__btree_key(tree, parent, i - 1), __btree_key(tree, left, left->num_keys - 1), size_of);
+    }
+
+    --left->num_keys;
+    ++node->num_keys;
+}
+
+
+static void __btree_borrow_right(const Btree *tree, Btree_node *parent, size_t i, Btree_node *node, Btree_node *right)
+{
+    const size_t size_of = tree->size_of;
+
+    if (node->level == 0)
+    {
+        (void)memcpy(__btree_entry(tree, node, node->num_keys), __btree_entry(tree, right, 0), size_of);
+        (void)memmove(__btree_entry(tree, right, 0), __btree_entry(tree, right, 1), (right->num_keys - 1) * size_of);
+        (void)memcpy(__btree_key(tree, parent, i), __btree_entry(tree, right, 0), size_of);
+    }
+    else
+    {
+        Btree_node **children = __btree_children(right);
+
+        (void)memcpy(__btree_key(tree, node, node->num_keys), __btree_key(tree, parent, i), size_of);
+        __btree_children(node)[node->num_keys + 1] = children[0];
+        (void)memcpy(__btree_key(tree, parent, i), __btree_key(tree, right, 0), size_of);
+
+        (void)memmove(__btree_key(tree, right, 0), __btree_key(tree, right, 1), (right->num_keys - 1) * size_of);
+        (void)memmove(children, children + 1, right->num_keys * sizeof(Btree_node *));
+    }
+
+    --right->num_keys;
+    ++node->num_keys;
+}
+
+
+static void __btree_merge(Btree *tree, Btree_node *parent, size_t i, Btree_node *left, Btree_node *right)
+{
+    const size_t size_of = tree->size_of;
+
+    if (left->level == 0)
+    {
+        (void)memcpy(__btree_entry(tree, left, left->num_keys), __btree_entry(tree, right, 0), right->num_keys * size_of);
+        left->num_keys += right->num_keys;
+
+        left->next = right->next;
+
+        if (right->next != NULL)
+            right->next->prev = left;
+        else
+            tree->last_leaf = left;
+    }
+    else
+    {
+        /* separator comes down between keys of both nodes */
+        (void)memcpy(__btree_key(tree, left, left->num_keys), __btree_key(tree, parent, i), size_of);
+        (void)memcpy(__btree_key(tree, left, left->num_keys + 1), __btree_key(tree, right, 0), right->num_keys * size_of);
+        (void)memcpy(__btree_children(left) + left->num_keys + 1, __btree_children(right), (right->num_keys + 1) * sizeof(Btree_node *));
+        left->num_keys += right->num_keys + 1;
+    }
+
+    Btree_node **children = __btree_children(parent);
+
+    (void)memmove(__btree_key(tree, parent, i), __btree_key(tree, parent, i + 1), (parent->num_keys - i - 1) * size_of);
+    (void)memmove(children + i + 1, children + i + 2, (parent->num_keys - i - 1) * sizeof(Btree_node *));
+    --parent->num_keys;
+
+    free(right);
+}
+
+
+static int __btree_delete(Btree * __restrict__ tree, const void * __restrict__ const data_key, bool destroy)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (data_key == NULL)
+        ERROR("data_key == NULL\n", -1);
+
+    Btree_node *path[BTREE_MAX_HEIGHT];
+    size_t pos[BTREE_MAX_HEIGHT];
+
+    Btree_node *node = __btree_find_leaf(tree, data_key, path, pos);
+    const size_t i = __btree_lower_bound(tree, __btree_entry(tree, node, 0), node->num_keys, data_key);
+
+    if (i == node->num_keys || tree->cmp_f(__btree_entry(tree, node, i), data_key) != 0)
+        return 1;
+
+    if (destroy && tree->destroy_f != NULL)
+        tree->destroy_f(__btree_entry(tree, node, i));
+
+    (void)memmove(__btree_entry(tree, node, i), __btree_entry(tree, node, i + 1), (node->num_keys - i - 1) * tree->size_of);
+    --node->num_keys;
+    --tree->num_entries;
+
+    /* separators in parents can stay, they still split ranges of children */
+    for (size_t depth = tree->root->level; depth > 0; --depth)
+    {
+        const size_t min = node->level == 0 ? tree->leaf_capacity / 2 : tree->inner_capacity / 2;
+
+        if (node->num_keys >= min)
+            break;
+
+        Btree_node *parent = path[depth - 1];
+        const size_t child = pos[depth - 1];
+        Btree_node **children = __btree_children(parent);
+
+        Btree_node *left = child > 0 ? children[child - 1] : NULL;
+        Btree_node *right = child < parent->num_keys ? children[child + 1] : NULL;
+
+        if (left != NULL && left->num_keys > min)
+        {
+            __btree_borrow_left(tree, parent, child, left, node);
+            break;
+        }
+
+        if (right != NULL && right->num_keys > min)
+        {
+            __btree_borrow_right(tree, parent, child, node, right);
+            break;
+        }
+
+        if (left != NULL)
+            __btree_merge(tree, parent, child - 1, left, node);
+        else
+            __btree_merge(tree, parent, child, node, right);
+
+        node = parent;
+    }
+
+    /* root with one child is not needed */
+    if (tree->root->level > 0 && tree->root->num_keys == 0)
+    {
+        Btree_node *old_root = tree->root;
+
+        tree->root = __btree_children(old_root)[0];
+        free(old_root);
+    }
+
+    return 0;
+}
+
+
+Btree *btree_create(const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f)
+{
+    if (size_of < 1)
+        ERROR("size_of < 1\n", NULL);
+
+    if (size_of > SIZE_MAX / (2 * (BTREE_MIN_CAPACITY + 2)))
+        ERROR("size_of is too big\n", NULL);
+
+    if (cmp_f == NULL)
+        ERROR("cmp_f == NULL\n", NULL);
+
+    Btree *tree = (Btree *)malloc(sizeof(Btree));
+
+    if (tree == NULL)
+        ERROR("malloc error\n", NULL);
+
+    /* nodes have place for one more entry (key), so overfull node can be split after insertion */
+    const size_t room = BTREE_NODE_SIZE - offsetof(Btree_node, data);
+    const size_t leaf_capacity = room / size_of;
+    const size_t inner_capacity = (room - sizeof(Btree_node *)) / (size_of + sizeof(Btree_node *));
+
+    tree->leaf_capacity = leaf_capacity > BTREE_MIN_CAPACITY ? leaf_capacity - 1 : BTREE_MIN_CAPACITY;
+    tree->inner_capacity = inner_capacity > BTREE_MIN_CAPACITY ? inner_capacity - 1 : BTREE_MIN_CAPACITY;
+
+    tree->size_of = size_of;
+    tree->cmp_f = cmp_f;
+    tree->destroy_f = destroy_f;
+    tree->num_entries = 0;
+
+    tree->tmp = malloc(size_of);
+
+    if (tree->tmp == NULL)
+    {
+        FREE(tree);
+        ERROR("malloc error\n", NULL);
+    }
+
+    tree->root = __btree_node_create(tree, 0);
+
+    if (tree->root == NULL)
+    {
+        FREE(tree->tmp);
+        FREE(tree);
+        ERROR("__btree_node_create error\n", NULL);
+    }
+
+    tree->first_leaf = tree->root;
+    tree->last_leaf = tree->root;
+
+    return tree;
+}
+
+
+void btree_destroy(Btree *tree)
+{
+    if (tree == NULL)
+        return;
+
+    __btree_node_destroy(tree->root);
+    FREE(tree->tmp);
+    FREE(tree);
+}
+
+
+void btree_destroy_with_entries(Btree *tree)
+{
+    if (tree == NULL)
+        return;
+
+    if (tree->destroy_f != NULL)
+        for (Btree_node *leaf = tree->first_leaf; leaf != NULL; leaf = leaf->next)
+            for (size_t i = 0; i < leaf->num_keys; ++i)
+                tree->destroy_f(__btree_entry(tree, leaf, i));
+
+    btree_destroy(tree);
+}
+
+
+int btree_insert(Btree * __restrict__ tree, const void * __restrict__ const data)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (data == NULL)
+        ERROR("data == NULL\n", -1);
+
+    Btree_node *path[BTREE_MAX_HEIGHT];
+    size_t pos[BTREE_MAX_HEIGHT];
+
+    Btree_node *leaf = __btree_find_leaf(tree, data, path, pos);
+    const size_t i = __btree_lower_bound(tree, __btree_entry(tree, leaf, 0), leaf->num_keys, data);
+
+    if (i < leaf->num_keys && tree->cmp_f(__btree_entry(tree, leaf, i), data) == 0)
+        return 1;
+
+    /* full nodes from leaf up will split, allocate new nodes before tree is changed */
+    const size_t depth = tree->root->level;
+    size_t splits = 0;
+
+    if (leaf->num_keys == tree->leaf_capacity)
+    {
+        splits = 1;
+
+        while (splits <= depth && path[depth - splits]->num_keys == tree->inner_capacity)
+            ++splits;
+    }
+
+    /* split of root needs new root */
+    const size_t new_nodes = splits == depth + 1 ? splits + 1 : splits;
+
+    if (new_nodes > BTREE_MAX_HEIGHT)
+        ERROR("tree is too high\n", -1);
+
+    Btree_node *spare[BTREE_MAX_HEIGHT];
+
+    for (size_t level = 0; level < new_nodes; ++level)
+    {
+        spare[level] = __btree_node_create(tree, level);
+
+        if (spare[level] == NULL)
+        {
+            for (size_t j = 0; j < level; ++j)
+                free(spare[j]);
+
+            ERROR("__btree_node_create error\n", -1);
+        }
+    }
+
+    (void)memmove(__btree_entry(tree, leaf, i + 1), __btree_entry(tree, leaf, i), (leaf->num_keys - i) * tree->size_of);
+    (void)memcpy(__btree_entry(tree, leaf, i), data, tree->size_of);
+    ++leaf->num_keys;
+    ++tree->num_entries;
+
+    if (splits == 0)
+        return 0;
+
+    __btree_split_leaf(tree, leaf, spare[0]);
+
+    /* separator from tree->tmp and new node go up until node has place for them */
+    for (size_t level = 1; ; ++level)
+    {
+        if (level > depth)
+        {
+            Btree_node *root = spare[level];
+
+            __btree_children(root)[0] = tree->root;
+            __btree_children(root)[1] = spare[level - 1];
+            (void)memcpy(__btree_key(tree, root, 0), tree->tmp, tree->size_of);
+            root->num_keys = 1;
+
+            tree->root = root;
+            break;
+        }
+
+        Btree_node *parent = path[depth - level];
+        const size_t child = pos[depth - level];
+        Btree_node **children = __btree_children(parent);
+
+        (void)memmove(__btree_key(tree, parent, child + 1), __btree_key(tree, parent, child), (parent->num_keys - child) * tree->size_of);
+        (void)memmove(children + child + 2, children + child + 1, (parent->num_keys - child) * sizeof(Btree_node *));
+        (void)memcpy(__btree_key(tree, parent, child), tree->tmp, tree->size_of);
+        children[child + 1] = spare[level - 1];
+        ++parent->num_keys;
+
+        if (parent->num_keys <= tree->inner_capacity)
+            break;
+
+        __btree_split_inner(tree, parent, spare[level]);
+    }
+
+    return 0;
+}
+
+
+int btree_delete(Btree * __restrict__ tree, const void * __restrict__ const data_key)
+{
+    return __btree_delete(tree, data_key, false);
+}
+
+
+int btree_delete_with_entry(Btree * __restrict__ tree, const void * __restrict__ const data_key)
+{
+    return __btree_delete(tree, data_key, true);
+}
+
+
+int btree_min(const Btree * __restrict__ const tree, void * __restrict__ data)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (data == NULL)
+        ERROR("data == NULL\n", -1);
+
+    if (tree->num_entries == 0)
+        ERROR("tree is empty\n", -1);
+
+    (void)memcpy(data, __btree_entry(tree, tree->first_leaf, 0), tree->size_of);
+
+    return 0;
+}
+
+
+int btree_max(const Btree * __restrict__ const tree, void * __restrict__ data)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (data == NULL)
+        ERROR("data == NULL\n", -1);
+
+    if (tree->num_entries == 0)
+        ERROR("tree is empty\n", -1);
+
+    (void)memcpy(data, __btree_entry(tree, tree->last_leaf, tree->last_leaf->num_keys - 1), tree->size_of);
+
+    return 0;
+}
+
+
+int btree_search(const Btree * __restrict__ const tree, const void * const data_key, void * data_out)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (data_key == NULL)
+        ERROR("data_key == NULL\n", -1);
+
+    if (data_out == NULL)
+        ERROR("data_out == NULL\n", -1);
+
+    Btree_node *leaf = __btree_find_leaf(tree, data_key, NULL, NULL);
+    const size_t i = __btree_lower_bound(tree, __btree_entry(tree, leaf, 0), leaf->num_keys, data_key);
+
+    if (i == leaf->num_keys || tree->cmp_f(__btree_entry(tree, leaf, i), data_key) != 0)
+        return 1;
+
+    (void)memcpy(data_out, __btree_entry(tree, leaf, i), tree->size_of);
+
+    return 0;
+}
+
+
+bool btree_key_exist(const Btree * __restrict__ const tree, const void * __restrict__ const data_key)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", false);
+
+    if (data_key == NULL)
+        ERROR("data_key == NULL\n", false);
+
+    Btree_node *leaf = __btree_find_leaf(tree, data_key, NULL, NULL);
+    const size_t i = __btree_lower_bound(tree, __btree_entry(tree, leaf, 0), leaf->num_keys, data_key);
+
+    return i < leaf->num_keys && tree->cmp_f(__btree_entry(tree, leaf, i), data_key) == 0;
+}
+
+
+int btree_to_array(const Btree * __restrict__ const tree, void * __restrict__ array, size_t * __restrict__ size)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (array == NULL)
+        ERROR("array == NULL\n", -1);
+
+    if (size == NULL)
+        ERROR("size == NULL\n", -1);
+
+    if (tree->num_entries == 0)
+        ERROR("tree is empty\n", -1);
+
+    BYTE *arr = (BYTE *)malloc(tree->size_of * tree->num_entries);
+
+    if (arr == NULL)
+        ERROR("malloc error\n", -1);
+
+    size_t offset = 0;
+
+    /* entries of leaf are already sorted, copy whole leaf at once */
+    for (Btree_node *leaf = tree->first_leaf; leaf != NULL; leaf = leaf->next)
+    {
+        (void)memcpy(arr + offset, __btree_entry(tree, leaf, 0), leaf->num_keys * tree->size_of);
+        offset += leaf->num_keys * tree->size_of;
+    }
+
+    *(void **)array = (void *)arr;
+    *size = tree->num_entries;
+
+    return 0;
+}
+
+
+int btree_range_chunks(const Btree * __restrict__ const tree, const void *data_from, const void *data_to,
+                       void * __restrict__ chunk, const size_t chunk_len, const chunk_f consume_f, void *arg)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (chunk == NULL)
+        ERROR("chunk == NULL\n", -1);
+
+    if (chunk_len == 0)
+        ERROR("chunk_len == 0\n", -1);
+
+    if (consume_f == NULL)
+        ERROR("consume_f == NULL\n", -1);
+
+    if (tree->num_entries == 0)
+        return 0;
+
+    BYTE *arr = (BYTE *)chunk;
+    Btree_node *leaf = tree->first_leaf;
+    size_t i = 0;
+    size_t entries = 0;
+
+    if (data_from != NULL)
+    {
+        leaf = __btree_find_leaf(tree, data_from, NULL, NULL);
+        i = __btree_lower_bound(tree, __btree_entry(tree, leaf, 0), leaf->num_keys, data_from);
+    }
+
+    while (leaf != NULL)
+    {
+        size_t end = leaf->num_keys;
+        bool last = false;
+
+        /* only leaf with end of range needs search, others are copied whole */
+        if (data_to != NULL && end > 0 && tree->cmp_f(__btree_entry(tree, leaf, end - 1), data_to) > 0)
+        {
+            end = __btree_upper_bound(tree, __btree_entry(tree, leaf, 0), end, data_to);
+            last = true;
+        }
+
+        while (i < end)
+        {
+            const size_t len = MIN(end - i, chunk_len - entries);
+
+            (void)memcpy(arr + entries * tree->size_of, __btree_entry(tree, leaf, i), len * tree->size_of);
+            entries += len;
+            i += len;
+
+            if (entries == chunk_len)
+            {
+                const int ret = consume_f(chunk, entries, arg);
+
+                if (ret != 0)
+                    return ret;
+
+                entries = 0;
+            }
+        }
+
+        if (last)
+            break;
+
+        leaf = leaf->next;
+        i = 0;
+    }
+
+    if (entries > 0)
+        return consume_f(chunk, entries, arg);
+
+    return 0;
+}
+
+
+int btree_bulk_load(Btree * __restrict__ tree, const void * __restrict__ array, const size_t len)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (array == NULL)
+        ERROR("array == NULL\n", -1);
+
+    if (tree->num_entries != 0)
+        ERROR("tree is not empty\n", -1);
+
+    if (len == 0)
+        return 0;
+
+    const BYTE *entries = (const BYTE *)array;
+    const size_t size_of = tree->size_of;
+
+    for (size_t i = 1; i < len; ++i)
+        if (tree->cmp_f(entries + (i - 1) * size_of, entries + i * size_of) >= 0)
+            ERROR("array is not sorted\n", -1);
+
+    /* number of nodes on each level, level 0 are leaves */
+    size_t counts[BTREE_MAX_HEIGHT];
+    size_t height = 1;
+    size_t total = counts[0] = (len + tree->leaf_capacity - 1) / tree->leaf_capacity;
+
+    while (counts[height - 1] > 1)
+    {
+        counts[height] = (counts[height - 1] + tree->inner_capacity) / (tree->inner_capacity + 1);
+        total += counts[height];
+        ++height;
+    }
+
+    Btree_node **nodes = (Btree_node **)malloc(total * sizeof(Btree_node *));
+
+    if (nodes == NULL)
+        ERROR("malloc error\n", -1);
+
+    for (size_t level = 0, n = 0; level < height; ++level)
+        for (size_t j = 0; j < counts[level]; ++j, ++n)
+        {
+            nodes[n] = __btree_node_create(tree, level);
+
+            if (nodes[n] == NULL)
+            {
+                for (size_t k = 0; k < n; ++k)
+                    free(nodes[k]);
+
+                FREE(nodes);
+                ERROR("__btree_node_create error\n", -1);
+            }
+        }
+
+    /* entries are spread evenly, so every node (but root) has at least half of capacity */
+    size_t offset = 0;
+
+    for (size_t j = 0; j < counts[0]; ++j)
+    {
+        Btree_node *leaf = nodes[j];
+        const size_t num = len / counts[0] + (j < len % counts[0] ? 1 : 0);
+
+        (void)memcpy(__btree_entry(tree, leaf, 0), entries + offset * size_of, num * size_of);
+        leaf->num_keys = num;
+        offset += num;
+
+        leaf->prev = j > 0 ? nodes[j - 1] : NULL;
+        leaf->next = j + 1 < counts[0] ? nodes[j + 1] : NULL;
+    }
+
+    Btree_node **children = nodes;
+    Btree_node **parents = nodes + counts[0];
+
+    for (size_t level = 1; level < height; ++level)
+    {
+        const size_t num_children = counts[level - 1];
+        const size_t num_parents = counts[level];
+        size_t child = 0;
+
+        for (size_t j = 0; j < num_parents; ++j)
+        {
+            Btree_node *parent = parents[j];
+            const size_t num = num_children / num_parents + (j < num_children % num_parents ? 1 : 0);
+
+            for (size_t k = 0; k < num; ++k)
+            {
+                __btree_children(parent)[k] = children[child + k];
+
+                if (k > 0)
+                    (void)memcpy(__btree_key(tree, parent, k - 1), __btree_subtree_min(tree, children[child + k]), size_of);
+            }
+
+            parent->num_keys = num - 1;
+            child += num;
+        }
+
+        children = parents;
+        parents += num_parents;
+    }
+
+    free(tree->root);
+
+    tree->root = children[0];
+    tree->first_leaf = nodes[0];
+    tree->last_leaf = nodes[counts[0] - 1];
+    tree->num_entries = len;
+
+    FREE(nodes);
+
+    return 0;
+}
+
+
+ssize_t btree_get_num_entries(const Btree * const tree)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    return (ssize_t)tree->num_entries;
+}
+
+
+ssize_t btree_get_data_size(const Btree * const tree)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    return (ssize_t)tree->size_of;
+}
+
+
+int btree_get_height(const Btree * const tree)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    return (int)tree->root->level + 1;
+}
@@ -0,0 +1,204 @@
+#include <btree.h>
+#include <rbt.h>
+#include <cbench.h>
+#include <stdint.h> /* int64_t */
+#include <stdlib.h> /* malloc, free, qsort */
+
+
+/*
+    Btree against Rbt with the same random int64_t keys: insert, search,
+    export to sorted array and delete. Btree is also timed for range scans
+    of RANGE_LEN entries and for bulk load from sorted array.
+*/
+
+
+#define LOOKUPS_PER_KEY 4
+#define RANGE_LEN ((size_t)1000)
+#define CHUNK_LEN ((size_t)256)
+
+
+/* functions needed for benchmark */
+static int my_compare_int64_t(const void *a, const void *b);
+static int my_sum_chunk(const void *chunk, size_t len, void *arg);
+static int64_t *keys_create(size_t n);
+
+
+/* benchmark function declarations */
+static void bench_btree(const int64_t *keys, const int64_t *sorted, size_t n);
+static void bench_rbt(const int64_t *keys, size_t n);
+
+
+/* implementation */
+static int my_compare_int64_t(const void *a, const void *b)
+{
+    const int64_t x = *(const int64_t *)a;
+    const int64_t y = *(const int64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+static int my_sum_chunk(const void *chunk, size_t len, void *arg)
+{
+    const int64_t *entries = (const int64_t *)chunk;
+    int64_t *sum = (int64_t *)arg;
+
+    for (size_t i = 0; i < len; ++i)
+        *sum += entries[i] & 1;
+
+    return 0;
+}
+
+
+/* unique keys, i-th key is i with random high bits */
+static int64_t *keys_create(size_t n)
+{
+    int64_t *keys = (int64_t *)malloc(n * sizeof(*keys));
+
+    if (keys == NULL)
+        ERROR("malloc error\n", NULL);
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+
+    for (size_t i = 0; i < n; ++i)
+        keys[i] = (int64_t)(((bench_rand(&state) >> 32) << 24) | i);
+
+    return keys;
+}
+
+
+static void bench_btree(const int64_t *keys, const int64_t *sorted, size_t n)
+{
+    char name[64];
+    uint64_t state = 1;
+    size_t found = 0;
+    size_t size = 0;
+    int64_t val;
+    int64_t sum = 0;
+    int64_t chunk[CHUNK_LEN];
+
+    int64_t *array = NULL;
+    Btree *tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+
+    if (tree == NULL)
+        VERROR("btree_create error\n");
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)btree_insert(tree, &keys[i]);
+    (void)snprintf(name, sizeof(name), "btree insert n=%zu", n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n * LOOKUPS_PER_KEY; ++i)
+        found += btree_search(tree, &keys[bench_rand(&state) % n], &val) == 0;
+    (void)snprintf(name, sizeof(name), "btree search n=%zu", n);
+    bench_report(name, n * LOOKUPS_PER_KEY, start);
+
+    start = bench_now();
+    (void)btree_to_array(tree, (void *)&array, &size);
+    (void)snprintf(name, sizeof(name), "btree to_array (per entry) n=%zu", n);
+    bench_report(name, size, start);
+
+    /* ranges of RANGE_LEN entries from random positions */
+    const size_t range_len = MIN(n, RANGE_LEN);
+    const size_t ranges = (size_t)1000;
+
+    start = bench_now();
+    for (size_t i = 0; i < ranges; ++i)
+    {
+        const size_t from = bench_rand(&state) % (n - range_len + 1);
+        (void)btree_range_chunks(tree, &sorted[from], &sorted[from + range_len - 1], chunk, CHUNK_LEN, my_sum_chunk, &sum);
+    }
+    (void)snprintf(name, sizeof(name), "btree range of %zu (per range) n=%zu", range_len, n);
+    bench_report(name, ranges, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)btree_delete(tree, &keys[i]);
+    (void)snprintf(name, sizeof(name), "btree delete n=%zu", n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    (void)btree_bulk_load(tree, sorted, n);
+    (void)snprintf(name, sizeof(name), "btree bulk_load (per entry) n=%zu", n);
+    bench_report(name, n, start);
+
+    if (found != n * LOOKUPS_PER_KEY || size != n || btree_get_num_entries(tree) != (ssize_t)n)
+        (void)printf("btree lost entries\n");
+
+    (void)printf("btree height %d, range checksum %lld\n", btree_get_height(tree), (long long)sum);
+
+    FREE(array);
+    btree_destroy(tree);
+}
+
+
+static void bench_rbt(const int64_t *keys, size_t n)
+{
+    char name[64];
+    uint64_t state = 1;
+    size_t found = 0;
+    size_t size = 0;
+    int64_t val;
+
+    int64_t *array = NULL;
+    Rbt *tree = rbt_create(sizeof(int64_t), my_compare_int64_t, NULL, NULL);
+
+    if (tree == NULL)
+        VERROR("rbt_create error\n");
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)rbt_insert(tree, &keys[i]);
+    (void)snprintf(name, sizeof(name), "rbt insert n=%zu", n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n * LOOKUPS_PER_KEY; ++i)
+        found += rbt_search(tree, &keys[bench_rand(&state) % n], &val) == 0;
+    (void)snprintf(name, sizeof(name), "rbt search n=%zu", n);
+    bench_report(name, n * LOOKUPS_PER_KEY, start);
+
+    start = bench_now();
+    (void)rbt_to_array(tree, (void *)&array, &size);
+    (void)snprintf(name, sizeof(name), "rbt to_array (per entry) n=%zu", n);
+    bench_report(name, size, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)rbt_delete(tree, &keys[i]);
+    (void)snprintf(name, sizeof(name), "rbt delete n=%zu", n);
+    bench_report(name, n, start);
+
+    if (found != n * LOOKUPS_PER_KEY || size != n || rbt_get_num_entries(tree) != 0)
+        (void)printf("rbt lost entries\n");
+
+    FREE(array);
+    rbt_destroy(tree);
+}
+
+
+int main(void)
+{
+    const size_t sizes[] = { 1000, 100000 };
+
+    for (size_t i = 0; i < ARRAY_SIZE(sizes); ++i)
+    {
+        int64_t *keys = keys_create(sizes[i]);
+        int64_t *sorted = keys_create(sizes[i]);
+
+        if (keys != NULL && sorted != NULL)
+        {
+            qsort(sorted, sizes[i], sizeof(*sorted), my_compare_int64_t);
+
+            bench_btree(keys, sorted, sizes[i]);
+            bench_rbt(keys, sizes[i]);
+        }
+
+        FREE(keys);
+        FREE(sorted);
+    }
+
+    return 0;
+}
@@ -0,0 +1,644 @@
+#include <btree.h>
+#include <common.h>
+#include <ctest.h>
+#include <stdint.h> /* int64_t */
+#include <stdbool.h>
+#include <string.h>
+
+
+/* entry so big that nodes have only BTREE_MIN_CAPACITY entries, so tree is high */
+typedef struct BigStruct
+{
+    int64_t key;
+    BYTE payload[248];
+} BigStruct;
+
+
+/* range of keys and sum of them collected from chunks */
+typedef struct Range_sum
+{
+    int64_t sum;
+    int64_t last;
+    size_t entries;
+} Range_sum;
+
+
+/* functions needed for testing */
+static int my_compare_int64_t(const void *a, const void *b);
+static int my_compare_big(const void *a, const void *b);
+static int my_compare_ptr(const void *a, const void *b);
+static void my_ptr_destroy(void *ptr);
+static void shuffle(int64_t *arr, size_t len);
+static bool check_node(const Btree *tree, Btree_node *node, const void *low, const void *high, size_t *entries);
+static bool check_tree(const Btree *tree);
+static int sum_chunk(const void *chunk, size_t entries, void *arg);
+
+
+/* unit tests function declaraions */
+static void test_btree_create(void);
+static void test_btree_insert_search(void);
+static void test_btree_delete(void);
+static void test_btree_big_entries(void);
+static void test_btree_to_array_range(void);
+static void test_btree_bulk_load(void);
+static void test_btree_with_entries(void);
+
+
+/* implementation */
+static int my_compare_int64_t(const void *a, const void *b)
+{
+    const int64_t *x = (const int64_t *)a;
+    const int64_t *y = (const int64_t *)b;
+
+    return (*x > *y) - (*x < *y);
+}
+
+
+static int my_compare_big(const void *a, const void *b)
+{
+    const BigStruct *x = (const BigStruct *)a;
+    const BigStruct *y = (const BigStruct *)b;
+
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+
+static int my_compare_ptr(const void *a, const void *b)
+{
+    const int64_t *x = *(int64_t * const *)a;
+    const int64_t *y = *(int64_t * const *)b;
+
+    return (*x > *y) - (*x < *y);
+}
+
+
+static void my_ptr_destroy(void *ptr)
+{
+    int64_t *p = *(int64_t **)ptr;
+    FREE(p);
+}
+
+
+static void shuffle(int64_t *arr, size_t len)
+{
+    for (size_t i = len - 1; i > 0; --i)
+    {
+        const size_t j = (size_t)rand() % (i + 1);
+        const int64_t tmp = arr[i];
+
+        arr[i] = arr[j];
+        arr[j] = tmp;
+    }
+}
+
+
+/* every entry of subtree has to be in [low, high), NULL means no bound */
+static bool check_node(const Btree *tree, Btree_node *node, const void *low, const void *high, size_t *entries)
+{
+    const bool is_root = node == tree->root;
+    const size_t capacity = node->level == 0 ? tree->leaf_capacity : tree->inner_capacity;
+
+    if (node->num_keys > capacity)
+        return false;
+
+    if (!is_root && node->num_keys < capacity / 2)
+        return false;
+
+    if (node->level == 0)
+    {
+        const BYTE *arr = node->data;
+
+        for (size_t i = 0; i < node->num_keys; ++i)
+        {
+            const void *entry = arr + i * tree->size_of;
+
+            if (i > 0 && tree->cmp_f(arr + (i - 1) * tree->size_of, entry) >= 0)
+                return false;
+
+            if ((low != NULL && tree->cmp_f(entry, low) < 0) || (high != NULL && tree->cmp_f(entry, high) >= 0))
+                return false;
+        }
+
+        *entries += node->num_keys;
+
+        return true;
+    }
+
+    if (is_root && node->num_keys == 0)
+        return false;
+
+    Btree_node **children = (Btree_node **)(void *)node->data;
+    const BYTE *keys = node->data + (tree->inner_capacity + 2) * sizeof(Btree_node *);
+
+    for (size_t i = 0; i <= node->num_keys; ++i)
+    {
+        const void *child_low = i == 0 ? low : keys + (i - 1) * tree->size_of;
+        const void *child_high = i == node->num_keys ? high : keys + i * tree->size_of;
+
+        if (children[i]->level + 1 != node->level)
+            return false;
+
+        if (!check_node(tree, children[i], child_low, child_high, entries))
+            return false;
+    }
+
+    return true;
+}
+
+
+static bool check_tree(const Btree *tree)
+{
+    size_t entries = 0;
+
+    if (!check_node(tree, tree->root, NULL, NULL, &entries) || entries != tree->num_entries)
+        return false;
+
+    /* leaves are linked in both directions and give all entries in order */
+    entries = 0;
+    Btree_node *prev = NULL;
+
+    for (Btree_node *leaf = tree->first_leaf; leaf != NULL; leaf = leaf->next)
+    {
+        if (leaf->prev != prev || leaf->level != 0)
+            return false;
+
+        if (prev != NULL && tree->cmp_f(prev->data + (prev->num_keys - 1) * tree->size_of, leaf->data) >= 0)
+            return false;
+
+        entries += leaf->num_keys;
+        prev = leaf;
+    }
+
+    return prev == tree->last_leaf && entries == tree->num_entries;
+}
+
+
+static int sum_chunk(const void *chunk, size_t entries, void *arg)
+{
+    const int64_t *arr = (const int64_t *)chunk;
+    Range_sum *range = (Range_sum *)arg;
+
+    /* entries have to come in order */
+    for (size_t i = 0; i < entries; ++i)
+    {
+        if (range->entries > 0 && range->last >= arr[i])
+            return -2;
+
+        range->sum += arr[i];
+        range->last = arr[i];
+        ++range->entries;
+    }
+
+    return 0;
+}
+
+
+static void test_btree_create(void)
+{
+    int64_t val = 0;
+
+    Btree *tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(tree == NULL);
+
+    /* node of int64_t fits in BTREE_NODE_SIZE */
+    T_CHECK(tree->leaf_capacity > 32);
+    T_CHECK(offsetof(Btree_node, data) + (tree->leaf_capacity + 1) * sizeof(int64_t) <= BTREE_NODE_SIZE);
+    T_CHECK(offsetof(Btree_node, data) + (tree->inner_capacity + 2) * sizeof(void *) + (tree->inner_capacity + 1) * sizeof(int64_t) <= BTREE_NODE_SIZE);
+
+    T_EXPECT(btree_get_num_entries(tree), (ssize_t)0);
+    T_EXPECT(btree_get_data_size(tree), (ssize_t)sizeof(int64_t));
+    T_EXPECT(btree_get_height(tree), 1);
+    T_EXPECT(btree_min(tree, (void *)&val), -1);
+    T_EXPECT(btree_max(tree, (void *)&val), -1);
+    T_EXPECT(btree_search(tree, (void *)&val, (void *)&val), 1);
+    T_EXPECT(btree_key_exist(tree, (void *)&val), (bool)false);
+    T_EXPECT(btree_delete(tree, (void *)&val), 1);
+    T_CHECK(check_tree(tree));
+
+    btree_destroy(tree);
+
+    tree = btree_create(sizeof(BigStruct), my_compare_big, NULL);
+    T_ERROR(tree == NULL);
+    T_ASSERT(tree->leaf_capacity, BTREE_MIN_CAPACITY);
+    T_ASSERT(tree->inner_capacity, BTREE_MIN_CAPACITY);
+    btree_destroy(tree);
+
+    T_ASSERT(btree_create(0, my_compare_int64_t, NULL), NULL);
+    T_ASSERT(btree_create(sizeof(int64_t), NULL, NULL), NULL);
+
+    T_EXPECT(btree_insert(NULL, (void *)&val), -1);
+    T_EXPECT(btree_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(btree_get_data_size(NULL), (ssize_t)-1);
+    T_EXPECT(btree_get_height(NULL), -1);
+}
+
+
+static void test_btree_insert_search(void)
+{
+    #define ARRAY_TEST_SIZE 100000
+
+    int64_t *arr = (int64_t *)malloc(sizeof(int64_t) * ARRAY_TEST_SIZE);
+    T_ERROR(arr == NULL);
+
+    int64_t val = 0;
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)i * 2;
+
+    srand(1234);
+    shuffle(arr, ARRAY_TEST_SIZE);
+
+    Btree *tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(tree == NULL);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(btree_insert(tree, (void *)&arr[i]), 0);
+        T_EXPECT(btree_insert(tree, (void *)&arr[i]), 1);
+    }
+
+    T_CHECK(check_tree(tree));
+    T_EXPECT(btree_get_num_entries(tree), (ssize_t)ARRAY_TEST_SIZE);
+
+    /* 100k entries in 4 levels at most */
+    T_CHECK(btree_get_height(tree) <= 4);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE * 2; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            T_EXPECT(btree_search(tree, (void *)&i, (void *)&val), 0);
+            T_ASSERT(val, i);
+            T_EXPECT(btree_key_exist(tree, (void *)&i), (bool)true);
+        }
+        else
+        {
+            T_EXPECT(btree_search(tree, (void *)&i, (void *)&val), 1);
+            T_EXPECT(btree_key_exist(tree, (void *)&i), (bool)false);
+        }
+    }
+
+    T_EXPECT(btree_min(tree, (void *)&val), 0);
+    T_ASSERT(val, (int64_t)0);
+    T_EXPECT(btree_max(tree, (void *)&val), 0);
+    T_ASSERT(val, (int64_t)(ARRAY_TEST_SIZE - 1) * 2);
+
+    btree_destroy(tree);
+
+    /* sorted insertion, the worst case for fill of nodes */
+    tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(tree == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(btree_insert(tree, (void *)&i), 0);
+
+    T_CHECK(check_tree(tree));
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(btree_key_exist(tree, (void *)&i), (bool)true);
+
+    btree_destroy(tree);
+    FREE(arr);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_btree_delete(void)
+{
+    #define ARRAY_TEST_SIZE 20000
+
+    int64_t *arr = (int64_t *)malloc(sizeof(int64_t) * ARRAY_TEST_SIZE);
+    T_ERROR(arr == NULL);
+
+    int64_t val = 0;
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)i;
+
+    srand(4321);
+    shuffle(arr, ARRAY_TEST_SIZE);
+
+    Btree *tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(tree == NULL);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(btree_insert(tree, (void *)&arr[i]), 0);
+
+    shuffle(arr, ARRAY_TEST_SIZE);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(btree_delete(tree, (void *)&arr[i]), 0);
+        T_EXPECT(btree_delete(tree, (void *)&arr[i]), 1);
+
+        if (i % 1000 == 0)
+        {
+            T_CHECK(check_tree(tree));
+            T_EXPECT(btree_get_num_entries(tree), (ssize_t)(ARRAY_TEST_SIZE - i - 1));
+        }
+    }
+
+    /* tree shrinks back to one leaf */
+    T_CHECK(check_tree(tree));
+    T_EXPECT(btree_get_num_entries(tree), (ssize_t)0);
+    T_EXPECT(btree_get_height(tree), 1);
+    T_EXPECT(btree_min(tree, (void *)&val), -1);
+
+    /* deleted from both ends */
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(btree_insert(tree, (void *)&i), 0);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE / 2; ++i)
+    {
+        const int64_t j = ARRAY_TEST_SIZE - 1 - i;
+
+        T_EXPECT(btree_delete(tree, (void *)&i), 0);
+        T_EXPECT(btree_delete(tree, (void *)&j), 0);
+
+        T_EXPECT(btree_min(tree, (void *)&val), i + 1 < j ? 0 : -1);
+
+        if (i + 1 < j)
+        {
+            T_ASSERT(val, i + 1);
+            T_EXPECT(btree_max(tree, (void *)&val), 0);
+            T_ASSERT(val, j - 1);
+        }
+    }
+
+    T_CHECK(check_tree(tree));
+
+    btree_destroy(tree);
+    FREE(arr);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_btree_big_entries(void)
+{
+    #define ARRAY_TEST_SIZE 2000
+
+    bool present[ARRAY_TEST_SIZE] = {0};
+    ssize_t num_entries = 0;
+    BigStruct entry;
+    BigStruct out;
+
+    (void)memset(&entry, 0, sizeof(entry));
+
+    Btree *tree = btree_create(sizeof(BigStruct), my_compare_big, NULL);
+    T_ERROR(tree == NULL);
+
+    srand(1234);
+
+    /* small nodes, so splits and merges go through many levels */
+    for (size_t i = 0; i < 50000; ++i)
+    {
+        const size_t k = (size_t)rand() % ARRAY_TEST_SIZE;
+
+        entry.key = (int64_t)k;
+        entry.payload[0] = (BYTE)k;
+
+        if (rand() % 3 != 0)
+        {
+            T_EXPECT(btree_insert(tree, (void *)&entry), present[k] ? 1 : 0);
+
+            if (!present[k])
+                ++num_entries;
+
+            present[k] = true;
+        }
+        else
+        {
+            T_EXPECT(btree_delete(tree, (void *)&entry), present[k] ? 0 : 1);
+
+            if (present[k])
+                --num_entries;
+
+            present[k] = false;
+        }
+
+        if (i % 5000 == 0)
+            T_CHECK(check_tree(tree));
+    }
+
+    T_CHECK(check_tree(tree));
+    T_EXPECT(btree_get_num_entries(tree), num_entries);
+    T_CHECK(btree_get_height(tree) > 3);
+
+    for (size_t k = 0; k < ARRAY_TEST_SIZE; ++k)
+    {
+        entry.key = (int64_t)k;
+
+        if (present[k])
+        {
+            T_EXPECT(btree_search(tree, (void *)&entry, (void *)&out), 0);
+            T_ASSERT(out.key, (int64_t)k);
+            T_ASSERT(out.payload[0], (BYTE)k);
+        }
+        else
+            T_EXPECT(btree_search(tree, (void *)&entry, (void *)&out), 1);
+    }
+
+    btree_destroy(tree);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_btree_to_array_range(void)
+{
+    #define ARRAY_TEST_SIZE 10000
+
+    int64_t chunk[64];
+    int64_t *arr = NULL;
+    size_t size = 0;
+    Range_sum range;
+
+    Btree *tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(tree == NULL);
+
+    T_EXPECT(btree_to_array(tree, (void *)&arr, &size), -1);
+
+    (void)memset(&range, 0, sizeof(range));
+    T_EXPECT(btree_range_chunks(tree, NULL, NULL, (void *)&chunk[0], ARRAY_SIZE(chunk), sum_chunk, (void *)&range), 0);
+    T_ASSERT(range.entries, (size_t)0);
+
+    /* keys 10, 20, ... */
+    for (int64_t i = ARRAY_TEST_SIZE; i > 0; --i)
+    {
+        const int64_t val = i * 10;
+        T_EXPECT(btree_insert(tree, (void *)&val), 0);
+    }
+
+    T_EXPECT(btree_to_array(tree, (void *)&arr, &size), 0);
+    T_ASSERT(size, (size_t)ARRAY_TEST_SIZE);
+
+    for (size_t i = 0; i < size; ++i)
+        T_ASSERT(arr[i], (int64_t)(i + 1) * 10);
+
+    FREE(arr);
+
+    /* whole tree */
+    (void)memset(&range, 0, sizeof(range));
+    T_EXPECT(btree_range_chunks(tree, NULL, NULL, (void *)&chunk[0], ARRAY_SIZE(chunk), sum_chunk, (void *)&range), 0);
+    T_ASSERT(range.entries, (size_t)ARRAY_TEST_SIZE);
+    T_ASSERT(range.sum, (int64_t)10 * ARRAY_TEST_SIZE * (ARRAY_TEST_SIZE + 1) / 2);
+
+    /* bounds between keys and on keys, [105, 50000] gives 110 .. 50000 */
+    const int64_t from[] = { 105, 110, 0, 50000, 100001, 100000 };
+    const int64_t to[] = { 50000, 49999, 5, 50000, 200000, 100000 };
+
+    for (size_t r = 0; r < ARRAY_SIZE(from); ++r)
+    {
+        int64_t expected_sum = 0;
+        size_t expected_entries = 0;
+
+        for (int64_t i = 1; i <= ARRAY_TEST_SIZE; ++i)
+            if (i * 10 >= from[r] && i * 10 <= to[r])
+            {
+                expected_sum += i * 10;
+                ++expected_entries;
+            }
+
+        (void)memset(&range, 0, sizeof(range));
+        T_EXPECT(btree_range_chunks(tree, (const void *)&from[r], (const void *)&to[r], (void *)&chunk[0], ARRAY_SIZE(chunk), sum_chunk, (void *)&range), 0);
+        T_ASSERT(range.entries, expected_entries);
+        T_ASSERT(range.sum, expected_sum);
+    }
+
+    /* open ranges */
+    const int64_t bound = 50000;
+
+    (void)memset(&range, 0, sizeof(range));
+    T_EXPECT(btree_range_chunks(tree, NULL, (const void *)&bound, (void *)&chunk[0], ARRAY_SIZE(chunk), sum_chunk, (void *)&range), 0);
+    T_ASSERT(range.entries, (size_t)5000);
+
+    (void)memset(&range, 0, sizeof(range));
+    T_EXPECT(btree_range_chunks(tree, (const void *)&bound, NULL, (void *)&chunk[0], ARRAY_SIZE(chunk), sum_chunk, (void *)&range), 0);
+    T_ASSERT(range.entries, (size_t)5001);
+
+    T_EXPECT(btree_range_chunks(tree, NULL, NULL, (void *)&chunk[0], 0, sum_chunk, (void *)&range), -1);
+    T_EXPECT(btree_range_chunks(tree, NULL, NULL, (void *)&chunk[0], ARRAY_SIZE(chunk), NULL, (void *)&range), -1);
+    T_EXPECT(btree_to_array(NULL, (void *)&arr, &size), -1);
+
+    btree_destroy(tree);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_btree_bulk_load(void)
+{
+    #define ARRAY_TEST_SIZE 100003
+
+    int64_t *arr = (int64_t *)malloc(sizeof(int64_t) * ARRAY_TEST_SIZE);
+    T_ERROR(arr == NULL);
+
+    int64_t val = 0;
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)i * 3;
+
+    Btree *tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(tree == NULL);
+
+    const size_t sizes[] = { 0, 1, 2, tree->leaf_capacity, tree->leaf_capacity + 1, 1000, 31337, ARRAY_TEST_SIZE };
+
+    btree_destroy(tree);
+
+    for (size_t s = 0; s < ARRAY_SIZE(sizes); ++s)
+    {
+        const size_t len = sizes[s];
+
+        tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+        T_ERROR(tree == NULL);
+
+        T_EXPECT(btree_bulk_load(tree, (void *)arr, len), 0);
+        T_CHECK(check_tree(tree));
+        T_EXPECT(btree_get_num_entries(tree), (ssize_t)len);
+
+        for (size_t i = 0; i < len; ++i)
+            T_EXPECT(btree_key_exist(tree, (void *)&arr[i]), (bool)true);
+
+        /* tree works as usual after load */
+        for (size_t i = 0; i < len; i += 2)
+            T_EXPECT(btree_delete(tree, (void *)&arr[i]), 0);
+
+        for (int64_t i = 0; i < (int64_t)len; ++i)
+        {
+            val = i * 3 + 1;
+            T_EXPECT(btree_insert(tree, (void *)&val), 0);
+        }
+
+        T_CHECK(check_tree(tree));
+        T_EXPECT(btree_get_num_entries(tree), (ssize_t)(len + len / 2));
+
+        /* only empty tree can be loaded */
+        if (len > 0)
+            T_EXPECT(btree_bulk_load(tree, (void *)arr, len), -1);
+
+        btree_destroy(tree);
+    }
+
+    /* unsorted array is rejected */
+    tree = btree_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(tree == NULL);
+
+    arr[500] = arr[499];
+    T_EXPECT(btree_bulk_load(tree, (void *)arr, 1000), -1);
+    T_EXPECT(btree_get_num_entries(tree), (ssize_t)0);
+    T_CHECK(check_tree(tree));
+
+    btree_destroy(tree);
+    FREE(arr);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_btree_with_entries(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    Btree *tree = btree_create(sizeof(int64_t *), my_compare_ptr, my_ptr_destroy);
+    T_ERROR(tree == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        int64_t *ptr = (int64_t *)malloc(sizeof(int64_t));
+        T_ERROR(ptr == NULL);
+
+        *ptr = i;
+        T_EXPECT(btree_insert(tree, (void *)&ptr), 0);
+    }
+
+    int64_t key = 7;
+    int64_t *key_ptr = &key;
+
+    /* entry from tree is freed, not the key */
+    T_EXPECT(btree_delete_with_entry(tree, (void *)&key_ptr), 0);
+    T_EXPECT(btree_delete_with_entry(tree, (void *)&key_ptr), 1);
+    T_EXPECT(btree_get_num_entries(tree), (ssize_t)(ARRAY_TEST_SIZE - 1));
+
+    /* rest of entries freed by destroy_f */
+    btree_destroy_with_entries(tree);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING BTREE");
+    TEST(test_btree_create());
+    TEST(test_btree_insert_search());
+    TEST(test_btree_delete());
+    TEST(test_btree_big_entries());
+    TEST(test_btree_to_array_range());
+    TEST(test_btree_bulk_load());
+    TEST(test_btree_with_entries());
+    TEST_SUMMARY();
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#ifndef CSTACK_H
+#define CSTACK_H
+
+
+/*
+    Lock-free concurrent stack implementation (Treiber stack)
+
+    Stack can be shared by many producers and consumers without mutex.
+    Nodes live in pool allocated once in cstack_create, so push / pop
+    never allocate. Top of stack and free list are pairs (node index, tag)
+    in one 64 bit word, tag is bumped by every successful CAS (ABA protection).
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <stddef.h> /* size_t */
+#include <stdbool.h> /* bool */
+#include <sys/types.h> /* ssize_t */
+
+
+typedef struct Cstack Cstack;
+
+
+/*
+    Create new instance of concurrent stack.
+
+    PARAMS:
+    @IN size_of - size of each element.
+    @IN capacity - max number of entries (< UINT32_MAX).
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to stack if success.
+*/
+Cstack *cstack_create(size_t size_of, size_t capacity);
+
+
+/*
+    Deallocate stack. (no other thread can use stack)
+
+    PARAMS:
+    @IN stack - pointer to stack.
+
+    RETURN:
+    %This is void function.
+*/
+void cstack_destroy(Cstack *stack);
+
+
+/*
+    Push value on stack. (thread safe, lock-free)
+
+    PARAMS:
+    @IN stack - pointer to stack.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %1 if stack is full.
+    %negative value if failure.
+*/
+int cstack_push(Cstack * __restrict__ stack, const void * __restrict__ entry);
+
+
+/*
+    Pop value from stack. (thread safe, lock-free)
+
+    PARAMS:
+    @IN stack - pointer to stack.
+    @OUT val_out - popped value.
+
+    RETURN:
+    %0 if success.
+    %1 if stack is empty.
+    %negative value if failure.
+*/
+int cstack_pop(Cstack * __restrict__ stack, void * __restrict__ val_out);
+
+
+/*
+    Check if stack is empty. (result can be outdated when returned)
+
+    PARAMS:
+    @IN stack - pointer to stack.
+
+    RETURN:
+    %TRUE if stack is empty.
+    %FALSE if is not empty or failure.
+*/
+bool cstack_is_empty(const Cstack *stack);
+
+
+/*
+    Get number of entries. (result can be outdated when returned)
+
+    PARAMS:
+    @IN stack - pointer to stack.
+
+    RETURN:
+    %number of entries if success.
+    %-1 if failure.
+*/
+ssize_t cstack_get_num_entries(const Cstack *stack);
+
+
+/*
+    Get max number of entries.
+
+    PARAMS:
+    @IN stack - pointer to stack.
+
+    RETURN:
+    %capacity if success.
+    %-1 if failure.
+*/
+ssize_t cstack_get_capacity(const Cstack *stack);
+
+
+/*
+    Get size of data.
+
+    PARAMS:
+    @IN stack - pointer to stack.
+
+    RETURN:
+    %sizeof if success.
+    %-1 if failure.
+*/
+ssize_t cstack_get_data_size(const Cstack *stack);
+
+
+#endif /* CSTACK_H */
@@ -0,0 +1,256 @@
+#include <cstack.h>
+#include <common.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* index of empty list */
+#define CSTACK_NIL ((uint32_t)UINT32_MAX)
+
+/* head of list is (index, tag) packed in one 64 bit word */
+#define CSTACK_PACK(index, tag) (((uint64_t)(tag) << 32) | (uint64_t)(index))
+#define CSTACK_INDEX(word) ((uint32_t)((word) & UINT32_MAX))
+#define CSTACK_TAG(word) ((uint32_t)((word) >> 32))
+
+
+typedef struct Cstack_node
+{
+    uint32_t next;              /* index of next node */
+    uint32_t reserved;          /* keeps data 8 byte aligned */
+
+    BYTE data[];                /* placeholder for data */
+} Cstack_node;
+
+
+/* each hot word has own cache line, so producers and consumers don't false share */
+typedef struct Cstack_head
+{
+    uint64_t word;              /* (index, tag) */
+    BYTE pad[CACHE_LINE_SIZE - sizeof(uint64_t)];
+} Cstack_head;
+
+
+struct Cstack
+{
+    Cstack_head top;            /* top of stack */
+    Cstack_head free;           /* top of free nodes list */
+
+    int64_t num_entries;        /* approximated number of entries */
+    BYTE pad[CACHE_LINE_SIZE - sizeof(int64_t)];
+
+    BYTE *nodes;                /* pool of nodes */
+    size_t node_size;           /* size of node with data */
+    size_t size_of;             /* size of element */
+    size_t capacity;            /* number of nodes in pool */
+};
+
+
+/*
+    Get node from pool.
+
+    PARAMS:
+    @IN stack - pointer to stack.
+    @IN index - index of node.
+
+    RETURN:
+    %Pointer to node.
+*/
+static ___inline___ Cstack_node *__cstack_node(const Cstack *stack, uint32_t index);
+
+
+/*
+    Pop node from lock-free list.
+
+    PARAMS:
+    @IN stack - pointer to stack.
+    @IN head - pointer to head of list.
+
+    RETURN:
+    %CSTACK_NIL if list is empty.
+    %Index of popped node.
+*/
+static ___inline___ uint32_t __cstack_list_pop(const Cstack *stack, uint64_t *head);
+
+
+/*
+    Push node to lock-free list.
+
+    PARAMS:
+    @IN stack - pointer to stack.
+    @IN head - pointer to head of list.
+    @IN index - index of pushed node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __cstack_list_push(const Cstack *stack, uint64_t *head, uint32_t index);
+
+
+static ___inline___ Cstack_node *__cstack_node(const Cstack *stack, uint32_t index)
+{
+    return (Cstack_node *)(void *)(stack->nodes + (size_t)index * stack->node_size);
+}
+
+
+static ___inline___ uint32_t __cstack_list_pop(const Cstack *stack, uint64_t *head)
+{
+    uint64_t old = __atomic_load_n(head, __ATOMIC_ACQUIRE);
+
+    for (;;)
+    {
+        const uint32_t index = CSTACK_INDEX(old);
+
+        if (index == CSTACK_NIL)
+            return CSTACK_NIL;
+
+        /*
+            Node can be popped and pushed again by other thread here, so next can be stale,
+            but then tag is different and CAS fails. Pool is never freed, so read is safe.
+        */
+        const uint32_t next = __atomic_load_n(&__cstack_node(stack, index)->next, __ATOMIC_RELAXED);
+
+        if (__atomic_compare_exchange_n(head, &old, CSTACK_PACK(next, CSTACK_TAG(old) + 1), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return index;
+    }
+}
+
+
+static ___inline___ void __cstack_list_push(const Cstack *stack, uint64_t *head, uint32_t index)
+{
+    Cstack_node *node = __cstack_node(stack, index);
+    uint64_t old = __atomic_load_n(head, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        __atomic_store_n(&node->next, CSTACK_INDEX(old), __ATOMIC_RELAXED);
+
+        /* release publishes node data and next to thread which pops node */
+        if (__atomic_compare_exchange_n(head, &old, CSTACK_PACK(index, CSTACK_TAG(old) + 1), true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            return;
+    }
+}
+
+
+Cstack *cstack_create(size_t size_of, size_t capacity)
+{
+    if (size_of < 1)
+        ERROR("size_of < 1\n", NULL);
+
+    if (capacity < 1 || capacity >= (size_t)CSTACK_NIL)
+        ERROR("incorrect capacity\n", NULL);
+
+    Cstack *stack = (Cstack *)calloc(1, sizeof(*stack));
+
+    if (stack == NULL)
+        ERROR("calloc error\n", NULL);
+
+    stack->size_of = size_of;
+    stack->capacity = capacity;
+    stack->node_size = ALIGN_UP(sizeof(Cstack_node) + size_of, sizeof(uint64_t));
+
+    stack->nodes = (BYTE *)malloc(capacity * stack->node_size);
+
+    if (stack->nodes == NULL)
+    {
+        FREE(stack);
+        ERROR("malloc error\n", NULL);
+    }
+
+    /* all nodes are on free list in memory order */
+    for (size_t i = 0; i < capacity; ++i)
+        __cstack_node(stack, (uint32_t)i)->next = (i + 1 == capacity) ? CSTACK_NIL : (uint32_t)(i + 1);
+
+    stack->top.word = CSTACK_PACK(CSTACK_NIL, 0);
+    stack->free.word = CSTACK_PACK(0, 0);
+    stack->num_entries = 0;
+
+    return stack;
+}
+
+
+void cstack_destroy(Cstack *stack)
+{
+    if (stack == NULL)
+        return;
+
+    FREE(stack->nodes);
+    FREE(stack);
+}
+
+
+int cstack_push(Cstack * __restrict__ stack, const void * __restrict__ entry)
+{
+    if (stack == NULL || entry == NULL)
+        ERROR("stack == NULL || entry == NULL\n", -1);
+
+    const uint32_t index = __cstack_list_pop(stack, &stack->free.word);
+
+    if (index == CSTACK_NIL)
+        return 1;
+
+    (void)memcpy((void *)__cstack_node(stack, index)->data, entry, stack->size_of);
+
+    __cstack_list_push(stack, &stack->top.word, index);
+    (void)__atomic_add_fetch(&stack->num_entries, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+
+int cstack_pop(Cstack * __restrict__ stack, void * __restrict__ val_out)
+{
+    if (stack == NULL || val_out == NULL)
+        ERROR("stack == NULL || val_out == NULL\n", -1);
+
+    const uint32_t index = __cstack_list_pop(stack, &stack->top.word);
+
+    if (index == CSTACK_NIL)
+        return 1;
+
+    (void)memcpy(val_out, (void *)__cstack_node(stack, index)->data, stack->size_of);
+
+    __cstack_list_push(stack, &stack->free.word, index);
+    (void)__atomic_sub_fetch(&stack->num_entries, 1, __ATOMIC_RELAXED);
+
+    return 0;
+}
+
+
+bool cstack_is_empty(const Cstack *stack)
+{
+    if (stack == NULL)
+        ERROR("stack == NULL\n", false);
+
+    return CSTACK_INDEX(__atomic_load_n(&stack->top.word, __ATOMIC_ACQUIRE)) == CSTACK_NIL;
+}
+
+
+ssize_t cstack_get_num_entries(const Cstack *stack)
+{
+    if (stack == NULL)
+        ERROR("stack == NULL\n", -1);
+
+    /* pop can be counted before its push, so counter can be below 0 for a moment */
+    const int64_t entries = __atomic_load_n(&stack->num_entries, __ATOMIC_RELAXED);
+
+    return entries < 0 ? 0 : (ssize_t)entries;
+}
+
+
+ssize_t cstack_get_capacity(const Cstack *stack)
+{
+    if (stack == NULL)
+        ERROR("stack == NULL\n", -1);
+
+    return (ssize_t)stack->capacity;
+}
+
+
+ssize_t cstack_get_data_size(const Cstack *stack)
+{
+    if (stack == NULL)
+        ERROR("stack == NULL\n", -1);
+
+    return (ssize_t)stack->size_of;
+}
@@ -0,0 +1,222 @@
+#include <cstack.h>
+#include <ctest.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h> /* sched_yield */
+
+
+#define THREADS 4
+#define ENTRIES_PER_THREAD 20000
+
+
+/* shared state of mpmc test */
+typedef struct Mpmc_ctx
+{
+    Cstack *stack;
+    size_t popped;                              /* entries popped by all consumers */
+    uint8_t seen[THREADS * ENTRIES_PER_THREAD]; /* how many times each value was popped */
+} Mpmc_ctx;
+
+
+typedef struct Producer_arg
+{
+    Mpmc_ctx *ctx;
+    uint64_t first;
+} Producer_arg;
+
+
+/* functions needed for testing */
+static void *producer(void *arg);
+static void *consumer(void *arg);
+
+
+/* unit tests function declaraions */
+static void test_cstack_create(void);
+static void test_cstack_push_pop(void);
+static void test_cstack_full(void);
+static void test_cstack_mpmc(void);
+
+
+/* implementation */
+static void *producer(void *arg)
+{
+    Producer_arg *parg = (Producer_arg *)arg;
+
+    for (uint64_t i = parg->first; i < parg->first + ENTRIES_PER_THREAD; ++i)
+        while (cstack_push(parg->ctx->stack, (void *)&i) != 0)
+            (void)sched_yield();
+
+    return NULL;
+}
+
+
+static void *consumer(void *arg)
+{
+    Mpmc_ctx *ctx = (Mpmc_ctx *)arg;
+    uint64_t val = 0;
+
+    while (__atomic_load_n(&ctx->popped, __ATOMIC_RELAXED) < THREADS * ENTRIES_PER_THREAD)
+    {
+        if (cstack_pop(ctx->stack, (void *)&val) != 0)
+        {
+            /* give cpu to producers, test can run on one core */
+            (void)sched_yield();
+            continue;
+        }
+
+        (void)__atomic_add_fetch(&ctx->seen[val], 1, __ATOMIC_RELAXED);
+        (void)__atomic_add_fetch(&ctx->popped, 1, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+
+
+static void test_cstack_create(void)
+{
+    Cstack *stack = cstack_create(sizeof(int), 10);
+    T_ERROR(stack == NULL);
+
+    T_EXPECT(cstack_is_empty(stack), (bool)true);
+    T_EXPECT(cstack_get_num_entries(stack), (ssize_t)0);
+    T_EXPECT(cstack_get_capacity(stack), (ssize_t)10);
+    T_EXPECT(cstack_get_data_size(stack), (ssize_t)sizeof(int));
+
+    cstack_destroy(stack);
+
+    T_ASSERT(cstack_create(0, 10), NULL);
+    T_ASSERT(cstack_create(sizeof(int), 0), NULL);
+    T_ASSERT(cstack_create(sizeof(int), (size_t)UINT32_MAX), NULL);
+
+    T_EXPECT(cstack_is_empty(NULL), (bool)false);
+    T_EXPECT(cstack_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(cstack_get_capacity(NULL), (ssize_t)-1);
+    T_EXPECT(cstack_get_data_size(NULL), (ssize_t)-1);
+}
+
+
+static void test_cstack_push_pop(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    int val = 0;
+
+    Cstack *stack = cstack_create(sizeof(int), ARRAY_TEST_SIZE);
+    T_ERROR(stack == NULL);
+
+    T_EXPECT(cstack_pop(stack, (void *)&val), 1);
+
+    for (int i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(cstack_push(stack, (void *)&i), 0);
+
+    T_EXPECT(cstack_get_num_entries(stack), (ssize_t)ARRAY_TEST_SIZE);
+    T_EXPECT(cstack_is_empty(stack), (bool)false);
+
+    /* LIFO */
+    for (int i = ARRAY_TEST_SIZE - 1; i >= 0; --i)
+    {
+        T_EXPECT(cstack_pop(stack, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    T_EXPECT(cstack_is_empty(stack), (bool)true);
+    T_EXPECT(cstack_pop(stack, (void *)&val), 1);
+
+    T_EXPECT(cstack_push(NULL, (void *)&val), -1);
+    T_EXPECT(cstack_push(stack, NULL), -1);
+    T_EXPECT(cstack_pop(NULL, (void *)&val), -1);
+    T_EXPECT(cstack_pop(stack, NULL), -1);
+
+    cstack_destroy(stack);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_cstack_full(void)
+{
+    #define ARRAY_TEST_SIZE 3
+
+    int64_t val = 0;
+
+    Cstack *stack = cstack_create(sizeof(int64_t), ARRAY_TEST_SIZE);
+    T_ERROR(stack == NULL);
+
+    /* nodes are reused many times */
+    for (int64_t round = 0; round < 1000; ++round)
+    {
+        for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            val = round + i;
+            T_EXPECT(cstack_push(stack, (void *)&val), 0);
+        }
+
+        T_EXPECT(cstack_push(stack, (void *)&val), 1);
+
+        for (int64_t i = ARRAY_TEST_SIZE - 1; i >= 0; --i)
+        {
+            T_EXPECT(cstack_pop(stack, (void *)&val), 0);
+            T_ASSERT(val, round + i);
+        }
+    }
+
+    cstack_destroy(stack);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_cstack_mpmc(void)
+{
+    pthread_t producers[THREADS];
+    pthread_t consumers[THREADS];
+    Producer_arg args[THREADS];
+
+    Mpmc_ctx *ctx = (Mpmc_ctx *)calloc(1, sizeof(*ctx));
+    T_ERROR(ctx == NULL);
+
+    /* small stack, so producers often hit full stack and nodes are reused a lot */
+    ctx->stack = cstack_create(sizeof(uint64_t), 64);
+    T_ERROR(ctx->stack == NULL);
+
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        args[i].ctx = ctx;
+        args[i].first = (uint64_t)(i * ENTRIES_PER_THREAD);
+
+        T_EXPECT(pthread_create(&consumers[i], NULL, consumer, (void *)ctx), 0);
+        T_EXPECT(pthread_create(&producers[i], NULL, producer, (void *)&args[i]), 0);
+    }
+
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        T_EXPECT(pthread_join(producers[i], NULL), 0);
+        T_EXPECT(pthread_join(consumers[i], NULL), 0);
+    }
+
+    /* every value was popped exactly once */
+    size_t bad = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(ctx->seen); ++i)
+        if (ctx->seen[i] != 1)
+            ++bad;
+
+    T_ASSERT(bad, (size_t)0);
+    T_EXPECT(cstack_is_empty(ctx->stack), (bool)true);
+    T_EXPECT(cstack_get_num_entries(ctx->stack), (ssize_t)0);
+
+    cstack_destroy(ctx->stack);
+    FREE(ctx);
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING LOCK-FREE STACK");
+    TEST(test_cstack_create());
+    TEST(test_cstack_push_pop());
+    TEST(test_cstack_full());
+    TEST(test_cstack_mpmc());
+    TEST_SUMMARY();
+
+    return 0;
+}
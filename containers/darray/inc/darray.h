@@ -24,6 +24,25 @@ typedef enum DARRAY_TYPE
 } DARRAY_TYPE;
 
 
+/* Darrays created with DARRAY_HUGEPAGE of at least this many bytes are backed by huge pages */
+#ifndef DARRAY_HUGEPAGE_THRESHOLD
+#define DARRAY_HUGEPAGE_THRESHOLD HUGE_PAGE_SIZE
+#endif
+
+
+typedef enum DARRAY_FLAGS
+{
+    DARRAY_DEFAULT = 0,         /* plain malloc / realloc */
+    DARRAY_ALIGNED = 1 << 0,    /* array aligned to CACHE_LINE_SIZE (SIMD friendly) */
+    DARRAY_HUGEPAGE = 1 << 1,   /* big array aligned to HUGE_PAGE_SIZE and advised as huge page */
+    DARRAY_MMAP = 1 << 2,       /* array mapped from file (set only by darray_open_mmap) */
+    DARRAY_FIXED = 1 << 3,      /* capacity never changes, insert fails when full (set only by darray_create_fixed) */
+    DARRAY_EXTERNAL = 1 << 4,   /* array is not owned by darray (set only by darray_create_fixed) */
+    DARRAY_INLINE = 1 << 5,     /* array is small inline buffer, moved to heap when full (set only by darray_create_inline and darray_init) */
+    DARRAY_STATIC = 1 << 6      /* darray itself is not owned by darray (set only by darray_init) */
+} DARRAY_FLAGS;
+
+
 typedef struct Darray 
 {
     void *array;	          /* main array */
@@ -34,6 +53,8 @@ typedef struct Darray
     size_t size_of;	          /* size of element */
     size_t num_entries;       /* number of entries in array */
     size_t size;	          /* current allocated size of array */
+    int flags;                /* allocation flags (DARRAY_FLAGS) */
+    int fd;                   /* backing file if DARRAY_MMAP, otherwise -1 */
 } Darray;
 
 
@@ -44,7 +65,7 @@ typedef struct Darray
     @IN type - type of darray.
     @IN size_of - size of element.
     @IN size - beggining size of darray.
-    @IN cmp_f - pointer to compare function.
+    @IN cmp_f - pointer to compare function (only sorted darray needs it).
 
     RETURN:
     %NULL if failure.
@@ -53,8 +74,137 @@ typedef struct Darray
 Darray *darray_create(const DARRAY_TYPE type, const size_t size_of, const size_t size, const compare_f cmp_f, const destructor_f destroy_f);
 
 
+/*
+    Create new instance of dynamic array with allocation flags.
+    Flags are kept for the whole life of darray, so array stays
+    aligned after every resize.
+
+    PARAMS:
+    @IN type - type of darray.
+    @IN size_of - size of element.
+    @IN size - beggining size of darray.
+    @IN cmp_f - pointer to compare function (only sorted darray needs it).
+    @IN destroy_f - pointer to destroy function.
+    @IN flags - DARRAY_FLAGS ored together.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to dynamic array if success.
+*/
+Darray *darray_create_with_flags(const DARRAY_TYPE type, const size_t size_of, const size_t size, const compare_f cmp_f, const destructor_f destroy_f, const int flags);
+
+
+/*
+    Create new instance of dynamic array with fixed capacity.
+    Darray never allocates after creation: insert fails when array is full
+    and delete never shrinks array. If @buffer is NULL array is embedded
+    in the same allocation as darray, otherwise @buffer is used and it is
+    not freed by darray_destroy.
+
+    PARAMS:
+    @IN type - type of darray.
+    @IN size_of - size of element.
+    @IN capacity - max number of entries.
+    @IN buffer - caller buffer for @capacity entries or NULL.
+    @IN cmp_f - pointer to compare function (only sorted darray needs it).
+    @IN destroy_f - pointer to destroy function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to dynamic array if success.
+*/
+Darray *darray_create_fixed(const DARRAY_TYPE type, const size_t size_of, const size_t capacity, void *buffer, const compare_f cmp_f, const destructor_f destroy_f);
+
+
+/*
+    Create new instance of dynamic array with @capacity inline slots.
+    Inline slots are embedded in the same allocation as darray, so small
+    darray needs only one malloc. When inline slots are full, entries are
+    moved to heap and darray grows like darray created by darray_create.
+
+    PARAMS:
+    @IN type - type of darray.
+    @IN size_of - size of element.
+    @IN capacity - number of inline slots.
+    @IN cmp_f - pointer to compare function (only sorted darray needs it).
+    @IN destroy_f - pointer to destroy function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to dynamic array if success.
+*/
+Darray *darray_create_inline(const DARRAY_TYPE type, const size_t size_of, const size_t capacity, const compare_f cmp_f, const destructor_f destroy_f);
+
+
+/*
+    Init dynamic array in memory provided by caller (e.g. on stack), darray
+    itself is never allocated. If @buffer is not NULL it is used as inline
+    slots for first @capacity entries, then entries are moved to heap.
+    darray_destroy frees only heap memory.
+
+    Usage:
+    Darray darray;
+    int buffer[8];
+    darray_init(&darray, DARRAY_UNSORTED, sizeof(int), buffer, ARRAY_SIZE(buffer), NULL, NULL);
+    ...
+    darray_destroy(&darray);
+
+    PARAMS:
+    @IN darray - pointer to darray to init.
+    @IN type - type of darray.
+    @IN size_of - size of element.
+    @IN buffer - caller buffer for @capacity entries or NULL.
+    @IN capacity - number of entries in @buffer.
+    @IN cmp_f - pointer to compare function (only sorted darray needs it).
+    @IN destroy_f - pointer to destroy function.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int darray_init(Darray *darray, const DARRAY_TYPE type, const size_t size_of, void *buffer, const size_t capacity, const compare_f cmp_f, const destructor_f destroy_f);
+
+
+/*
+    Open dynamic array backed by file @path. File is created if doesn't exist.
+
+    File starts with a small header (element size, number of entries, type)
+    followed by entries, which are mapped as darray array. Opening is O(1)
+    and page cache is shared between processes. Darray grows with
+    ftruncate + mremap and never shrinks. Header is updated by darray_sync
+    and darray_destroy.
+
+    PARAMS:
+    @IN path - path to file.
+    @IN type - type of darray (has to match file).
+    @IN size_of - size of element (has to match file).
+    @IN cmp_f - pointer to compare function (only sorted darray needs it).
+    @IN destroy_f - pointer to destroy function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to dynamic array if success.
+*/
+Darray *darray_open_mmap(const char * const path, const DARRAY_TYPE type, const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f);
+
+
+/*
+    Write header and flush entries of darray opened by darray_open_mmap to file.
+
+    PARAMS:
+    @IN darray - pointer to dynamic array.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int darray_sync(Darray *darray);
+
+
 /*
     Deallocate dynamic array with all entries.
+    Darray opened by darray_open_mmap is synced, unmapped and closed.
+    Darray initialized by darray_init frees only heap memory.
 
     PARAMS:
     @IN darray - pointer to dynamic array.
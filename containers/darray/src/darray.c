@@ -1,12 +1,36 @@
+#define _GNU_SOURCE /* mremap */
+
 #include <darray.h>
 #include <common.h>
 #include <stdlib.h> /* malloc, free, qsort */
 #include <string.h> /* memcpy, memmove */
+#include <sys/mman.h> /* madvise, mmap, mremap */
+#include <sys/stat.h> /* fstat */
+#include <fcntl.h> /* open */
+#include <unistd.h> /* ftruncate, pread, close */
 
 
 #define RATIO ((size_t)2)
 
 
+/* "DARRAY01" */
+#define DARRAY_MMAP_MAGIC ((uint64_t)0x3130594152524144ULL)
+
+
+/* entries in file start after header, on separate cache line */
+#define DARRAY_MMAP_HEADER_SIZE CACHE_LINE_SIZE
+
+
+/* Header of file backing darray opened by darray_open_mmap */
+typedef struct Darray_file_header
+{
+	uint64_t magic;           /* DARRAY_MMAP_MAGIC */
+	uint64_t size_of;         /* size of element */
+	uint64_t num_entries;     /* number of entries in file */
+	uint64_t type;            /* DARRAY_TYPE (sorted / unsorted) */
+} Darray_file_header;
+
+
 /*
     Calculate offset.
 
@@ -23,6 +47,170 @@ static __inline__ void *__calc_offset(const void * const src, const size_t offse
 }
 
 
+/*
+    Allocate memory for array in dynamic array honoring darray flags.
+
+    PARAMS:
+    @IN darray - pointer to the dynamic array.
+    @IN bytes - number of bytes to allocate.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to allocated memory if success.
+*/
+static void *__darray_alloc(const Darray * const darray, const size_t bytes)
+{
+	if ((darray->flags & (DARRAY_ALIGNED | DARRAY_HUGEPAGE)) == 0)
+		return malloc(bytes);
+
+	size_t alignment = CACHE_LINE_SIZE;
+
+	if ((darray->flags & DARRAY_HUGEPAGE) && bytes >= DARRAY_HUGEPAGE_THRESHOLD)
+		alignment = HUGE_PAGE_SIZE;
+
+	const size_t size = ALIGN_UP(bytes, alignment);
+	void *ptr = NULL;
+
+	if (posix_memalign(&ptr, alignment, size) != 0)
+		return NULL;
+
+#ifdef MADV_HUGEPAGE
+	if (alignment == HUGE_PAGE_SIZE)
+		(void)madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+
+	return ptr;
+}
+
+
+/*
+    Get beginning of mapping (file header) of darray opened by darray_open_mmap.
+
+    PARAMS:
+    @IN darray - pointer to the dynamic array.
+
+    RETURN:
+    %Pointer to mapped file header.
+*/
+static __inline__ Darray_file_header *__darray_mmap_header(const Darray * const darray)
+{
+	return (Darray_file_header *)((BYTE *)darray->array - DARRAY_MMAP_HEADER_SIZE);
+}
+
+
+/*
+    Grow file and mapping of darray opened by darray_open_mmap.
+
+    PARAMS:
+    @IN darray - pointer to the dynamic array.
+    @IN bytes - new size of array in bytes.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to remapped array if success.
+*/
+static void *__darray_mmap_resize(Darray *darray, const size_t bytes)
+{
+	const size_t old_len = DARRAY_MMAP_HEADER_SIZE + darray->size * darray->size_of;
+	const size_t new_len = DARRAY_MMAP_HEADER_SIZE + bytes;
+
+	if (ftruncate(darray->fd, (off_t)new_len) != 0)
+		return NULL;
+
+	void *base = mremap((void *)__darray_mmap_header(darray), old_len, new_len, MREMAP_MAYMOVE);
+
+	if (base == MAP_FAILED)
+		return NULL;
+
+	return (void *)((BYTE *)base + DARRAY_MMAP_HEADER_SIZE);
+}
+
+
+/*
+    Check file header (or create new one in empty file) for darray_open_mmap.
+
+    PARAMS:
+    @IN fd - file descriptor.
+    @IN type - expected type of darray.
+    @IN size_of - expected size of element.
+    @OUT header - read or created header.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __darray_mmap_read_header(const int fd, const DARRAY_TYPE type, const size_t size_of, Darray_file_header *header)
+{
+	struct stat st;
+
+	if (fstat(fd, &st) != 0)
+		ERROR("fstat error\n", -1);
+
+	/* brand new file */
+	if (st.st_size == 0)
+	{
+		header->magic = DARRAY_MMAP_MAGIC;
+		header->size_of = (uint64_t)size_of;
+		header->num_entries = 0;
+		header->type = (uint64_t)type;
+
+		return 0;
+	}
+
+	if ((size_t)st.st_size < DARRAY_MMAP_HEADER_SIZE)
+		ERROR("file is too small\n", -1);
+
+	if (pread(fd, (void *)header, sizeof(*header), 0) != (ssize_t)sizeof(*header))
+		ERROR("pread error\n", -1);
+
+	if (header->magic != DARRAY_MMAP_MAGIC)
+		ERROR("header->magic != DARRAY_MMAP_MAGIC\n", -1);
+
+	if (header->size_of != (uint64_t)size_of || header->type != (uint64_t)type)
+		ERROR("header doesn't match size_of or type\n", -1);
+
+	if ((size_t)st.st_size < DARRAY_MMAP_HEADER_SIZE + (size_t)header->num_entries * size_of)
+		ERROR("file is truncated\n", -1);
+
+	return 0;
+}
+
+
+/*
+    Reallocate array in dynamic array honoring darray flags.
+    Aligned memory cannot be realloced, so entries are copied to the new block.
+
+    PARAMS:
+    @IN darray - pointer to the dynamic array.
+    @IN bytes - new size of array in bytes.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to reallocated memory if success.
+*/
+static void *__darray_realloc(Darray *darray, const size_t bytes)
+{
+	if (darray->flags & DARRAY_MMAP)
+		return __darray_mmap_resize(darray, bytes);
+
+	if ((darray->flags & (DARRAY_ALIGNED | DARRAY_HUGEPAGE)) == 0)
+		return realloc(darray->array, bytes);
+
+	void *ptr = __darray_alloc(darray, bytes);
+
+	if (ptr == NULL)
+		return NULL;
+
+	if (darray->array != NULL)
+	{
+		(void)memcpy(ptr, darray->array, MIN(darray->num_entries * darray->size_of, bytes));
+		free(darray->array);
+	}
+
+	return ptr;
+}
+
+
 /*
     Realloc array in dynamic array when inserted new element.
 
@@ -30,29 +218,61 @@ static __inline__ void *__calc_offset(const void * const src, const size_t offse
     @IN src - pointer to the dynamic array.
 
     RETURN:
-    %This is void function.
+    %0 if there is place for new element.
+    %negative value if failure or fixed darray is full.
 */
-static void __darray_resize_insert(Darray *darray)
+static int __darray_resize_insert(Darray *darray)
 {
+	if (darray->flags & DARRAY_FIXED)
+	{
+		if (darray->num_entries == darray->size)
+			ERROR("fixed darray is full\n", -1);
+
+		return 0;
+	}
+
+	if (darray->flags & DARRAY_INLINE)
+	{
+		if (darray->num_entries < darray->size)
+			return 0;
+
+		/* inline slots are full, so move entries to heap, from now on darray grows as usual */
+		void *array = __darray_alloc(darray, darray->size * darray->size_of * RATIO);
+
+		if (array == NULL)
+			ERROR("malloc error\n", -1);
+
+		(void)memcpy(array, darray->array, darray->num_entries * darray->size_of);
+
+		darray->array = array;
+		darray->size *= RATIO;
+		darray->flags &= ~DARRAY_INLINE;
+
+		return 0;
+	}
+
 	if (darray->size == 0)
 	{
-		darray->array = malloc(darray->size_of * RATIO);
+		darray->array = __darray_alloc(darray, darray->size_of * RATIO);
 
 		if (darray->array == NULL)
-			VERROR("malloc error\n");
+			ERROR("malloc error\n", -1);
 
 		darray->size = RATIO;
 	}
 
 	if (darray->num_entries == darray->size)
 	{
-		darray->array = realloc(darray->array, darray->size * darray->size_of * RATIO);
+		void *array = __darray_realloc(darray, darray->size * darray->size_of * RATIO);
 
-		if (darray->array == NULL)
-			VERROR("realloc error\n");
+		if (array == NULL)
+			ERROR("realloc error\n", -1);
 
+		darray->array = array;
 		darray->size *= RATIO;
 	}
+
+	return 0;
 }
 
 
@@ -67,6 +287,10 @@ static void __darray_resize_insert(Darray *darray)
 */
 static void __darray_resize_delete(Darray *darray)
 {
+	/* file backed, fixed and inline darray keep their capacity */
+	if (darray->flags & (DARRAY_MMAP | DARRAY_FIXED | DARRAY_INLINE))
+		return;
+
 	if (darray->num_entries == 1)
 	{
 		darray->size = 0;
@@ -76,16 +300,70 @@ static void __darray_resize_delete(Darray *darray)
 
 	if (darray->num_entries == (darray->size / (2 * RATIO)))
 	{
-		darray->array = realloc(darray->array, (darray->size / RATIO) * darray->size_of);
+		void *array = __darray_realloc(darray, (darray->size / RATIO) * darray->size_of);
 
-		if (darray->array == NULL)
+		/* failed shrink is not fatal, old array is still valid */
+		if (array == NULL)
 			VERROR("realloc error\n");
 
+		darray->array = array;
 		darray->size /= RATIO;
 	}
 }
 
 
+/*
+    Create dynamic array with array of @capacity entries embedded in darray or in caller @buffer.
+
+    PARAMS:
+    @IN type - type of darray.
+    @IN size_of - size of element.
+    @IN capacity - number of entries.
+    @IN buffer - caller buffer for @capacity entries or NULL.
+    @IN cmp_f - pointer to compare function.
+    @IN destroy_f - pointer to destroy function.
+    @IN flags - DARRAY_FLAGS of new darray.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to dynamic array if success.
+*/
+static Darray *__darray_create_embedded(const DARRAY_TYPE type, const size_t size_of, const size_t capacity, void *buffer, const compare_f cmp_f, const destructor_f destroy_f, const int flags)
+{
+	if (size_of < 1)
+		ERROR("size_of < 1\n", NULL);
+
+	if (capacity < 1)
+		ERROR("capacity < 1\n", NULL);
+
+	if (type == DARRAY_SORTED && cmp_f == NULL)
+		ERROR("type == DARRAY_SORTED && cmp_f == NULL\n", NULL);
+
+	/* embedded array starts after darray, aligned for any element */
+	const size_t header = ALIGN_UP(sizeof(Darray), 2 * sizeof(void *));
+
+	if (buffer == NULL && capacity > (SIZE_MAX - header) / size_of)
+		ERROR("capacity is too big\n", NULL);
+
+	Darray *darray = (Darray *)malloc(buffer == NULL ? header + capacity * size_of : sizeof(Darray));
+
+	if (darray == NULL)
+		ERROR("malloc error\n", NULL);
+
+	darray->array = buffer == NULL ? __calc_offset((void *)darray, header) : buffer;
+	darray->cmp_f = cmp_f;
+	darray->destroy_f = destroy_f;
+	darray->type = type;
+	darray->size_of = size_of;
+	darray->num_entries = 0;
+	darray->size = capacity;
+	darray->flags = flags;
+	darray->fd = -1;
+
+	return darray;
+}
+
+
 /*
     Insert new element to the sorted dynamic array.
 
@@ -102,7 +380,8 @@ static int __darray_sorted_insert(Darray * restrict darray, const void * restric
 	if (entry == NULL)
 		ERROR("entry == NULL\n", -1);
 
-	__darray_resize_insert(darray);
+	if (__darray_resize_insert(darray) != 0)
+		ERROR("__darray_resize_insert error\n", -1);
 
 	size_t pos = 0;
 
@@ -145,7 +424,8 @@ static int __darray_unsorted_insert(Darray * restrict darray, const void * restr
 	if (entry == NULL)
 		ERROR("entry == NULL\n", -1);
 
-	__darray_resize_insert(darray);
+	if (__darray_resize_insert(darray) != 0)
+		ERROR("__darray_resize_insert error\n", -1);
 
 	void *src = __calc_offset(darray->array, (darray->num_entries * darray->size_of));
 	__ASSIGN__(*(char *)src, *(char *)entry, darray->size_of);
@@ -208,12 +488,18 @@ static ssize_t __darray_search_last(const Darray * const restrict darray, const
 
 
 Darray *darray_create(const DARRAY_TYPE type, const size_t size_of, const size_t size, const compare_f cmp_f, const destructor_f destroy_f)
+{
+	return darray_create_with_flags(type, size_of, size, cmp_f, destroy_f, DARRAY_DEFAULT);
+}
+
+
+Darray *darray_create_with_flags(const DARRAY_TYPE type, const size_t size_of, const size_t size, const compare_f cmp_f, const destructor_f destroy_f, const int flags)
 {
 	if (size_of < 1)
 		ERROR("size_of < 1\n", NULL);
 
-	if (cmp_f == NULL)
-		ERROR("cmp_f == NULL\n", NULL);
+	if (type == DARRAY_SORTED && cmp_f == NULL)
+		ERROR("type == DARRAY_SORTED && cmp_f == NULL\n", NULL);
 
 	Darray *darray = (Darray *)malloc(sizeof(Darray));
 
@@ -221,10 +507,14 @@ Darray *darray_create(const DARRAY_TYPE type, const size_t size_of, const size_t
 		ERROR("malloc error\n", NULL);
 
 	darray->array = NULL;
+	darray->flags = flags & ~(DARRAY_MMAP | DARRAY_FIXED | DARRAY_EXTERNAL | DARRAY_INLINE | DARRAY_STATIC);
+	darray->fd = -1;
+	darray->size_of = size_of;
+	darray->num_entries = 0;
 
 	if (size >= 1)
 	{
-		darray->array = malloc(size_of * size);
+		darray->array = __darray_alloc(darray, size_of * size);
 
 		if (darray->array == NULL)
 		{
@@ -235,24 +525,168 @@ Darray *darray_create(const DARRAY_TYPE type, const size_t size_of, const size_t
 	
 	darray->cmp_f = cmp_f;
     darray->destroy_f = destroy_f;
+	darray->type = type;
+	darray->size = size;
+
+	return darray;
+}
+
+
+Darray *darray_create_fixed(const DARRAY_TYPE type, const size_t size_of, const size_t capacity, void *buffer, const compare_f cmp_f, const destructor_f destroy_f)
+{
+	return __darray_create_embedded(type, size_of, capacity, buffer, cmp_f, destroy_f, DARRAY_FIXED | DARRAY_EXTERNAL);
+}
+
+
+Darray *darray_create_inline(const DARRAY_TYPE type, const size_t size_of, const size_t capacity, const compare_f cmp_f, const destructor_f destroy_f)
+{
+	return __darray_create_embedded(type, size_of, capacity, NULL, cmp_f, destroy_f, DARRAY_INLINE);
+}
+
+
+int darray_init(Darray *darray, const DARRAY_TYPE type, const size_t size_of, void *buffer, const size_t capacity, const compare_f cmp_f, const destructor_f destroy_f)
+{
+	if (darray == NULL)
+		ERROR("darray == NULL\n", -1);
+
+	if (size_of < 1)
+		ERROR("size_of < 1\n", -1);
+
+	if (buffer != NULL && capacity < 1)
+		ERROR("buffer != NULL && capacity < 1\n", -1);
+
+	if (type == DARRAY_SORTED && cmp_f == NULL)
+		ERROR("type == DARRAY_SORTED && cmp_f == NULL\n", -1);
+
+	/* without buffer first insert allocates array like in darray_create */
+	darray->array = buffer;
+	darray->cmp_f = cmp_f;
+	darray->destroy_f = destroy_f;
 	darray->type = type;
 	darray->size_of = size_of;
 	darray->num_entries = 0;
+	darray->size = buffer == NULL ? 0 : capacity;
+	darray->flags = buffer == NULL ? DARRAY_STATIC : (DARRAY_STATIC | DARRAY_INLINE);
+	darray->fd = -1;
+
+	return 0;
+}
+
+
+Darray *darray_open_mmap(const char * const path, const DARRAY_TYPE type, const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f)
+{
+	if (path == NULL)
+		ERROR("path == NULL\n", NULL);
+
+	if (size_of < 1)
+		ERROR("size_of < 1\n", NULL);
+
+	if (type == DARRAY_SORTED && cmp_f == NULL)
+		ERROR("type == DARRAY_SORTED && cmp_f == NULL\n", NULL);
+
+	const int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0)
+		ERROR("open error\n", NULL);
+
+	Darray_file_header header;
+
+	if (__darray_mmap_read_header(fd, type, size_of, &header) != 0)
+	{
+		(void)close(fd);
+		ERROR("__darray_mmap_read_header error\n", NULL);
+	}
+
+	const size_t size = MAX((size_t)header.num_entries, RATIO);
+	const size_t len = DARRAY_MMAP_HEADER_SIZE + size * size_of;
+
+	/* file is kept compact on disk, so always make room for capacity */
+	if (ftruncate(fd, (off_t)len) != 0)
+	{
+		(void)close(fd);
+		ERROR("ftruncate error\n", NULL);
+	}
+
+	void *base = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+	if (base == MAP_FAILED)
+	{
+		(void)close(fd);
+		ERROR("mmap error\n", NULL);
+	}
+
+	(void)memcpy(base, (const void *)&header, sizeof(header));
+
+	Darray *darray = (Darray *)malloc(sizeof(Darray));
+
+	if (darray == NULL)
+	{
+		(void)munmap(base, len);
+		(void)close(fd);
+		ERROR("malloc error\n", NULL);
+	}
+
+	darray->array = (void *)((BYTE *)base + DARRAY_MMAP_HEADER_SIZE);
+	darray->cmp_f = cmp_f;
+	darray->destroy_f = destroy_f;
+	darray->type = type;
+	darray->size_of = size_of;
+	darray->num_entries = (size_t)header.num_entries;
 	darray->size = size;
+	darray->flags = DARRAY_MMAP;
+	darray->fd = fd;
 
 	return darray;
 }
 
 
+int darray_sync(Darray *darray)
+{
+	if (darray == NULL)
+		ERROR("darray == NULL\n", -1);
+
+	if ((darray->flags & DARRAY_MMAP) == 0)
+		ERROR("darray is not mapped from file\n", -1);
+
+	Darray_file_header *header = __darray_mmap_header(darray);
+	header->num_entries = (uint64_t)darray->num_entries;
+
+	const size_t len = DARRAY_MMAP_HEADER_SIZE + darray->size * darray->size_of;
+
+	if (msync((void *)header, len, MS_SYNC) != 0)
+		ERROR("msync error\n", -1);
+
+	return 0;
+}
+
+
 void darray_destroy(Darray *darray)
 {
 	if (darray == NULL)
 		VERROR("darray == NULL\n");
 
-	if (darray->array != NULL)
+	if (darray->flags & DARRAY_MMAP)
+	{
+		Darray_file_header *header = __darray_mmap_header(darray);
+		header->num_entries = (uint64_t)darray->num_entries;
+
+		(void)munmap((void *)header, DARRAY_MMAP_HEADER_SIZE + darray->size * darray->size_of);
+
+		/* drop unused capacity from file */
+		(void)ftruncate(darray->fd, (off_t)(DARRAY_MMAP_HEADER_SIZE + darray->num_entries * darray->size_of));
+		(void)close(darray->fd);
+
+		FREE(darray);
+		return;
+	}
+
+	/* caller buffer or array embedded in darray */
+	if (darray->array != NULL && (darray->flags & (DARRAY_EXTERNAL | DARRAY_INLINE)) == 0)
 		FREE(darray->array);
 
-	FREE(darray);
+	/* darray from darray_init is owned by caller */
+	if ((darray->flags & DARRAY_STATIC) == 0)
+		FREE(darray);
 }
 
 
@@ -270,6 +704,9 @@ int darray_delete(Darray * restrict darray, void * restrict val_out)
 	if (darray->array == NULL)
 		ERROR("darray->array == NULL\n", -1);
 
+	if (darray->num_entries == 0)
+		ERROR("darray->num_entries == 0\n", -1);
+
 	if (val_out != NULL)
 	{
 		const void *dst = __calc_offset(darray->array, ((darray->num_entries - 1) * darray->size_of));
@@ -291,10 +728,11 @@ int darray_insert_pos(Darray * restrict darray, const void * restrict entry, con
 	if (darray->type == DARRAY_SORTED)
 		ERROR("darray->type == DARRAY_SORTED\n", -1);
 
-    if (pos > darray->num_entries)
-        ERROR("pos > darray->num_entries\n", -1);
+	if (pos > darray->num_entries)
+		ERROR("pos > darray->num_entries\n", -1);
 
-    	__darray_resize_insert(darray);
+	if (__darray_resize_insert(darray) != 0)
+		ERROR("__darray_resize_insert error\n", -1);
 
 	const void *src = __calc_offset(darray->array, (pos * darray->size_of));
 	void *dst = __calc_offset(darray->array, ((pos + 1) * darray->size_of));
@@ -315,6 +753,9 @@ int darray_delete_pos(Darray * restrict darray, void * restrict val_out, const s
 	if (darray->type == DARRAY_SORTED)
 		ERROR("darray->type == DARRAY_SORTED\n", -1);
 
+	if (darray->num_entries == 0)
+		ERROR("darray->num_entries == 0\n", -1);
+
     if (pos > darray->num_entries)
         ERROR("pos > darray->num_entries\n", -1);
 
@@ -347,6 +788,9 @@ int darray_get_data(const Darray * const restrict darray, void * restrict val_ou
 	if (val_out == NULL)
 		ERROR("val_out == NULL\n", -1);
 
+	if (darray->num_entries == 0)
+		ERROR("darray->num_entries == 0\n", -1);
+
 	if (pos > (darray->num_entries - 1))
 		ERROR("pos > (darray->num_entries - 1)\n", -1);
 
@@ -362,6 +806,9 @@ ssize_t darray_search_first(const Darray * const restrict darray, const void * c
 	if (darray == NULL || darray->array == NULL)
 		ERROR("darray == NULL || darray->array == NULL\n", -1);
 
+	if (darray->cmp_f == NULL)
+		ERROR("darray->cmp_f == NULL\n", -1);
+
 	if (key == NULL)
 		ERROR("key == NULL\n", -1);
 
@@ -382,6 +829,9 @@ ssize_t darray_search_last(const Darray * const restrict darray, const void * co
 	if (darray == NULL || darray->array == NULL)
 		ERROR("darray == NULL || darray->array == NULL\n", -1);
 
+	if (darray->cmp_f == NULL)
+		ERROR("darray->cmp_f == NULL\n", -1);
+
 	if (key == NULL)
 		ERROR("key == NULL\n", -1);
 
@@ -402,10 +852,14 @@ ssize_t darray_search_min(const Darray * const restrict darray, void * restrict
 	if (darray == NULL || darray->array == NULL)
 		ERROR("darray == NULL || darray->array == NULL\n", -1);
 
+	if (darray->cmp_f == NULL)
+		ERROR("darray->cmp_f == NULL\n", -1);
+
 	const size_t size_of = darray->size_of;
 	const size_t length = darray->num_entries * size_of;
 
-	ssize_t index = -1;
+	/* first entry is minimum until smaller one is found */
+	ssize_t index = darray->num_entries > 0 ? 0 : -1;
 	void *arr = darray->array;
 	void *curr = arr;
 
@@ -433,10 +887,14 @@ ssize_t darray_search_max(const Darray * const restrict darray, void * restrict
 	if (darray == NULL || darray->array == NULL)
 		ERROR("darray == NULL || darray->array == NULL\n", -1);
 
+	if (darray->cmp_f == NULL)
+		ERROR("darray->cmp_f == NULL\n", -1);
+
 	const size_t size_of = darray->size_of;
 	const size_t length = darray->num_entries * size_of;
 
-	ssize_t index = -1;
+	/* first entry is maximum until bigger one is found */
+	ssize_t index = darray->num_entries > 0 ? 0 : -1;
 	void *arr = darray->array;
 	void *curr = arr;
 
@@ -464,6 +922,9 @@ int darray_sort(Darray *darray)
 	if (darray == NULL || darray->array == NULL)
 		ERROR("darray == NULL || darray->array == NULL\n", -1);
 
+	if (darray->cmp_f == NULL)
+		ERROR("darray->cmp_f == NULL\n", -1);
+
 	if (darray->type == DARRAY_SORTED)
 		ERROR("darray->type == DARRAY_SORTED\n", -1);
 
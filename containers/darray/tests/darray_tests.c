@@ -2,6 +2,7 @@
 #include <ctest.h>
 #include <stdint.h> 
 #include <assert.h>
+#include <unistd.h> /* close, unlink */
 
 typedef struct S
 {
@@ -50,6 +51,139 @@ static void test_create_and_delete_darray(void)
 	darray_destroy(darray);
 }
 
+static void test_create_with_flags_darray(void)
+{
+	Darray *darray = darray_create_with_flags(DARRAY_UNSORTED, sizeof(S), (size_t)3, compare, NULL, DARRAY_ALIGNED);
+	T_ERROR(darray == NULL);
+
+	T_CHECK(darray->array != NULL);
+	T_CHECK(darray->flags == DARRAY_ALIGNED);
+	T_CHECK(((uintptr_t)darray->array % CACHE_LINE_SIZE) == 0);
+
+	/* alignment has to survive every grow and shrink */
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		const S val = { i, 0 };
+		T_EXPECT(darray_insert(darray, &val), 0);
+		T_CHECK(((uintptr_t)darray->array % CACHE_LINE_SIZE) == 0);
+	}
+
+	for (int64_t i = 999; i > 0; --i)
+	{
+		S val_out = {0};
+		T_EXPECT(darray_delete(darray, &val_out), 0);
+		T_CHECK(val_out.a == i);
+		T_CHECK(((uintptr_t)darray->array % CACHE_LINE_SIZE) == 0);
+	}
+
+	for (size_t index = 0; index < (size_t)darray_get_num_entries(darray); ++index)
+	{
+		S val_out = {0};
+		T_EXPECT(darray_get_data(darray, &val_out, index), 0);
+		T_CHECK(val_out.a == (int64_t)index);
+	}
+
+	darray_destroy(darray);
+
+	const size_t big_size = (DARRAY_HUGEPAGE_THRESHOLD / sizeof(S)) + 1;
+
+	darray = darray_create_with_flags(DARRAY_UNSORTED, sizeof(S), big_size, compare, NULL, DARRAY_HUGEPAGE);
+	T_ERROR(darray == NULL);
+
+	T_CHECK(((uintptr_t)darray->array % HUGE_PAGE_SIZE) == 0);
+
+	darray_destroy(darray);
+}
+
+
+static void test_open_mmap_darray(void)
+{
+	char path[] = "/tmp/darray_tests_XXXXXX";
+	const int fd = mkstemp(path);
+	T_ERROR(fd < 0);
+	(void)close(fd);
+
+	const size_t entries = 1000;
+
+	Darray *darray = darray_open_mmap(path, DARRAY_SORTED, sizeof(S), compare, NULL);
+	T_ERROR(darray == NULL);
+
+	T_CHECK(darray->num_entries == 0);
+	T_CHECK(darray->flags == DARRAY_MMAP);
+
+	S val_out = {0};
+	T_EXPECT(darray_delete(darray, &val_out), -1);
+
+	/* reversed order to force memmove in sorted insert */
+	for (size_t i = 0; i < entries; ++i)
+	{
+		const S val = { 0, (int64_t)(entries - i - 1) };
+		T_EXPECT(darray_insert(darray, &val), 0);
+	}
+
+	T_EXPECT(darray_sync(darray), 0);
+	darray_destroy(darray);
+
+	/* wrong size_of or type */
+	T_ASSERT(darray_open_mmap(path, DARRAY_SORTED, sizeof(int64_t), compare, NULL), NULL);
+	T_ASSERT(darray_open_mmap(path, DARRAY_UNSORTED, sizeof(S), compare, NULL), NULL);
+
+	darray = darray_open_mmap(path, DARRAY_SORTED, sizeof(S), compare, NULL);
+	T_ERROR(darray == NULL);
+
+	T_CHECK(darray->num_entries == entries);
+
+	for (size_t index = 0; index < entries; ++index)
+	{
+		T_EXPECT(darray_get_data(darray, &val_out, index), 0);
+		T_CHECK(val_out.b == (int64_t)index);
+	}
+
+	for (size_t i = 0; i < entries / 2; ++i)
+		T_EXPECT(darray_delete(darray, NULL), 0);
+
+	darray_destroy(darray);
+
+	darray = darray_open_mmap(path, DARRAY_SORTED, sizeof(S), compare, NULL);
+	T_ERROR(darray == NULL);
+
+	T_CHECK(darray->num_entries == entries / 2);
+	T_EXPECT(darray_get_data(darray, &val_out, entries / 2 - 1), 0);
+	T_CHECK(val_out.b == (int64_t)(entries / 2 - 1));
+
+	darray_destroy(darray);
+
+	T_EXPECT(darray_sync(NULL), -1);
+	T_ASSERT(darray_open_mmap(NULL, DARRAY_SORTED, sizeof(S), compare, NULL), NULL);
+	T_ASSERT(darray_open_mmap(path, DARRAY_SORTED, sizeof(S), NULL, NULL), NULL);
+
+	(void)unlink(path);
+
+	/* unsorted darray doesn't need compare function */
+	darray = darray_open_mmap(path, DARRAY_UNSORTED, sizeof(S), NULL, NULL);
+	T_ERROR(darray == NULL);
+
+	for (size_t i = 0; i < entries; ++i)
+	{
+		const S val = { (int64_t)i, 0 };
+		T_EXPECT(darray_insert(darray, &val), 0);
+	}
+
+	darray_destroy(darray);
+
+	darray = darray_open_mmap(path, DARRAY_UNSORTED, sizeof(S), NULL, NULL);
+	T_ERROR(darray == NULL);
+
+	T_CHECK(darray->num_entries == entries);
+	T_EXPECT(darray_get_data(darray, &val_out, entries - 1), 0);
+	T_CHECK(val_out.a == (int64_t)(entries - 1));
+
+	darray_destroy(darray);
+
+	(void)unlink(path);
+}
+
+
 static void test_insert_sorted_darray(void)
 {
 	Darray *darray = darray_create(DARRAY_SORTED, sizeof(S), (size_t)9, compare, NULL);
@@ -789,10 +923,171 @@ static void test_darray_sort(void)
 	darray_destroy(darray);
 }
 
+static void test_create_fixed_darray(void)
+{
+	S buffer[4];
+
+	Darray *darray = darray_create_fixed(DARRAY_SORTED, sizeof(S), ARRAY_SIZE(buffer), (void *)&buffer[0], compare, NULL);
+	T_ERROR(darray == NULL);
+
+	T_CHECK(darray->array == (void *)&buffer[0]);
+	T_CHECK(darray->flags == (DARRAY_FIXED | DARRAY_EXTERNAL));
+	T_CHECK(darray->size == ARRAY_SIZE(buffer));
+
+	for (int64_t i = (int64_t)ARRAY_SIZE(buffer) - 1; i >= 0; --i)
+	{
+		const S val = { i, 0 };
+		T_EXPECT(darray_insert(darray, &val), 0);
+	}
+
+	/* full fixed darray doesn't grow */
+	const S val = { 100, 0 };
+	T_CHECK(darray_insert(darray, &val) != 0);
+	T_CHECK(darray->array == (void *)&buffer[0]);
+
+	for (size_t index = 0; index < ARRAY_SIZE(buffer); ++index)
+		T_CHECK(buffer[index].a == (int64_t)index);
+
+	/* and doesn't shrink */
+	for (size_t index = 0; index < ARRAY_SIZE(buffer); ++index)
+		T_EXPECT(darray_delete(darray, NULL), 0);
+
+	T_CHECK(darray->array == (void *)&buffer[0]);
+	T_CHECK(darray->size == ARRAY_SIZE(buffer));
+
+	darray_destroy(darray);
+
+	/* array embedded in darray */
+	darray = darray_create_fixed(DARRAY_UNSORTED, sizeof(S), (size_t)1000, NULL, NULL, NULL);
+	T_ERROR(darray == NULL);
+
+	for (int64_t i = 0; i < 1000; ++i)
+	{
+		const S entry = { i, 0 };
+		T_EXPECT(darray_insert(darray, &entry), 0);
+	}
+
+	T_CHECK(darray_insert(darray, &val) != 0);
+	T_EXPECT(darray_search_min(darray, NULL), (ssize_t)-1);
+
+	darray_destroy(darray);
+
+	T_CHECK(darray_create_fixed(DARRAY_SORTED, sizeof(S), (size_t)10, NULL, NULL, NULL) == NULL);
+	T_CHECK(darray_create_fixed(DARRAY_UNSORTED, sizeof(S), (size_t)0, NULL, NULL, NULL) == NULL);
+	T_CHECK(darray_create_fixed(DARRAY_UNSORTED, (size_t)0, (size_t)10, NULL, NULL, NULL) == NULL);
+}
+
+static void test_create_inline_darray(void)
+{
+	Darray *darray = darray_create_inline(DARRAY_SORTED, sizeof(S), (size_t)4, compare, NULL);
+	T_ERROR(darray == NULL);
+
+	/* inline slots are in the same allocation as darray */
+	void *inline_array = darray->array;
+	T_CHECK(darray->flags == DARRAY_INLINE);
+	T_CHECK((char *)inline_array > (char *)darray && (char *)inline_array < (char *)darray + 2 * sizeof(Darray));
+
+	for (int64_t i = 3; i >= 0; --i)
+	{
+		const S val = { i, 0 };
+		T_EXPECT(darray_insert(darray, &val), 0);
+	}
+
+	T_CHECK(darray->array == inline_array);
+	T_CHECK(darray->size == 4);
+
+	/* inline darray doesn't shrink */
+	S val_out;
+	T_EXPECT(darray_delete(darray, &val_out), 0);
+	T_CHECK(val_out.a == 3);
+	T_CHECK(darray->array == inline_array);
+
+	/* spill to heap */
+	for (int64_t i = 3; i < 100; ++i)
+	{
+		const S val = { i, 0 };
+		T_EXPECT(darray_insert(darray, &val), 0);
+	}
+
+	T_CHECK(darray->array != inline_array);
+	T_CHECK((darray->flags & DARRAY_INLINE) == 0);
+	T_EXPECT(darray_get_num_entries(darray), (ssize_t)100);
+
+	for (size_t index = 0; index < 100; ++index)
+	{
+		T_EXPECT(darray_get_data(darray, &val_out, index), 0);
+		T_CHECK(val_out.a == (int64_t)index);
+	}
+
+	for (size_t index = 0; index < 99; ++index)
+		T_EXPECT(darray_delete(darray, NULL), 0);
+
+	darray_destroy(darray);
+
+	T_CHECK(darray_create_inline(DARRAY_SORTED, sizeof(S), (size_t)4, NULL, NULL) == NULL);
+	T_CHECK(darray_create_inline(DARRAY_UNSORTED, sizeof(S), (size_t)0, NULL, NULL) == NULL);
+	T_CHECK(darray_create_inline(DARRAY_UNSORTED, (size_t)0, (size_t)4, NULL, NULL) == NULL);
+}
+
+static void test_init_darray(void)
+{
+	Darray darray;
+	S buffer[8];
+
+	T_EXPECT(darray_init(&darray, DARRAY_UNSORTED, sizeof(S), (void *)&buffer[0], ARRAY_SIZE(buffer), NULL, NULL), 0);
+	T_CHECK(darray.flags == (DARRAY_STATIC | DARRAY_INLINE));
+
+	for (int64_t i = 0; i < 8; ++i)
+	{
+		const S val = { i, i };
+		T_EXPECT(darray_insert(&darray, &val), 0);
+	}
+
+	T_CHECK(darray.array == (void *)&buffer[0]);
+
+	/* spill to heap, darray stays on stack */
+	const S val = { 8, 8 };
+	T_EXPECT(darray_insert(&darray, &val), 0);
+	T_CHECK(darray.array != (void *)&buffer[0]);
+	T_CHECK(darray.flags == DARRAY_STATIC);
+
+	for (size_t index = 0; index < 9; ++index)
+	{
+		S val_out;
+		T_EXPECT(darray_get_data(&darray, &val_out, index), 0);
+		T_CHECK(val_out.a == (int64_t)index && val_out.b == (int64_t)index);
+	}
+
+	/* frees only heap array */
+	darray_destroy(&darray);
+
+	/* without buffer */
+	T_EXPECT(darray_init(&darray, DARRAY_SORTED, sizeof(S), NULL, (size_t)0, compare, NULL), 0);
+	T_CHECK(darray.array == NULL);
+
+	for (int64_t i = 99; i >= 0; --i)
+	{
+		const S entry = { i, 0 };
+		T_EXPECT(darray_insert(&darray, &entry), 0);
+	}
+
+	T_EXPECT(darray_search_min(&darray, NULL), (ssize_t)0);
+	T_EXPECT(darray_search_max(&darray, NULL), (ssize_t)99);
+	T_EXPECT(darray_get_num_entries(&darray), (ssize_t)100);
+
+	darray_destroy(&darray);
+
+	T_EXPECT(darray_init(NULL, DARRAY_UNSORTED, sizeof(S), NULL, (size_t)0, NULL, NULL), -1);
+	T_EXPECT(darray_init(&darray, DARRAY_SORTED, sizeof(S), NULL, (size_t)0, NULL, NULL), -1);
+	T_EXPECT(darray_init(&darray, DARRAY_UNSORTED, sizeof(S), (void *)&buffer[0], (size_t)0, NULL, NULL), -1);
+}
+
 int main(void)
 {
 	TEST_INIT("TESTING DYNAMIC ARRAY");
 	TEST(test_create_and_delete_darray());
+	TEST(test_create_with_flags_darray());
+	TEST(test_open_mmap_darray());
 	TEST(test_insert_sorted_darray());
 	TEST(test_insert_unsorted_darray());
 	TEST(test_delete_sorted_unsorted_darray());
@@ -803,6 +1098,9 @@ int main(void)
 	TEST(test_darray_search_min());
 	TEST(test_darray_search_max());
 	TEST(test_darray_sort());
+	TEST(test_create_fixed_darray());
+	TEST(test_create_inline_darray());
+	TEST(test_init_darray());
 	TEST_SUMMARY();
 
 	return 0;
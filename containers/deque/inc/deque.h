@@ -0,0 +1,419 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+
+/*
+    Double ended queue implementation (growable ring buffer)
+
+    Entries are kept in one array which size is power of 2, so index is
+    wrapped by mask instead of modulo. Push and pop at both ends are O(1),
+    array grows by 2 when full and shrinks by 2 when only quarter is used.
+    Queue (FIFO) is deque used only from back (enqueue) to front (dequeue).
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <stddef.h> /* size_t */
+#include <stdbool.h> /* bool */
+#include <sys/types.h> /* ssize_t */
+#include <common.h> /* destructor_f */
+
+
+/* array is never smaller than this (power of 2) */
+#ifndef DEQUE_MIN_SIZE
+#define DEQUE_MIN_SIZE ((size_t)8)
+#endif
+
+
+typedef struct Deque
+{
+    void *array;              /* main array (ring) */
+    destructor_f destroy_f;   /* pointer to destroy function */
+
+    size_t size_of;           /* size of element */
+    size_t num_entries;       /* number of entries in deque */
+    size_t size;              /* current allocated size of array (power of 2) */
+    size_t head;              /* index of first entry in array */
+} Deque;
+
+
+typedef Deque Queue;
+
+
+/*
+    Create new instance of deque.
+
+    PARAMS:
+    @IN size_of - size of element.
+    @IN size - beggining size of deque (rounded up to power of 2).
+    @IN destroy_f - pointer to destroy function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to deque if success.
+*/
+Deque *deque_create(size_t size_of, size_t size, destructor_f destroy_f);
+
+
+/*
+    Deallocate deque.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+
+    RETURN:
+    %This is void function.
+*/
+void deque_destroy(Deque *deque);
+
+
+/*
+    Deallocate deque with all entries (destroy_f is called for each entry).
+
+    PARAMS:
+    @IN deque - pointer to deque.
+
+    RETURN:
+    %This is void function.
+*/
+void deque_destroy_with_entries(Deque *deque);
+
+
+/*
+    Insert entry at the front of deque.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int deque_push_front(Deque * __restrict__ deque, const void * __restrict__ entry);
+
+
+/*
+    Insert entry at the back of deque.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int deque_push_back(Deque * __restrict__ deque, const void * __restrict__ entry);
+
+
+/*
+    Delete entry from the front of deque.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @OUT val_out - deleted entry (can be NULL).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (or deque is empty).
+*/
+int deque_pop_front(Deque * __restrict__ deque, void * __restrict__ val_out);
+
+
+/*
+    Delete entry from the back of deque.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @OUT val_out - deleted entry (can be NULL).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (or deque is empty).
+*/
+int deque_pop_back(Deque * __restrict__ deque, void * __restrict__ val_out);
+
+
+/*
+    Insert @num entries from @entries at the back of deque.
+    Array grows at most once and entries are copied by at most two memcpy.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @IN entries - array of entries.
+    @IN num - number of entries.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (nothing is inserted).
+*/
+int deque_push_back_batch(Deque * __restrict__ deque, const void * __restrict__ entries, size_t num);
+
+
+/*
+    Delete up to @num entries from the front of deque.
+    Entries are copied by at most two memcpy.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @OUT val_out - array for at least @num entries (can be NULL).
+    @IN num - max number of entries to delete.
+
+    RETURN:
+    %number of deleted entries if success.
+    %-1 if failure.
+*/
+ssize_t deque_pop_front_batch(Deque * __restrict__ deque, void * __restrict__ val_out, size_t num);
+
+
+/*
+    Get entry from the front of deque.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @OUT val_out - front entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (or deque is empty).
+*/
+int deque_get_front(const Deque * __restrict__ deque, void * __restrict__ val_out);
+
+
+/*
+    Get entry from the back of deque.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @OUT val_out - back entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (or deque is empty).
+*/
+int deque_get_back(const Deque * __restrict__ deque, void * __restrict__ val_out);
+
+
+/*
+    Get entry at position @pos counted from the front of deque.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @OUT val_out - entry.
+    @IN pos - position from front.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int deque_get_data(const Deque * __restrict__ deque, void * __restrict__ val_out, size_t pos);
+
+
+/*
+    Check if deque is empty.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+
+    RETURN:
+    %TRUE if deque is empty.
+    %FALSE if is not empty or failure.
+*/
+bool deque_is_empty(const Deque *deque);
+
+
+/*
+    Get number of entries.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+
+    RETURN:
+    %number of entries if success.
+    %-1 if failure.
+*/
+ssize_t deque_get_num_entries(const Deque *deque);
+
+
+/*
+    Get size of array.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+
+    RETURN:
+    %size of array if success.
+    %-1 if failure.
+*/
+ssize_t deque_get_size(const Deque *deque);
+
+
+/*
+    Get size of data.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+
+    RETURN:
+    %sizeof if success.
+    %-1 if failure.
+*/
+ssize_t deque_get_data_size(const Deque *deque);
+
+
+/*
+    Create new instance of queue (FIFO).
+
+    PARAMS:
+    @IN size_of - size of element.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to queue if success.
+*/
+static inline Queue *queue_create(size_t size_of)
+{
+    return deque_create(size_of, 0, NULL);
+}
+
+
+/*
+    Deallocate queue.
+
+    PARAMS:
+    @IN queue - pointer to queue.
+
+    RETURN:
+    %This is void function.
+*/
+static inline void queue_destroy(Queue *queue)
+{
+    deque_destroy(queue);
+}
+
+
+/*
+    Insert entry at the end of queue.
+
+    PARAMS:
+    @IN queue - pointer to queue.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static inline int queue_enqueue(Queue * __restrict__ queue, const void * __restrict__ entry)
+{
+    return deque_push_back(queue, entry);
+}
+
+
+/*
+    Delete first entry from queue.
+
+    PARAMS:
+    @IN queue - pointer to queue.
+    @OUT val_out - deleted entry (can be NULL).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (or queue is empty).
+*/
+static inline int queue_dequeue(Queue * __restrict__ queue, void * __restrict__ val_out)
+{
+    return deque_pop_front(queue, val_out);
+}
+
+
+/*
+    Insert @num entries at the end of queue.
+
+    PARAMS:
+    @IN queue - pointer to queue.
+    @IN entries - array of entries.
+    @IN num - number of entries.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static inline int queue_enqueue_batch(Queue * __restrict__ queue, const void * __restrict__ entries, size_t num)
+{
+    return deque_push_back_batch(queue, entries, num);
+}
+
+
+/*
+    Delete up to @num first entries from queue.
+
+    PARAMS:
+    @IN queue - pointer to queue.
+    @OUT val_out - array for at least @num entries (can be NULL).
+    @IN num - max number of entries to delete.
+
+    RETURN:
+    %number of deleted entries if success.
+    %-1 if failure.
+*/
+static inline ssize_t queue_dequeue_batch(Queue * __restrict__ queue, void * __restrict__ val_out, size_t num)
+{
+    return deque_pop_front_batch(queue, val_out, num);
+}
+
+
+/*
+    Get first entry from queue.
+
+    PARAMS:
+    @IN queue - pointer to queue.
+    @OUT val_out - first entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (or queue is empty).
+*/
+static inline int queue_get_head(const Queue * __restrict__ queue, void * __restrict__ val_out)
+{
+    return deque_get_front(queue, val_out);
+}
+
+
+/*
+    Check if queue is empty.
+
+    PARAMS:
+    @IN queue - pointer to queue.
+
+    RETURN:
+    %TRUE if queue is empty.
+    %FALSE if is not empty or failure.
+*/
+static inline bool queue_is_empty(const Queue *queue)
+{
+    return deque_is_empty(queue);
+}
+
+
+/*
+    Get number of entries.
+
+    PARAMS:
+    @IN queue - pointer to queue.
+
+    RETURN:
+    %number of entries if success.
+    %-1 if failure.
+*/
+static inline ssize_t queue_get_num_entries(const Queue *queue)
+{
+    return deque_get_num_entries(queue);
+}
+
+
+#endif /* DEQUE_H */
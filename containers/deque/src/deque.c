@@ -0,0 +1,428 @@
+#include <deque.h>
+#include <common.h>
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memcpy */
+
+
+#define RATIO ((size_t)2)
+
+
+/*
+    Round @size up to power of 2 (at least DEQUE_MIN_SIZE).
+
+    PARAMS:
+    @IN size - requested size.
+
+    RETURN:
+    %0 if @size is too big.
+    %Rounded size if success.
+*/
+static size_t __deque_round_size(size_t size);
+
+
+/*
+    Get pointer to entry at position @pos counted from front.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @IN pos - position from front (can be equal to num_entries).
+
+    RETURN:
+    %Pointer to entry in array.
+*/
+static ___inline___ void *__deque_entry(const Deque *deque, size_t pos);
+
+
+/*
+    Copy @num entries starting at position @pos to contiguous @dst.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @OUT dst - destination array.
+    @IN pos - position from front.
+    @IN num - number of entries.
+
+    RETURN:
+    %This is void function.
+*/
+static void __deque_copy_out(const Deque * __restrict__ deque, void * __restrict__ dst, size_t pos, size_t num);
+
+
+/*
+    Copy @num entries from contiguous @src to deque starting at position @pos.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @IN src - source array.
+    @IN pos - position from front.
+    @IN num - number of entries.
+
+    RETURN:
+    %This is void function.
+*/
+static void __deque_copy_in(Deque * __restrict__ deque, const void * __restrict__ src, size_t pos, size_t num);
+
+
+/*
+    Move entries to new array of @size entries, front lands at index 0.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @IN size - new size of array (power of 2, >= num_entries).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __deque_resize(Deque *deque, size_t size);
+
+
+/*
+    Make place for @num new entries.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+    @IN num - number of new entries.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __deque_resize_insert(Deque *deque, size_t num);
+
+
+/*
+    Shrink array when only quarter of it is used.
+
+    PARAMS:
+    @IN deque - pointer to deque.
+
+    RETURN:
+    %This is void function.
+*/
+static void __deque_resize_delete(Deque *deque);
+
+
+static size_t __deque_round_size(size_t size)
+{
+    size_t rounded = DEQUE_MIN_SIZE;
+
+    while (rounded < size)
+    {
+        if (rounded > SIZE_MAX / RATIO)
+            return 0;
+
+        rounded *= RATIO;
+    }
+
+    return rounded;
+}
+
+
+static ___inline___ void *__deque_entry(const Deque *deque, size_t pos)
+{
+    return (void *)((BYTE *)deque->array + ((deque->head + pos) & (deque->size - 1)) * deque->size_of);
+}
+
+
+static void __deque_copy_out(const Deque * __restrict__ deque, void * __restrict__ dst, size_t pos, size_t num)
+{
+    const size_t start = (deque->head + pos) & (deque->size - 1);
+    const size_t first = MIN(num, deque->size - start);
+
+    (void)memcpy(dst, (BYTE *)deque->array + start * deque->size_of, first * deque->size_of);
+    (void)memcpy((BYTE *)dst + first * deque->size_of, deque->array, (num - first) * deque->size_of);
+}
+
+
+static void __deque_copy_in(Deque * __restrict__ deque, const void * __restrict__ src, size_t pos, size_t num)
+{
+    const size_t start = (deque->head + pos) & (deque->size - 1);
+    const size_t first = MIN(num, deque->size - start);
+
+    (void)memcpy((BYTE *)deque->array + start * deque->size_of, src, first * deque->size_of);
+    (void)memcpy(deque->array, (const BYTE *)src + first * deque->size_of, (num - first) * deque->size_of);
+}
+
+
+static int __deque_resize(Deque *deque, size_t size)
+{
+    void *array = malloc(size * deque->size_of);
+
+    if (array == NULL)
+        ERROR("malloc error\n", -1);
+
+    __deque_copy_out(deque, array, 0, deque->num_entries);
+
+    FREE(deque->array);
+    deque->array = array;
+    deque->size = size;
+    deque->head = 0;
+
+    return 0;
+}
+
+
+static int __deque_resize_insert(Deque *deque, size_t num)
+{
+    if (num > SIZE_MAX - deque->num_entries)
+        ERROR("too many entries\n", -1);
+
+    if (deque->num_entries + num <= deque->size)
+        return 0;
+
+    const size_t size = __deque_round_size(deque->num_entries + num);
+
+    if (size == 0 || size > SIZE_MAX / deque->size_of)
+        ERROR("too many entries\n", -1);
+
+    return __deque_resize(deque, size);
+}
+
+
+static void __deque_resize_delete(Deque *deque)
+{
+    if (deque->size <= DEQUE_MIN_SIZE || deque->num_entries > deque->size / (2 * RATIO))
+        return;
+
+    /* deque is still valid with bigger array */
+    (void)__deque_resize(deque, deque->size / RATIO);
+}
+
+
+Deque *deque_create(size_t size_of, size_t size, destructor_f destroy_f)
+{
+    if (size_of < 1)
+        ERROR("size_of < 1\n", NULL);
+
+    size = __deque_round_size(size);
+
+    if (size == 0 || size > SIZE_MAX / size_of)
+        ERROR("size is too big\n", NULL);
+
+    Deque *deque = (Deque *)malloc(sizeof(*deque));
+
+    if (deque == NULL)
+        ERROR("malloc error\n", NULL);
+
+    deque->array = malloc(size * size_of);
+
+    if (deque->array == NULL)
+    {
+        FREE(deque);
+        ERROR("malloc error\n", NULL);
+    }
+
+    deque->destroy_f = destroy_f;
+    deque->size_of = size_of;
+    deque->num_entries = 0;
+    deque->size = size;
+    deque->head = 0;
+
+    return deque;
+}
+
+
+void deque_destroy(Deque *deque)
+{
+    if (deque == NULL)
+        return;
+
+    FREE(deque->array);
+    FREE(deque);
+}
+
+
+void deque_destroy_with_entries(Deque *deque)
+{
+    if (deque == NULL)
+        return;
+
+    if (deque->destroy_f != NULL)
+        for (size_t i = 0; i < deque->num_entries; ++i)
+            deque->destroy_f(__deque_entry(deque, i));
+
+    deque_destroy(deque);
+}
+
+
+int deque_push_front(Deque * __restrict__ deque, const void * __restrict__ entry)
+{
+    if (deque == NULL || entry == NULL)
+        ERROR("deque == NULL || entry == NULL\n", -1);
+
+    if (__deque_resize_insert(deque, 1) != 0)
+        ERROR("__deque_resize_insert error\n", -1);
+
+    deque->head = (deque->head - 1) & (deque->size - 1);
+    (void)memcpy(__deque_entry(deque, 0), entry, deque->size_of);
+    ++deque->num_entries;
+
+    return 0;
+}
+
+
+int deque_push_back(Deque * __restrict__ deque, const void * __restrict__ entry)
+{
+    if (deque == NULL || entry == NULL)
+        ERROR("deque == NULL || entry == NULL\n", -1);
+
+    if (__deque_resize_insert(deque, 1) != 0)
+        ERROR("__deque_resize_insert error\n", -1);
+
+    (void)memcpy(__deque_entry(deque, deque->num_entries), entry, deque->size_of);
+    ++deque->num_entries;
+
+    return 0;
+}
+
+
+int deque_pop_front(Deque * __restrict__ deque, void * __restrict__ val_out)
+{
+    if (deque == NULL)
+        ERROR("deque == NULL\n", -1);
+
+    if (deque->num_entries == 0)
+        ERROR("deque is empty\n", -1);
+
+    if (val_out != NULL)
+        (void)memcpy(val_out, __deque_entry(deque, 0), deque->size_of);
+
+    deque->head = (deque->head + 1) & (deque->size - 1);
+    --deque->num_entries;
+
+    __deque_resize_delete(deque);
+
+    return 0;
+}
+
+
+int deque_pop_back(Deque * __restrict__ deque, void * __restrict__ val_out)
+{
+    if (deque == NULL)
+        ERROR("deque == NULL\n", -1);
+
+    if (deque->num_entries == 0)
+        ERROR("deque is empty\n", -1);
+
+    --deque->num_entries;
+
+    if (val_out != NULL)
+        (void)memcpy(val_out, __deque_entry(deque, deque->num_entries), deque->size_of);
+
+    __deque_resize_delete(deque);
+
+    return 0;
+}
+
+
+int deque_push_back_batch(Deque * __restrict__ deque, const void * __restrict__ entries, size_t num)
+{
+    if (deque == NULL || entries == NULL)
+        ERROR("deque == NULL || entries == NULL\n", -1);
+
+    if (__deque_resize_insert(deque, num) != 0)
+        ERROR("__deque_resize_insert error\n", -1);
+
+    __deque_copy_in(deque, entries, deque->num_entries, num);
+    deque->num_entries += num;
+
+    return 0;
+}
+
+
+ssize_t deque_pop_front_batch(Deque * __restrict__ deque, void * __restrict__ val_out, size_t num)
+{
+    if (deque == NULL)
+        ERROR("deque == NULL\n", -1);
+
+    num = MIN(num, deque->num_entries);
+
+    if (val_out != NULL)
+        __deque_copy_out(deque, val_out, 0, num);
+
+    deque->head = (deque->head + num) & (deque->size - 1);
+    deque->num_entries -= num;
+
+    __deque_resize_delete(deque);
+
+    return (ssize_t)num;
+}
+
+
+int deque_get_front(const Deque * __restrict__ deque, void * __restrict__ val_out)
+{
+    if (deque == NULL || val_out == NULL)
+        ERROR("deque == NULL || val_out == NULL\n", -1);
+
+    if (deque->num_entries == 0)
+        ERROR("deque is empty\n", -1);
+
+    (void)memcpy(val_out, __deque_entry(deque, 0), deque->size_of);
+
+    return 0;
+}
+
+
+int deque_get_back(const Deque * __restrict__ deque, void * __restrict__ val_out)
+{
+    if (deque == NULL || val_out == NULL)
+        ERROR("deque == NULL || val_out == NULL\n", -1);
+
+    if (deque->num_entries == 0)
+        ERROR("deque is empty\n", -1);
+
+    (void)memcpy(val_out, __deque_entry(deque, deque->num_entries - 1), deque->size_of);
+
+    return 0;
+}
+
+
+int deque_get_data(const Deque * __restrict__ deque, void * __restrict__ val_out, size_t pos)
+{
+    if (deque == NULL || val_out == NULL)
+        ERROR("deque == NULL || val_out == NULL\n", -1);
+
+    if (pos >= deque->num_entries)
+        ERROR("pos >= deque->num_entries\n", -1);
+
+    (void)memcpy(val_out, __deque_entry(deque, pos), deque->size_of);
+
+    return 0;
+}
+
+
+bool deque_is_empty(const Deque *deque)
+{
+    if (deque == NULL)
+        ERROR("deque == NULL\n", false);
+
+    return deque->num_entries == 0;
+}
+
+
+ssize_t deque_get_num_entries(const Deque *deque)
+{
+    if (deque == NULL)
+        ERROR("deque == NULL\n", -1);
+
+    return (ssize_t)deque->num_entries;
+}
+
+
+ssize_t deque_get_size(const Deque *deque)
+{
+    if (deque == NULL)
+        ERROR("deque == NULL\n", -1);
+
+    return (ssize_t)deque->size;
+}
+
+
+ssize_t deque_get_data_size(const Deque *deque)
+{
+    if (deque == NULL)
+        ERROR("deque == NULL\n", -1);
+
+    return (ssize_t)deque->size_of;
+}
@@ -0,0 +1,358 @@
+#include <deque.h>
+#include <ctest.h>
+#include <stdint.h>
+
+
+typedef struct MyStruct
+{
+    int64_t key;
+    int64_t a;
+    int64_t *ptr;
+} MyStruct;
+
+
+/* functions needed for testing */
+static void my_struct_destroy(void *ms);
+
+
+/* unit tests function declaraions */
+static void test_deque_create(void);
+static void test_deque_push_pop_back(void);
+static void test_deque_push_pop_front(void);
+static void test_deque_wrap_around(void);
+static void test_deque_batch(void);
+static void test_deque_with_entries(void);
+static void test_queue(void);
+
+
+/* implementation */
+static void my_struct_destroy(void *ms)
+{
+    FREE(((MyStruct *)ms)->ptr);
+}
+
+
+static void test_deque_create(void)
+{
+    Deque *deque = deque_create(sizeof(int), 0, NULL);
+    T_ERROR(deque == NULL);
+
+    T_EXPECT(deque_is_empty(deque), (bool)true);
+    T_EXPECT(deque_get_num_entries(deque), (ssize_t)0);
+    T_EXPECT(deque_get_size(deque), (ssize_t)DEQUE_MIN_SIZE);
+    T_EXPECT(deque_get_data_size(deque), (ssize_t)sizeof(int));
+
+    deque_destroy(deque);
+
+    /* size is rounded to power of 2 */
+    deque = deque_create(sizeof(int), 100, NULL);
+    T_ERROR(deque == NULL);
+
+    T_EXPECT(deque_get_size(deque), (ssize_t)128);
+
+    deque_destroy(deque);
+
+    T_ASSERT(deque_create(0, 10, NULL), NULL);
+    T_ASSERT(deque_create(sizeof(int), SIZE_MAX, NULL), NULL);
+
+    T_EXPECT(deque_is_empty(NULL), (bool)false);
+    T_EXPECT(deque_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(deque_get_size(NULL), (ssize_t)-1);
+    T_EXPECT(deque_get_data_size(NULL), (ssize_t)-1);
+}
+
+
+static void test_deque_push_pop_back(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t val = 0;
+
+    Deque *deque = deque_create(sizeof(int64_t), 0, NULL);
+    T_ERROR(deque == NULL);
+
+    T_CHECK(deque_pop_back(deque, (void *)&val) != 0);
+    T_CHECK(deque_get_back(deque, (void *)&val) != 0);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(deque_push_back(deque, (void *)&i), 0);
+        T_EXPECT(deque_get_back(deque, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    T_EXPECT(deque_get_num_entries(deque), (ssize_t)ARRAY_TEST_SIZE);
+    T_EXPECT(deque_get_size(deque), (ssize_t)1024);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(deque_get_data(deque, (void *)&val, (size_t)i), 0);
+        T_ASSERT(val, i);
+    }
+
+    T_CHECK(deque_get_data(deque, (void *)&val, ARRAY_TEST_SIZE) != 0);
+
+    for (int64_t i = ARRAY_TEST_SIZE - 1; i >= 0; --i)
+    {
+        T_EXPECT(deque_pop_back(deque, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    /* array shrinks back */
+    T_EXPECT(deque_is_empty(deque), (bool)true);
+    T_EXPECT(deque_get_size(deque), (ssize_t)DEQUE_MIN_SIZE);
+
+    T_CHECK(deque_push_back(NULL, (void *)&val) != 0);
+    T_CHECK(deque_push_back(deque, NULL) != 0);
+    T_CHECK(deque_pop_back(NULL, (void *)&val) != 0);
+    T_CHECK(deque_get_back(deque, NULL) != 0);
+
+    deque_destroy(deque);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_deque_push_pop_front(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t val = 0;
+
+    Deque *deque = deque_create(sizeof(int64_t), 0, NULL);
+    T_ERROR(deque == NULL);
+
+    T_CHECK(deque_pop_front(deque, (void *)&val) != 0);
+    T_CHECK(deque_get_front(deque, (void *)&val) != 0);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(deque_push_front(deque, (void *)&i), 0);
+        T_EXPECT(deque_get_front(deque, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    /* front is the last pushed entry, back is the first */
+    T_EXPECT(deque_get_back(deque, (void *)&val), 0);
+    T_ASSERT(val, (int64_t)0);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(deque_get_data(deque, (void *)&val, (size_t)i), 0);
+        T_ASSERT(val, ARRAY_TEST_SIZE - 1 - i);
+    }
+
+    /* FIFO from back to front */
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(deque_pop_back(deque, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    T_EXPECT(deque_is_empty(deque), (bool)true);
+
+    T_CHECK(deque_push_front(NULL, (void *)&val) != 0);
+    T_CHECK(deque_push_front(deque, NULL) != 0);
+    T_CHECK(deque_pop_front(NULL, (void *)&val) != 0);
+    T_CHECK(deque_get_front(deque, NULL) != 0);
+
+    deque_destroy(deque);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_deque_wrap_around(void)
+{
+    int64_t val = 0;
+    int64_t next_in = 0;
+    int64_t next_out = 0;
+
+    Deque *deque = deque_create(sizeof(int64_t), 0, NULL);
+    T_ERROR(deque == NULL);
+
+    /* head runs around array many times, array grows when entries wrap */
+    for (size_t round = 0; round < 1000; ++round)
+    {
+        for (size_t i = 0; i < 5 + round % 7; ++i)
+        {
+            T_EXPECT(deque_push_back(deque, (void *)&next_in), 0);
+            ++next_in;
+        }
+
+        for (size_t i = 0; i < 4 + round % 5; ++i)
+        {
+            if (deque_is_empty(deque))
+                break;
+
+            T_EXPECT(deque_pop_front(deque, (void *)&val), 0);
+            T_ASSERT(val, next_out);
+            ++next_out;
+        }
+    }
+
+    T_EXPECT(deque_get_num_entries(deque), (ssize_t)(next_in - next_out));
+
+    for (int64_t i = next_out; i < next_in; ++i)
+    {
+        T_EXPECT(deque_pop_front(deque, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    T_EXPECT(deque_is_empty(deque), (bool)true);
+
+    deque_destroy(deque);
+}
+
+
+static void test_deque_batch(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    int64_t arr[ARRAY_TEST_SIZE];
+    int64_t out[ARRAY_TEST_SIZE];
+    int64_t val = 0;
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)i;
+
+    Deque *deque = deque_create(sizeof(int64_t), 16, NULL);
+    T_ERROR(deque == NULL);
+
+    /* move head to the middle, so batch wraps */
+    for (int64_t i = 0; i < 10; ++i)
+        T_EXPECT(deque_push_back(deque, (void *)&i), 0);
+
+    T_EXPECT(deque_pop_front_batch(deque, NULL, 10), (ssize_t)10);
+
+    T_EXPECT(deque_push_back_batch(deque, (void *)&arr[0], 12), 0);
+    T_EXPECT(deque_get_size(deque), (ssize_t)16);
+    T_EXPECT(deque_pop_front_batch(deque, (void *)&out[0], 5), (ssize_t)5);
+
+    for (size_t i = 0; i < 5; ++i)
+        T_ASSERT(out[i], arr[i]);
+
+    /* grows once */
+    T_EXPECT(deque_push_back_batch(deque, (void *)&arr[12], ARRAY_TEST_SIZE - 12), 0);
+    T_EXPECT(deque_get_num_entries(deque), (ssize_t)(ARRAY_TEST_SIZE - 5));
+    T_EXPECT(deque_get_size(deque), (ssize_t)128);
+
+    for (size_t i = 5; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(deque_get_data(deque, (void *)&val, i - 5), 0);
+        T_ASSERT(val, arr[i]);
+    }
+
+    /* pops no more than entries */
+    T_EXPECT(deque_pop_front_batch(deque, (void *)&out[0], ARRAY_TEST_SIZE), (ssize_t)(ARRAY_TEST_SIZE - 5));
+
+    for (size_t i = 5; i < ARRAY_TEST_SIZE; ++i)
+        T_ASSERT(out[i - 5], arr[i]);
+
+    T_EXPECT(deque_is_empty(deque), (bool)true);
+    T_EXPECT(deque_pop_front_batch(deque, (void *)&out[0], ARRAY_TEST_SIZE), (ssize_t)0);
+    T_EXPECT(deque_push_back_batch(deque, (void *)&arr[0], 0), 0);
+
+    T_CHECK(deque_push_back_batch(deque, NULL, 1) != 0);
+    T_CHECK(deque_push_back_batch(deque, (void *)&arr[0], SIZE_MAX) != 0);
+    T_EXPECT(deque_get_num_entries(deque), (ssize_t)0);
+    T_EXPECT(deque_pop_front_batch(NULL, (void *)&out[0], 1), (ssize_t)-1);
+
+    deque_destroy(deque);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_deque_with_entries(void)
+{
+    #define ARRAY_TEST_SIZE 20
+
+    MyStruct ms;
+
+    Deque *deque = deque_create(sizeof(MyStruct), 0, my_struct_destroy);
+    T_ERROR(deque == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        ms.key = i;
+        ms.a = 0;
+        ms.ptr = (int64_t *)malloc(sizeof(int64_t));
+        T_ERROR(ms.ptr == NULL);
+
+        if (i & 1)
+            T_EXPECT(deque_push_front(deque, (void *)&ms), 0);
+        else
+            T_EXPECT(deque_push_back(deque, (void *)&ms), 0);
+    }
+
+    T_EXPECT(deque_pop_front(deque, (void *)&ms), 0);
+    T_ASSERT(ms.key, (int64_t)(ARRAY_TEST_SIZE - 1));
+    my_struct_destroy((void *)&ms);
+
+    /* rest of entries freed by destroy_f */
+    deque_destroy_with_entries(deque);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_queue(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE];
+    int64_t val = 0;
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)i;
+
+    Queue *queue = queue_create(sizeof(int64_t));
+    T_ERROR(queue == NULL);
+
+    T_EXPECT(queue_is_empty(queue), (bool)true);
+    T_CHECK(queue_dequeue(queue, (void *)&val) != 0);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE / 2; ++i)
+        T_EXPECT(queue_enqueue(queue, (void *)&arr[i]), 0);
+
+    T_EXPECT(queue_enqueue_batch(queue, (void *)&arr[ARRAY_TEST_SIZE / 2], ARRAY_TEST_SIZE / 2), 0);
+    T_EXPECT(queue_get_num_entries(queue), (ssize_t)ARRAY_TEST_SIZE);
+
+    T_EXPECT(queue_get_head(queue, (void *)&val), 0);
+    T_ASSERT(val, (int64_t)0);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE / 2; ++i)
+    {
+        T_EXPECT(queue_dequeue(queue, (void *)&val), 0);
+        T_ASSERT(val, arr[i]);
+    }
+
+    int64_t out[ARRAY_TEST_SIZE / 2];
+    T_EXPECT(queue_dequeue_batch(queue, (void *)&out[0], ARRAY_SIZE(out)), (ssize_t)ARRAY_SIZE(out));
+
+    for (size_t i = 0; i < ARRAY_SIZE(out); ++i)
+        T_ASSERT(out[i], arr[ARRAY_TEST_SIZE / 2 + i]);
+
+    T_EXPECT(queue_is_empty(queue), (bool)true);
+
+    queue_destroy(queue);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING DEQUE");
+    TEST(test_deque_create());
+    TEST(test_deque_push_pop_back());
+    TEST(test_deque_push_pop_front());
+    TEST(test_deque_wrap_around());
+    TEST(test_deque_batch());
+    TEST(test_deque_with_entries());
+    TEST(test_queue());
+    TEST_SUMMARY();
+
+    return 0;
+}
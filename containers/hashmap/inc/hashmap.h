@@ -0,0 +1,257 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+
+/*
+    Generic hash map implementation (open addressing, SwissTable layout)
+
+    Every slot (key + value) has one control byte: EMPTY, DELETED or 7 low
+    bits of hash (h2) if slot is full. Control bytes of 16 slots (group) are
+    compared with h2 at once (SSE2 if available), so usually only one key
+    is compared per lookup. Probe sequence jumps by groups (triangular),
+    table is rehashed when 7/8 of slots are full or deleted.
+
+    Result of key_hash_f is mixed again, so even weak hash (like identity)
+    is spread well over table. Without key_hash_f bytes of key are hashed
+    by hash_bytes (hash.h).
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* int8_t */
+#include <stdbool.h> /* bool */
+#include <sys/types.h> /* ssize_t */
+#include <common.h> /* hash_f, compare_f, destructor_f */
+
+
+/* number of control bytes checked at once */
+#define HASHMAP_GROUP_WIDTH ((size_t)16)
+
+
+typedef struct Hashmap
+{
+    int8_t *ctrl;             /* control bytes (capacity + HASHMAP_GROUP_WIDTH, first group mirrored at the end) */
+    BYTE *slots;              /* slots, key with value after it */
+
+    hash_f key_hash_f;        /* pointer to hash function (NULL means hash_bytes of key) */
+    compare_f cmp_f;          /* pointer to compare function (NULL means memcmp of keys) */
+    destructor_f destroy_f;   /* pointer to destroy function (for value, for key if value_size is 0) */
+
+    size_t key_size;          /* size of key */
+    size_t value_size;        /* size of value */
+    size_t value_offset;      /* offset of value in slot */
+    size_t slot_size;         /* size of slot */
+
+    size_t capacity;          /* number of slots (power of 2) */
+    size_t num_entries;       /* number of entries in map */
+    size_t growth_left;       /* number of entries which can be inserted before rehash */
+} Hashmap;
+
+
+/*
+    Create new instance of hash map.
+
+    PARAMS:
+    @IN key_size - size of key.
+    @IN value_size - size of value (can be 0, then map is a set of keys).
+    @IN capacity - number of entries which can be inserted without rehash.
+    @IN key_hash_f - pointer to hash function of key or NULL to hash bytes.
+    @IN cmp_f - pointer to compare function of keys (0 if equal) or NULL to compare bytes.
+    @IN destroy_f - pointer to destroy function of value (of key if value_size is 0).
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to hash map if success.
+*/
+Hashmap *hashmap_create(size_t key_size, size_t value_size, size_t capacity, hash_f key_hash_f, compare_f cmp_f, destructor_f destroy_f);
+
+
+/*
+    Deallocate hash map.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+
+    RETURN:
+    %This is void function.
+*/
+void hashmap_destroy(Hashmap *map);
+
+
+/*
+    Deallocate hash map with all entries (destroy_f is called for each value,
+    or for each key if value_size is 0).
+
+    PARAMS:
+    @IN map - pointer to hash map.
+
+    RETURN:
+    %This is void function.
+*/
+void hashmap_destroy_with_entries(Hashmap *map);
+
+
+/*
+    Insert key with value to hash map. If key exists, value is replaced.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN key - pointer to key.
+    @IN value - pointer to value (can be NULL if value_size is 0).
+
+    RETURN:
+    %0 if key was inserted.
+    %1 if value of existing key was replaced.
+    %negative value if failure.
+*/
+int hashmap_insert(Hashmap * __restrict__ map, const void * __restrict__ key, const void * __restrict__ value);
+
+
+/*
+    Delete key with value from hash map.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN key - pointer to key.
+
+    RETURN:
+    %0 if success.
+    %1 if key doesn't exist.
+    %negative value if failure.
+*/
+int hashmap_delete(Hashmap * __restrict__ map, const void * __restrict__ key);
+
+
+/*
+    Delete key with value from hash map and call destroy_f for value
+    (for key if value_size is 0).
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN key - pointer to key.
+
+    RETURN:
+    %0 if success.
+    %1 if key doesn't exist.
+    %negative value if failure.
+*/
+int hashmap_delete_with_entry(Hashmap * __restrict__ map, const void * __restrict__ key);
+
+
+/*
+    Search value of key.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN key - pointer to key.
+    @OUT val_out - value of key (can be NULL).
+
+    RETURN:
+    %0 if key was found.
+    %1 if key doesn't exist.
+    %negative value if failure.
+*/
+int hashmap_search(const Hashmap * __restrict__ map, const void * __restrict__ key, void * __restrict__ val_out);
+
+
+/*
+    Check if key exists in hash map.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN key - pointer to key.
+
+    RETURN:
+    %TRUE if key exists.
+    %FALSE if key doesn't exist or failure.
+*/
+bool hashmap_key_exist(const Hashmap * __restrict__ map, const void * __restrict__ key);
+
+
+/*
+    Make place for @num_entries entries, so they can be inserted without rehash.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN num_entries - number of entries.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int hashmap_reserve(Hashmap *map, size_t num_entries);
+
+
+/*
+    Rebuild table with at least @capacity slots (and at least enough slots for
+    current entries). Deleted slots are dropped, so it can also shrink table.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN capacity - requested number of slots (0 means as small as possible).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int hashmap_rehash(Hashmap *map, size_t capacity);
+
+
+/*
+    Get number of entries.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+
+    RETURN:
+    %number of entries if success.
+    %-1 if failure.
+*/
+ssize_t hashmap_get_num_entries(const Hashmap *map);
+
+
+/*
+    Get number of slots.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+
+    RETURN:
+    %number of slots if success.
+    %-1 if failure.
+*/
+ssize_t hashmap_get_capacity(const Hashmap *map);
+
+
+/*
+    Get size of key.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+
+    RETURN:
+    %size of key if success.
+    %-1 if failure.
+*/
+ssize_t hashmap_get_key_size(const Hashmap *map);
+
+
+/*
+    Get size of value.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+
+    RETURN:
+    %size of value if success.
+    %-1 if failure.
+*/
+ssize_t hashmap_get_value_size(const Hashmap *map);
+
+
+#endif /* HASHMAP_H */
@@ -0,0 +1,602 @@
+#include <hashmap.h>
+#include <common.h>
+#include <hash.h>
+#include <stdint.h>
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memcpy, memcmp, memset */
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+/* control bytes of free slots are negative, full slot keeps h2 (0 .. 127) */
+#define HASHMAP_CTRL_EMPTY ((int8_t)-128)
+#define HASHMAP_CTRL_DELETED ((int8_t)-2)
+
+/* index returned when key is not found */
+#define HASHMAP_NOT_FOUND ((size_t)SIZE_MAX)
+
+
+/* bit i is set if control byte i in group matches */
+typedef uint32_t Hashmap_bits;
+
+
+/*
+    Mix result of user hash function, so h1 and h2 are well distributed.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN key - pointer to key.
+
+    RETURN:
+    %Hash of key.
+*/
+static ___inline___ uint64_t __hashmap_hash(const Hashmap *map, const void *key);
+
+
+/*
+    Get bits of control bytes in group equal to @h2.
+
+    PARAMS:
+    @IN group - pointer to first control byte of group.
+    @IN h2 - control byte to match.
+
+    RETURN:
+    %Bits of matching control bytes.
+*/
+static ___inline___ Hashmap_bits __hashmap_group_match(const int8_t *group, int8_t h2);
+
+
+/*
+    Get bits of empty or deleted control bytes in group.
+
+    PARAMS:
+    @IN group - pointer to first control byte of group.
+
+    RETURN:
+    %Bits of free control bytes.
+*/
+static ___inline___ Hashmap_bits __hashmap_group_match_free(const int8_t *group);
+
+
+/*
+    Get pointer to slot.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN index - index of slot.
+
+    RETURN:
+    %Pointer to slot.
+*/
+static ___inline___ BYTE *__hashmap_slot(const Hashmap *map, size_t index);
+
+
+/*
+    Set control byte of slot (and its mirror at the end of control bytes).
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN index - index of slot.
+    @IN ctrl - new control byte.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __hashmap_set_ctrl(Hashmap *map, size_t index, int8_t ctrl);
+
+
+/*
+    Call destroy_f for value of slot (for key if map has no values).
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN index - index of slot.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __hashmap_destroy_slot(const Hashmap *map, size_t index);
+
+
+/*
+    Find slot with key.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN key - pointer to key.
+    @IN hash - hash of key.
+
+    RETURN:
+    %HASHMAP_NOT_FOUND if key doesn't exist.
+    %Index of slot with key.
+*/
+static size_t __hashmap_find(const Hashmap *map, const void *key, uint64_t hash);
+
+
+/*
+    Find first empty or deleted slot in probe sequence of hash.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN hash - hash of key.
+
+    RETURN:
+    %Index of free slot.
+*/
+static size_t __hashmap_find_free(const Hashmap *map, uint64_t hash);
+
+
+/*
+    Get number of slots needed for @num_entries entries.
+
+    PARAMS:
+    @IN num_entries - number of entries.
+
+    RETURN:
+    %0 if @num_entries is too big.
+    %Number of slots (power of 2, at least HASHMAP_GROUP_WIDTH).
+*/
+static size_t __hashmap_capacity_for(size_t num_entries);
+
+
+/*
+    Move all entries to new table with @capacity slots.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN capacity - number of slots (power of 2, enough for all entries).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __hashmap_resize(Hashmap *map, size_t capacity);
+
+
+/*
+    Delete key from hash map.
+
+    PARAMS:
+    @IN map - pointer to hash map.
+    @IN key - pointer to key.
+    @IN destroy - call destroy_f for value (or key).
+
+    RETURN:
+    %0 if success.
+    %1 if key doesn't exist.
+    %negative value if failure.
+*/
+static int __hashmap_delete(Hashmap *map, const void *key, bool destroy);
+
+
+static ___inline___ uint64_t __hashmap_hash(const Hashmap *map, const void *key)
+{
+    if (map->key_hash_f == NULL)
+        return hash_bytes(key, map->key_size, HASH_DEFAULT_SEED);
+
+    uint64_t hash = map->key_hash_f(key) * 0x9E3779B97F4A7C15ULL;
+
+    return hash ^ (hash >> 32);
+}
+
+
+static ___inline___ Hashmap_bits __hashmap_group_match(const int8_t *group, int8_t h2)
+{
+#ifdef __SSE2__
+    const __m128i ctrl = _mm_loadu_si128((const __m128i *)(const void *)group);
+
+    return (Hashmap_bits)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl));
+#else
+    Hashmap_bits bits = 0;
+
+    for (size_t i = 0; i < HASHMAP_GROUP_WIDTH; ++i)
+        bits |= (Hashmap_bits)(group[i] == h2) << i;
+
+    return bits;
+#endif
+}
+
+
+static ___inline___ Hashmap_bits __hashmap_group_match_free(const int8_t *group)
+{
+#ifdef __SSE2__
+    /* only EMPTY and DELETED have sign bit set */
+    return (Hashmap_bits)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(const void *)group));
+#else
+    Hashmap_bits bits = 0;
+
+    for (size_t i = 0; i < HASHMAP_GROUP_WIDTH; ++i)
+        bits |= (Hashmap_bits)(group[i] < 0) << i;
+
+    return bits;
+#endif
+}
+
+
+static ___inline___ BYTE *__hashmap_slot(const Hashmap *map, size_t index)
+{
+    return map->slots + index * map->slot_size;
+}
+
+
+static ___inline___ void __hashmap_set_ctrl(Hashmap *map, size_t index, int8_t ctrl)
+{
+    const size_t mask = map->capacity - 1;
+
+    /* index < GROUP_WIDTH - 1 is mirrored after last slot, other indexes map to itself */
+    map->ctrl[index] = ctrl;
+    map->ctrl[((index - (HASHMAP_GROUP_WIDTH - 1)) & mask) + (HASHMAP_GROUP_WIDTH - 1)] = ctrl;
+}
+
+
+static ___inline___ void __hashmap_destroy_slot(const Hashmap *map, size_t index)
+{
+    map->destroy_f(__hashmap_slot(map, index) + (map->value_size != 0 ? map->value_offset : 0));
+}
+
+
+static size_t __hashmap_find(const Hashmap *map, const void *key, uint64_t hash)
+{
+    const size_t mask = map->capacity - 1;
+    const int8_t h2 = (int8_t)(hash & 0x7F);
+
+    size_t offset = (size_t)(hash >> 7) & mask;
+    size_t step = 0;
+
+    for (;;)
+    {
+        const int8_t *group = map->ctrl + offset;
+
+        for (Hashmap_bits bits = __hashmap_group_match(group, h2); bits != 0; bits &= bits - 1)
+        {
+            const size_t index = (offset + (size_t)__builtin_ctz(bits)) & mask;
+            const BYTE *slot = __hashmap_slot(map, index);
+
+            if (map->cmp_f != NULL ? map->cmp_f(key, slot) == 0 : memcmp(key, slot, map->key_size) == 0)
+                return index;
+        }
+
+        /* key would be inserted in first empty slot of its sequence */
+        if (__hashmap_group_match(group, HASHMAP_CTRL_EMPTY) != 0)
+            return HASHMAP_NOT_FOUND;
+
+        step += HASHMAP_GROUP_WIDTH;
+        offset = (offset + step) & mask;
+    }
+}
+
+
+static size_t __hashmap_find_free(const Hashmap *map, uint64_t hash)
+{
+    const size_t mask = map->capacity - 1;
+
+    size_t offset = (size_t)(hash >> 7) & mask;
+    size_t step = 0;
+
+    /* there is always empty slot, so loop ends */
+    for (;;)
+    {
+        const Hashmap_bits bits = __hashmap_group_match_free(map->ctrl + offset);
+
+        if (bits != 0)
+            return (offset + (size_t)__builtin_ctz(bits)) & mask;
+
+        step += HASHMAP_GROUP_WIDTH;
+        offset = (offset + step) & mask;
+    }
+}
+
+
+static size_t __hashmap_capacity_for(size_t num_entries)
+{
+    size_t capacity = HASHMAP_GROUP_WIDTH;
+
+    /* max load factor is 7/8 */
+    while (capacity - capacity / 8 < num_entries)
+    {
+        if (capacity > SIZE_MAX / 4)
+            return 0;
+
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+
+static int __hashmap_resize(Hashmap *map, size_t capacity)
+{
+    const size_t ctrl_size = ALIGN_UP(capacity + HASHMAP_GROUP_WIDTH, CACHE_LINE_SIZE);
+
+    if (capacity > (SIZE_MAX - ctrl_size) / map->slot_size)
+        ERROR("capacity is too big\n", -1);
+
+    /* control bytes and slots in one block, slots start on new cache line */
+    BYTE *block = (BYTE *)malloc(ctrl_size + capacity * map->slot_size);
+
+    if (block == NULL)
+        ERROR("malloc error\n", -1);
+
+    Hashmap old = *map;
+
+    map->ctrl = (int8_t *)(void *)block;
+    map->slots = block + ctrl_size;
+    map->capacity = capacity;
+    map->growth_left = capacity - capacity / 8 - map->num_entries;
+
+    (void)memset(map->ctrl, HASHMAP_CTRL_EMPTY, capacity + HASHMAP_GROUP_WIDTH);
+
+    /* no key is equal to other, so only free slot has to be found */
+    for (size_t i = 0; i < old.capacity; ++i)
+    {
+        if (old.ctrl[i] < 0)
+            continue;
+
+        const BYTE *slot = __hashmap_slot(&old, i);
+        const uint64_t hash = __hashmap_hash(map, slot);
+        const size_t index = __hashmap_find_free(map, hash);
+
+        __hashmap_set_ctrl(map, index, (int8_t)(hash & 0x7F));
+        (void)memcpy(__hashmap_slot(map, index), slot, map->slot_size);
+    }
+
+    free(old.ctrl);
+
+    return 0;
+}
+
+
+static int __hashmap_delete(Hashmap *map, const void *key, bool destroy)
+{
+    if (map == NULL || key == NULL)
+        ERROR("map == NULL || key == NULL\n", -1);
+
+    const size_t index = __hashmap_find(map, key, __hashmap_hash(map, key));
+
+    if (index == HASHMAP_NOT_FOUND)
+        return 1;
+
+    if (destroy && map->destroy_f != NULL)
+        __hashmap_destroy_slot(map, index);
+
+    const size_t mask = map->capacity - 1;
+    const Hashmap_bits empty_after = __hashmap_group_match(map->ctrl + index, HASHMAP_CTRL_EMPTY);
+    const Hashmap_bits empty_before = __hashmap_group_match(map->ctrl + ((index - HASHMAP_GROUP_WIDTH) & mask), HASHMAP_CTRL_EMPTY);
+
+    /*
+        If there is no window of GROUP_WIDTH full slots around slot, no probe
+        sequence went through it, so slot can be EMPTY instead of DELETED.
+    */
+    const bool was_never_full = empty_before != 0 && empty_after != 0 &&
+        (size_t)(__builtin_ctz(empty_after) + __builtin_clz(empty_before) - (int)(32 - HASHMAP_GROUP_WIDTH)) < HASHMAP_GROUP_WIDTH;
+
+    __hashmap_set_ctrl(map, index, was_never_full ? HASHMAP_CTRL_EMPTY : HASHMAP_CTRL_DELETED);
+
+    if (was_never_full)
+        ++map->growth_left;
+
+    --map->num_entries;
+
+    return 0;
+}
+
+
+Hashmap *hashmap_create(size_t key_size, size_t value_size, size_t capacity, hash_f key_hash_f, compare_f cmp_f, destructor_f destroy_f)
+{
+    if (key_size < 1)
+        ERROR("key_size < 1\n", NULL);
+
+    const size_t value_offset = value_size == 0 ? key_size : ALIGN_UP(key_size, sizeof(void *));
+
+    if (value_offset < key_size || value_size > SIZE_MAX - value_offset - sizeof(void *))
+        ERROR("key_size or value_size is too big\n", NULL);
+
+    const size_t slots = __hashmap_capacity_for(capacity);
+
+    if (slots == 0)
+        ERROR("capacity is too big\n", NULL);
+
+    Hashmap *map = (Hashmap *)calloc(1, sizeof(*map));
+
+    if (map == NULL)
+        ERROR("calloc error\n", NULL);
+
+    map->key_hash_f = key_hash_f;
+    map->cmp_f = cmp_f;
+    map->destroy_f = destroy_f;
+    map->key_size = key_size;
+    map->value_size = value_size;
+    map->value_offset = value_offset;
+    map->slot_size = value_size == 0 ? key_size : ALIGN_UP(value_offset + value_size, sizeof(void *));
+
+    if (__hashmap_resize(map, slots) != 0)
+    {
+        FREE(map);
+        ERROR("__hashmap_resize error\n", NULL);
+    }
+
+    return map;
+}
+
+
+void hashmap_destroy(Hashmap *map)
+{
+    if (map == NULL)
+        return;
+
+    FREE(map->ctrl);
+    FREE(map);
+}
+
+
+void hashmap_destroy_with_entries(Hashmap *map)
+{
+    if (map == NULL)
+        return;
+
+    if (map->destroy_f != NULL)
+        for (size_t i = 0; i < map->capacity; ++i)
+            if (map->ctrl[i] >= 0)
+                __hashmap_destroy_slot(map, i);
+
+    hashmap_destroy(map);
+}
+
+
+int hashmap_insert(Hashmap * __restrict__ map, const void * __restrict__ key, const void * __restrict__ value)
+{
+    if (map == NULL || key == NULL)
+        ERROR("map == NULL || key == NULL\n", -1);
+
+    if (value == NULL && map->value_size != 0)
+        ERROR("value == NULL\n", -1);
+
+    const uint64_t hash = __hashmap_hash(map, key);
+    size_t index = __hashmap_find(map, key, hash);
+
+    if (index != HASHMAP_NOT_FOUND)
+    {
+        if (map->value_size != 0)
+            (void)memcpy(__hashmap_slot(map, index) + map->value_offset, value, map->value_size);
+
+        return 1;
+    }
+
+    index = __hashmap_find_free(map, hash);
+
+    /* deleted slot can be reused without rehash */
+    if (map->growth_left == 0 && map->ctrl[index] == HASHMAP_CTRL_EMPTY)
+    {
+        /* lot of deleted slots, rehash to the same size drops them */
+        const size_t capacity = map->num_entries < (map->capacity - map->capacity / 8) / 2 ? map->capacity : map->capacity * 2;
+
+        if (capacity == 0 || __hashmap_resize(map, capacity) != 0)
+            ERROR("__hashmap_resize error\n", -1);
+
+        index = __hashmap_find_free(map, hash);
+    }
+
+    if (map->ctrl[index] == HASHMAP_CTRL_EMPTY)
+        --map->growth_left;
+
+    __hashmap_set_ctrl(map, index, (int8_t)(hash & 0x7F));
+
+    BYTE *slot = __hashmap_slot(map, index);
+    (void)memcpy(slot, key, map->key_size);
+
+    if (map->value_size != 0)
+        (void)memcpy(slot + map->value_offset, value, map->value_size);
+
+    ++map->num_entries;
+
+    return 0;
+}
+
+
+int hashmap_delete(Hashmap * __restrict__ map, const void * __restrict__ key)
+{
+    return __hashmap_delete(map, key, false);
+}
+
+
+int hashmap_delete_with_entry(Hashmap * __restrict__ map, const void * __restrict__ key)
+{
+    return __hashmap_delete(map, key, true);
+}
+
+
+int hashmap_search(const Hashmap * __restrict__ map, const void * __restrict__ key, void * __restrict__ val_out)
+{
+    if (map == NULL || key == NULL)
+        ERROR("map == NULL || key == NULL\n", -1);
+
+    const size_t index = __hashmap_find(map, key, __hashmap_hash(map, key));
+
+    if (index == HASHMAP_NOT_FOUND)
+        return 1;
+
+    if (val_out != NULL)
+        (void)memcpy(val_out, __hashmap_slot(map, index) + map->value_offset, map->value_size);
+
+    return 0;
+}
+
+
+bool hashmap_key_exist(const Hashmap * __restrict__ map, const void * __restrict__ key)
+{
+    if (map == NULL || key == NULL)
+        ERROR("map == NULL || key == NULL\n", false);
+
+    return __hashmap_find(map, key, __hashmap_hash(map, key)) != HASHMAP_NOT_FOUND;
+}
+
+
+int hashmap_reserve(Hashmap *map, size_t num_entries)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    /* deleted slots are counted as full, so count them as well */
+    if (num_entries <= map->num_entries + map->growth_left)
+        return 0;
+
+    const size_t capacity = __hashmap_capacity_for(num_entries);
+
+    if (capacity == 0)
+        ERROR("num_entries is too big\n", -1);
+
+    return __hashmap_resize(map, MAX(capacity, map->capacity));
+}
+
+
+int hashmap_rehash(Hashmap *map, size_t capacity)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    const size_t min_capacity = __hashmap_capacity_for(map->num_entries);
+    const size_t requested = __hashmap_capacity_for(capacity - capacity / 8);
+
+    if (requested == 0)
+        ERROR("capacity is too big\n", -1);
+
+    return __hashmap_resize(map, MAX(min_capacity, requested));
+}
+
+
+ssize_t hashmap_get_num_entries(const Hashmap *map)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    return (ssize_t)map->num_entries;
+}
+
+
+ssize_t hashmap_get_capacity(const Hashmap *map)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    return (ssize_t)map->capacity;
+}
+
+
+ssize_t hashmap_get_key_size(const Hashmap *map)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    return (ssize_t)map->key_size;
+}
+
+
+ssize_t hashmap_get_value_size(const Hashmap *map)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    return (ssize_t)map->value_size;
+}
@@ -0,0 +1,178 @@
+#include <hashmap.h>
+#include <rbt.h>
+#include <hash.h>
+#include <cbench.h>
+#include <stdint.h> /* int64_t */
+#include <stdlib.h> /* malloc, free */
+
+
+/*
+    Hashmap against Rbt used as map (int64_t key -> int64_t value) in
+    lookup heavy workload: insert n keys once, then look up every key
+    LOOKUPS_PER_KEY times in random order and the same number of missing keys.
+*/
+
+
+#define LOOKUPS_PER_KEY 4
+
+
+typedef struct Pair
+{
+    int64_t key;
+    int64_t value;
+} Pair;
+
+
+/* functions needed for benchmark */
+static int my_compare_pair(const void *a, const void *b);
+static int my_compare_int64_t(const void *a, const void *b);
+static int64_t *keys_create(size_t n, uint64_t seed);
+
+
+/* benchmark function declarations */
+static void bench_hashmap(const int64_t *keys, const int64_t *missing, size_t n);
+static void bench_rbt(const int64_t *keys, const int64_t *missing, size_t n);
+
+
+/* implementation */
+static int my_compare_pair(const void *a, const void *b)
+{
+    return my_compare_int64_t(&((const Pair *)a)->key, &((const Pair *)b)->key);
+}
+
+
+static int my_compare_int64_t(const void *a, const void *b)
+{
+    const int64_t x = *(const int64_t *)a;
+    const int64_t y = *(const int64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+/* odd keys for seed with lowest bit set, even for the other, so two sets never share key */
+static int64_t *keys_create(size_t n, uint64_t seed)
+{
+    int64_t *keys = (int64_t *)malloc(n * sizeof(*keys));
+
+    if (keys == NULL)
+        ERROR("malloc error\n", NULL);
+
+    uint64_t state = seed;
+
+    for (size_t i = 0; i < n; ++i)
+        keys[i] = (int64_t)(((bench_rand(&state) >> 2) << 1) | (seed & 1));
+
+    return keys;
+}
+
+
+static void bench_hashmap(const int64_t *keys, const int64_t *missing, size_t n)
+{
+    char name[64];
+    uint64_t state = 1;
+    size_t found = 0;
+    int64_t val;
+
+    Hashmap *map = hashmap_create(sizeof(int64_t), sizeof(int64_t), 0, hash_int64, my_compare_int64_t, NULL);
+
+    if (map == NULL)
+        VERROR("hashmap_create error\n");
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)hashmap_insert(map, &keys[i], &keys[i]);
+    (void)snprintf(name, sizeof(name), "hashmap insert n=%zu", n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n * LOOKUPS_PER_KEY; ++i)
+        found += hashmap_search(map, &keys[bench_rand(&state) % n], &val) == 0;
+    (void)snprintf(name, sizeof(name), "hashmap search hit n=%zu", n);
+    bench_report(name, n * LOOKUPS_PER_KEY, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n * LOOKUPS_PER_KEY; ++i)
+        found += hashmap_search(map, &missing[bench_rand(&state) % n], &val) == 0;
+    (void)snprintf(name, sizeof(name), "hashmap search miss n=%zu", n);
+    bench_report(name, n * LOOKUPS_PER_KEY, start);
+
+    /* only hits are found */
+    if (found != n * LOOKUPS_PER_KEY)
+        (void)printf("hashmap found wrong entries\n");
+
+    hashmap_destroy(map);
+}
+
+
+static void bench_rbt(const int64_t *keys, const int64_t *missing, size_t n)
+{
+    char name[64];
+    uint64_t state = 1;
+    size_t found = 0;
+    Pair pair;
+    Pair val;
+
+    Rbt *tree = rbt_create(sizeof(Pair), my_compare_pair, NULL, NULL);
+
+    if (tree == NULL)
+        VERROR("rbt_create error\n");
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        pair.key = keys[i];
+        pair.value = keys[i];
+        (void)rbt_insert(tree, &pair);
+    }
+    (void)snprintf(name, sizeof(name), "rbt insert n=%zu", n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n * LOOKUPS_PER_KEY; ++i)
+    {
+        pair.key = keys[bench_rand(&state) % n];
+
+        found += rbt_search(tree, &pair, &val) == 0;
+    }
+    (void)snprintf(name, sizeof(name), "rbt search hit n=%zu", n);
+    bench_report(name, n * LOOKUPS_PER_KEY, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n * LOOKUPS_PER_KEY; ++i)
+    {
+        pair.key = missing[bench_rand(&state) % n];
+        found += rbt_search(tree, &pair, &val) == 0;
+    }
+    (void)snprintf(name, sizeof(name), "rbt search miss n=%zu", n);
+    bench_report(name, n * LOOKUPS_PER_KEY, start);
+
+    /* only hits are found */
+    if (found != n * LOOKUPS_PER_KEY)
+        (void)printf("rbt found wrong entries\n");
+
+    rbt_destroy(tree);
+}
+
+
+int main(void)
+{
+    const size_t sizes[] = { 1000, 100000 };
+
+    for (size_t i = 0; i < ARRAY_SIZE(sizes); ++i)
+    {
+        int64_t *keys = keys_create(sizes[i], 0x9e3779b97f4a7c16ULL);
+        int64_t *missing = keys_create(sizes[i], 0x9e3779b97f4a7c15ULL);
+
+        if (keys != NULL && missing != NULL)
+        {
+            bench_hashmap(keys, missing, sizes[i]);
+            bench_rbt(keys, missing, sizes[i]);
+        }
+
+        FREE(keys);
+        FREE(missing);
+    }
+
+    return 0;
+}
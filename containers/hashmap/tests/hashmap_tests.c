@@ -0,0 +1,608 @@
+#include <hashmap.h>
+#include <ctest.h>
+#include <stdint.h>
+
+
+typedef struct MyStruct
+{
+    int64_t key;
+    int64_t a;
+    int64_t *ptr;
+} MyStruct;
+
+
+/* key compared by bytes (no padding) */
+typedef struct Point
+{
+    int32_t x;
+    int32_t y;
+} Point;
+
+
+/* functions needed for testing */
+static uint64_t my_hash_int64_t(const void *key);
+static uint64_t my_hash_const(const void *key);
+static uint64_t my_hash_point(const void *key);
+static uint64_t my_hash_ptr_int64_t(const void *key);
+static int my_compare_int64_t(const void *a, const void *b);
+static int my_compare_ptr_int64_t(const void *a, const void *b);
+static void my_struct_destroy(void *ms);
+static void my_ptr_destroy(void *ptr);
+
+
+/* unit tests function declaraions */
+static void test_hashmap_create(void);
+static void test_hashmap_insert_search_delete(void);
+static void test_hashmap_collisions(void);
+static void test_hashmap_growth(void);
+static void test_hashmap_churn(void);
+static void test_hashmap_reserve_rehash(void);
+static void test_hashmap_memcmp_keys(void);
+static void test_hashmap_set(void);
+static void test_hashmap_with_entries(void);
+static void test_hashmap_set_with_entries(void);
+
+
+/* implementation */
+static uint64_t my_hash_int64_t(const void *key)
+{
+    /* identity, map mixes it */
+    return (uint64_t)*(const int64_t *)key;
+}
+
+
+static uint64_t my_hash_const(const void *key)
+{
+    (void)key;
+
+    return 42;
+}
+
+
+static uint64_t my_hash_point(const void *key)
+{
+    const Point *p = (const Point *)key;
+
+    return ((uint64_t)(uint32_t)p->x << 32) | (uint64_t)(uint32_t)p->y;
+}
+
+
+static uint64_t my_hash_ptr_int64_t(const void *key)
+{
+    return (uint64_t)**(int64_t * const *)key;
+}
+
+
+static int my_compare_int64_t(const void *a, const void *b)
+{
+    const int64_t *x = (const int64_t *)a;
+    const int64_t *y = (const int64_t *)b;
+
+    return (*x > *y) - (*x < *y);
+}
+
+
+static int my_compare_ptr_int64_t(const void *a, const void *b)
+{
+    return my_compare_int64_t(*(int64_t * const *)a, *(int64_t * const *)b);
+}
+
+
+static void my_struct_destroy(void *ms)
+{
+    FREE(((MyStruct *)ms)->ptr);
+}
+
+
+static void my_ptr_destroy(void *ptr)
+{
+    int64_t *p = *(int64_t **)ptr;
+    FREE(p);
+}
+
+
+static void test_hashmap_create(void)
+{
+    Hashmap *map = hashmap_create(sizeof(int64_t), sizeof(int64_t), 0, my_hash_int64_t, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+
+    T_EXPECT(hashmap_get_num_entries(map), (ssize_t)0);
+    T_EXPECT(hashmap_get_capacity(map), (ssize_t)HASHMAP_GROUP_WIDTH);
+    T_EXPECT(hashmap_get_key_size(map), (ssize_t)sizeof(int64_t));
+    T_EXPECT(hashmap_get_value_size(map), (ssize_t)sizeof(int64_t));
+
+    hashmap_destroy(map);
+
+    /* capacity is number of entries, not slots */
+    map = hashmap_create(sizeof(int64_t), sizeof(int64_t), 100, my_hash_int64_t, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+    T_EXPECT(hashmap_get_capacity(map), (ssize_t)128);
+    hashmap_destroy(map);
+
+    map = hashmap_create(sizeof(int64_t), sizeof(int64_t), 113, my_hash_int64_t, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+    T_EXPECT(hashmap_get_capacity(map), (ssize_t)256);
+    hashmap_destroy(map);
+
+    T_ASSERT(hashmap_create(0, sizeof(int64_t), 0, my_hash_int64_t, NULL, NULL), NULL);
+    T_ASSERT(hashmap_create(sizeof(int64_t), sizeof(int64_t), SIZE_MAX, my_hash_int64_t, NULL, NULL), NULL);
+
+    T_EXPECT(hashmap_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(hashmap_get_capacity(NULL), (ssize_t)-1);
+    T_EXPECT(hashmap_get_key_size(NULL), (ssize_t)-1);
+    T_EXPECT(hashmap_get_value_size(NULL), (ssize_t)-1);
+    T_EXPECT(hashmap_key_exist(NULL, NULL), (bool)false);
+}
+
+
+static void test_hashmap_insert_search_delete(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t key;
+    int64_t val;
+
+    Hashmap *map = hashmap_create(sizeof(int64_t), sizeof(int64_t), 0, my_hash_int64_t, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+
+    key = 1;
+    T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 1);
+    T_EXPECT(hashmap_delete(map, (void *)&key), 1);
+    T_CHECK(hashmap_insert(map, NULL, (void *)&val) < 0);
+    T_CHECK(hashmap_insert(map, (void *)&key, NULL) < 0);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        val = i * 10;
+        T_EXPECT(hashmap_insert(map, (void *)&key, (void *)&val), 0);
+    }
+
+    T_EXPECT(hashmap_get_num_entries(map), (ssize_t)ARRAY_TEST_SIZE);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 0);
+        T_ASSERT(val, i * 10);
+        T_EXPECT(hashmap_key_exist(map, (void *)&key), (bool)true);
+    }
+
+    /* replace value of existing key */
+    key = 7;
+    val = -7;
+    T_EXPECT(hashmap_insert(map, (void *)&key, (void *)&val), 1);
+    T_EXPECT(hashmap_get_num_entries(map), (ssize_t)ARRAY_TEST_SIZE);
+    val = 0;
+    T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 0);
+    T_ASSERT(val, (int64_t)-7);
+
+    /* delete even keys */
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; i += 2)
+    {
+        key = i;
+        T_EXPECT(hashmap_delete(map, (void *)&key), 0);
+        T_EXPECT(hashmap_delete(map, (void *)&key), 1);
+    }
+
+    T_EXPECT(hashmap_get_num_entries(map), (ssize_t)(ARRAY_TEST_SIZE / 2));
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        T_EXPECT(hashmap_key_exist(map, (void *)&key), (bool)(i & 1));
+        T_EXPECT(hashmap_search(map, (void *)&key, NULL), (i & 1) ? 0 : 1);
+    }
+
+    key = ARRAY_TEST_SIZE;
+    T_EXPECT(hashmap_key_exist(map, (void *)&key), (bool)false);
+
+    hashmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashmap_collisions(void)
+{
+    #define ARRAY_TEST_SIZE 200
+
+    int64_t key;
+    int64_t val;
+
+    /* every key has the same hash, so all keys are in one probe sequence */
+    Hashmap *map = hashmap_create(sizeof(int64_t), sizeof(int64_t), 0, my_hash_const, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        val = -i;
+        T_EXPECT(hashmap_insert(map, (void *)&key, (void *)&val), 0);
+    }
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; i += 3)
+    {
+        key = i;
+        T_EXPECT(hashmap_delete(map, (void *)&key), 0);
+    }
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+
+        if (i % 3 == 0)
+            T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 1);
+        else
+        {
+            T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 0);
+            T_ASSERT(val, -i);
+        }
+    }
+
+    /* deleted keys back, they can take deleted slots */
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; i += 3)
+    {
+        key = i;
+        val = i;
+        T_EXPECT(hashmap_insert(map, (void *)&key, (void *)&val), 0);
+    }
+
+    T_EXPECT(hashmap_get_num_entries(map), (ssize_t)ARRAY_TEST_SIZE);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 0);
+        T_ASSERT(val, i % 3 == 0 ? i : -i);
+    }
+
+    hashmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashmap_growth(void)
+{
+    #define ARRAY_TEST_SIZE 100000
+
+    int64_t key;
+    int64_t val;
+
+    Hashmap *map = hashmap_create(sizeof(int64_t), sizeof(int64_t), 0, my_hash_int64_t, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+
+    ssize_t capacity = hashmap_get_capacity(map);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        /* keys with the same low bits, identity hash alone would collide */
+        key = i << 20;
+        val = i;
+        T_EXPECT(hashmap_insert(map, (void *)&key, (void *)&val), 0);
+
+        /* load factor never goes above 7/8 */
+        const ssize_t new_capacity = hashmap_get_capacity(map);
+        T_CHECK(new_capacity == capacity || new_capacity == capacity * 2);
+        T_CHECK((i + 1) * 8 <= (int64_t)new_capacity * 7);
+        capacity = new_capacity;
+    }
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i << 20;
+        T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    hashmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashmap_churn(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t key;
+    int64_t val;
+    bool present[ARRAY_TEST_SIZE] = {0};
+    int64_t values[ARRAY_TEST_SIZE] = {0};
+    ssize_t num_entries = 0;
+
+    Hashmap *map = hashmap_create(sizeof(int64_t), sizeof(int64_t), ARRAY_TEST_SIZE / 4, my_hash_int64_t, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+
+    srand(1234);
+
+    /* random inserts and deletes, checked with plain array */
+    for (size_t i = 0; i < 200000; ++i)
+    {
+        key = (int64_t)(rand() % ARRAY_TEST_SIZE);
+        const size_t k = (size_t)key;
+
+        if (rand() % 2)
+        {
+            val = (int64_t)rand();
+            T_EXPECT(hashmap_insert(map, (void *)&key, (void *)&val), present[k] ? 1 : 0);
+
+            if (!present[k])
+                ++num_entries;
+
+            present[k] = true;
+            values[k] = val;
+        }
+        else
+        {
+            T_EXPECT(hashmap_delete(map, (void *)&key), present[k] ? 0 : 1);
+
+            if (present[k])
+                --num_entries;
+
+            present[k] = false;
+        }
+    }
+
+    T_EXPECT(hashmap_get_num_entries(map), num_entries);
+
+    /* tombstones don't make table grow without end */
+    T_CHECK(hashmap_get_capacity(map) <= (ssize_t)(4 * ARRAY_TEST_SIZE));
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = (int64_t)i;
+
+        if (present[i])
+        {
+            T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 0);
+            T_ASSERT(val, values[i]);
+        }
+        else
+            T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 1);
+    }
+
+    hashmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashmap_reserve_rehash(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t key;
+    int64_t val;
+
+    Hashmap *map = hashmap_create(sizeof(int64_t), sizeof(int64_t), 0, my_hash_int64_t, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+
+    T_EXPECT(hashmap_reserve(map, ARRAY_TEST_SIZE), 0);
+
+    const ssize_t capacity = hashmap_get_capacity(map);
+    T_EXPECT(capacity, (ssize_t)2048);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        val = i;
+        T_EXPECT(hashmap_insert(map, (void *)&key, (void *)&val), 0);
+    }
+
+    /* no rehash after reserve */
+    T_EXPECT(hashmap_get_capacity(map), capacity);
+
+    /* reserve never shrinks table */
+    T_EXPECT(hashmap_reserve(map, 10), 0);
+    T_EXPECT(hashmap_get_capacity(map), capacity);
+
+    for (int64_t i = 10; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        T_EXPECT(hashmap_delete(map, (void *)&key), 0);
+    }
+
+    /* shrink to fit */
+    T_EXPECT(hashmap_rehash(map, 0), 0);
+    T_EXPECT(hashmap_get_capacity(map), (ssize_t)HASHMAP_GROUP_WIDTH);
+    T_EXPECT(hashmap_get_num_entries(map), (ssize_t)10);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        T_EXPECT(hashmap_key_exist(map, (void *)&key), (bool)(i < 10));
+    }
+
+    /* too small capacity is ignored */
+    T_EXPECT(hashmap_rehash(map, 4), 0);
+    T_EXPECT(hashmap_get_capacity(map), (ssize_t)HASHMAP_GROUP_WIDTH);
+
+    T_EXPECT(hashmap_rehash(map, 300), 0);
+    T_EXPECT(hashmap_get_capacity(map), (ssize_t)512);
+
+    for (int64_t i = 0; i < 10; ++i)
+    {
+        key = i;
+        T_EXPECT(hashmap_search(map, (void *)&key, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    T_CHECK(hashmap_reserve(NULL, 10) < 0);
+    T_CHECK(hashmap_rehash(NULL, 10) < 0);
+
+    hashmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashmap_memcmp_keys(void)
+{
+    #define ARRAY_TEST_SIZE 64
+
+    Point p;
+    double val;
+
+    /* NULL hash_f hashes bytes of key */
+    const hash_f hashes[] = { my_hash_point, NULL };
+
+    for (size_t h = 0; h < ARRAY_SIZE(hashes); ++h)
+    {
+        /* NULL cmp_f, keys are compared by bytes */
+        Hashmap *map = hashmap_create(sizeof(Point), sizeof(double), 0, hashes[h], NULL, NULL);
+        T_ERROR(map == NULL);
+
+        for (int32_t x = 0; x < ARRAY_TEST_SIZE; ++x)
+            for (int32_t y = 0; y < ARRAY_TEST_SIZE; ++y)
+            {
+                p.x = x;
+                p.y = y;
+                val = (double)x * 0.5 + (double)y;
+                T_EXPECT(hashmap_insert(map, (void *)&p, (void *)&val), 0);
+            }
+
+        T_EXPECT(hashmap_get_num_entries(map), (ssize_t)(ARRAY_TEST_SIZE * ARRAY_TEST_SIZE));
+
+        for (int32_t x = 0; x < ARRAY_TEST_SIZE; ++x)
+            for (int32_t y = 0; y < ARRAY_TEST_SIZE; ++y)
+            {
+                p.x = x;
+                p.y = y;
+                T_EXPECT(hashmap_search(map, (void *)&p, (void *)&val), 0);
+                T_CHECK(val == (double)x * 0.5 + (double)y);
+            }
+
+        p.x = ARRAY_TEST_SIZE;
+        p.y = 0;
+        T_EXPECT(hashmap_key_exist(map, (void *)&p), (bool)false);
+
+        hashmap_destroy(map);
+    }
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashmap_set(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t key;
+
+    /* value_size 0, map is set of keys */
+    Hashmap *map = hashmap_create(sizeof(int64_t), 0, 0, my_hash_int64_t, my_compare_int64_t, NULL);
+    T_ERROR(map == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i * 3;
+        T_EXPECT(hashmap_insert(map, (void *)&key, NULL), 0);
+        T_EXPECT(hashmap_insert(map, (void *)&key, NULL), 1);
+    }
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE * 3; ++i)
+    {
+        key = i;
+        T_EXPECT(hashmap_key_exist(map, (void *)&key), (bool)(i % 3 == 0));
+    }
+
+    T_EXPECT(hashmap_get_num_entries(map), (ssize_t)ARRAY_TEST_SIZE);
+
+    hashmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashmap_with_entries(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    int64_t key;
+    MyStruct ms;
+
+    Hashmap *map = hashmap_create(sizeof(int64_t), sizeof(MyStruct), 0, my_hash_int64_t, my_compare_int64_t, my_struct_destroy);
+    T_ERROR(map == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        key = i;
+        ms.key = i;
+        ms.a = 0;
+        ms.ptr = (int64_t *)malloc(sizeof(int64_t));
+        T_ERROR(ms.ptr == NULL);
+
+        T_EXPECT(hashmap_insert(map, (void *)&key, (void *)&ms), 0);
+    }
+
+    /* value is freed by destroy_f */
+    key = 5;
+    T_EXPECT(hashmap_delete_with_entry(map, (void *)&key), 0);
+    T_EXPECT(hashmap_delete_with_entry(map, (void *)&key), 1);
+
+    /* value is returned to user */
+    key = 6;
+    T_EXPECT(hashmap_search(map, (void *)&key, (void *)&ms), 0);
+    T_ASSERT(ms.key, (int64_t)6);
+    T_EXPECT(hashmap_delete(map, (void *)&key), 0);
+    my_struct_destroy((void *)&ms);
+
+    /* rest of values freed by destroy_f */
+    hashmap_destroy_with_entries(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashmap_set_with_entries(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    int64_t val;
+    int64_t *key = &val;
+
+    /* value_size 0, so destroy_f gets key (pointer to int64_t owned by map) */
+    Hashmap *map = hashmap_create(sizeof(int64_t *), 0, 0, my_hash_ptr_int64_t, my_compare_ptr_int64_t, my_ptr_destroy);
+    T_ERROR(map == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        int64_t *ptr = (int64_t *)malloc(sizeof(int64_t));
+        T_ERROR(ptr == NULL);
+
+        *ptr = i;
+        T_EXPECT(hashmap_insert(map, (void *)&ptr, NULL), 0);
+    }
+
+    /* key from map is freed, not the search key */
+    val = 5;
+    T_EXPECT(hashmap_delete_with_entry(map, (void *)&key), 0);
+    T_EXPECT(hashmap_delete_with_entry(map, (void *)&key), 1);
+    T_EXPECT(hashmap_get_num_entries(map), (ssize_t)(ARRAY_TEST_SIZE - 1));
+
+    /* rest of keys freed by destroy_f */
+    hashmap_destroy_with_entries(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING HASHMAP");
+    TEST(test_hashmap_create());
+    TEST(test_hashmap_insert_search_delete());
+    TEST(test_hashmap_collisions());
+    TEST(test_hashmap_growth());
+    TEST(test_hashmap_churn());
+    TEST(test_hashmap_reserve_rehash());
+    TEST(test_hashmap_memcmp_keys());
+    TEST(test_hashmap_set());
+    TEST(test_hashmap_with_entries());
+    TEST(test_hashmap_set_with_entries());
+    TEST_SUMMARY();
+
+    return 0;
+}
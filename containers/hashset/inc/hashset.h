@@ -0,0 +1,171 @@
+#ifndef HASHSET_H
+#define HASHSET_H
+
+
+/*
+    Generic hash set implementation
+
+    Hashset is hash map without values, so entries are stored inline in
+    SwissTable slots (see hashmap.h). Built-in hash functions from hash.h
+    (hash_int32, hash_int64, hash_ptr, hash_string) can be used as hash_f,
+    NULL hash_f hashes bytes of entry.
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <hashmap.h>
+#include <hash.h>
+#include <stddef.h> /* size_t */
+#include <stdbool.h> /* bool */
+#include <sys/types.h> /* ssize_t */
+#include <common.h> /* hash_f, compare_f, destructor_f */
+
+
+typedef Hashmap Hashset;
+
+
+/*
+    Create new instance of hash set.
+
+    PARAMS:
+    @IN size_of - size of entry.
+    @IN capacity - number of entries which can be inserted without rehash.
+    @IN key_hash_f - pointer to hash function of entry or NULL to hash bytes.
+    @IN cmp_f - pointer to compare function (0 if equal) or NULL to compare bytes.
+    @IN destroy_f - pointer to destroy function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to hash set if success.
+*/
+Hashset *hashset_create(size_t size_of, size_t capacity, hash_f key_hash_f, compare_f cmp_f, destructor_f destroy_f);
+
+
+/*
+    Deallocate hash set.
+
+    PARAMS:
+    @IN set - pointer to hash set.
+
+    RETURN:
+    %This is void function.
+*/
+void hashset_destroy(Hashset *set);
+
+
+/*
+    Deallocate hash set with all entries (destroy_f is called for each entry).
+
+    PARAMS:
+    @IN set - pointer to hash set.
+
+    RETURN:
+    %This is void function.
+*/
+void hashset_destroy_with_entries(Hashset *set);
+
+
+/*
+    Insert entry to hash set. Equal entry in set is kept (not replaced).
+
+    PARAMS:
+    @IN set - pointer to hash set.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if entry was inserted.
+    %1 if entry is already in set.
+    %negative value if failure.
+*/
+int hashset_insert(Hashset * __restrict__ set, const void * __restrict__ entry);
+
+
+/*
+    Delete entry from hash set.
+
+    PARAMS:
+    @IN set - pointer to hash set.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %1 if entry isn't in set.
+    %negative value if failure.
+*/
+int hashset_delete(Hashset * __restrict__ set, const void * __restrict__ entry);
+
+
+/*
+    Delete entry from hash set and call destroy_f for entry from set.
+
+    PARAMS:
+    @IN set - pointer to hash set.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %1 if entry isn't in set.
+    %negative value if failure.
+*/
+int hashset_delete_with_entry(Hashset * __restrict__ set, const void * __restrict__ entry);
+
+
+/*
+    Check if entry is in hash set.
+
+    PARAMS:
+    @IN set - pointer to hash set.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %TRUE if entry is in set.
+    %FALSE if entry isn't in set or failure.
+*/
+bool hashset_contains(const Hashset * __restrict__ set, const void * __restrict__ entry);
+
+
+/*
+    Make place for @num_entries entries, so they can be inserted without rehash.
+
+    PARAMS:
+    @IN set - pointer to hash set.
+    @IN num_entries - number of entries.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int hashset_reserve(Hashset *set, size_t num_entries);
+
+
+/*
+    Get number of entries.
+
+    PARAMS:
+    @IN set - pointer to hash set.
+
+    RETURN:
+    %number of entries if success.
+    %-1 if failure.
+*/
+ssize_t hashset_get_num_entries(const Hashset *set);
+
+
+/*
+    Get size of data.
+
+    PARAMS:
+    @IN set - pointer to hash set.
+
+    RETURN:
+    %sizeof if success.
+    %-1 if failure.
+*/
+ssize_t hashset_get_data_size(const Hashset *set);
+
+
+#endif /* HASHSET_H */
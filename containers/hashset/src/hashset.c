@@ -0,0 +1,69 @@
+#include <hashset.h>
+#include <hashmap.h>
+#include <common.h>
+
+
+Hashset *hashset_create(size_t size_of, size_t capacity, hash_f key_hash_f, compare_f cmp_f, destructor_f destroy_f)
+{
+    /* map without values, destroy_f is called for keys */
+    Hashset *set = hashmap_create(size_of, 0, capacity, key_hash_f, cmp_f, destroy_f);
+
+    if (set == NULL)
+        ERROR("hashmap_create error\n", NULL);
+
+    return set;
+}
+
+
+void hashset_destroy(Hashset *set)
+{
+    hashmap_destroy(set);
+}
+
+
+void hashset_destroy_with_entries(Hashset *set)
+{
+    hashmap_destroy_with_entries(set);
+}
+
+
+int hashset_insert(Hashset * __restrict__ set, const void * __restrict__ entry)
+{
+    return hashmap_insert(set, entry, NULL);
+}
+
+
+int hashset_delete(Hashset * __restrict__ set, const void * __restrict__ entry)
+{
+    return hashmap_delete(set, entry);
+}
+
+
+int hashset_delete_with_entry(Hashset * __restrict__ set, const void * __restrict__ entry)
+{
+    return hashmap_delete_with_entry(set, entry);
+}
+
+
+bool hashset_contains(const Hashset * __restrict__ set, const void * __restrict__ entry)
+{
+    return hashmap_key_exist(set, entry);
+}
+
+
+int hashset_reserve(Hashset *set, size_t num_entries)
+{
+    return hashmap_reserve(set, num_entries);
+}
+
+
+ssize_t hashset_get_num_entries(const Hashset *set)
+{
+    return hashmap_get_num_entries(set);
+}
+
+
+ssize_t hashset_get_data_size(const Hashset *set)
+{
+    return hashmap_get_key_size(set);
+}
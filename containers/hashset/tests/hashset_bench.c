@@ -0,0 +1,169 @@
+#include <hashset.h>
+#include <hash.h>
+#include <cbench.h>
+#include <stdint.h> /* int64_t, uint64_t */
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memset */
+
+
+/*
+    Throughput of built-in hash functions (hash.h) for short and long keys,
+    with FNV-1a (byte at a time) as reference, and Hashset with int64_t
+    entries hashed by hash_int64 and by default hash_bytes (NULL hash_f).
+*/
+
+
+/* bytes hashed by every hash_bytes loop */
+#define BYTES_PER_LOOP ((size_t)(64 << 20))
+
+
+/* functions needed for benchmark */
+static uint64_t fnv1a(const void *data, size_t len, uint64_t seed);
+static int my_compare_int64_t(const void *a, const void *b);
+
+
+/* benchmark function declarations */
+static uint64_t bench_hash_bytes(const BYTE *data, size_t len);
+static uint64_t bench_hash_int(size_t n);
+static void bench_hashset(hash_f key_hash_f, const char *hash_name, size_t n);
+
+
+/* implementation */
+static uint64_t fnv1a(const void *data, size_t len, uint64_t seed)
+{
+    const BYTE *p = (const BYTE *)data;
+    uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+
+    for (size_t i = 0; i < len; ++i)
+    {
+        h ^= (uint64_t)p[i];
+        h *= 0x100000001b3ULL;
+    }
+
+    return h;
+}
+
+
+static int my_compare_int64_t(const void *a, const void *b)
+{
+    const int64_t x = *(const int64_t *)a;
+    const int64_t y = *(const int64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+static uint64_t bench_hash_bytes(const BYTE *data, size_t len)
+{
+    char name[64];
+    const size_t n = BYTES_PER_LOOP / len;
+    uint64_t acc = 0;
+
+    /* hash of one key is seed of the next one, so calls can't overlap or be skipped */
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        acc = hash_bytes(data, len, acc);
+    (void)snprintf(name, sizeof(name), "hash_bytes len=%zu", len);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        acc = fnv1a(data, len, acc);
+    (void)snprintf(name, sizeof(name), "fnv1a len=%zu", len);
+    bench_report(name, n, start);
+
+    return acc;
+}
+
+
+static uint64_t bench_hash_int(size_t n)
+{
+    uint64_t acc = 0;
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int64_t key = (int64_t)(i ^ acc);
+        acc += hash_int64(&key);
+    }
+    bench_report("hash_int64", n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int64_t key = (int64_t)(i ^ acc);
+        acc += hash_bytes(&key, sizeof(key), HASH_DEFAULT_SEED);
+    }
+    bench_report("hash_bytes len=8 (int64_t key)", n, start);
+
+    return acc;
+}
+
+
+static void bench_hashset(hash_f key_hash_f, const char *hash_name, size_t n)
+{
+    char name[64];
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    size_t found = 0;
+
+    Hashset *set = hashset_create(sizeof(int64_t), 0, key_hash_f, my_compare_int64_t, NULL);
+
+    if (set == NULL)
+        VERROR("hashset_create error\n");
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int64_t key = (int64_t)bench_rand(&state);
+        (void)hashset_insert(set, &key);
+    }
+    (void)snprintf(name, sizeof(name), "hashset insert %s n=%zu", hash_name, n);
+    bench_report(name, n, start);
+
+    /* the same sequence again, every key is in set */
+    state = 0x9e3779b97f4a7c15ULL;
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int64_t key = (int64_t)bench_rand(&state);
+        found += hashset_contains(set, &key);
+    }
+    (void)snprintf(name, sizeof(name), "hashset contains %s n=%zu", hash_name, n);
+    bench_report(name, n, start);
+
+    if (found != n)
+        (void)printf("hashset lost entries\n");
+
+    hashset_destroy(set);
+}
+
+
+int main(void)
+{
+    const size_t lengths[] = { 8, 16, 32, 64, 256, 4096, 65536 };
+
+    BYTE *data = (BYTE *)malloc(lengths[ARRAY_SIZE(lengths) - 1]);
+
+    if (data == NULL)
+        ERROR("malloc error\n", 1);
+
+    (void)memset(data, 0x5a, lengths[ARRAY_SIZE(lengths) - 1]);
+
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(lengths); ++i)
+        acc ^= bench_hash_bytes(data, lengths[i]);
+
+    acc ^= bench_hash_int((size_t)1 << 24);
+
+    bench_hashset(hash_int64, "hash_int64", (size_t)1 << 20);
+    bench_hashset(NULL, "hash_bytes", (size_t)1 << 20);
+
+    /* print result, so hashing is not optimised away */
+    (void)printf("checksum %llx\n", (unsigned long long)acc);
+
+    FREE(data);
+
+    return 0;
+}
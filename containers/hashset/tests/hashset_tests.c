@@ -0,0 +1,300 @@
+#include <hashset.h>
+#include <hash.h>
+#include <ctest.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/* functions needed for testing */
+static int my_compare_int64_t(const void *a, const void *b);
+static int my_compare_string(const void *a, const void *b);
+static void my_string_destroy(void *str);
+
+
+/* unit tests function declaraions */
+static void test_hash_bytes(void);
+static void test_hash_mix(void);
+static void test_hashset_create(void);
+static void test_hashset_insert_delete(void);
+static void test_hashset_builtin_hashes(void);
+static void test_hashset_strings(void);
+
+
+/* implementation */
+static int my_compare_int64_t(const void *a, const void *b)
+{
+    const int64_t *x = (const int64_t *)a;
+    const int64_t *y = (const int64_t *)b;
+
+    return (*x > *y) - (*x < *y);
+}
+
+
+static int my_compare_string(const void *a, const void *b)
+{
+    const char *x;
+    const char *y;
+
+    (void)memcpy(&x, a, sizeof(x));
+    (void)memcpy(&y, b, sizeof(y));
+
+    return strcmp(x, y);
+}
+
+
+static void my_string_destroy(void *str)
+{
+    char *s;
+
+    (void)memcpy(&s, str, sizeof(s));
+    FREE(s);
+}
+
+
+static void test_hash_bytes(void)
+{
+    #define ARRAY_TEST_SIZE 200
+
+    uint8_t buf[ARRAY_TEST_SIZE + 8];
+    uint64_t hashes[ARRAY_TEST_SIZE + 1];
+
+    for (size_t i = 0; i < ARRAY_SIZE(buf); ++i)
+        buf[i] = (uint8_t)(i * 7 + 1);
+
+    /* every length goes through different path (0, 1 .. 3, 4 .. 16, 17 .. 48, > 48) */
+    for (size_t len = 0; len <= ARRAY_TEST_SIZE; ++len)
+    {
+        hashes[len] = hash_bytes(buf, len, HASH_DEFAULT_SEED);
+
+        /* the same input, the same hash, also from unaligned address */
+        uint8_t copy[ARRAY_TEST_SIZE + 8];
+        (void)memcpy(copy + 3, buf, len);
+        T_ASSERT(hash_bytes(copy + 3, len, HASH_DEFAULT_SEED), hashes[len]);
+
+        /* seed changes hash */
+        T_CHECK(hash_bytes(buf, len, 1234) != hashes[len]);
+
+        for (size_t j = 0; j < len; ++j)
+            T_CHECK(hashes[j] != hashes[len]);
+    }
+
+    /* every bit of input changes hash */
+    for (size_t len = 1; len <= 64; ++len)
+        for (size_t bit = 0; bit < len * 8; ++bit)
+        {
+            buf[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+            T_CHECK(hash_bytes(buf, len, HASH_DEFAULT_SEED) != hashes[len]);
+            buf[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+        }
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hash_mix(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    /* mixers are bijections, consecutive integers don't collide */
+    for (uint64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        for (uint64_t j = i + 1; j < i + 16; ++j)
+        {
+            T_CHECK(hash_mix64(i) != hash_mix64(j));
+            T_CHECK(hash_mix32((uint32_t)i) != hash_mix32((uint32_t)j));
+        }
+
+    /* one flipped bit changes about half of output bits */
+    size_t flipped = 0;
+
+    for (uint64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        for (unsigned int bit = 0; bit < 64; ++bit)
+            flipped += (size_t)__builtin_popcountll(hash_mix64(i) ^ hash_mix64(i ^ (1ULL << bit)));
+
+    T_CHECK(flipped > ARRAY_TEST_SIZE * 64 * 30);
+    T_CHECK(flipped < ARRAY_TEST_SIZE * 64 * 34);
+
+    const int32_t a = -5;
+    const int64_t b = -5;
+    const char *str = "hash";
+    const void *ptr = &a;
+
+    T_ASSERT(hash_int32((const void *)&a), hash_mix64((uint64_t)(uint32_t)a));
+    T_ASSERT(hash_int64((const void *)&b), hash_mix64((uint64_t)b));
+    T_ASSERT(hash_ptr((const void *)&ptr), hash_mix64((uint64_t)(uintptr_t)ptr));
+    T_ASSERT(hash_string((const void *)&str), hash_bytes("hash", 4, HASH_DEFAULT_SEED));
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashset_create(void)
+{
+    Hashset *set = hashset_create(sizeof(int64_t), 0, hash_int64, my_compare_int64_t, NULL);
+    T_ERROR(set == NULL);
+
+    T_EXPECT(hashset_get_num_entries(set), (ssize_t)0);
+    T_EXPECT(hashset_get_data_size(set), (ssize_t)sizeof(int64_t));
+
+    hashset_destroy(set);
+
+    T_ASSERT(hashset_create(0, 0, hash_int64, NULL, NULL), NULL);
+
+    T_EXPECT(hashset_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(hashset_get_data_size(NULL), (ssize_t)-1);
+    T_EXPECT(hashset_contains(NULL, NULL), (bool)false);
+    T_CHECK(hashset_insert(NULL, NULL) < 0);
+    T_CHECK(hashset_delete(NULL, NULL) < 0);
+}
+
+
+static void test_hashset_insert_delete(void)
+{
+    #define ARRAY_TEST_SIZE 10000
+
+    int64_t val;
+
+    Hashset *set = hashset_create(sizeof(int64_t), 0, hash_int64, my_compare_int64_t, NULL);
+    T_ERROR(set == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        val = i * 2;
+        T_EXPECT(hashset_insert(set, (void *)&val), 0);
+        T_EXPECT(hashset_insert(set, (void *)&val), 1);
+    }
+
+    T_EXPECT(hashset_get_num_entries(set), (ssize_t)ARRAY_TEST_SIZE);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE * 2; ++i)
+    {
+        val = i;
+        T_EXPECT(hashset_contains(set, (void *)&val), (bool)(i % 2 == 0));
+    }
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE * 2; ++i)
+    {
+        val = i;
+        T_EXPECT(hashset_delete(set, (void *)&val), i % 2 == 0 ? 0 : 1);
+    }
+
+    T_EXPECT(hashset_get_num_entries(set), (ssize_t)0);
+
+    T_EXPECT(hashset_reserve(set, ARRAY_TEST_SIZE), 0);
+    T_EXPECT(hashset_insert(set, (void *)&val), 0);
+    T_EXPECT(hashset_contains(set, (void *)&val), (bool)true);
+
+    hashset_destroy(set);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashset_builtin_hashes(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int32_t arr32[ARRAY_TEST_SIZE];
+    int64_t val64;
+
+    /* NULL hash_f and NULL cmp_f, entries are hashed and compared by bytes */
+    Hashset *set64 = hashset_create(sizeof(int64_t), ARRAY_TEST_SIZE, NULL, NULL, NULL);
+    T_ERROR(set64 == NULL);
+
+    Hashset *set32 = hashset_create(sizeof(int32_t), ARRAY_TEST_SIZE, hash_int32, NULL, NULL);
+    T_ERROR(set32 == NULL);
+
+    /* address as entry */
+    Hashset *set_ptr = hashset_create(sizeof(int32_t *), ARRAY_TEST_SIZE, hash_ptr, NULL, NULL);
+    T_ERROR(set_ptr == NULL);
+
+    for (int32_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        arr32[i] = -i;
+        val64 = (int64_t)i << 32;
+
+        const int32_t *ptr = &arr32[i];
+
+        T_EXPECT(hashset_insert(set64, (void *)&val64), 0);
+        T_EXPECT(hashset_insert(set32, (void *)&arr32[i]), 0);
+        T_EXPECT(hashset_insert(set_ptr, (void *)&ptr), 0);
+    }
+
+    for (int32_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        const int32_t val32 = -i;
+        const int32_t *ptr = &arr32[i];
+        val64 = (int64_t)i << 32;
+
+        T_EXPECT(hashset_contains(set64, (void *)&val64), (bool)true);
+        T_EXPECT(hashset_contains(set32, (const void *)&val32), (bool)true);
+        T_EXPECT(hashset_contains(set_ptr, (void *)&ptr), (bool)true);
+
+        val64 = ((int64_t)i << 32) + 1;
+        T_EXPECT(hashset_contains(set64, (void *)&val64), (bool)false);
+    }
+
+    hashset_destroy(set64);
+    hashset_destroy(set32);
+    hashset_destroy(set_ptr);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_hashset_strings(void)
+{
+    #define ARRAY_TEST_SIZE 500
+
+    char buf[32];
+    char *str;
+
+    Hashset *set = hashset_create(sizeof(char *), 0, hash_string, my_compare_string, my_string_destroy);
+    T_ERROR(set == NULL);
+
+    for (int i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        (void)snprintf(buf, sizeof(buf), "key_%d", i);
+        str = strdup(buf);
+        T_ERROR(str == NULL);
+
+        T_EXPECT(hashset_insert(set, (void *)&str), 0);
+    }
+
+    /* equal string from other buffer is found */
+    for (int i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        (void)snprintf(buf, sizeof(buf), "key_%d", i);
+        str = buf;
+        T_EXPECT(hashset_contains(set, (void *)&str), (bool)true);
+    }
+
+    str = buf;
+    (void)snprintf(buf, sizeof(buf), "key_%d", ARRAY_TEST_SIZE);
+    T_EXPECT(hashset_contains(set, (void *)&str), (bool)false);
+
+    /* string owned by set is freed, not the one passed */
+    (void)snprintf(buf, sizeof(buf), "key_%d", 7);
+    T_EXPECT(hashset_delete_with_entry(set, (void *)&str), 0);
+    T_EXPECT(hashset_contains(set, (void *)&str), (bool)false);
+    T_EXPECT(hashset_get_num_entries(set), (ssize_t)(ARRAY_TEST_SIZE - 1));
+
+    /* rest of strings freed by destroy_f */
+    hashset_destroy_with_entries(set);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING HASHSET");
+    TEST(test_hash_bytes());
+    TEST(test_hash_mix());
+    TEST(test_hashset_create());
+    TEST(test_hashset_insert_delete());
+    TEST(test_hashset_builtin_hashes());
+    TEST(test_hashset_strings());
+    TEST_SUMMARY();
+
+    return 0;
+}
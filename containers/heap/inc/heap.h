@@ -0,0 +1,244 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+
+/*
+    Heap (priority queue) implementation
+
+    d-ary min heap on darray storage, top is the smallest entry in sense of
+    cmp_f (use reversed cmp_f for max heap). Children of entry i are at
+    d * i + 1 .. d * i + d, with d = 4 siblings of one entry are close in
+    memory and tree is half as deep as binary heap.
+
+    Heap created by heap_create_with_handles gives every pushed entry
+    a handle (index), which is stable until entry is popped and can be used
+    to decrease key of entry inside heap (Dijkstra, Prim, A*).
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <darray.h>
+#include <stddef.h> /* size_t */
+#include <stdbool.h> /* bool */
+#include <sys/types.h> /* ssize_t */
+#include <common.h> /* compare_f, destructor_f */
+
+
+/* number of children of each entry if 0 is passed to create */
+#define HEAP_DEFAULT_ARITY ((size_t)4)
+
+
+typedef struct Heap
+{
+    Darray *darray;           /* entries in heap order */
+    Darray *handle_of;        /* handle of entry at given position (only with handles) */
+    Darray *pos_of;           /* position of entry with given handle, SIZE_MAX if popped (only with handles) */
+    Darray *free_handles;     /* handles of popped entries to reuse (only with handles) */
+    void *tmp;                /* place for entry moved during sift down */
+
+    compare_f cmp_f;          /* pointer to compare function */
+    size_t arity;             /* number of children of each entry */
+} Heap;
+
+
+/*
+    Create new instance of heap.
+
+    PARAMS:
+    @IN size_of - size of element.
+    @IN arity - number of children of each entry (0 means HEAP_DEFAULT_ARITY).
+    @IN cmp_f - pointer to compare function.
+    @IN destroy_f - pointer to destroy function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to heap if success.
+*/
+Heap *heap_create(size_t size_of, size_t arity, compare_f cmp_f, destructor_f destroy_f);
+
+
+/*
+    Create new instance of heap with handles (heap_push_with_handle, heap_decrease_key).
+
+    PARAMS:
+    @IN size_of - size of element.
+    @IN arity - number of children of each entry (0 means HEAP_DEFAULT_ARITY).
+    @IN cmp_f - pointer to compare function.
+    @IN destroy_f - pointer to destroy function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to heap if success.
+*/
+Heap *heap_create_with_handles(size_t size_of, size_t arity, compare_f cmp_f, destructor_f destroy_f);
+
+
+/*
+    Deallocate heap.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+
+    RETURN:
+    %This is void function.
+*/
+void heap_destroy(Heap *heap);
+
+
+/*
+    Deallocate heap with all entries (destroy_f is called for each entry).
+
+    PARAMS:
+    @IN heap - pointer to heap.
+
+    RETURN:
+    %This is void function.
+*/
+void heap_destroy_with_entries(Heap *heap);
+
+
+/*
+    Insert entry to heap. O(log(n) / log(d))
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int heap_push(Heap * __restrict__ heap, const void * __restrict__ entry);
+
+
+/*
+    Insert entry to heap created with handles.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %handle of entry if success.
+    %-1 if failure.
+*/
+ssize_t heap_push_with_handle(Heap * __restrict__ heap, const void * __restrict__ entry);
+
+
+/*
+    Delete top (the smallest) entry from heap. O(d * log(n) / log(d))
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @OUT val_out - deleted entry (can be NULL).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (or heap is empty).
+*/
+int heap_pop(Heap * __restrict__ heap, void * __restrict__ val_out);
+
+
+/*
+    Get top (the smallest) entry from heap.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @OUT val_out - top entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (or heap is empty).
+*/
+int heap_top(const Heap * __restrict__ heap, void * __restrict__ val_out);
+
+
+/*
+    Build heap from array in O(n). Heap has to be empty.
+    In heap with handles, array[i] gets handle i.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @IN array - array of entries.
+    @IN len - number of entries.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int heap_build(Heap * __restrict__ heap, const void * __restrict__ array, size_t len);
+
+
+/*
+    Replace entry with given handle by smaller (or equal) entry.
+
+    PARAMS:
+    @IN heap - pointer to heap created with handles.
+    @IN handle - handle of entry in heap.
+    @IN entry - new entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (handle isn't in heap or entry is bigger).
+*/
+int heap_decrease_key(Heap * __restrict__ heap, size_t handle, const void * __restrict__ entry);
+
+
+/*
+    Check if entry with given handle is in heap.
+
+    PARAMS:
+    @IN heap - pointer to heap created with handles.
+    @IN handle - handle of entry.
+
+    RETURN:
+    %TRUE if entry is in heap.
+    %FALSE if entry was popped or failure.
+*/
+bool heap_contains(const Heap *heap, size_t handle);
+
+
+/*
+    Check if heap is empty.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+
+    RETURN:
+    %TRUE if heap is empty.
+    %FALSE if is not empty or failure.
+*/
+bool heap_is_empty(const Heap *heap);
+
+
+/*
+    Get number of entries.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+
+    RETURN:
+    %number of entries if success.
+    %-1 if failure.
+*/
+ssize_t heap_get_num_entries(const Heap *heap);
+
+
+/*
+    Get size of data.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+
+    RETURN:
+    %sizeof if success.
+    %-1 if failure.
+*/
+ssize_t heap_get_data_size(const Heap *heap);
+
+
+#endif /* HEAP_H */
@@ -0,0 +1,551 @@
+#include <heap.h>
+#include <common.h>
+#include <stdint.h>
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memcpy */
+
+
+/* position of handle which entry was popped */
+#define HEAP_NO_POS ((size_t)SIZE_MAX)
+
+
+/*
+    Create new instance of heap.
+
+    PARAMS:
+    @IN size_of - size of element.
+    @IN arity - number of children of each entry (0 means HEAP_DEFAULT_ARITY).
+    @IN cmp_f - pointer to compare function.
+    @IN destroy_f - pointer to destroy function.
+    @IN with_handles - create handle tables.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to heap if success.
+*/
+static Heap *__heap_create(size_t size_of, size_t arity, compare_f cmp_f, destructor_f destroy_f, bool with_handles);
+
+
+/*
+    Get pointer to entry at position @pos.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @IN pos - position in heap.
+
+    RETURN:
+    %Pointer to entry.
+*/
+static ___inline___ void *__heap_entry(const Heap *heap, size_t pos);
+
+
+/*
+    Get pointer to size_t at index @index in darray (handle tables).
+
+    PARAMS:
+    @IN darray - pointer to darray of size_t.
+    @IN index - index in darray.
+
+    RETURN:
+    %Pointer to size_t.
+*/
+static ___inline___ size_t *__heap_index(const Darray *darray, size_t index);
+
+
+/*
+    Move entry (and its handle) from position @src to position @dst.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @IN dst - destination position.
+    @IN src - source position.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __heap_move(Heap *heap, size_t dst, size_t src);
+
+
+/*
+    Put @entry (and its handle) at position @pos.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @IN pos - position in heap.
+    @IN handle - handle of entry (ignored without handles).
+    @IN entry - pointer to entry outside of heap storage.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __heap_place(Heap *heap, size_t pos, size_t handle, const void *entry);
+
+
+/*
+    Move @entry up from position @pos (hole) to its place.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @IN pos - position of hole.
+    @IN handle - handle of entry (ignored without handles).
+    @IN entry - pointer to entry outside of heap storage.
+
+    RETURN:
+    %This is void function.
+*/
+static void __heap_sift_up(Heap *heap, size_t pos, size_t handle, const void *entry);
+
+
+/*
+    Move entry from heap->tmp down from position @pos (hole) to its place.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+    @IN pos - position of hole.
+    @IN handle - handle of entry (ignored without handles).
+
+    RETURN:
+    %This is void function.
+*/
+static void __heap_sift_down(Heap *heap, size_t pos, size_t handle);
+
+
+/*
+    Get handle for new entry (reused or new one) and register it in pos_of.
+
+    PARAMS:
+    @IN heap - pointer to heap.
+
+    RETURN:
+    %handle if success.
+    %-1 if failure.
+*/
+static ssize_t __heap_handle_alloc(Heap *heap);
+
+
+/*
+    Drop all entries from darray without deallocation of entries.
+
+    PARAMS:
+    @IN darray - pointer to darray.
+
+    RETURN:
+    %This is void function.
+*/
+static void __heap_darray_clear(Darray *darray);
+
+
+static Heap *__heap_create(size_t size_of, size_t arity, compare_f cmp_f, destructor_f destroy_f, bool with_handles)
+{
+    if (size_of < 1)
+        ERROR("size_of < 1\n", NULL);
+
+    if (cmp_f == NULL)
+        ERROR("cmp_f == NULL\n", NULL);
+
+    if (arity == 0)
+        arity = HEAP_DEFAULT_ARITY;
+
+    if (arity < 2)
+        ERROR("arity < 2\n", NULL);
+
+    Heap *heap = (Heap *)calloc(1, sizeof(*heap));
+
+    if (heap == NULL)
+        ERROR("calloc error\n", NULL);
+
+    heap->cmp_f = cmp_f;
+    heap->arity = arity;
+
+    heap->tmp = malloc(size_of);
+    heap->darray = darray_create(DARRAY_UNSORTED, size_of, 0, NULL, destroy_f);
+
+    if (heap->tmp == NULL || heap->darray == NULL)
+    {
+        heap_destroy(heap);
+        ERROR("malloc error\n", NULL);
+    }
+
+    if (!with_handles)
+        return heap;
+
+    heap->handle_of = darray_create(DARRAY_UNSORTED, sizeof(size_t), 0, NULL, NULL);
+    heap->pos_of = darray_create(DARRAY_UNSORTED, sizeof(size_t), 0, NULL, NULL);
+    heap->free_handles = darray_create(DARRAY_UNSORTED, sizeof(size_t), 0, NULL, NULL);
+
+    if (heap->handle_of == NULL || heap->pos_of == NULL || heap->free_handles == NULL)
+    {
+        heap_destroy(heap);
+        ERROR("darray_create error\n", NULL);
+    }
+
+    return heap;
+}
+
+
+static ___inline___ void *__heap_entry(const Heap *heap, size_t pos)
+{
+    return (void *)((BYTE *)heap->darray->array + pos * heap->darray->size_of);
+}
+
+
+static ___inline___ size_t *__heap_index(const Darray *darray, size_t index)
+{
+    return (size_t *)darray->array + index;
+}
+
+
+static ___inline___ void __heap_move(Heap *heap, size_t dst, size_t src)
+{
+    (void)memcpy(__heap_entry(heap, dst), __heap_entry(heap, src), heap->darray->size_of);
+
+    if (heap->handle_of != NULL)
+    {
+        const size_t handle = *__heap_index(heap->handle_of, src);
+
+        *__heap_index(heap->handle_of, dst) = handle;
+        *__heap_index(heap->pos_of, handle) = dst;
+    }
+}
+
+
+static ___inline___ void __heap_place(Heap *heap, size_t pos, size_t handle, const void *entry)
+{
+    (void)memcpy(__heap_entry(heap, pos), entry, heap->darray->size_of);
+
+    if (heap->handle_of != NULL)
+    {
+        *__heap_index(heap->handle_of, pos) = handle;
+        *__heap_index(heap->pos_of, handle) = pos;
+    }
+}
+
+
+static void __heap_sift_up(Heap *heap, size_t pos, size_t handle, const void *entry)
+{
+    while (pos > 0)
+    {
+        const size_t parent = (pos - 1) / heap->arity;
+
+        if (heap->cmp_f(entry, __heap_entry(heap, parent)) >= 0)
+            break;
+
+        __heap_move(heap, pos, parent);
+        pos = parent;
+    }
+
+    __heap_place(heap, pos, handle, entry);
+}
+
+
+static void __heap_sift_down(Heap *heap, size_t pos, size_t handle)
+{
+    const size_t num_entries = heap->darray->num_entries;
+
+    for (;;)
+    {
+        /* pos < num_entries, so first child can't overflow for any real heap */
+        const size_t first = heap->arity * pos + 1;
+
+        if (first >= num_entries)
+            break;
+
+        const size_t last = MIN(first + heap->arity, num_entries);
+        size_t min = first;
+
+        /* children are next to each other, usually in one or two cache lines */
+        for (size_t child = first + 1; child < last; ++child)
+            if (heap->cmp_f(__heap_entry(heap, child), __heap_entry(heap, min)) < 0)
+                min = child;
+
+        if (heap->cmp_f(__heap_entry(heap, min), heap->tmp) >= 0)
+            break;
+
+        __heap_move(heap, pos, min);
+        pos = min;
+    }
+
+    __heap_place(heap, pos, handle, heap->tmp);
+}
+
+
+static ssize_t __heap_handle_alloc(Heap *heap)
+{
+    size_t handle;
+
+    if (heap->free_handles->num_entries > 0)
+        return darray_delete(heap->free_handles, (void *)&handle) == 0 ? (ssize_t)handle : -1;
+
+    /* position is set when entry is placed in heap */
+    handle = HEAP_NO_POS;
+
+    if (darray_insert(heap->pos_of, (void *)&handle) != 0)
+        ERROR("darray_insert error\n", -1);
+
+    return (ssize_t)(heap->pos_of->num_entries - 1);
+}
+
+
+static void __heap_darray_clear(Darray *darray)
+{
+    while (darray->num_entries > 0)
+        (void)darray_delete(darray, NULL);
+}
+
+
+Heap *heap_create(size_t size_of, size_t arity, compare_f cmp_f, destructor_f destroy_f)
+{
+    return __heap_create(size_of, arity, cmp_f, destroy_f, false);
+}
+
+
+Heap *heap_create_with_handles(size_t size_of, size_t arity, compare_f cmp_f, destructor_f destroy_f)
+{
+    return __heap_create(size_of, arity, cmp_f, destroy_f, true);
+}
+
+
+void heap_destroy(Heap *heap)
+{
+    if (heap == NULL)
+        return;
+
+    if (heap->darray != NULL)
+        darray_destroy(heap->darray);
+
+    if (heap->handle_of != NULL)
+        darray_destroy(heap->handle_of);
+
+    if (heap->pos_of != NULL)
+        darray_destroy(heap->pos_of);
+
+    if (heap->free_handles != NULL)
+        darray_destroy(heap->free_handles);
+
+    FREE(heap->tmp);
+    FREE(heap);
+}
+
+
+void heap_destroy_with_entries(Heap *heap)
+{
+    if (heap == NULL)
+        return;
+
+    if (heap->darray->destroy_f != NULL)
+        for (size_t pos = 0; pos < heap->darray->num_entries; ++pos)
+            heap->darray->destroy_f(__heap_entry(heap, pos));
+
+    heap_destroy(heap);
+}
+
+
+int heap_push(Heap * __restrict__ heap, const void * __restrict__ entry)
+{
+    if (heap == NULL || entry == NULL)
+        ERROR("heap == NULL || entry == NULL\n", -1);
+
+    if (heap->handle_of != NULL)
+        return heap_push_with_handle(heap, entry) < 0 ? -1 : 0;
+
+    /*
+        darray_insert makes place at the end (and copies entry there), sift up compares
+        caller entry directly and copies it once more to its final position.
+    */
+    if (darray_insert(heap->darray, entry) != 0)
+        ERROR("darray_insert error\n", -1);
+
+    __heap_sift_up(heap, heap->darray->num_entries - 1, 0, entry);
+
+    return 0;
+}
+
+
+ssize_t heap_push_with_handle(Heap * __restrict__ heap, const void * __restrict__ entry)
+{
+    if (heap == NULL || entry == NULL)
+        ERROR("heap == NULL || entry == NULL\n", -1);
+
+    if (heap->handle_of == NULL)
+        ERROR("heap is created without handles\n", -1);
+
+    const ssize_t ret = __heap_handle_alloc(heap);
+
+    if (ret < 0)
+        ERROR("__heap_handle_alloc error\n", -1);
+
+    const size_t handle = (size_t)ret;
+
+    if (darray_insert(heap->darray, entry) != 0)
+    {
+        (void)darray_insert(heap->free_handles, (const void *)&handle);
+        ERROR("darray_insert error\n", -1);
+    }
+
+    if (darray_insert(heap->handle_of, (const void *)&handle) != 0)
+    {
+        (void)darray_delete(heap->darray, NULL);
+        (void)darray_insert(heap->free_handles, (const void *)&handle);
+        ERROR("darray_insert error\n", -1);
+    }
+
+    __heap_sift_up(heap, heap->darray->num_entries - 1, handle, entry);
+
+    return ret;
+}
+
+
+int heap_pop(Heap * __restrict__ heap, void * __restrict__ val_out)
+{
+    if (heap == NULL)
+        ERROR("heap == NULL\n", -1);
+
+    if (heap->darray->num_entries == 0)
+        ERROR("heap is empty\n", -1);
+
+    size_t last_handle = 0;
+    const size_t last = heap->darray->num_entries - 1;
+
+    if (heap->handle_of != NULL)
+    {
+        const size_t handle = *__heap_index(heap->handle_of, 0);
+
+        /* only step which can fail, so it goes first */
+        if (darray_insert(heap->free_handles, (const void *)&handle) != 0)
+            ERROR("darray_insert error\n", -1);
+
+        *__heap_index(heap->pos_of, handle) = HEAP_NO_POS;
+        last_handle = *__heap_index(heap->handle_of, last);
+
+        (void)darray_delete(heap->handle_of, NULL);
+    }
+
+    if (val_out != NULL)
+        (void)memcpy(val_out, __heap_entry(heap, 0), heap->darray->size_of);
+
+    /* last entry fills hole at the top */
+    (void)darray_delete(heap->darray, heap->tmp);
+
+    if (last > 0)
+        __heap_sift_down(heap, 0, last_handle);
+
+    return 0;
+}
+
+
+int heap_top(const Heap * __restrict__ heap, void * __restrict__ val_out)
+{
+    if (heap == NULL || val_out == NULL)
+        ERROR("heap == NULL || val_out == NULL\n", -1);
+
+    if (heap->darray->num_entries == 0)
+        ERROR("heap is empty\n", -1);
+
+    (void)memcpy(val_out, __heap_entry(heap, 0), heap->darray->size_of);
+
+    return 0;
+}
+
+
+int heap_build(Heap * __restrict__ heap, const void * __restrict__ array, size_t len)
+{
+    if (heap == NULL || array == NULL)
+        ERROR("heap == NULL || array == NULL\n", -1);
+
+    if (heap->darray->num_entries != 0)
+        ERROR("heap is not empty\n", -1);
+
+    if (len == 0)
+        return 0;
+
+    /* every handle is free when heap is empty, so handles start again from 0 */
+    if (heap->handle_of != NULL)
+    {
+        __heap_darray_clear(heap->pos_of);
+        __heap_darray_clear(heap->free_handles);
+    }
+
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (darray_insert(heap->darray, (const void *)((const BYTE *)array + i * heap->darray->size_of)) != 0)
+            goto error;
+
+        if (heap->handle_of != NULL && (darray_insert(heap->handle_of, (const void *)&i) != 0 || darray_insert(heap->pos_of, (const void *)&i) != 0))
+            goto error;
+    }
+
+    /* Floyd: sift down every parent from the last one, O(n) */
+    for (size_t pos = len > 1 ? (len - 2) / heap->arity + 1 : 0; pos-- > 0; )
+    {
+        (void)memcpy(heap->tmp, __heap_entry(heap, pos), heap->darray->size_of);
+        __heap_sift_down(heap, pos, heap->handle_of != NULL ? *__heap_index(heap->handle_of, pos) : 0);
+    }
+
+    return 0;
+
+error:
+    __heap_darray_clear(heap->darray);
+
+    if (heap->handle_of != NULL)
+    {
+        __heap_darray_clear(heap->handle_of);
+        __heap_darray_clear(heap->pos_of);
+    }
+
+    ERROR("darray_insert error\n", -1);
+}
+
+
+int heap_decrease_key(Heap * __restrict__ heap, size_t handle, const void * __restrict__ entry)
+{
+    if (heap == NULL || entry == NULL)
+        ERROR("heap == NULL || entry == NULL\n", -1);
+
+    if (!heap_contains(heap, handle))
+        ERROR("handle isn't in heap\n", -1);
+
+    const size_t pos = *__heap_index(heap->pos_of, handle);
+
+    if (heap->cmp_f(entry, __heap_entry(heap, pos)) > 0)
+        ERROR("new entry is bigger\n", -1);
+
+    __heap_sift_up(heap, pos, handle, entry);
+
+    return 0;
+}
+
+
+bool heap_contains(const Heap *heap, size_t handle)
+{
+    if (heap == NULL || heap->pos_of == NULL)
+        ERROR("heap == NULL || heap->pos_of == NULL\n", false);
+
+    return handle < heap->pos_of->num_entries && *__heap_index(heap->pos_of, handle) != HEAP_NO_POS;
+}
+
+
+bool heap_is_empty(const Heap *heap)
+{
+    if (heap == NULL)
+        ERROR("heap == NULL\n", false);
+
+    return heap->darray->num_entries == 0;
+}
+
+
+ssize_t heap_get_num_entries(const Heap *heap)
+{
+    if (heap == NULL)
+        ERROR("heap == NULL\n", -1);
+
+    return (ssize_t)heap->darray->num_entries;
+}
+
+
+ssize_t heap_get_data_size(const Heap *heap)
+{
+    if (heap == NULL)
+        ERROR("heap == NULL\n", -1);
+
+    return (ssize_t)heap->darray->size_of;
+}
@@ -0,0 +1,392 @@
+#include <heap.h>
+#include <ctest.h>
+#include <stdint.h>
+
+
+typedef struct MyStruct
+{
+    int64_t key;
+    int64_t a;
+    int64_t *ptr;
+} MyStruct;
+
+
+/* vertex with its distance in dijkstra */
+typedef struct Dist
+{
+    int64_t dist;
+    size_t vertex;
+} Dist;
+
+
+/* functions needed for testing */
+static int my_compare_int64_t(const void *a, const void *b);
+static int my_compare_struct(const void *a, const void *b);
+static int my_compare_dist(const void *a, const void *b);
+static void my_struct_destroy(void *ms);
+
+
+/* unit tests function declaraions */
+static void test_heap_create(void);
+static void test_heap_push_pop(void);
+static void test_heap_build(void);
+static void test_heap_with_entries(void);
+static void test_heap_handles(void);
+static void test_heap_dijkstra(void);
+
+
+/* implementation */
+static int my_compare_int64_t(const void *a, const void *b)
+{
+    const int64_t *x = (const int64_t *)a;
+    const int64_t *y = (const int64_t *)b;
+
+    return (*x > *y) - (*x < *y);
+}
+
+
+static int my_compare_struct(const void *a, const void *b)
+{
+    const MyStruct *x = (const MyStruct *)a;
+    const MyStruct *y = (const MyStruct *)b;
+
+    return (x->key > y->key) - (x->key < y->key);
+}
+
+
+static int my_compare_dist(const void *a, const void *b)
+{
+    const Dist *x = (const Dist *)a;
+    const Dist *y = (const Dist *)b;
+
+    return (x->dist > y->dist) - (x->dist < y->dist);
+}
+
+
+static void my_struct_destroy(void *ms)
+{
+    FREE(((MyStruct *)ms)->ptr);
+}
+
+
+static void test_heap_create(void)
+{
+    Heap *heap = heap_create(sizeof(int64_t), 0, my_compare_int64_t, NULL);
+    T_ERROR(heap == NULL);
+
+    T_ASSERT(heap->arity, HEAP_DEFAULT_ARITY);
+    T_EXPECT(heap_is_empty(heap), (bool)true);
+    T_EXPECT(heap_get_num_entries(heap), (ssize_t)0);
+    T_EXPECT(heap_get_data_size(heap), (ssize_t)sizeof(int64_t));
+
+    heap_destroy(heap);
+
+    T_ASSERT(heap_create(0, 4, my_compare_int64_t, NULL), NULL);
+    T_ASSERT(heap_create(sizeof(int64_t), 4, NULL, NULL), NULL);
+    T_ASSERT(heap_create(sizeof(int64_t), 1, my_compare_int64_t, NULL), NULL);
+    T_ASSERT(heap_create_with_handles(sizeof(int64_t), 1, my_compare_int64_t, NULL), NULL);
+
+    T_EXPECT(heap_is_empty(NULL), (bool)false);
+    T_EXPECT(heap_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(heap_get_data_size(NULL), (ssize_t)-1);
+}
+
+
+static void test_heap_push_pop(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE];
+    int64_t val = 0;
+
+    srand(1234);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)(rand() % 500);
+
+    const size_t arities[] = { 2, 3, 4, 8 };
+
+    for (size_t a = 0; a < ARRAY_SIZE(arities); ++a)
+    {
+        Heap *heap = heap_create(sizeof(int64_t), arities[a], my_compare_int64_t, NULL);
+        T_ERROR(heap == NULL);
+
+        T_CHECK(heap_pop(heap, (void *)&val) != 0);
+        T_CHECK(heap_top(heap, (void *)&val) != 0);
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            T_EXPECT(heap_push(heap, (void *)&arr[i]), 0);
+
+        T_EXPECT(heap_get_num_entries(heap), (ssize_t)ARRAY_TEST_SIZE);
+
+        /* entries go out in order, duplicates included */
+        int64_t prev = INT64_MIN;
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            int64_t top = 0;
+            T_EXPECT(heap_top(heap, (void *)&top), 0);
+            T_EXPECT(heap_pop(heap, (void *)&val), 0);
+            T_ASSERT(val, top);
+            T_CHECK(prev <= val);
+            prev = val;
+        }
+
+        T_EXPECT(heap_is_empty(heap), (bool)true);
+
+        /* interleaved push and pop */
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            T_EXPECT(heap_push(heap, (void *)&arr[i]), 0);
+
+            if (i % 3 == 2)
+                T_EXPECT(heap_pop(heap, NULL), 0);
+        }
+
+        prev = INT64_MIN;
+        while (!heap_is_empty(heap))
+        {
+            T_EXPECT(heap_pop(heap, (void *)&val), 0);
+            T_CHECK(prev <= val);
+            prev = val;
+        }
+
+        T_CHECK(heap_push(NULL, (void *)&val) != 0);
+        T_CHECK(heap_push(heap, NULL) != 0);
+        T_CHECK(heap_pop(NULL, (void *)&val) != 0);
+        T_CHECK(heap_top(heap, NULL) != 0);
+        T_EXPECT(heap_push_with_handle(heap, (void *)&val), (ssize_t)-1);
+
+        heap_destroy(heap);
+    }
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_heap_build(void)
+{
+    #define ARRAY_TEST_SIZE 1001
+
+    int64_t arr[ARRAY_TEST_SIZE];
+    int64_t val = 0;
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)((i * 7919) % ARRAY_TEST_SIZE);
+
+    Heap *heap = heap_create(sizeof(int64_t), 4, my_compare_int64_t, NULL);
+    T_ERROR(heap == NULL);
+
+    T_EXPECT(heap_build(heap, (void *)&arr[0], ARRAY_TEST_SIZE), 0);
+    T_EXPECT(heap_get_num_entries(heap), (ssize_t)ARRAY_TEST_SIZE);
+
+    /* heap has to be empty */
+    T_CHECK(heap_build(heap, (void *)&arr[0], ARRAY_TEST_SIZE) != 0);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(heap_pop(heap, (void *)&val), 0);
+        T_ASSERT(val, i);
+    }
+
+    /* single entry and empty array */
+    T_EXPECT(heap_build(heap, (void *)&arr[0], 1), 0);
+    T_EXPECT(heap_pop(heap, (void *)&val), 0);
+    T_ASSERT(val, arr[0]);
+    T_EXPECT(heap_build(heap, (void *)&arr[0], 0), 0);
+    T_EXPECT(heap_is_empty(heap), (bool)true);
+
+    T_CHECK(heap_build(heap, NULL, 1) != 0);
+
+    heap_destroy(heap);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_heap_with_entries(void)
+{
+    #define ARRAY_TEST_SIZE 20
+
+    MyStruct ms;
+
+    Heap *heap = heap_create(sizeof(MyStruct), 0, my_compare_struct, my_struct_destroy);
+    T_ERROR(heap == NULL);
+
+    for (int64_t i = ARRAY_TEST_SIZE; i > 0; --i)
+    {
+        ms.key = i;
+        ms.a = 0;
+        ms.ptr = (int64_t *)malloc(sizeof(int64_t));
+        T_ERROR(ms.ptr == NULL);
+
+        T_EXPECT(heap_push(heap, (void *)&ms), 0);
+    }
+
+    T_EXPECT(heap_pop(heap, (void *)&ms), 0);
+    T_ASSERT(ms.key, (int64_t)1);
+    my_struct_destroy((void *)&ms);
+
+    /* rest of entries freed by destroy_f */
+    heap_destroy_with_entries(heap);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_heap_handles(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    int64_t val = 0;
+    ssize_t handles[ARRAY_TEST_SIZE];
+
+    Heap *heap = heap_create_with_handles(sizeof(int64_t), 4, my_compare_int64_t, NULL);
+    T_ERROR(heap == NULL);
+
+    /* keys 1000 .. 1099, handle i has key 1000 + i */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        val = 1000 + (int64_t)i;
+        handles[i] = heap_push_with_handle(heap, (void *)&val);
+        T_ASSERT(handles[i], (ssize_t)i);
+        T_EXPECT(heap_contains(heap, (size_t)handles[i]), (bool)true);
+    }
+
+    /* reverse order with decrease key */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        val = (int64_t)(ARRAY_TEST_SIZE - i);
+        T_EXPECT(heap_decrease_key(heap, (size_t)handles[i], (void *)&val), 0);
+    }
+
+    /* key can't grow */
+    val = 5000;
+    T_CHECK(heap_decrease_key(heap, 0, (void *)&val) != 0);
+
+    T_EXPECT(heap_top(heap, (void *)&val), 0);
+    T_ASSERT(val, (int64_t)1);
+
+    /* handle of popped entry is not in heap and is reused */
+    T_EXPECT(heap_pop(heap, (void *)&val), 0);
+    T_EXPECT(heap_contains(heap, ARRAY_TEST_SIZE - 1), (bool)false);
+    T_CHECK(heap_decrease_key(heap, ARRAY_TEST_SIZE - 1, (void *)&val) != 0);
+    T_EXPECT(heap_contains(heap, ARRAY_TEST_SIZE), (bool)false);
+
+    val = 0;
+    T_EXPECT(heap_push_with_handle(heap, (void *)&val), (ssize_t)(ARRAY_TEST_SIZE - 1));
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(heap_pop(heap, (void *)&val), 0);
+        T_ASSERT(val, i == 0 ? 0 : i + 1);
+    }
+
+    T_EXPECT(heap_is_empty(heap), (bool)true);
+
+    /* build on empty heap starts handles from 0 */
+    const int64_t arr[] = { 50, 40, 30, 20, 10 };
+    T_EXPECT(heap_build(heap, (const void *)&arr[0], ARRAY_SIZE(arr)), 0);
+
+    val = 5;
+    T_EXPECT(heap_decrease_key(heap, 0, (void *)&val), 0);
+    T_EXPECT(heap_top(heap, (void *)&val), 0);
+    T_ASSERT(val, (int64_t)5);
+
+    for (size_t i = 0; i < ARRAY_SIZE(arr); ++i)
+        T_EXPECT(heap_contains(heap, i), (bool)true);
+
+    T_EXPECT(heap_contains(heap, ARRAY_SIZE(arr)), (bool)false);
+
+    heap_destroy(heap);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_heap_dijkstra(void)
+{
+    #define VERTICES 64
+
+    /* grid 8 x 8, edge weight depends on vertices */
+    int64_t dist[VERTICES];
+    int64_t expt[VERTICES];
+    ssize_t handle[VERTICES];
+    Dist d;
+
+    Heap *heap = heap_create_with_handles(sizeof(Dist), 4, my_compare_dist, NULL);
+    T_ERROR(heap == NULL);
+
+    for (size_t v = 0; v < VERTICES; ++v)
+    {
+        dist[v] = v == 0 ? 0 : INT64_MAX;
+        d = (Dist){ .dist = dist[v], .vertex = v };
+        handle[v] = heap_push_with_handle(heap, (void *)&d);
+        T_ASSERT(handle[v], (ssize_t)v);
+    }
+
+    while (!heap_is_empty(heap))
+    {
+        T_EXPECT(heap_pop(heap, (void *)&d), 0);
+
+        const size_t u = d.vertex;
+        const size_t neighbours[] = { u + 1, u - 1, u + 8, u - 8 };
+        const bool valid[] = { u % 8 != 7, u % 8 != 0, u < VERTICES - 8, u >= 8 };
+
+        for (size_t i = 0; i < ARRAY_SIZE(neighbours); ++i)
+        {
+            const size_t v = neighbours[i];
+
+            if (!valid[i] || !heap_contains(heap, (size_t)handle[v]))
+                continue;
+
+            const int64_t w = (int64_t)((u + v) % 5 + 1);
+
+            if (dist[u] + w < dist[v])
+            {
+                dist[v] = dist[u] + w;
+                d = (Dist){ .dist = dist[v], .vertex = v };
+                T_EXPECT(heap_decrease_key(heap, (size_t)handle[v], (void *)&d), 0);
+            }
+        }
+    }
+
+    /* Bellman-Ford as reference */
+    for (size_t v = 0; v < VERTICES; ++v)
+        expt[v] = v == 0 ? 0 : INT64_MAX;
+
+    for (size_t round = 0; round < VERTICES; ++round)
+        for (size_t u = 0; u < VERTICES; ++u)
+        {
+            if (expt[u] == INT64_MAX)
+                continue;
+
+            const size_t neighbours[] = { u + 1, u - 1, u + 8, u - 8 };
+            const bool valid[] = { u % 8 != 7, u % 8 != 0, u < VERTICES - 8, u >= 8 };
+
+            for (size_t i = 0; i < ARRAY_SIZE(neighbours); ++i)
+                if (valid[i] && expt[u] + (int64_t)((u + neighbours[i]) % 5 + 1) < expt[neighbours[i]])
+                    expt[neighbours[i]] = expt[u] + (int64_t)((u + neighbours[i]) % 5 + 1);
+        }
+
+    for (size_t v = 0; v < VERTICES; ++v)
+        T_ASSERT(dist[v], expt[v]);
+
+    heap_destroy(heap);
+
+    #undef VERTICES
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING HEAP");
+    TEST(test_heap_create());
+    TEST(test_heap_push_pop());
+    TEST(test_heap_build());
+    TEST(test_heap_with_entries());
+    TEST(test_heap_handles());
+    TEST(test_heap_dijkstra());
+    TEST_SUMMARY();
+
+    return 0;
+}
@@ -0,0 +1,544 @@
+#ifndef ILIST_H
+#define ILIST_H
+
+
+/*
+    Intrusive doubly linked list implementation
+
+    Link (Ilist_node) lives inside user struct, so list never allocates
+    and never copies data. Use container_of / ilist_entry to get user struct
+    from node. List is circular with head node embedded in Ilist,
+    so every operation is O(1) without special cases for ends.
+
+    All functions are inline, node has to be linked in given list
+    (or unlinked, for insert functions). Arguments are checked (NULL,
+    unlink of head) only in debug build, compile with -DILIST_DEBUG
+    to enable checks.
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <stddef.h> /* size_t */
+#include <stdbool.h> /* bool */
+#include <sys/types.h> /* ssize_t */
+#include <common.h> /* container_of */
+
+
+typedef struct Ilist_node
+{
+    struct Ilist_node* next_p;    /* pointer to next node */
+    struct Ilist_node* prev_p;    /* pointer to previous node */
+} Ilist_node;
+
+
+typedef struct Ilist
+{
+    Ilist_node head;              /* head.next_p is first, head.prev_p is last */
+    size_t length;                /* number of linked nodes */
+} Ilist;
+
+
+/* get user struct of @type from node @ptr which is @member of @type */
+#define ilist_entry(ptr, type, member) container_of(ptr, type, member)
+
+
+/* iterate over list, node_p can't be unlinked in loop */
+#define ilist_for_each(node_p, list_p) \
+    for ((node_p) = (list_p)->head.next_p; (node_p) != &(list_p)->head; (node_p) = (node_p)->next_p)
+
+
+/* iterate over list, node_p can be unlinked in loop (next_p holds next node) */
+#define ilist_for_each_safe(node_p, next_p, list_p) \
+    for ((node_p) = (list_p)->head.next_p, (next_p) = (node_p)->next_p; \
+         (node_p) != &(list_p)->head; \
+         (node_p) = (next_p), (next_p) = (node_p)->next_p)
+
+
+/*
+    Init empty list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_init(Ilist* list_p);
+
+
+/*
+    Init node as unlinked (node points to itself).
+
+    PARAMS:
+    @IN node_p - pointer to node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_node_init(Ilist_node* node_p);
+
+
+/*
+    Check if node is linked in some list (node has to be inited or linked).
+
+    PARAMS:
+    @IN node_p - pointer to node.
+
+    RETURN:
+    %true if node is linked.
+    %false if node is unlinked.
+*/
+static ___inline___ bool ilist_node_is_linked(const Ilist_node* node_p);
+
+
+/*
+    Check if list is empty.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+
+    RETURN:
+    %true if list is empty.
+    %false if list has entries.
+*/
+static ___inline___ bool ilist_is_empty(const Ilist* list_p);
+
+
+/*
+    Get number of entries in list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+
+    RETURN:
+    %-1 if failure.
+    %number of entries.
+*/
+static ___inline___ ssize_t ilist_get_num_entries(const Ilist* list_p);
+
+
+/*
+    Insert node after pos_p (pos_p can be &list_p->head).
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN pos_p - pointer to node in list.
+    @IN node_p - pointer to inserted node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_insert_after(Ilist* list_p, Ilist_node* pos_p, Ilist_node* node_p);
+
+
+/*
+    Insert node before pos_p (pos_p can be &list_p->head).
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN pos_p - pointer to node in list.
+    @IN node_p - pointer to inserted node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_insert_before(Ilist* list_p, Ilist_node* pos_p, Ilist_node* node_p);
+
+
+/*
+    Insert node at the beginning of list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN node_p - pointer to inserted node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_push_front(Ilist* list_p, Ilist_node* node_p);
+
+
+/*
+    Insert node at the end of list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN node_p - pointer to inserted node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_push_back(Ilist* list_p, Ilist_node* node_p);
+
+
+/*
+    Unlink node from list, node is left unlinked (inited).
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN node_p - pointer to node in list.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_unlink(Ilist* list_p, Ilist_node* node_p);
+
+
+/*
+    Get first node of list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+
+    RETURN:
+    %NULL if list is empty.
+    %Pointer to first node.
+*/
+static ___inline___ Ilist_node* ilist_front(const Ilist* list_p);
+
+
+/*
+    Get last node of list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+
+    RETURN:
+    %NULL if list is empty.
+    %Pointer to last node.
+*/
+static ___inline___ Ilist_node* ilist_back(const Ilist* list_p);
+
+
+/*
+    Unlink first node of list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+
+    RETURN:
+    %NULL if list is empty.
+    %Pointer to unlinked node.
+*/
+static ___inline___ Ilist_node* ilist_pop_front(Ilist* list_p);
+
+
+/*
+    Unlink last node of list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+
+    RETURN:
+    %NULL if list is empty.
+    %Pointer to unlinked node.
+*/
+static ___inline___ Ilist_node* ilist_pop_back(Ilist* list_p);
+
+
+/*
+    Move node linked in list to the beginning of list (LRU touch).
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN node_p - pointer to node in list.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_move_front(Ilist* list_p, Ilist_node* node_p);
+
+
+/*
+    Move node linked in list to the end of list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN node_p - pointer to node in list.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_move_back(Ilist* list_p, Ilist_node* node_p);
+
+
+/*
+    Move all nodes from src_p to the beginning of dst_p, src_p is left empty.
+
+    PARAMS:
+    @IN dst_p - pointer to destination list.
+    @IN src_p - pointer to source list.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_splice_front(Ilist* __restrict__ dst_p, Ilist* __restrict__ src_p);
+
+
+/*
+    Move all nodes from src_p to the end of dst_p, src_p is left empty.
+
+    PARAMS:
+    @IN dst_p - pointer to destination list.
+    @IN src_p - pointer to source list.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void ilist_splice_back(Ilist* __restrict__ dst_p, Ilist* __restrict__ src_p);
+
+
+/*
+    Link nodes between prev_p and next_p.
+
+    PARAMS:
+    @IN prev_p - pointer to previous node.
+    @IN node_p - pointer to inserted node.
+    @IN next_p - pointer to next node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __ilist_link(Ilist_node* prev_p, Ilist_node* node_p, Ilist_node* next_p);
+
+
+/*
+    Link all nodes of src_p between prev_p and next_p.
+
+    PARAMS:
+    @IN dst_p - pointer to destination list.
+    @IN src_p - pointer to source list.
+    @IN prev_p - pointer to previous node.
+    @IN next_p - pointer to next node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __ilist_splice(Ilist* __restrict__ dst_p, Ilist* __restrict__ src_p, Ilist_node* prev_p, Ilist_node* next_p);
+
+
+static ___inline___ void __ilist_link(Ilist_node* prev_p, Ilist_node* node_p, Ilist_node* next_p)
+{
+    node_p->prev_p = prev_p;
+    node_p->next_p = next_p;
+    prev_p->next_p = node_p;
+    next_p->prev_p = node_p;
+}
+
+
+static ___inline___ void __ilist_splice(Ilist* __restrict__ dst_p, Ilist* __restrict__ src_p, Ilist_node* prev_p, Ilist_node* next_p)
+{
+    if (ilist_is_empty(src_p))
+        return;
+
+    Ilist_node* first_p = src_p->head.next_p;
+    Ilist_node* last_p = src_p->head.prev_p;
+
+    first_p->prev_p = prev_p;
+    prev_p->next_p = first_p;
+    last_p->next_p = next_p;
+    next_p->prev_p = last_p;
+
+    dst_p->length += src_p->length;
+    ilist_init(src_p);
+}
+
+
+static ___inline___ void ilist_init(Ilist* list_p)
+{
+#ifdef ILIST_DEBUG
+    if (list_p == NULL)
+        VERROR("list_p == NULL\n");
+#endif
+
+    list_p->head.next_p = &list_p->head;
+    list_p->head.prev_p = &list_p->head;
+    list_p->length = 0;
+}
+
+
+static ___inline___ void ilist_node_init(Ilist_node* node_p)
+{
+#ifdef ILIST_DEBUG
+    if (node_p == NULL)
+        VERROR("node_p == NULL\n");
+#endif
+
+    node_p->next_p = node_p;
+    node_p->prev_p = node_p;
+}
+
+
+static ___inline___ bool ilist_node_is_linked(const Ilist_node* node_p)
+{
+#ifdef ILIST_DEBUG
+    if (node_p == NULL)
+        ERROR("node_p == NULL\n", false);
+#endif
+
+    return node_p->next_p != node_p;
+}
+
+
+static ___inline___ bool ilist_is_empty(const Ilist* list_p)
+{
+#ifdef ILIST_DEBUG
+    /* NULL list is reported as empty, so front / back / pop return NULL for it */
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", true);
+#endif
+
+    return list_p->length == 0;
+}
+
+
+static ___inline___ ssize_t ilist_get_num_entries(const Ilist* list_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    return (ssize_t)list_p->length;
+}
+
+
+static ___inline___ void ilist_insert_after(Ilist* list_p, Ilist_node* pos_p, Ilist_node* node_p)
+{
+#ifdef ILIST_DEBUG
+    if (list_p == NULL || pos_p == NULL || node_p == NULL)
+        VERROR("list_p == NULL || pos_p == NULL || node_p == NULL\n");
+#endif
+
+    __ilist_link(pos_p, node_p, pos_p->next_p);
+    ++list_p->length;
+}
+
+
+static ___inline___ void ilist_insert_before(Ilist* list_p, Ilist_node* pos_p, Ilist_node* node_p)
+{
+#ifdef ILIST_DEBUG
+    if (list_p == NULL || pos_p == NULL || node_p == NULL)
+        VERROR("list_p == NULL || pos_p == NULL || node_p == NULL\n");
+#endif
+
+    __ilist_link(pos_p->prev_p, node_p, pos_p);
+    ++list_p->length;
+}
+
+
+static ___inline___ void ilist_push_front(Ilist* list_p, Ilist_node* node_p)
+{
+    ilist_insert_after(list_p, &list_p->head, node_p);
+}
+
+
+static ___inline___ void ilist_push_back(Ilist* list_p, Ilist_node* node_p)
+{
+    ilist_insert_before(list_p, &list_p->head, node_p);
+}
+
+
+static ___inline___ void ilist_unlink(Ilist* list_p, Ilist_node* node_p)
+{
+#ifdef ILIST_DEBUG
+    if (list_p == NULL || node_p == NULL)
+        VERROR("list_p == NULL || node_p == NULL\n");
+
+    if (node_p == &list_p->head || list_p->length == 0)
+        VERROR("node_p == &list_p->head || list_p->length == 0\n");
+#endif
+
+    node_p->prev_p->next_p = node_p->next_p;
+    node_p->next_p->prev_p = node_p->prev_p;
+    ilist_node_init(node_p);
+
+    --list_p->length;
+}
+
+
+static ___inline___ Ilist_node* ilist_front(const Ilist* list_p)
+{
+    return ilist_is_empty(list_p) ? NULL : list_p->head.next_p;
+}
+
+
+static ___inline___ Ilist_node* ilist_back(const Ilist* list_p)
+{
+    return ilist_is_empty(list_p) ? NULL : list_p->head.prev_p;
+}
+
+
+static ___inline___ Ilist_node* ilist_pop_front(Ilist* list_p)
+{
+    Ilist_node* node_p = ilist_front(list_p);
+
+    if (node_p != NULL)
+        ilist_unlink(list_p, node_p);
+
+    return node_p;
+}
+
+
+static ___inline___ Ilist_node* ilist_pop_back(Ilist* list_p)
+{
+    Ilist_node* node_p = ilist_back(list_p);
+
+    if (node_p != NULL)
+        ilist_unlink(list_p, node_p);
+
+    return node_p;
+}
+
+
+static ___inline___ void ilist_move_front(Ilist* list_p, Ilist_node* node_p)
+{
+#ifdef ILIST_DEBUG
+    if (list_p == NULL || node_p == NULL)
+        VERROR("list_p == NULL || node_p == NULL\n");
+#endif
+
+    node_p->prev_p->next_p = node_p->next_p;
+    node_p->next_p->prev_p = node_p->prev_p;
+    __ilist_link(&list_p->head, node_p, list_p->head.next_p);
+}
+
+
+static ___inline___ void ilist_move_back(Ilist* list_p, Ilist_node* node_p)
+{
+#ifdef ILIST_DEBUG
+    if (list_p == NULL || node_p == NULL)
+        VERROR("list_p == NULL || node_p == NULL\n");
+#endif
+
+    node_p->prev_p->next_p = node_p->next_p;
+    node_p->next_p->prev_p = node_p->prev_p;
+    __ilist_link(list_p->head.prev_p, node_p, &list_p->head);
+}
+
+
+static ___inline___ void ilist_splice_front(Ilist* __restrict__ dst_p, Ilist* __restrict__ src_p)
+{
+#ifdef ILIST_DEBUG
+    if (dst_p == NULL || src_p == NULL)
+        VERROR("dst_p == NULL || src_p == NULL\n");
+#endif
+
+    __ilist_splice(dst_p, src_p, &dst_p->head, dst_p->head.next_p);
+}
+
+
+static ___inline___ void ilist_splice_back(Ilist* __restrict__ dst_p, Ilist* __restrict__ src_p)
+{
+#ifdef ILIST_DEBUG
+    if (dst_p == NULL || src_p == NULL)
+        VERROR("dst_p == NULL || src_p == NULL\n");
+#endif
+
+    __ilist_splice(dst_p, src_p, dst_p->head.prev_p, &dst_p->head);
+}
+
+
+#endif /* ILIST_H */
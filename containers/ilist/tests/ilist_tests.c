@@ -0,0 +1,282 @@
+#include <ilist.h>
+#include <ctest.h>
+#include <stdint.h>
+
+
+typedef struct MyStruct
+{
+    int64_t key;
+    Ilist_node node;
+    int64_t a;
+} MyStruct;
+
+
+/* functions needed for testing */
+static void my_struct_init(MyStruct* ms_p, size_t len);
+static int check_order(const Ilist* list_p, const int64_t* keys_p, size_t len);
+
+
+/* unit tests function declaraions */
+static void test_ilist_init_empty(void);
+static void test_ilist_push_pop(void);
+static void test_ilist_unlink(void);
+static void test_ilist_insert_move(void);
+static void test_ilist_splice(void);
+
+
+/* implementation */
+static void my_struct_init(MyStruct* ms_p, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        ms_p[i].key = (int64_t)i;
+        ms_p[i].a = 0;
+        ilist_node_init(&ms_p[i].node);
+    }
+}
+
+
+/* check both directions of list */
+static int check_order(const Ilist* list_p, const int64_t* keys_p, size_t len)
+{
+    if ((size_t)ilist_get_num_entries(list_p) != len)
+        return 1;
+
+    size_t i = 0;
+    Ilist_node* node_p = NULL;
+
+    ilist_for_each(node_p, list_p)
+    {
+        if (i == len || ilist_entry(node_p, MyStruct, node)->key != keys_p[i])
+            return 1;
+        ++i;
+    }
+
+    if (i != len)
+        return 1;
+
+    for (node_p = list_p->head.prev_p; node_p != &list_p->head; node_p = node_p->prev_p)
+        if (ilist_entry(node_p, MyStruct, node)->key != keys_p[--i])
+            return 1;
+
+    return 0;
+}
+
+
+static void test_ilist_init_empty(void)
+{
+    Ilist list;
+    MyStruct ms;
+
+    ilist_init(&list);
+    my_struct_init(&ms, 1);
+
+    T_EXPECT(ilist_is_empty(&list), (bool)true);
+    T_EXPECT(ilist_get_num_entries(&list), (ssize_t)0);
+    T_EXPECT(ilist_get_num_entries(NULL), (ssize_t)-1);
+    T_ASSERT(ilist_front(&list), NULL);
+    T_ASSERT(ilist_back(&list), NULL);
+    T_ASSERT(ilist_pop_front(&list), NULL);
+    T_ASSERT(ilist_pop_back(&list), NULL);
+    T_EXPECT(ilist_node_is_linked(&ms.node), (bool)false);
+
+    T_ASSERT(ilist_entry(&ms.node, MyStruct, node), &ms);
+
+#ifdef ILIST_DEBUG
+    T_EXPECT(ilist_is_empty(NULL), (bool)true);
+    T_EXPECT(ilist_node_is_linked(NULL), (bool)false);
+    T_ASSERT(ilist_front(NULL), NULL);
+    T_ASSERT(ilist_pop_back(NULL), NULL);
+
+    /* list is not changed by bad arguments */
+    ilist_insert_after(NULL, &list.head, &ms.node);
+    ilist_insert_before(&list, &list.head, NULL);
+    ilist_unlink(&list, &list.head);
+    ilist_unlink(&list, &ms.node);
+    ilist_splice_back(&list, NULL);
+
+    T_EXPECT(ilist_get_num_entries(&list), (ssize_t)0);
+    T_EXPECT(ilist_node_is_linked(&ms.node), (bool)false);
+#endif
+}
+
+
+static void test_ilist_push_pop(void)
+{
+    #define ARRAY_TEST_SIZE 10
+
+    Ilist list;
+    MyStruct ms[ARRAY_TEST_SIZE];
+    int64_t keys[ARRAY_TEST_SIZE];
+
+    ilist_init(&list);
+    my_struct_init(&ms[0], ARRAY_TEST_SIZE);
+
+    /* 4 3 2 1 0 5 6 7 8 9 */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE / 2; ++i)
+        ilist_push_front(&list, &ms[i].node);
+
+    for (size_t i = ARRAY_TEST_SIZE / 2; i < ARRAY_TEST_SIZE; ++i)
+        ilist_push_back(&list, &ms[i].node);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE / 2; ++i)
+        keys[i] = (int64_t)(ARRAY_TEST_SIZE / 2 - 1 - i);
+
+    for (size_t i = ARRAY_TEST_SIZE / 2; i < ARRAY_TEST_SIZE; ++i)
+        keys[i] = (int64_t)i;
+
+    T_EXPECT(check_order(&list, &keys[0], ARRAY_TEST_SIZE), 0);
+    T_EXPECT(ilist_node_is_linked(&ms[0].node), (bool)true);
+
+    T_ASSERT(ilist_front(&list), &ms[ARRAY_TEST_SIZE / 2 - 1].node);
+    T_ASSERT(ilist_back(&list), &ms[ARRAY_TEST_SIZE - 1].node);
+
+    T_ASSERT(ilist_pop_front(&list), &ms[ARRAY_TEST_SIZE / 2 - 1].node);
+    T_ASSERT(ilist_pop_back(&list), &ms[ARRAY_TEST_SIZE - 1].node);
+    T_EXPECT(ilist_node_is_linked(&ms[ARRAY_TEST_SIZE - 1].node), (bool)false);
+    T_EXPECT(check_order(&list, &keys[1], ARRAY_TEST_SIZE - 2), 0);
+
+    while (ilist_pop_front(&list) != NULL)
+        ;
+
+    T_EXPECT(ilist_is_empty(&list), (bool)true);
+    T_EXPECT(check_order(&list, &keys[0], 0), 0);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_ilist_unlink(void)
+{
+    #define ARRAY_TEST_SIZE 10
+
+    Ilist list;
+    MyStruct ms[ARRAY_TEST_SIZE];
+    int64_t keys[ARRAY_TEST_SIZE / 2];
+    Ilist_node* node_p = NULL;
+    Ilist_node* next_p = NULL;
+
+    ilist_init(&list);
+    my_struct_init(&ms[0], ARRAY_TEST_SIZE);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        ilist_push_back(&list, &ms[i].node);
+
+    /* unlink odd keys during iteration */
+    ilist_for_each_safe(node_p, next_p, &list)
+        if (ilist_entry(node_p, MyStruct, node)->key & 1)
+            ilist_unlink(&list, node_p);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE / 2; ++i)
+        keys[i] = (int64_t)(2 * i);
+
+    T_EXPECT(check_order(&list, &keys[0], ARRAY_TEST_SIZE / 2), 0);
+
+    /* unlink first, last and middle */
+    ilist_unlink(&list, &ms[0].node);
+    ilist_unlink(&list, &ms[ARRAY_TEST_SIZE - 2].node);
+    ilist_unlink(&list, &ms[4].node);
+
+    const int64_t keys_left[] = { 2, 6 };
+    T_EXPECT(check_order(&list, &keys_left[0], ARRAY_SIZE(keys_left)), 0);
+
+    /* unlinked node can be linked again */
+    ilist_push_front(&list, &ms[4].node);
+
+    const int64_t keys_again[] = { 4, 2, 6 };
+    T_EXPECT(check_order(&list, &keys_again[0], ARRAY_SIZE(keys_again)), 0);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_ilist_insert_move(void)
+{
+    #define ARRAY_TEST_SIZE 5
+
+    Ilist list;
+    MyStruct ms[ARRAY_TEST_SIZE];
+
+    ilist_init(&list);
+    my_struct_init(&ms[0], ARRAY_TEST_SIZE);
+
+    ilist_push_back(&list, &ms[0].node);
+    ilist_push_back(&list, &ms[4].node);
+    ilist_insert_after(&list, &ms[0].node, &ms[2].node);
+    ilist_insert_before(&list, &ms[2].node, &ms[1].node);
+    ilist_insert_after(&list, &ms[2].node, &ms[3].node);
+
+    const int64_t keys[] = { 0, 1, 2, 3, 4 };
+    T_EXPECT(check_order(&list, &keys[0], ARRAY_SIZE(keys)), 0);
+
+    /* LRU: touched entries go to the front, victim is at the back */
+    ilist_move_front(&list, &ms[3].node);
+    ilist_move_front(&list, &ms[1].node);
+    ilist_move_back(&list, &ms[0].node);
+    ilist_move_front(&list, &ms[1].node);
+
+    const int64_t keys_lru[] = { 1, 3, 2, 4, 0 };
+    T_EXPECT(check_order(&list, &keys_lru[0], ARRAY_SIZE(keys_lru)), 0);
+    T_ASSERT(ilist_entry(ilist_pop_back(&list), MyStruct, node), &ms[0]);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_ilist_splice(void)
+{
+    #define ARRAY_TEST_SIZE 6
+
+    Ilist list1;
+    Ilist list2;
+    Ilist empty;
+    MyStruct ms[ARRAY_TEST_SIZE];
+
+    ilist_init(&list1);
+    ilist_init(&list2);
+    ilist_init(&empty);
+    my_struct_init(&ms[0], ARRAY_TEST_SIZE);
+
+    ilist_push_back(&list1, &ms[2].node);
+    ilist_push_back(&list1, &ms[3].node);
+
+    ilist_push_back(&list2, &ms[0].node);
+    ilist_push_back(&list2, &ms[1].node);
+
+    ilist_splice_front(&list1, &list2);
+    T_EXPECT(ilist_is_empty(&list2), (bool)true);
+
+    const int64_t keys[] = { 0, 1, 2, 3 };
+    T_EXPECT(check_order(&list1, &keys[0], ARRAY_SIZE(keys)), 0);
+
+    ilist_push_back(&list2, &ms[4].node);
+    ilist_push_back(&list2, &ms[5].node);
+
+    ilist_splice_back(&list1, &list2);
+    ilist_splice_back(&list1, &empty);
+    T_EXPECT(ilist_is_empty(&list2), (bool)true);
+
+    const int64_t keys_all[] = { 0, 1, 2, 3, 4, 5 };
+    T_EXPECT(check_order(&list1, &keys_all[0], ARRAY_SIZE(keys_all)), 0);
+
+    /* splice to empty list */
+    ilist_splice_back(&list2, &list1);
+    T_EXPECT(ilist_is_empty(&list1), (bool)true);
+    T_EXPECT(check_order(&list2, &keys_all[0], ARRAY_SIZE(keys_all)), 0);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING INTRUSIVE LIST");
+    TEST(test_ilist_init_empty());
+    TEST(test_ilist_push_pop());
+    TEST(test_ilist_unlink());
+    TEST(test_ilist_insert_move());
+    TEST(test_ilist_splice());
+    TEST_SUMMARY();
+
+    return 0;
+}
@@ -21,6 +21,13 @@ typedef struct List List;
 typedef struct List_node List_node;
 
 
+typedef enum LIST_TYPE
+{
+    LIST_LINKED = 0,        /* one entry per node */
+    LIST_UNROLLED           /* sorted block of entries per node (few cache lines) */
+} LIST_TYPE;
+
+
 /*
     Create new instance of list.
 
@@ -37,6 +44,44 @@ typedef struct List_node List_node;
 List* list_create(size_t size_of, compare_f cmp_f, destructor_f destroy_f);
 
 
+/*
+    Create new instance of list with given storage type.
+    LIST_UNROLLED keeps small sorted blocks of entries in each node,
+    so traversal touches one node per block instead of one node per entry.
+    API and results are the same for both types.
+
+    PARAMS:
+    @IN type - type of list.
+    @IN size_of - size of element.
+    @IN cmp_f - pointer to compare function.
+    @IN destroy_f - pointer to destructor function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to list if success.
+*/
+List* list_create_with_type(LIST_TYPE type, size_t size_of, compare_f cmp_f, destructor_f destroy_f);
+
+
+/*
+    Create new instance of list from sorted array in O(n).
+    All nodes (blocks) are taken from one pooled allocation.
+
+    PARAMS:
+    @IN type - type of list.
+    @IN array_p - pointer to sorted array.
+    @IN len - number of entries in array_p.
+    @IN size_of - size of element.
+    @IN cmp_f - pointer to compare function.
+    @IN destroy_f - pointer to destructor function.
+
+    RETURN:
+    %NULL if failure (also if array_p is not sorted).
+    %Pointer to list if success.
+*/
+List* list_create_from_sorted_array(LIST_TYPE type, const void* __restrict__ array_p, size_t len, size_t size_of, compare_f cmp_f, destructor_f destroy_f);
+
+
 /*
     Destroy list.
 
@@ -63,6 +108,8 @@ void list_destroy_with_entries(List* list_p);
 
 /*
     Insert element to sorted list.
+    Entry >= tail is appended in O(1), otherwise scan starts after
+    the last inserted entry if it is <= entry (locally ordered streams).
 
     PARAMS:
     @IN list_p - pointer to list.
@@ -179,6 +226,72 @@ int list_search(const List* __restrict__ list_p, const void* entry_p, void* val_
 int list_to_array(const List* __restrict__ list_p, void* __restrict__ array, size_t* __restrict__ size_p);
 
 
+/*
+    Copy list_p entries to buffer provided by caller (no allocation).
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @OUT buffer_p - pointer to buffer.
+    @IN capacity - number of entries which fit in buffer_p.
+    @OUT size_p - pointer to number of copied entries (required capacity if buffer is too small).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int list_to_array_buffer(const List* __restrict__ list_p, void* __restrict__ buffer_p, size_t capacity, size_t* __restrict__ size_p);
+
+
+/*
+    Export list_p entries in chunks of @chunk_len entries.
+    Chunk buffer is filled in order and passed to @consume_f, last chunk can be shorter.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN chunk_p - pointer to chunk buffer provided by caller.
+    @IN chunk_len - number of entries which fit in chunk_p.
+    @IN consume_f - pointer to chunk consumer function.
+    @IN arg_p - user argument passed to consume_f.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+    %value returned by consume_f if it stopped export.
+*/
+int list_to_array_chunks(const List* __restrict__ list_p, void* __restrict__ chunk_p, size_t chunk_len, chunk_f consume_f, void* arg_p);
+
+
+/*
+    Merge all entries of src_p into dst_p in O(n + m), src_p is left empty.
+    Nodes are relinked without copying data (unrolled lists copy entries between blocks
+    unless src_p goes after dst_p). Equal entries from dst_p stay before entries from src_p.
+    Lists have to be the same type, size of element and compare function.
+
+    PARAMS:
+    @IN dst_p - pointer to destination list.
+    @IN src_p - pointer to source list.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure (both lists are left unchanged).
+*/
+int list_merge(List* __restrict__ dst_p, List* __restrict__ src_p);
+
+
+/*
+    Split list, all entries >= entry_p are moved to new list.
+
+    PARAMS:
+    @IN list_p - pointer to list.
+    @IN entry_p - pointer to entry (key of split).
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to new list (may be empty) if success.
+*/
+List* list_split_at(List* __restrict__ list_p, const void* __restrict__ entry_p);
+
+
 /*
     Get number of entries in list.
 
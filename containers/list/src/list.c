@@ -9,18 +9,46 @@
 struct List_node
 {
     struct List_node* next_p;     /* pointer to next_p node */
-    size_t size_of;             /* size of node */
 
     BYTE data_p[];                /* placeholder for data_p */
 };
 
 
-struct List
+typedef struct List_slab
 {
-    List_node* head_p;            /* pointer to head_p */
-    List_node* tail_p;            /* pointer to tail_p */
+    struct List_slab* next_p;     /* pointer to next slab */
+
+    BYTE nodes_p[];               /* placeholder for pooled nodes */
+} List_slab;
+
+
+typedef struct List_block
+{
+    struct List_block* next_p;    /* pointer to next block (first field, like in List_node) */
+    size_t entries;               /* number of entries in block */
+
+    BYTE data_p[];                /* placeholder for sorted entries */
+} List_block;
+
 
-    size_t length;              /* num of nodes in list_p */
+struct List
+{
+    List_node* head_p;            /* pointer to head_p (sentinel_p if empty) */
+    List_node* tail_p;            /* pointer to tail_p (NULL if empty) */
+    List_node* sentinel_p;        /* permanent guard node after tail_p */
+    List_node* finger_p;          /* last inserted node, start of next scan (NULL if unknown) */
+
+    List_node* free_p;            /* free list of pooled nodes */
+    List_slab* slabs_p;           /* slabs owned by node pool */
+    size_t slab_nodes;            /* number of nodes in next slab */
+    size_t node_size;             /* size of pooled node */
+
+    LIST_TYPE type;               /* type of list_p (linked / unrolled) */
+    List_block* first_block_p;    /* pointer to first block (LIST_UNROLLED) */
+    List_block* last_block_p;     /* pointer to last block (LIST_UNROLLED) */
+    size_t block_entries;         /* capacity of block (LIST_UNROLLED) */
+
+    size_t length;              /* num of entries in list_p */
     size_t size_of;             /* size of element */
 
     compare_f cmp_f;            /* compare function */
@@ -28,16 +56,58 @@ struct List
 };
 
 
+/* first slab of node pool, next slabs are twice bigger up to LIST_SLAB_MAX_NODES */
+#define LIST_SLAB_MIN_NODES ((size_t)16)
+#define LIST_SLAB_MAX_NODES ((size_t)4096)
+
+/*
+    Unrolled merge takes output block only when previous one is full and frees input block
+    as soon as it is consumed, so it never needs more free blocks than this.
+*/
+#define LIST_UNROLLED_MERGE_BLOCKS ((size_t)3)
+
+/* block of unrolled list_p takes few cache lines, but holds at least LIST_BLOCK_MIN_ENTRIES */
+#define LIST_BLOCK_SIZE ((size_t)(4 * CACHE_LINE_SIZE))
+#define LIST_BLOCK_MIN_ENTRIES ((size_t)4)
+
+
+/*
+    Allocate new slab and put all its nodes on free list.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __list_pool_grow(List* list_p);
+
+
+/*
+    Take node from pool.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+
+    RETURN:
+    %Pointer to node if success.
+    %NULL if failure.
+*/
+static ___inline___ List_node* __list_node_alloc(List* list_p);
+
+
 /*
-    Destroy list_p node.
+    Return list_p node to pool.
 
     PARAMS:
+    @IN list_p - pointer to list_p.
     @IN list_node_p - pointer to list_p node
 
     RETURN:
     %This is void function.
 */
-static ___inline___ void __list_node_destroy(List_node* list_node_p);
+static ___inline___ void __list_node_destroy(List* list_p, List_node* list_node_p);
 
 
 /*
@@ -54,20 +124,34 @@ static void __list_destroy(List* list_p, bool destroy);
 
 
 /*
-    Create new list_p node.
+    Create new list_p node from pool.
 
     PARAMS:
+    @IN list_p - pointer to list_p.
     @IN next_p - pointer to next_p node.
     @IN data_p - pointer to data_p stored in node.
-    @IN size_of - size of data_p.
 
     RETURN:
     %Pointer to node if success.
     %NULL if failure.
 */ 
-static ___inline___ List_node* __list_node_create(List_node* const __restrict__ next_p, 
-                                                  const void* const __restrict__ data_p, 
-                                                  const size_t size_of);
+static ___inline___ List_node* __list_node_create(List* const __restrict__ list_p,
+                                                  List_node* const __restrict__ next_p, 
+                                                  const void* const __restrict__ data_p);
+
+
+/*
+    Unlink node from list_p.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN prev_p - pointer to previous node (NULL if node_p is head_p).
+    @IN node_p - pointer to unlinked node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __list_unlink(List* __restrict__ list_p, List_node* __restrict__ prev_p, List_node* __restrict__ node_p);
 
 
 /*
@@ -85,12 +169,250 @@ static ___inline___ List_node* __list_node_create(List_node* const __restrict__
 static int __list_delete(List* __restrict__ list_p, const void* __restrict__ const entry_p, const bool destroy);
 
 
-static ___inline___ void __list_node_destroy(List_node* list_node_p)
+/*
+    Get pointer to entry stored in block.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN block_p - pointer to block.
+    @IN pos - position of entry in block.
+
+    RETURN:
+    %Pointer to entry.
+*/
+static ___inline___ BYTE* __list_block_entry(const List* __restrict__ list_p, List_block* __restrict__ block_p, size_t pos);
+
+
+/*
+    Find position in block for entry_p (binary search).
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN block_p - pointer to block.
+    @IN entry_p - pointer to entry_p.
+    @IN after_equal - false: first entry >= entry_p, true: first entry > entry_p.
+
+    RETURN:
+    %Position in block.
+*/
+static ___inline___ size_t __list_block_bound(const List* __restrict__ list_p, List_block* __restrict__ block_p, const void* __restrict__ entry_p, bool after_equal);
+
+
+/*
+    Create new empty block from pool and link it after prev_p.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN prev_p - pointer to previous block (NULL if new block is first).
+
+    RETURN:
+    %Pointer to block if success.
+    %NULL if failure.
+*/
+static List_block* __list_block_create(List* __restrict__ list_p, List_block* __restrict__ prev_p);
+
+
+/*
+    Unlink empty block and return it to pool.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN prev_p - pointer to previous block (NULL if block_p is first).
+    @IN block_p - pointer to unlinked block.
+
+    RETURN:
+    %This is void function.
+*/
+static void __list_block_unlink(List* __restrict__ list_p, List_block* __restrict__ prev_p, List_block* __restrict__ block_p);
+
+
+/*
+    Merge next block into block_p if both fit in 3/4 of block.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN block_p - pointer to block.
+
+    RETURN:
+    %This is void function.
+*/
+static void __list_block_try_merge(List* __restrict__ list_p, List_block* __restrict__ block_p);
+
+
+/*
+    Find block and position of the first entry which compare(entry, entry_p) == 0.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN entry_p - pointer to entry_p.
+    @OUT prev_pp - pointer to previous block.
+    @OUT pos_p - position of found entry.
+
+    RETURN:
+    %Pointer to block if entry exists.
+    %NULL if entry doesn't exist.
+*/
+static List_block* __list_unrolled_find(const List* __restrict__ list_p, const void* __restrict__ entry_p, List_block** __restrict__ prev_pp, size_t* __restrict__ pos_p);
+
+
+/*
+    Insert entry_p to unrolled list_p (after all equal entries).
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN entry_p - pointer to entry_p.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __list_unrolled_insert(List* __restrict__ list_p, const void* __restrict__ entry_p);
+
+
+/*
+    Delete the first entry which compare(list_p->entry_p, entry_p) == 0 from unrolled list_p.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN entry_p - pointer to entry_p.
+    @IN destroy - call destructor.
+
+    RETURN:
+    %0 if success.
+    %1 if entry doesn't exist.
+*/
+static int __list_unrolled_delete(List* __restrict__ list_p, const void* __restrict__ entry_p, bool destroy);
+
+
+/*
+    Delete the all entries which compare(list_p->entry_p, entry_p) == 0 from unrolled list_p.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN entry_p - pointer to entry_p.
+    @IN destroy - call destructor.
+
+    RETURN:
+    %number of deleted (>0) if success.
+    %-1 if entry doesn't exist.
+*/
+static int __list_unrolled_delete_all(List* __restrict__ list_p, const void* __restrict__ entry_p, bool destroy);
+
+
+/*
+    Copy entries of unrolled list_p to buffer.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @OUT arr_p - pointer to buffer with space for all entries.
+
+    RETURN:
+    %This is void function.
+*/
+static void __list_unrolled_copy(const List* __restrict__ list_p, BYTE* __restrict__ arr_p);
+
+
+/*
+    Move all slabs and free nodes of src_p pool to dst_p pool.
+    After this every node / block of src_p belongs to dst_p.
+
+    PARAMS:
+    @IN dst_p - pointer to destination list.
+    @IN src_p - pointer to source list.
+
+    RETURN:
+    %This is void function.
+*/
+static void __list_pool_take(List* __restrict__ dst_p, List* __restrict__ src_p);
+
+
+/*
+    Append sorted entries at the end of list_p (entries >= last entry).
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN data_p - pointer to first entry.
+    @IN len - number of entries.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __list_append(List* __restrict__ list_p, const BYTE* __restrict__ data_p, size_t len);
+
+
+/*
+    Make sure that list_p pool has at least @nodes free nodes / blocks.
+
+    PARAMS:
+    @IN list_p - pointer to list_p.
+    @IN nodes - number of free nodes / blocks (not more than LIST_SLAB_MIN_NODES).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __list_pool_reserve(List* list_p, size_t nodes);
+
+
+/*
+    Merge unrolled src_p to unrolled dst_p, src_p pool has to be taken by dst_p
+    and LIST_UNROLLED_MERGE_BLOCKS blocks have to be reserved in dst_p pool before.
+
+    PARAMS:
+    @IN dst_p - pointer to destination list.
+    @IN src_p - pointer to source list.
+
+    RETURN:
+    %This is void function.
+*/
+static void __list_unrolled_merge(List* __restrict__ dst_p, List* __restrict__ src_p);
+
+
+static int __list_pool_grow(List* list_p)
+{
+    List_slab* slab_p = (List_slab*)malloc(sizeof(*slab_p) + list_p->slab_nodes * list_p->node_size);
+
+    if (slab_p == NULL)
+        ERROR("malloc error\n", -1);
+
+    slab_p->next_p = list_p->slabs_p;
+    list_p->slabs_p = slab_p;
+
+    /* push nodes in reverse order, so they are taken in memory order */
+    for (size_t i = list_p->slab_nodes; i > 0; --i)
+    {
+        List_node* node_p = (List_node*)(slab_p->nodes_p + (i - 1) * list_p->node_size);
+
+        node_p->next_p = list_p->free_p;
+        list_p->free_p = node_p;
+    }
+
+    list_p->slab_nodes = MIN(list_p->slab_nodes * 2, LIST_SLAB_MAX_NODES);
+
+    return 0;
+}
+
+
+static ___inline___ List_node* __list_node_alloc(List* list_p)
+{
+    if (list_p->free_p == NULL && __list_pool_grow(list_p) != 0)
+        return NULL;
+
+    List_node* node_p = list_p->free_p;
+    list_p->free_p = node_p->next_p;
+
+    return node_p;
+}
+
+
+static ___inline___ void __list_node_destroy(List* list_p, List_node* list_node_p)
 {
     if (list_node_p == NULL)
         VERROR("list_node_p == NULL\n");
 
-    FREE(list_node_p);
+    list_node_p->next_p = list_p->free_p;
+    list_p->free_p = list_node_p;
 }
 
 
@@ -99,45 +421,65 @@ static void __list_destroy(List* list_p, bool destroy)
     if (list_p == NULL)
         VERROR("list_p == NULL\n");
 
-    List_node* ptr_p = list_p->head_p;
-    List_node* next_p = NULL;
-
-    while (ptr_p != NULL)
+    if (list_p->destroy_f != NULL && destroy == true)
     {
-        next_p = ptr_p->next_p;
-
-        if (list_p->destroy_f != NULL && destroy == true)
+        for (List_node* ptr_p = list_p->head_p; ptr_p != list_p->sentinel_p; ptr_p = ptr_p->next_p)
             list_p->destroy_f((void*)ptr_p->data_p);
-        
-        __list_node_destroy(ptr_p);
 
-        ptr_p = next_p;
+        for (List_block* block_p = list_p->first_block_p; block_p != NULL; block_p = block_p->next_p)
+            for (size_t i = 0; i < block_p->entries; ++i)
+                list_p->destroy_f((void*)__list_block_entry(list_p, block_p, i));
+    }
+
+    /* every node lives in some slab, so nodes are not freed one by one */
+    List_slab* slab_p = list_p->slabs_p;
+
+    while (slab_p != NULL)
+    {
+        List_slab* next_p = slab_p->next_p;
+        FREE(slab_p);
+        slab_p = next_p;
     }
 
     FREE(list_p);
 }
 
 
-static ___inline___ List_node* __list_node_create(List_node* const __restrict__ next_p, 
-                                                  const void* const __restrict__ data_p, 
-                                                  const size_t size_of)
+static ___inline___ List_node* __list_node_create(List* const __restrict__ list_p,
+                                                  List_node* const __restrict__ next_p, 
+                                                  const void* const __restrict__ data_p)
 {
     assert(data_p != NULL);
-    assert(size_of >= 1);
 
-    List_node* node = (List_node*)calloc(1, sizeof(*node) + size_of);
+    List_node* node = __list_node_alloc(list_p);
 
     if (node == NULL)
-        ERROR("calloc error\n", NULL);
+        ERROR("__list_node_alloc error\n", NULL);
 
     node->next_p = next_p;
-    node->size_of = size_of;
-    __ASSIGN__(*(BYTE*)node->data_p, *(BYTE*)data_p, size_of);
+    __ASSIGN__(*(BYTE*)node->data_p, *(BYTE*)data_p, list_p->size_of);
 
     return node;
 }
 
 
+static ___inline___ void __list_unlink(List* __restrict__ list_p, List_node* __restrict__ prev_p, List_node* __restrict__ node_p)
+{
+    if (prev_p == NULL)
+        list_p->head_p = node_p->next_p;
+    else
+        prev_p->next_p = node_p->next_p;
+
+    if (node_p == list_p->tail_p)
+        list_p->tail_p = prev_p;
+
+    if (node_p == list_p->finger_p)
+        list_p->finger_p = NULL;
+
+    --list_p->length;
+}
+
+
 static int __list_delete(List* __restrict__ list_p, const void* __restrict__ const entry_p, const bool destroy)
 {
     if (list_p == NULL)
@@ -146,15 +488,55 @@ static int __list_delete(List* __restrict__ list_p, const void* __restrict__ con
     if (entry_p == NULL)  
         ERROR("entry_p == NULL\n", -1);
 
+    if (list_p->type == LIST_UNROLLED)
+        return __list_unrolled_delete(list_p, entry_p, destroy);
+
     List_node* ptr_p = list_p->head_p;
     List_node* prev_p = NULL;
-    
-    List_node* guard_p = __list_node_create(NULL, entry_p, list_p->size_of);
 
-    if (guard_p == NULL)
-        ERROR("__list_node_create error\n", -1);
+    /* sentinel_p holds entry_p, so loop stops at the end of list_p */
+    __ASSIGN__(*(BYTE*)list_p->sentinel_p->data_p, *(BYTE*)entry_p, list_p->size_of);
+
+    /* skip all entries < in entry_p */
+    while (list_p->cmp_f(ptr_p->data_p, entry_p) < 0)
+    {
+        prev_p = ptr_p;
+        ptr_p = ptr_p->next_p;
+    }
+
+    /* this entry_p doesn't exist in list_p */
+    if (ptr_p == list_p->sentinel_p || list_p->cmp_f(ptr_p->data_p, entry_p) != 0)
+        return 1;
+
+    __list_unlink(list_p, prev_p, ptr_p);
+
+    if (list_p->destroy_f != NULL && destroy == true)
+        list_p->destroy_f((void *)ptr_p->data_p);
+
+    __list_node_destroy(list_p, ptr_p);
+
+    return 0;
+}
+
+
+static int __list_delete_all(List* __restrict__ list_p, const void* __restrict__ const entry_p, const bool destroy)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    if (entry_p == NULL)  
+        ERROR("entry_p == NULL\n", -1);
+
+    if (list_p->length == 0)
+        ERROR("list_p->length == 0\n", -1);
 
-    list_p->tail_p->next_p = guard_p;
+    if (list_p->type == LIST_UNROLLED)
+        return __list_unrolled_delete_all(list_p, entry_p, destroy);
+
+    List_node* ptr_p = list_p->head_p;
+    List_node* prev_p = NULL;
+
+    __ASSIGN__(*(BYTE*)list_p->sentinel_p->data_p, *(BYTE*)entry_p, list_p->size_of);
 
     /* skip all entries < in entry_p */
     while (list_p->cmp_f(ptr_p->data_p, entry_p) < 0)
@@ -163,170 +545,500 @@ static int __list_delete(List* __restrict__ list_p, const void* __restrict__ con
         ptr_p = ptr_p->next_p;
     }
 
-    if (list_p->cmp_f(ptr_p->data_p, entry_p) == 0 && ptr_p != guard_p)
+    List_node* first_p = ptr_p;
+    List_node* last_p = NULL;
+    size_t deleted = 0;
+
+    /* list_p is sorted, so all equal entries are next to each other and run ends at first entry > entry_p */
+    while (ptr_p != list_p->sentinel_p && list_p->cmp_f(ptr_p->data_p, entry_p) == 0)
     {
-        /* we delete head_p node */
-        if (prev_p == NULL)
-        {
-            ptr_p = list_p->head_p->next_p;
+        last_p = ptr_p;
+        ptr_p = ptr_p->next_p;
+        ++deleted;
+    }
 
-            if (list_p->destroy_f != NULL && destroy == true)
-                list_p->destroy_f((void *)list_p->head_p->data_p);
+    /* this entry_p doesn't exist in list_p */
+    if (deleted == 0)
+        return -1;
 
-            __list_node_destroy(list_p->head_p);
-            list_p->head_p = ptr_p;
+    /* unlink whole run at once */
+    if (prev_p == NULL)
+        list_p->head_p = ptr_p;
+    else
+        prev_p->next_p = ptr_p;
 
-            if (list_p->head_p == guard_p)
-                list_p->head_p = NULL;
-        }
-        /* we delete in middle or at the end */
+    if (ptr_p == list_p->sentinel_p)
+        list_p->tail_p = prev_p;
+
+    /* finger_p could be in the run, prev_p is still good start of scan */
+    list_p->finger_p = prev_p;
+    list_p->length -= deleted;
+
+    if (list_p->destroy_f != NULL && destroy == true)
+        for (List_node* node_p = first_p; node_p != ptr_p; node_p = node_p->next_p)
+            list_p->destroy_f((void *)node_p->data_p);
+
+    /* run is already chained, so return it to pool in one step */
+    last_p->next_p = list_p->free_p;
+    list_p->free_p = first_p;
+
+    return (int)deleted;
+}
+
+
+static ___inline___ BYTE* __list_block_entry(const List* __restrict__ list_p, List_block* __restrict__ block_p, size_t pos)
+{
+    return block_p->data_p + pos * list_p->size_of;
+}
+
+
+static ___inline___ size_t __list_block_bound(const List* __restrict__ list_p, List_block* __restrict__ block_p, const void* __restrict__ entry_p, bool after_equal)
+{
+    /* entry_p goes after entry while cmp < limit */
+    const int limit = after_equal ? 1 : 0;
+
+    size_t left = 0;
+    size_t right = block_p->entries;
+
+    while (left < right)
+    {
+        const size_t middle = left + ((right - left) >> 1);
+
+        if (list_p->cmp_f(__list_block_entry(list_p, block_p, middle), entry_p) < limit)
+            left = middle + 1;
         else
-        {
-            prev_p->next_p = ptr_p->next_p;
+            right = middle;
+    }
 
-            if (ptr_p == list_p->tail_p)
-                list_p->tail_p = prev_p;
+    return left;
+}
 
-            if (list_p->destroy_f != NULL && destroy == true)
-                list_p->destroy_f((void *)ptr_p->data_p);
 
-            __list_node_destroy(ptr_p);
-        }
+static List_block* __list_block_create(List* __restrict__ list_p, List_block* __restrict__ prev_p)
+{
+    List_block* block_p = (List_block*)(void*)__list_node_alloc(list_p);
+
+    if (block_p == NULL)
+        ERROR("__list_node_alloc error\n", NULL);
+
+    block_p->entries = 0;
+
+    if (prev_p == NULL)
+    {
+        block_p->next_p = list_p->first_block_p;
+        list_p->first_block_p = block_p;
     }
-    /* this entry_p doesn't exist in list_p */
-    else 
+    else
     {
-        __list_node_destroy(guard_p);
-        list_p->tail_p->next_p = NULL;
-        return 1;
+        block_p->next_p = prev_p->next_p;
+        prev_p->next_p = block_p;
     }
 
-    /* corner case, if we have only one node and we delete it, we cannot do offset on freed node [valgrind error] */
-    if (list_p->head_p != NULL)
-        list_p->tail_p->next_p = NULL;
+    if (block_p->next_p == NULL)
+        list_p->last_block_p = block_p;
 
-    __list_node_destroy(guard_p);
-    --list_p->length;
+    return block_p;
+}
 
-    if (list_p->length == 0)
+
+static void __list_block_unlink(List* __restrict__ list_p, List_block* __restrict__ prev_p, List_block* __restrict__ block_p)
+{
+    if (prev_p == NULL)
+        list_p->first_block_p = block_p->next_p;
+    else
+        prev_p->next_p = block_p->next_p;
+
+    if (block_p == list_p->last_block_p)
+        list_p->last_block_p = prev_p;
+
+    __list_node_destroy(list_p, (List_node*)(void*)block_p);
+}
+
+
+static void __list_block_try_merge(List* __restrict__ list_p, List_block* __restrict__ block_p)
+{
+    List_block* next_p = block_p->next_p;
+
+    /* merge only to 3/4 of block, so next insert doesn't split block again */
+    if (next_p == NULL || block_p->entries + next_p->entries > (list_p->block_entries * 3) / 4)
+        return;
+
+    (void)memcpy((void*)__list_block_entry(list_p, block_p, block_p->entries),
+                 (void*)next_p->data_p,
+                 next_p->entries * list_p->size_of);
+
+    block_p->entries += next_p->entries;
+    __list_block_unlink(list_p, block_p, next_p);
+}
+
+
+static List_block* __list_unrolled_find(const List* __restrict__ list_p, const void* __restrict__ entry_p, List_block** __restrict__ prev_pp, size_t* __restrict__ pos_p)
+{
+    List_block* prev_p = NULL;
+    List_block* block_p = list_p->first_block_p;
+
+    /* skip all blocks with last entry < entry_p, blocks are never empty */
+    while (block_p != NULL && list_p->cmp_f(__list_block_entry(list_p, block_p, block_p->entries - 1), entry_p) < 0)
     {
-        list_p->head_p = NULL;
-        list_p->tail_p = NULL;
+        prev_p = block_p;
+        block_p = block_p->next_p;
     }
 
+    if (block_p == NULL)
+        return NULL;
+
+    /* last entry of block_p >= entry_p, so pos is inside block_p */
+    const size_t pos = __list_block_bound(list_p, block_p, entry_p, false);
+
+    if (list_p->cmp_f(__list_block_entry(list_p, block_p, pos), entry_p) != 0)
+        return NULL;
+
+    *prev_pp = prev_p;
+    *pos_p = pos;
+
+    return block_p;
+}
+
+
+static int __list_unrolled_insert(List* __restrict__ list_p, const void* __restrict__ entry_p)
+{
+    List_block* block_p = list_p->first_block_p;
+
+    if (block_p == NULL)
+    {
+        block_p = __list_block_create(list_p, NULL);
+
+        if (block_p == NULL)
+            ERROR("__list_block_create error\n", -1);
+    }
+    /* append fast path, skip walk if entry_p goes after the last entry */
+    else if (list_p->cmp_f(__list_block_entry(list_p, list_p->last_block_p, list_p->last_block_p->entries - 1), entry_p) <= 0)
+        block_p = list_p->last_block_p;
+
+    /* entry_p goes to the last block with first entry <= entry_p (or to the first block) */
+    while (block_p->next_p != NULL && list_p->cmp_f(block_p->next_p->data_p, entry_p) <= 0)
+        block_p = block_p->next_p;
+
+    size_t pos = __list_block_bound(list_p, block_p, entry_p, true);
+
+    /* full block, move upper half to new block */
+    if (block_p->entries == list_p->block_entries)
+    {
+        List_block* new_block_p = __list_block_create(list_p, block_p);
+
+        if (new_block_p == NULL)
+            ERROR("__list_block_create error\n", -1);
+
+        const size_t half = block_p->entries >> 1;
+
+        new_block_p->entries = block_p->entries - half;
+        block_p->entries = half;
+
+        (void)memcpy((void*)new_block_p->data_p,
+                     (void*)__list_block_entry(list_p, block_p, half),
+                     new_block_p->entries * list_p->size_of);
+
+        if (pos > half)
+        {
+            pos -= half;
+            block_p = new_block_p;
+        }
+    }
+
+    (void)memmove((void*)__list_block_entry(list_p, block_p, pos + 1),
+                  (void*)__list_block_entry(list_p, block_p, pos),
+                  (block_p->entries - pos) * list_p->size_of);
+
+    __ASSIGN__(*__list_block_entry(list_p, block_p, pos), *(BYTE*)entry_p, list_p->size_of);
+
+    ++block_p->entries;
+    ++list_p->length;
+
     return 0;
 }
 
 
-static int __list_delete_all(List* __restrict__ list_p, const void* __restrict__ const entry_p, const bool destroy)
+static int __list_unrolled_delete(List* __restrict__ list_p, const void* __restrict__ entry_p, bool destroy)
 {
-    if (list_p == NULL)
-        ERROR("list_p == NULL\n", -1);
+    List_block* prev_p = NULL;
+    size_t pos = 0;
 
-    if (entry_p == NULL)  
-        ERROR("entry_p == NULL\n", -1);
+    List_block* block_p = __list_unrolled_find(list_p, entry_p, &prev_p, &pos);
 
-    if (list_p->head_p == NULL)
-        ERROR("list_p->head_p == NULL\n", -1);
+    /* this entry_p doesn't exist in list_p */
+    if (block_p == NULL)
+        return 1;
 
-    List_node* ptr_p = list_p->head_p;
-    List_node* prev_p = NULL;
-    
-    List_node* guard_p = __list_node_create(NULL, entry_p, list_p->size_of);
+    if (list_p->destroy_f != NULL && destroy == true)
+        list_p->destroy_f((void*)__list_block_entry(list_p, block_p, pos));
 
-    if (guard_p == NULL)
-        ERROR("__list_node_create error\n", -1);
+    --block_p->entries;
+    --list_p->length;
 
-    list_p->tail_p->next_p = guard_p;
+    (void)memmove((void*)__list_block_entry(list_p, block_p, pos),
+                  (void*)__list_block_entry(list_p, block_p, pos + 1),
+                  (block_p->entries - pos) * list_p->size_of);
 
-    /* skip all entries < in entry_p */
-    while (list_p->cmp_f(ptr_p->data_p, entry_p) < 0)
+    if (block_p->entries == 0)
+        __list_block_unlink(list_p, prev_p, block_p);
+    else
+        __list_block_try_merge(list_p, block_p);
+
+    return 0;
+}
+
+
+static int __list_unrolled_delete_all(List* __restrict__ list_p, const void* __restrict__ entry_p, bool destroy)
+{
+    List_block* prev_p = NULL;
+    size_t pos = 0;
+
+    List_block* block_p = __list_unrolled_find(list_p, entry_p, &prev_p, &pos);
+
+    /* this entry_p doesn't exist in list_p */
+    if (block_p == NULL)
+        return -1;
+
+    size_t deleted = 0;
+
+    /* run of equal entries can span several blocks, but it starts at pos */
+    while (block_p != NULL)
     {
-        prev_p = ptr_p;
-        ptr_p = ptr_p->next_p;
+        size_t end = pos;
+
+        while (end < block_p->entries && list_p->cmp_f(__list_block_entry(list_p, block_p, end), entry_p) == 0)
+            ++end;
+
+        if (list_p->destroy_f != NULL && destroy == true)
+            for (size_t i = pos; i < end; ++i)
+                list_p->destroy_f((void*)__list_block_entry(list_p, block_p, i));
+
+        const bool last_block = end < block_p->entries;
+
+        (void)memmove((void*)__list_block_entry(list_p, block_p, pos),
+                      (void*)__list_block_entry(list_p, block_p, end),
+                      (block_p->entries - end) * list_p->size_of);
+
+        block_p->entries -= end - pos;
+        deleted += end - pos;
+
+        List_block* next_p = block_p->next_p;
+
+        if (block_p->entries == 0)
+            __list_block_unlink(list_p, prev_p, block_p);
+        else
+            prev_p = block_p;
+
+        if (last_block)
+            break;
+
+        block_p = next_p;
+        pos = 0;
     }
 
-    size_t deleted = 0;
+    list_p->length -= deleted;
+
+    if (prev_p != NULL)
+        __list_block_try_merge(list_p, prev_p);
+
+    return (int)deleted;
+}
+
+
+static void __list_unrolled_copy(const List* __restrict__ list_p, BYTE* __restrict__ arr_p)
+{
+    for (List_block* block_p = list_p->first_block_p; block_p != NULL; block_p = block_p->next_p)
+    {
+        (void)memcpy((void*)arr_p, (void*)block_p->data_p, block_p->entries * list_p->size_of);
+        arr_p += block_p->entries * list_p->size_of;
+    }
+}
+
+
+static void __list_pool_take(List* __restrict__ dst_p, List* __restrict__ src_p)
+{
+    if (src_p->slabs_p != NULL)
+    {
+        List_slab* slab_p = src_p->slabs_p;
+
+        while (slab_p->next_p != NULL)
+            slab_p = slab_p->next_p;
+
+        slab_p->next_p = dst_p->slabs_p;
+        dst_p->slabs_p = src_p->slabs_p;
+    }
+
+    if (src_p->free_p != NULL)
+    {
+        List_node* node_p = src_p->free_p;
+
+        while (node_p->next_p != NULL)
+            node_p = node_p->next_p;
 
-    if (list_p->cmp_f(ptr_p->data_p, entry_p) == 0 && ptr_p != guard_p)
+        node_p->next_p = dst_p->free_p;
+        dst_p->free_p = src_p->free_p;
+    }
+
+    dst_p->slab_nodes = MAX(dst_p->slab_nodes, src_p->slab_nodes);
+
+    src_p->slabs_p = NULL;
+    src_p->free_p = NULL;
+    src_p->slab_nodes = LIST_SLAB_MIN_NODES;
+}
+
+
+static int __list_append(List* __restrict__ list_p, const BYTE* __restrict__ data_p, size_t len)
+{
+    if (list_p->type == LIST_UNROLLED)
     {
-        /* we delete head_p node */
-        if (prev_p == NULL)
+        while (len > 0)
         {
-            while (list_p->cmp_f(ptr_p->data_p, entry_p) == 0 && ptr_p != guard_p)
-            {
-                ptr_p = list_p->head_p->next_p;
+            List_block* block_p = list_p->last_block_p;
 
-                if (list_p->destroy_f != NULL && destroy == true)
-                    list_p->destroy_f((void *)list_p->head_p->data_p);
+            if (block_p == NULL || block_p->entries == list_p->block_entries)
+            {
+                block_p = __list_block_create(list_p, list_p->last_block_p);
 
-                __list_node_destroy(list_p->head_p);
-                list_p->head_p = ptr_p;
-                ++deleted;
+                if (block_p == NULL)
+                    ERROR("__list_block_create error\n", -1);
             }
 
-            if (list_p->head_p == guard_p)
-                list_p->head_p = NULL;
+            const size_t n = MIN(len, list_p->block_entries - block_p->entries);
+
+            (void)memcpy((void*)__list_block_entry(list_p, block_p, block_p->entries), (const void*)data_p, n * list_p->size_of);
+
+            block_p->entries += n;
+            list_p->length += n;
+            data_p += n * list_p->size_of;
+            len -= n;
         }
-        /* we delete in middle or at the end */
+
+        return 0;
+    }
+
+    for (size_t i = 0; i < len; ++i)
+    {
+        List_node* node_p = __list_node_create(list_p, list_p->sentinel_p, data_p + i * list_p->size_of);
+
+        if (node_p == NULL)
+            ERROR("__list_node_create error\n", -1);
+
+        if (list_p->tail_p == NULL)
+            list_p->head_p = node_p;
         else
-        {
-            while (list_p->cmp_f(ptr_p->data_p, entry_p) == 0 && ptr_p != guard_p)
-            {
-                prev_p->next_p = ptr_p->next_p;
+            list_p->tail_p->next_p = node_p;
+
+        list_p->tail_p = node_p;
+        ++list_p->length;
+    }
+
+    return 0;
+}
+
+
+static int __list_pool_reserve(List* list_p, size_t nodes)
+{
+    size_t free_nodes = 0;
+
+    for (List_node* node_p = list_p->free_p; node_p != NULL && free_nodes < nodes; node_p = node_p->next_p)
+        ++free_nodes;
+
+    /* slab has at least LIST_SLAB_MIN_NODES nodes, so one grow is enough */
+    if (free_nodes < nodes && __list_pool_grow(list_p) != 0)
+        ERROR("__list_pool_grow error\n", -1);
+
+    return 0;
+}
+
 
-                if (ptr_p == list_p->tail_p)
-                    list_p->tail_p = prev_p;
+static void __list_unrolled_merge(List* __restrict__ dst_p, List* __restrict__ src_p)
+{
+    List_block* a_p = dst_p->first_block_p;
+    List_block* b_p = src_p->first_block_p;
+    size_t a_pos = 0;
+    size_t b_pos = 0;
 
-                if (list_p->destroy_f != NULL && destroy == true)
-                    list_p->destroy_f((void *)ptr_p->data_p);
+    dst_p->first_block_p = NULL;
+    dst_p->last_block_p = NULL;
 
-                __list_node_destroy(ptr_p);
-                ptr_p = prev_p->next_p;
-                ++deleted;
-            }
-        }
-    }
-    /* this entry_p doesn't exist in list_p */
-    else 
+    while (a_p != NULL || b_p != NULL)
     {
-        __list_node_destroy(guard_p);
-        list_p->tail_p->next_p = NULL;
-        return -1;
-    }
+        /* equal entries from dst_p go first */
+        const bool take_b = a_p == NULL ||
+                            (b_p != NULL && dst_p->cmp_f(__list_block_entry(dst_p, b_p, b_pos), __list_block_entry(dst_p, a_p, a_pos)) < 0);
 
-    __list_node_destroy(guard_p);
+        List_block** in_pp = take_b ? &b_p : &a_p;
+        size_t* pos_p = take_b ? &b_pos : &a_pos;
 
-    if (list_p->head_p != NULL)
-        list_p->tail_p->next_p = NULL;
+        List_block* out_p = dst_p->last_block_p;
 
-    list_p->length -= deleted;
+        if (out_p == NULL || out_p->entries == dst_p->block_entries)
+        {
+            out_p = __list_block_create(dst_p, dst_p->last_block_p);
+            assert(out_p != NULL);
+        }
 
-    if (list_p->length == 0)
-    {
-        list_p->head_p = NULL;
-        list_p->tail_p = NULL;
-    }
+        __ASSIGN__(*__list_block_entry(dst_p, out_p, out_p->entries), *__list_block_entry(dst_p, *in_pp, *pos_p), dst_p->size_of);
+        ++out_p->entries;
 
-    return (int)deleted;
+        if (++*pos_p == (*in_pp)->entries)
+        {
+            List_block* next_p = (*in_pp)->next_p;
+
+            __list_node_destroy(dst_p, (List_node*)(void*)*in_pp);
+            *in_pp = next_p;
+            *pos_p = 0;
+        }
+    }
 }
 
 
 List* list_create(const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f)
 {
+    return list_create_with_type(LIST_LINKED, size_of, cmp_f, destroy_f);
+}
+
+
+List* list_create_with_type(const LIST_TYPE type, const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f)
+{
+    if (type != LIST_LINKED && type != LIST_UNROLLED)
+        ERROR("incorrect type\n", NULL);
+
     if (size_of == 0)
         ERROR("size_of == 0\n", NULL);
 
     if (cmp_f == NULL)
         ERROR("cmp_f == NULL\n", NULL);
 
-    List* list_p = (List*)calloc(1, sizeof(*list_p));
+    /* sentinel_p is embedded right after list_p, so it is never allocated again */
+    List* list_p = (List*)calloc(1, sizeof(*list_p) + sizeof(List_node) + size_of);
 
     if (list_p == NULL)
         ERROR("calloc error\n", NULL);
 
-    list_p->head_p = NULL;
+    list_p->sentinel_p = (List_node*)(list_p + 1);
+    list_p->sentinel_p->next_p = NULL;
+
+    list_p->head_p = list_p->sentinel_p;
     list_p->tail_p = NULL;
+    list_p->finger_p = NULL;
+
+    list_p->free_p = NULL;
+    list_p->slabs_p = NULL;
+    list_p->slab_nodes = LIST_SLAB_MIN_NODES;
+    list_p->node_size = ALIGN_UP(sizeof(List_node) + size_of, sizeof(void*));
+
+    list_p->type = type;
+    list_p->first_block_p = NULL;
+    list_p->last_block_p = NULL;
+    list_p->block_entries = 0;
+
+    /* in unrolled list_p pool gives blocks instead of nodes */
+    if (type == LIST_UNROLLED)
+    {
+        list_p->block_entries = MAX((LIST_BLOCK_SIZE - sizeof(List_block)) / size_of, LIST_BLOCK_MIN_ENTRIES);
+        list_p->node_size = ALIGN_UP(sizeof(List_block) + list_p->block_entries * size_of, sizeof(void*));
+    }
 
     list_p->length = 0;
     list_p->size_of = size_of;
@@ -358,54 +1070,64 @@ int list_insert(List* __restrict__ list_p, const void* __restrict__ const entry_
     if (entry_p == NULL)
         ERROR("entry_p == NULL\n", -1);
 
-    if (list_p->head_p == NULL)
-    {
-        List_node* new_node_p = __list_node_create(NULL, entry_p, list_p->size_of);
+    if (list_p->type == LIST_UNROLLED)
+        return __list_unrolled_insert(list_p, entry_p);
 
-        if (new_node_p == NULL)
-            ERROR("__list_node_create error\n", -1);
+    List_node* new_node_p = __list_node_create(list_p, NULL, entry_p);
 
-        list_p->head_p = new_node_p;
+    if (new_node_p == NULL)
+        ERROR("__list_node_create error\n", -1);
+
+    /* append fast path, time ordered entries go always after tail_p */
+    if (list_p->tail_p != NULL && list_p->cmp_f(list_p->tail_p->data_p, entry_p) <= 0)
+    {
+        new_node_p->next_p = list_p->sentinel_p;
+        list_p->tail_p->next_p = new_node_p;
         list_p->tail_p = new_node_p;
+        list_p->finger_p = new_node_p;
+
+        ++list_p->length;
+        return 0;
     }
-    else
+
+    List_node* ptr_p = list_p->head_p;
+    List_node* prev_p = NULL;
+
+    /* locally ordered entries, new entry_p goes after last inserted one */
+    if (list_p->finger_p != NULL && list_p->cmp_f(list_p->finger_p->data_p, entry_p) <= 0)
     {
-        List_node* ptr_p = list_p->head_p;
-        List_node* prev_p = NULL;
+        prev_p = list_p->finger_p;
+        ptr_p = prev_p->next_p;
+    }
 
-        /* create guard_p node which allows for doesn't check in first while
-           if ptr_p != NULL */
-        List_node* guard_p = __list_node_create(NULL, entry_p, list_p->size_of);
-        list_p->tail_p->next_p = guard_p;
+    /* sentinel_p holds entry_p, so first loop doesn't need to check end of list_p */
+    __ASSIGN__(*(BYTE*)list_p->sentinel_p->data_p, *(BYTE*)entry_p, list_p->size_of);
 
-        /* skip all entries < new entry_p */
-        while (list_p->cmp_f(ptr_p->data_p, entry_p) < 0)
-        {
-            prev_p = ptr_p;
-            ptr_p = ptr_p->next_p;
-        }
+    /* skip all entries < new entry_p */
+    while (list_p->cmp_f(ptr_p->data_p, entry_p) < 0)
+    {
+        prev_p = ptr_p;
+        ptr_p = ptr_p->next_p;
+    }
 
-        /* skip all entries == new entry_p */
-        while (list_p->cmp_f(ptr_p->data_p, entry_p) == 0 && ptr_p != guard_p)
-        {
-            prev_p = ptr_p;
-            ptr_p = ptr_p->next_p;
-        }
+    /* skip all entries == new entry_p */
+    while (ptr_p != list_p->sentinel_p && list_p->cmp_f(ptr_p->data_p, entry_p) == 0)
+    {
+        prev_p = ptr_p;
+        ptr_p = ptr_p->next_p;
+    }
 
-        guard_p->next_p = ptr_p;
+    new_node_p->next_p = ptr_p;
 
-        if (prev_p != NULL)
-        {
-            prev_p->next_p = guard_p;
+    if (prev_p != NULL)
+        prev_p->next_p = new_node_p;
+    else
+        list_p->head_p = new_node_p;
 
-            if (prev_p == list_p->tail_p)
-                list_p->tail_p = guard_p;
-        }
-        else
-            list_p->head_p = guard_p;
-        
-        list_p->tail_p->next_p = NULL;
-    }
+    if (ptr_p == list_p->sentinel_p)
+        list_p->tail_p = new_node_p;
+
+    list_p->finger_p = new_node_p;
 
     ++list_p->length;
     return 0;
@@ -447,31 +1169,35 @@ int list_search(const List* __restrict__ const list_p, const void* const entry_p
     if (val_out == NULL)
         ERROR("val == NULL\n", -1);
 
-    List_node *ptr_p = list_p->head_p;
+    if (list_p->type == LIST_UNROLLED)
+    {
+        List_block* prev_p = NULL;
+        size_t pos = 0;
 
-    List_node *guard_p = __list_node_create(NULL, entry_p, list_p->size_of);
+        List_block* block_p = __list_unrolled_find(list_p, entry_p, &prev_p, &pos);
 
-    if (guard_p == NULL)
-        ERROR("__list_node_create error\n", -1);
+        if (block_p == NULL)
+            return -1;
+
+        __ASSIGN__(*(BYTE*)val_out, *__list_block_entry(list_p, block_p, pos), list_p->size_of);
+
+        return 0;
+    }
+
+    List_node *ptr_p = list_p->head_p;
 
-    list_p->tail_p->next_p = guard_p;
+    __ASSIGN__(*(BYTE*)list_p->sentinel_p->data_p, *(BYTE*)entry_p, list_p->size_of);
 
     /* skip all entries < in entry_p */
     while (list_p->cmp_f(ptr_p->data_p, entry_p) < 0)
         ptr_p = ptr_p->next_p;
-    
-    bool found = false;
 
-    if (list_p->cmp_f(ptr_p->data_p, entry_p) == 0 && ptr_p != guard_p)
-    {
-        __ASSIGN__(*(BYTE*)val_out, *(BYTE*)ptr_p->data_p, list_p->size_of);
-        found = true;
-    }
+    if (ptr_p == list_p->sentinel_p || list_p->cmp_f(ptr_p->data_p, entry_p) != 0)
+        return -1;
 
-    __list_node_destroy(guard_p);
-    list_p->tail_p->next_p = NULL;
+    __ASSIGN__(*(BYTE*)val_out, *(BYTE*)ptr_p->data_p, list_p->size_of);
 
-    return found == true ? 0 : -1;
+    return 0;
 }
 
 
@@ -494,10 +1220,13 @@ int list_to_array(const List* __restrict__ const list_p, void* __restrict__ arra
     if (arr_p == NULL)    
         ERROR("calloc error\n", -1);
 
+    if (list_p->type == LIST_UNROLLED)
+        __list_unrolled_copy(list_p, arr_p);
+
     List_node* ptr_p = list_p->head_p;
     size_t offset = 0;
 
-    while (ptr_p != NULL)
+    while (ptr_p != list_p->sentinel_p)
     {
         __ASSIGN__(arr_p[offset], *(BYTE*)ptr_p->data_p, list_p->size_of);
 
@@ -512,6 +1241,352 @@ int list_to_array(const List* __restrict__ const list_p, void* __restrict__ arra
 }
 
 
+int list_to_array_buffer(const List* __restrict__ const list_p, void* __restrict__ buffer_p, const size_t capacity, size_t* __restrict__ size_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    if (buffer_p == NULL)
+        ERROR("buffer_p == NULL\n", -1);
+
+    if (size_p == NULL)
+        ERROR("size_p == NULL\n", -1);
+
+    if (capacity < list_p->length)
+    {
+        *size_p = list_p->length;
+        ERROR("capacity < list_p->length\n", -1);
+    }
+
+    BYTE* arr_p = (BYTE*)buffer_p;
+
+    if (list_p->type == LIST_UNROLLED)
+        __list_unrolled_copy(list_p, arr_p);
+
+    List_node* ptr_p = list_p->head_p;
+    size_t offset = 0;
+
+    while (ptr_p != list_p->sentinel_p)
+    {
+        __ASSIGN__(arr_p[offset], *(BYTE*)ptr_p->data_p, list_p->size_of);
+
+        ptr_p = ptr_p->next_p;
+        offset += list_p->size_of;
+    }
+
+    *size_p = list_p->length;
+
+    return 0;
+}
+
+
+int list_to_array_chunks(const List* __restrict__ const list_p, void* __restrict__ chunk_p, const size_t chunk_len, const chunk_f consume_f, void* arg_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    if (chunk_p == NULL)
+        ERROR("chunk_p == NULL\n", -1);
+
+    if (chunk_len == 0)
+        ERROR("chunk_len == 0\n", -1);
+
+    if (consume_f == NULL)
+        ERROR("consume_f == NULL\n", -1);
+
+    BYTE* arr_p = (BYTE*)chunk_p;
+    List_node* ptr_p = list_p->head_p;
+    size_t entries = 0;
+
+    while (ptr_p != list_p->sentinel_p)
+    {
+        __ASSIGN__(arr_p[entries * list_p->size_of], *(BYTE*)ptr_p->data_p, list_p->size_of);
+        ptr_p = ptr_p->next_p;
+
+        if (++entries == chunk_len)
+        {
+            const int ret = consume_f(chunk_p, entries, arg_p);
+
+            if (ret != 0)
+                return ret;
+
+            entries = 0;
+        }
+    }
+
+    /* unrolled list_p copies whole runs of block, chunk boundary can split block */
+    for (List_block* block_p = list_p->first_block_p; block_p != NULL; block_p = block_p->next_p)
+    {
+        size_t pos = 0;
+
+        while (pos < block_p->entries)
+        {
+            const size_t n = MIN(block_p->entries - pos, chunk_len - entries);
+
+            (void)memcpy((void*)&arr_p[entries * list_p->size_of],
+                         (void*)__list_block_entry(list_p, block_p, pos),
+                         n * list_p->size_of);
+
+            pos += n;
+            entries += n;
+
+            if (entries == chunk_len)
+            {
+                const int ret = consume_f(chunk_p, entries, arg_p);
+
+                if (ret != 0)
+                    return ret;
+
+                entries = 0;
+            }
+        }
+    }
+
+    if (entries > 0)
+        return consume_f(chunk_p, entries, arg_p);
+
+    return 0;
+}
+
+
+List* list_create_from_sorted_array(const LIST_TYPE type, const void* __restrict__ array_p, const size_t len, const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f)
+{
+    if (array_p == NULL)
+        ERROR("array_p == NULL\n", NULL);
+
+    List* list_p = list_create_with_type(type, size_of, cmp_f, destroy_f);
+
+    if (list_p == NULL)
+        ERROR("list_create_with_type error\n", NULL);
+
+    const BYTE* data_p = (const BYTE*)array_p;
+
+    for (size_t i = 1; i < len; ++i)
+        if (cmp_f((const void*)(data_p + (i - 1) * size_of), (const void*)(data_p + i * size_of)) > 0)
+        {
+            list_destroy(list_p);
+            ERROR("array_p is not sorted\n", NULL);
+        }
+
+    if (len == 0)
+        return list_p;
+
+    /* first slab holds all nodes (blocks), so list_p is built with one allocation */
+    list_p->slab_nodes = type == LIST_UNROLLED ? (len + list_p->block_entries - 1) / list_p->block_entries : len;
+
+    if (__list_pool_grow(list_p) != 0 || __list_append(list_p, data_p, len) != 0)
+    {
+        list_destroy(list_p);
+        ERROR("__list_append error\n", NULL);
+    }
+
+    return list_p;
+}
+
+
+int list_merge(List* __restrict__ dst_p, List* __restrict__ src_p)
+{
+    if (dst_p == NULL)
+        ERROR("dst_p == NULL\n", -1);
+
+    if (src_p == NULL)
+        ERROR("src_p == NULL\n", -1);
+
+    if (dst_p->type != src_p->type || dst_p->size_of != src_p->size_of || dst_p->cmp_f != src_p->cmp_f)
+        ERROR("dst_p and src_p are not compatible\n", -1);
+
+    if (src_p->length == 0)
+        return 0;
+
+    /* after reserve unrolled merge can't fail, so src_p is never left with nodes owned by dst_p */
+    if (dst_p->type == LIST_UNROLLED && dst_p->length != 0 && __list_pool_reserve(dst_p, LIST_UNROLLED_MERGE_BLOCKS) != 0)
+        ERROR("__list_pool_reserve error\n", -1);
+
+    /* src_p nodes are linked into dst_p, so dst_p has to own their memory */
+    __list_pool_take(dst_p, src_p);
+
+    if (dst_p->type == LIST_UNROLLED)
+    {
+        if (dst_p->length == 0)
+        {
+            dst_p->first_block_p = src_p->first_block_p;
+            dst_p->last_block_p = src_p->last_block_p;
+        }
+        else if (dst_p->cmp_f(__list_block_entry(dst_p, dst_p->last_block_p, dst_p->last_block_p->entries - 1), src_p->first_block_p->data_p) <= 0)
+        {
+            dst_p->last_block_p->next_p = src_p->first_block_p;
+            dst_p->last_block_p = src_p->last_block_p;
+        }
+        else
+        {
+            __list_unrolled_merge(dst_p, src_p);
+        }
+
+        src_p->first_block_p = NULL;
+        src_p->last_block_p = NULL;
+    }
+    else
+    {
+        List_node** link_pp = &dst_p->head_p;
+        List_node* a_p = dst_p->head_p;
+        List_node* b_p = src_p->head_p;
+
+        /* time ordered lists are just concatenated */
+        if (dst_p->tail_p != NULL && dst_p->cmp_f(dst_p->tail_p->data_p, b_p->data_p) <= 0)
+        {
+            link_pp = &dst_p->tail_p->next_p;
+            a_p = dst_p->sentinel_p;
+        }
+
+        /* equal entries from dst_p go first */
+        while (a_p != dst_p->sentinel_p && b_p != src_p->sentinel_p)
+        {
+            if (dst_p->cmp_f(b_p->data_p, a_p->data_p) < 0)
+            {
+                *link_pp = b_p;
+                link_pp = &b_p->next_p;
+                b_p = b_p->next_p;
+            }
+            else
+            {
+                *link_pp = a_p;
+                link_pp = &a_p->next_p;
+                a_p = a_p->next_p;
+            }
+        }
+
+        if (b_p != src_p->sentinel_p)
+        {
+            *link_pp = b_p;
+            src_p->tail_p->next_p = dst_p->sentinel_p;
+            dst_p->tail_p = src_p->tail_p;
+        }
+        else
+        {
+            *link_pp = a_p;
+        }
+
+        src_p->head_p = src_p->sentinel_p;
+        src_p->tail_p = NULL;
+        src_p->finger_p = NULL;
+    }
+
+    dst_p->length += src_p->length;
+    src_p->length = 0;
+
+    return 0;
+}
+
+
+List* list_split_at(List* __restrict__ list_p, const void* __restrict__ entry_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", NULL);
+
+    if (entry_p == NULL)
+        ERROR("entry_p == NULL\n", NULL);
+
+    List* new_list_p = list_create_with_type(list_p->type, list_p->size_of, list_p->cmp_f, list_p->destroy_f);
+
+    if (new_list_p == NULL)
+        ERROR("list_create_with_type error\n", NULL);
+
+    if (list_p->type == LIST_UNROLLED)
+    {
+        List_block* prev_p = NULL;
+        List_block* block_p = list_p->first_block_p;
+
+        while (block_p != NULL && list_p->cmp_f(__list_block_entry(list_p, block_p, block_p->entries - 1), entry_p) < 0)
+        {
+            prev_p = block_p;
+            block_p = block_p->next_p;
+        }
+
+        if (block_p == NULL)
+            return new_list_p;
+
+        /* entries are copied first, so list_p is untouched if allocation fails */
+        const size_t pos = __list_block_bound(list_p, block_p, entry_p, false);
+
+        for (List_block* ptr_p = block_p; ptr_p != NULL; ptr_p = ptr_p->next_p)
+        {
+            const size_t first = ptr_p == block_p ? pos : 0;
+
+            if (__list_append(new_list_p, (const BYTE*)__list_block_entry(list_p, ptr_p, first), ptr_p->entries - first) != 0)
+            {
+                list_destroy(new_list_p);
+                ERROR("__list_append error\n", NULL);
+            }
+        }
+
+        list_p->length -= new_list_p->length;
+
+        List_block* ptr_p = block_p->next_p;
+        block_p->next_p = NULL;
+        list_p->last_block_p = block_p;
+
+        while (ptr_p != NULL)
+        {
+            List_block* next_p = ptr_p->next_p;
+            __list_node_destroy(list_p, (List_node*)(void*)ptr_p);
+            ptr_p = next_p;
+        }
+
+        block_p->entries = pos;
+
+        if (pos == 0)
+            __list_block_unlink(list_p, prev_p, block_p);
+
+        return new_list_p;
+    }
+
+    List_node* ptr_p = list_p->head_p;
+    List_node* prev_p = NULL;
+
+    __ASSIGN__(*(BYTE*)list_p->sentinel_p->data_p, *(BYTE*)entry_p, list_p->size_of);
+
+    /* skip all entries < in entry_p */
+    while (list_p->cmp_f(ptr_p->data_p, entry_p) < 0)
+    {
+        prev_p = ptr_p;
+        ptr_p = ptr_p->next_p;
+    }
+
+    if (ptr_p == list_p->sentinel_p)
+        return new_list_p;
+
+    /* new_list_p has its own pool, so entries are copied, first slab fits all of them */
+    size_t entries = 0;
+
+    for (List_node* node_p = ptr_p; node_p != list_p->sentinel_p; node_p = node_p->next_p)
+        ++entries;
+
+    new_list_p->slab_nodes = entries;
+
+    for (List_node* node_p = ptr_p; node_p != list_p->sentinel_p; node_p = node_p->next_p)
+        if (__list_append(new_list_p, (const BYTE*)node_p->data_p, 1) != 0)
+        {
+            list_destroy(new_list_p);
+            ERROR("__list_append error\n", NULL);
+        }
+
+    /* the tail run is already chained, so return it to pool in one step */
+    list_p->tail_p->next_p = list_p->free_p;
+    list_p->free_p = ptr_p;
+
+    if (prev_p == NULL)
+        list_p->head_p = list_p->sentinel_p;
+    else
+        prev_p->next_p = list_p->sentinel_p;
+
+    list_p->tail_p = prev_p;
+    list_p->finger_p = prev_p;
+    list_p->length -= entries;
+
+    return new_list_p;
+}
+
+
 ssize_t list_get_num_entries(const List* const list_p)
 {
     if (list_p == NULL)   
@@ -20,6 +20,18 @@ static int my_struct_compare(const void* a_p, const void* b_p);
 static int my_compare_int64_t(const void* a_p, const void* b_p);
 
 
+/* collects chunks passed by list_to_array_chunks */
+typedef struct Chunk_sink
+{
+    int64_t* arr_p;
+    size_t entries;
+    size_t calls;
+    size_t stop_after;
+} Chunk_sink;
+
+static int chunk_sink_consume(const void* chunk_p, size_t entries, void* arg_p);
+
+
 /* unit tests function declaraions */
 static void test_list_create_destroy_empty(void);
 static void test_list_insert(void);
@@ -28,6 +40,16 @@ static void test_list_delete_with_entry(void);
 static void test_list_delete_all(void);
 static void test_list_delete_all_with_entries(void);
 static void test_list_search(void);
+static void test_list_to_array_buffer(void);
+static void test_list_node_reuse(void);
+static void test_list_to_array_chunks(void);
+static void test_list_unrolled(void);
+static void test_list_unrolled_with_entries(void);
+static void test_list_insert_ordered(void);
+static void test_list_delete_all_batch(void);
+static void test_list_create_from_sorted_array(void);
+static void test_list_merge(void);
+static void test_list_split_at(void);
 
 
 /* implementation */
@@ -80,6 +102,20 @@ static int my_compare_int64_t(const void* a_p, const void* b_p)
 }
 
 
+static int chunk_sink_consume(const void* chunk_p, size_t entries, void* arg_p)
+{
+    Chunk_sink* sink_p = (Chunk_sink*)arg_p;
+
+    (void)memcpy((void*)&sink_p->arr_p[sink_p->entries], chunk_p, entries * sizeof(int64_t));
+    sink_p->entries += entries;
+
+    if (++sink_p->calls == sink_p->stop_after)
+        return 1;
+
+    return 0;
+}
+
+
 static void test_list_create_destroy_empty(void)
 {
     List *list_p = NULL;
@@ -680,6 +716,554 @@ static void test_list_search(void)
 }
 
 
+static void test_list_node_reuse(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE] = {0};
+    int64_t rarr[ARRAY_TEST_SIZE] = {0};
+    int64_t val = 0;
+    size_t rsize = 0;
+
+    List* list_p = list_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    /* empty list_p */
+    T_EXPECT(list_search(list_p, (void*)&val, (void*)&val), -1);
+    T_EXPECT(list_delete(list_p, (void*)&val), 1);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)((i * 7919) % ARRAY_TEST_SIZE);
+
+    /* nodes freed in first round are reused in next rounds */
+    for (size_t round = 0; round < 3; ++round)
+    {
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            T_EXPECT(list_insert(list_p, (void*)&arr[i]), 0);
+
+        T_EXPECT(list_get_num_entries(list_p), (ssize_t)ARRAY_TEST_SIZE);
+        T_EXPECT(list_to_array_buffer(list_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            T_ASSERT(rarr[i], (int64_t)i);
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            T_EXPECT(list_delete(list_p, (void*)&arr[ARRAY_TEST_SIZE - 1 - i]), 0);
+
+        T_EXPECT(list_get_num_entries(list_p), (ssize_t)0);
+        T_EXPECT(list_search(list_p, (void*)&arr[0], (void*)&val), -1);
+    }
+
+    list_destroy(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_list_to_array_buffer(void)
+{
+    int64_t arr[] = { 9, 0, 1, 8, 2, 7, 7, 6, 5, 3, 4 };
+    int64_t arr_expt[] = { 0, 1, 2, 3, 4, 5, 6, 7, 7, 8, 9 };
+    int64_t buffer[ARRAY_SIZE(arr)] = {0};
+    size_t rsize = 0;
+
+    List* list_p = list_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    T_EXPECT(list_to_array_buffer(list_p, (void*)&buffer[0], ARRAY_SIZE(buffer), &rsize), 0);
+    T_ASSERT(rsize, (size_t)0);
+
+    for (size_t i = 0; i < ARRAY_SIZE(arr); ++i)
+        T_EXPECT(list_insert(list_p, (void*)&arr[i]), 0);
+
+    T_EXPECT(list_to_array_buffer(list_p, (void*)&buffer[0], ARRAY_SIZE(buffer) - 1, &rsize), -1);
+    T_ASSERT(rsize, ARRAY_SIZE(arr));
+
+    rsize = 0;
+    T_EXPECT(list_to_array_buffer(list_p, (void*)&buffer[0], ARRAY_SIZE(buffer), &rsize), 0);
+    T_ASSERT(rsize, ARRAY_SIZE(arr));
+    T_EXPECT(memcmp((const void*)&buffer[0], (const void*)&arr_expt[0], sizeof(buffer)), 0);
+
+    T_EXPECT(list_to_array_buffer(NULL, (void*)&buffer[0], ARRAY_SIZE(buffer), &rsize), -1);
+    T_EXPECT(list_to_array_buffer(list_p, NULL, ARRAY_SIZE(buffer), &rsize), -1);
+    T_EXPECT(list_to_array_buffer(list_p, (void*)&buffer[0], ARRAY_SIZE(buffer), NULL), -1);
+
+    list_destroy(list_p);
+}
+
+
+static void test_list_to_array_chunks(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    int64_t arr[ARRAY_TEST_SIZE] = {0};
+    int64_t out[ARRAY_TEST_SIZE] = {0};
+    int64_t chunk[7] = {0};
+
+    List* list_p = list_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)i;
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(list_insert(list_p, (void*)&arr[ARRAY_TEST_SIZE - 1 - i]), 0);
+
+    /* 100 entries = 14 full chunks + 1 chunk of 2 entries */
+    Chunk_sink sink = { &out[0], 0, 0, 0 };
+    T_EXPECT(list_to_array_chunks(list_p, (void*)&chunk[0], ARRAY_SIZE(chunk), chunk_sink_consume, (void*)&sink), 0);
+    T_ASSERT(sink.entries, (size_t)ARRAY_TEST_SIZE);
+    T_ASSERT(sink.calls, (size_t)15);
+    T_EXPECT(memcmp((const void*)&out[0], (const void*)&arr[0], sizeof(out)), 0);
+
+    /* consumer stops export */
+    Chunk_sink stop_sink = { &out[0], 0, 0, 3 };
+    T_EXPECT(list_to_array_chunks(list_p, (void*)&chunk[0], ARRAY_SIZE(chunk), chunk_sink_consume, (void*)&stop_sink), 1);
+    T_ASSERT(stop_sink.entries, (size_t)21);
+
+    T_EXPECT(list_to_array_chunks(list_p, NULL, ARRAY_SIZE(chunk), chunk_sink_consume, (void*)&sink), -1);
+    T_EXPECT(list_to_array_chunks(list_p, (void*)&chunk[0], 0, chunk_sink_consume, (void*)&sink), -1);
+    T_EXPECT(list_to_array_chunks(list_p, (void*)&chunk[0], ARRAY_SIZE(chunk), NULL, (void*)&sink), -1);
+
+    list_destroy(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_list_unrolled(void)
+{
+    #define ARRAY_TEST_SIZE 5000
+    #define KEY_RANGE 300
+
+    int64_t linked_arr[ARRAY_TEST_SIZE] = {0};
+    int64_t unrolled_arr[ARRAY_TEST_SIZE] = {0};
+    int64_t chunk[13] = {0};
+    int64_t out[ARRAY_TEST_SIZE] = {0};
+    size_t linked_size = 0;
+    size_t unrolled_size = 0;
+    int64_t* rarr_p = NULL;
+    size_t rsize = 0;
+
+    T_ASSERT(list_create_with_type((LIST_TYPE)7, sizeof(int64_t), my_compare_int64_t, NULL), NULL);
+
+    /* linked list_p is reference for unrolled one */
+    List* linked_p = list_create_with_type(LIST_LINKED, sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(linked_p == NULL);
+
+    List* unrolled_p = list_create_with_type(LIST_UNROLLED, sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(unrolled_p == NULL);
+
+    srand(4321);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        int64_t val = (int64_t)(rand() % KEY_RANGE);
+        int64_t linked_val = -1;
+        int64_t unrolled_val = -1;
+
+        switch (rand() % 8)
+        {
+            case 0:
+            {
+                T_EXPECT(list_delete(unrolled_p, (void*)&val), list_delete(linked_p, (void*)&val));
+                break;
+            }
+            case 1:
+            {
+                if (list_get_num_entries(linked_p) > 0)
+                    T_EXPECT(list_delete_all(unrolled_p, (void*)&val), list_delete_all(linked_p, (void*)&val));
+                break;
+            }
+            case 2:
+            {
+                T_EXPECT(list_search(unrolled_p, (void*)&val, (void*)&unrolled_val), list_search(linked_p, (void*)&val, (void*)&linked_val));
+                T_ASSERT(unrolled_val, linked_val);
+                break;
+            }
+            default:
+            {
+                T_EXPECT(list_insert(linked_p, (void*)&val), 0);
+                T_EXPECT(list_insert(unrolled_p, (void*)&val), 0);
+                break;
+            }
+        }
+    }
+
+    T_EXPECT(list_get_num_entries(unrolled_p), list_get_num_entries(linked_p));
+    T_EXPECT(list_to_array_buffer(linked_p, (void*)&linked_arr[0], ARRAY_SIZE(linked_arr), &linked_size), 0);
+    T_EXPECT(list_to_array_buffer(unrolled_p, (void*)&unrolled_arr[0], ARRAY_SIZE(unrolled_arr), &unrolled_size), 0);
+    T_ASSERT(unrolled_size, linked_size);
+    T_EXPECT(memcmp((const void*)&unrolled_arr[0], (const void*)&linked_arr[0], linked_size * sizeof(int64_t)), 0);
+
+    T_EXPECT(list_to_array(unrolled_p, &rarr_p, &rsize), 0);
+    T_ASSERT(rsize, linked_size);
+    T_EXPECT(memcmp((const void*)rarr_p, (const void*)&linked_arr[0], linked_size * sizeof(int64_t)), 0);
+    FREE(rarr_p);
+
+    Chunk_sink sink = { &out[0], 0, 0, 0 };
+    T_EXPECT(list_to_array_chunks(unrolled_p, (void*)&chunk[0], ARRAY_SIZE(chunk), chunk_sink_consume, (void*)&sink), 0);
+    T_ASSERT(sink.entries, linked_size);
+    T_EXPECT(memcmp((const void*)&out[0], (const void*)&linked_arr[0], linked_size * sizeof(int64_t)), 0);
+
+    /* remove everything, the last keys through delete_all */
+    for (int64_t key = 0; key < KEY_RANGE; ++key)
+        if (list_get_num_entries(unrolled_p) > 0)
+            T_EXPECT(list_delete_all(unrolled_p, (void*)&key), list_delete_all(linked_p, (void*)&key));
+
+    T_EXPECT(list_get_num_entries(unrolled_p), (ssize_t)0);
+    T_EXPECT(list_get_num_entries(linked_p), (ssize_t)0);
+
+    list_destroy(linked_p);
+    list_destroy(unrolled_p);
+
+    #undef KEY_RANGE
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_list_unrolled_with_entries(void)
+{
+    #define ARRAY_TEST_SIZE 201
+
+    MyStruct* ms_p = NULL;
+    MyStruct key = { 0, 0, 0, 0 };
+    MyStruct* key_p = &key;
+
+    List* list_p = list_create_with_type(LIST_UNROLLED, sizeof(MyStruct*), my_struct_compare, my_struct_destroy);
+    T_ERROR(list_p == NULL);
+
+    /* one key fills several blocks */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        ms_p = my_struct_create((int64_t)(i % 3));
+        T_ERROR(ms_p == NULL);
+        T_EXPECT(list_insert(list_p, (void*)&ms_p), 0);
+    }
+
+    key.key = 1;
+    T_EXPECT(list_delete_all_with_entry(list_p, (void*)&key_p), (int)(ARRAY_TEST_SIZE / 3));
+    T_EXPECT(list_search(list_p, (void*)&key_p, (void*)&ms_p), -1);
+
+    key.key = 0;
+    T_EXPECT(list_delete_with_entry(list_p, (void*)&key_p), 0);
+
+    T_EXPECT(list_get_num_entries(list_p), (ssize_t)(ARRAY_TEST_SIZE - ARRAY_TEST_SIZE / 3 - 1));
+
+    list_destroy_with_entries(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_list_insert_ordered(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE] = {0};
+    int64_t sorted[ARRAY_TEST_SIZE] = {0};
+    int64_t rarr[ARRAY_TEST_SIZE] = {0};
+    size_t rsize = 0;
+
+    const LIST_TYPE types[] = { LIST_LINKED, LIST_UNROLLED };
+
+    for (size_t t = 0; t < ARRAY_SIZE(types); ++t)
+    {
+        /* monotonic with duplicates, every insert goes after tail */
+        List* list_p = list_create_with_type(types[t], sizeof(int64_t), my_compare_int64_t, NULL);
+        T_ERROR(list_p == NULL);
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            arr[i] = (int64_t)(i / 3);
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            T_EXPECT(list_insert(list_p, (void*)&arr[i]), 0);
+
+        T_EXPECT(list_to_array_buffer(list_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+        T_EXPECT(memcmp((const void*)&rarr[0], (const void*)&arr[0], sizeof(arr)), 0);
+
+        list_destroy(list_p);
+
+        /* nearly monotonic, entries are late by few positions */
+        list_p = list_create_with_type(types[t], sizeof(int64_t), my_compare_int64_t, NULL);
+        T_ERROR(list_p == NULL);
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            arr[i] = (int64_t)i;
+
+        for (size_t i = 0; i + 4 < ARRAY_TEST_SIZE; i += 5)
+        {
+            SWAP(*(BYTE*)&arr[i], *(BYTE*)&arr[i + 4], sizeof(int64_t));
+            SWAP(*(BYTE*)&arr[i + 1], *(BYTE*)&arr[i + 2], sizeof(int64_t));
+        }
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            T_EXPECT(list_insert(list_p, (void*)&arr[i]), 0);
+
+            /* delete last inserted entry from time to time, next scan can't start from it */
+            if (i % 7 == 0)
+            {
+                T_EXPECT(list_delete(list_p, (void*)&arr[i]), 0);
+                T_EXPECT(list_insert(list_p, (void*)&arr[i]), 0);
+            }
+        }
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            sorted[i] = (int64_t)i;
+
+        T_EXPECT(list_to_array_buffer(list_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+        T_ASSERT(rsize, (size_t)ARRAY_TEST_SIZE);
+        T_EXPECT(memcmp((const void*)&rarr[0], (const void*)&sorted[0], sizeof(sorted)), 0);
+
+        /* entry smaller than everything after finger */
+        int64_t val = -1;
+        T_EXPECT(list_insert(list_p, (void*)&val), 0);
+        T_EXPECT(list_search(list_p, (void*)&val, (void*)&val), 0);
+        T_EXPECT(list_to_array_buffer(list_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), -1);
+        T_ASSERT(rsize, (size_t)ARRAY_TEST_SIZE + 1);
+
+        list_destroy(list_p);
+    }
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_list_delete_all_batch(void)
+{
+    #define ARRAY_TEST_SIZE 300
+
+    int64_t rarr[ARRAY_TEST_SIZE] = {0};
+    size_t rsize = 0;
+    MyStruct key = { 0, 0, 0, 0 };
+    MyStruct* key_p = &key;
+    MyStruct* ms_p = NULL;
+
+    List* list_p = list_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    /* keys 0, 1, 2 with 100 entries each */
+    for (size_t round = 0; round < 2; ++round)
+    {
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            int64_t val = (int64_t)(i % 3);
+            T_EXPECT(list_insert(list_p, (void*)&val), 0);
+        }
+
+        /* run in the middle, at the tail and at the head */
+        int64_t val = 1;
+        T_EXPECT(list_delete_all(list_p, (void*)&val), ARRAY_TEST_SIZE / 3);
+        T_EXPECT(list_delete_all(list_p, (void*)&val), -1);
+
+        val = 2;
+        T_EXPECT(list_delete_all(list_p, (void*)&val), ARRAY_TEST_SIZE / 3);
+
+        /* tail_p has to be fixed, so append goes after last 0 */
+        val = 5;
+        T_EXPECT(list_insert(list_p, (void*)&val), 0);
+
+        T_EXPECT(list_to_array_buffer(list_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+        T_ASSERT(rsize, (size_t)(ARRAY_TEST_SIZE / 3 + 1));
+        T_ASSERT(rarr[rsize - 1], (int64_t)5);
+
+        T_EXPECT(list_delete_all(list_p, (void*)&val), 1);
+
+        val = 0;
+        T_EXPECT(list_delete_all(list_p, (void*)&val), ARRAY_TEST_SIZE / 3);
+        T_EXPECT(list_get_num_entries(list_p), (ssize_t)0);
+    }
+
+    list_destroy(list_p);
+
+    /* destructor is called for whole run */
+    list_p = list_create(sizeof(MyStruct*), my_struct_compare, my_struct_destroy);
+    T_ERROR(list_p == NULL);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        ms_p = my_struct_create((int64_t)(i % 3));
+        T_ERROR(ms_p == NULL);
+        T_EXPECT(list_insert(list_p, (void*)&ms_p), 0);
+    }
+
+    key.key = 2;
+    T_EXPECT(list_delete_all_with_entry(list_p, (void*)&key_p), ARRAY_TEST_SIZE / 3);
+
+    key.key = 0;
+    T_EXPECT(list_delete_all_with_entry(list_p, (void*)&key_p), ARRAY_TEST_SIZE / 3);
+    T_EXPECT(list_get_num_entries(list_p), (ssize_t)(ARRAY_TEST_SIZE / 3));
+
+    list_destroy_with_entries(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_list_create_from_sorted_array(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE] = {0};
+    int64_t rarr[ARRAY_TEST_SIZE] = {0};
+    size_t rsize = 0;
+    int64_t val = 0;
+
+    const LIST_TYPE types[] = { LIST_LINKED, LIST_UNROLLED };
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)(i / 2);
+
+    for (size_t t = 0; t < ARRAY_SIZE(types); ++t)
+    {
+        List* list_p = list_create_from_sorted_array(types[t], (void*)&arr[0], ARRAY_TEST_SIZE, sizeof(int64_t), my_compare_int64_t, NULL);
+        T_ERROR(list_p == NULL);
+        T_EXPECT(list_get_num_entries(list_p), (ssize_t)ARRAY_TEST_SIZE);
+
+        T_EXPECT(list_to_array_buffer(list_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+        T_EXPECT(memcmp((const void*)&rarr[0], (const void*)&arr[0], sizeof(arr)), 0);
+
+        /* list_p works as usual */
+        val = ARRAY_TEST_SIZE;
+        T_EXPECT(list_insert(list_p, (void*)&val), 0);
+        val = 7;
+        T_EXPECT(list_delete_all(list_p, (void*)&val), 2);
+        T_EXPECT(list_insert(list_p, (void*)&val), 0);
+        T_EXPECT(list_get_num_entries(list_p), (ssize_t)ARRAY_TEST_SIZE);
+
+        list_destroy(list_p);
+
+        list_p = list_create_from_sorted_array(types[t], (void*)&arr[0], 0, sizeof(int64_t), my_compare_int64_t, NULL);
+        T_ERROR(list_p == NULL);
+        T_EXPECT(list_get_num_entries(list_p), (ssize_t)0);
+        list_destroy(list_p);
+    }
+
+    SWAP(*(BYTE*)&arr[10], *(BYTE*)&arr[500], sizeof(int64_t));
+    T_ASSERT(list_create_from_sorted_array(LIST_LINKED, (void*)&arr[0], ARRAY_TEST_SIZE, sizeof(int64_t), my_compare_int64_t, NULL), NULL);
+    T_ASSERT(list_create_from_sorted_array(LIST_LINKED, NULL, ARRAY_TEST_SIZE, sizeof(int64_t), my_compare_int64_t, NULL), NULL);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_list_merge(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[2 * ARRAY_TEST_SIZE] = {0};
+    int64_t rarr[2 * ARRAY_TEST_SIZE] = {0};
+    size_t rsize = 0;
+
+    const LIST_TYPE types[] = { LIST_LINKED, LIST_UNROLLED };
+
+    for (size_t t = 0; t < ARRAY_SIZE(types); ++t)
+    {
+        /* interleaved keys, odd from src_p */
+        List* dst_p = list_create_with_type(types[t], sizeof(int64_t), my_compare_int64_t, NULL);
+        T_ERROR(dst_p == NULL);
+
+        List* src_p = list_create_with_type(types[t], sizeof(int64_t), my_compare_int64_t, NULL);
+        T_ERROR(src_p == NULL);
+
+        for (size_t i = 0; i < 2 * ARRAY_TEST_SIZE; ++i)
+        {
+            arr[i] = (int64_t)(((i * 7919) % (2 * ARRAY_TEST_SIZE)) / 3);
+            T_EXPECT(list_insert((i & 1) ? src_p : dst_p, (void*)&arr[i]), 0);
+        }
+
+        /* src_p is reused after merge, its nodes belong to dst_p now */
+        T_EXPECT(list_merge(dst_p, src_p), 0);
+        T_EXPECT(list_get_num_entries(src_p), (ssize_t)0);
+        T_EXPECT(list_get_num_entries(dst_p), (ssize_t)(2 * ARRAY_TEST_SIZE));
+
+        qsort((void*)&arr[0], ARRAY_SIZE(arr), sizeof(int64_t), my_compare_int64_t);
+        T_EXPECT(list_to_array_buffer(dst_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+        T_EXPECT(memcmp((const void*)&rarr[0], (const void*)&arr[0], sizeof(arr)), 0);
+
+        /* concatenation, merge to empty and merge of empty */
+        int64_t val = 5 * ARRAY_TEST_SIZE;
+        T_EXPECT(list_insert(src_p, (void*)&val), 0);
+        T_EXPECT(list_merge(dst_p, src_p), 0);
+        T_EXPECT(list_merge(dst_p, src_p), 0);
+        T_EXPECT(list_merge(src_p, dst_p), 0);
+        T_EXPECT(list_get_num_entries(dst_p), (ssize_t)0);
+        T_EXPECT(list_get_num_entries(src_p), (ssize_t)(2 * ARRAY_TEST_SIZE + 1));
+
+        T_EXPECT(list_to_array_buffer(src_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), -1);
+        T_EXPECT(list_delete(src_p, (void*)&val), 0);
+        T_EXPECT(list_to_array_buffer(src_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+        T_EXPECT(memcmp((const void*)&rarr[0], (const void*)&arr[0], sizeof(arr)), 0);
+
+        /* both lists still work */
+        T_EXPECT(list_insert(dst_p, (void*)&val), 0);
+        T_EXPECT(list_delete_all(src_p, (void*)&arr[0]), 3);
+
+        list_destroy(dst_p);
+        list_destroy(src_p);
+    }
+
+    List* linked_p = list_create_with_type(LIST_LINKED, sizeof(int64_t), my_compare_int64_t, NULL);
+    List* unrolled_p = list_create_with_type(LIST_UNROLLED, sizeof(int64_t), my_compare_int64_t, NULL);
+    T_EXPECT(list_merge(linked_p, unrolled_p), -1);
+    T_EXPECT(list_merge(linked_p, NULL), -1);
+    list_destroy(linked_p);
+    list_destroy(unrolled_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_list_split_at(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE] = {0};
+    int64_t rarr[ARRAY_TEST_SIZE] = {0};
+    size_t rsize = 0;
+
+    const LIST_TYPE types[] = { LIST_LINKED, LIST_UNROLLED };
+    const int64_t keys[] = { -1, 0, 1, 333, 498, 499, 500 };
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)(i / 2);
+
+    for (size_t t = 0; t < ARRAY_SIZE(types); ++t)
+        for (size_t k = 0; k < ARRAY_SIZE(keys); ++k)
+        {
+            List* list_p = list_create_from_sorted_array(types[t], (void*)&arr[0], ARRAY_TEST_SIZE, sizeof(int64_t), my_compare_int64_t, NULL);
+            T_ERROR(list_p == NULL);
+
+            List* high_p = list_split_at(list_p, (void*)&keys[k]);
+            T_ERROR(high_p == NULL);
+
+            const size_t low = keys[k] < 0 ? 0 : MIN((size_t)(2 * keys[k]), (size_t)ARRAY_TEST_SIZE);
+
+            T_EXPECT(list_get_num_entries(list_p), (ssize_t)low);
+            T_EXPECT(list_get_num_entries(high_p), (ssize_t)(ARRAY_TEST_SIZE - low));
+
+            T_EXPECT(list_to_array_buffer(list_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+            T_EXPECT(memcmp((const void*)&rarr[0], (const void*)&arr[0], low * sizeof(int64_t)), 0);
+
+            T_EXPECT(list_to_array_buffer(high_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+            T_EXPECT(memcmp((const void*)&rarr[0], (const void*)&arr[low], (ARRAY_TEST_SIZE - low) * sizeof(int64_t)), 0);
+
+            /* tail of list_p is fixed, so append and merge back give the same list */
+            T_EXPECT(list_merge(list_p, high_p), 0);
+            T_EXPECT(list_to_array_buffer(list_p, (void*)&rarr[0], ARRAY_SIZE(rarr), &rsize), 0);
+            T_EXPECT(memcmp((const void*)&rarr[0], (const void*)&arr[0], sizeof(arr)), 0);
+
+            list_destroy(high_p);
+            list_destroy(list_p);
+        }
+
+    T_ASSERT(list_split_at(NULL, (void*)&keys[0]), NULL);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
 int main(void)
 {
     TEST_INIT("TESTING LINKED LIST");
@@ -690,6 +1274,16 @@ int main(void)
     TEST(test_list_delete_all());
     TEST(test_list_delete_all_with_entries());
     TEST(test_list_search());
+    TEST(test_list_node_reuse());
+    TEST(test_list_to_array_buffer());
+    TEST(test_list_to_array_chunks());
+    TEST(test_list_unrolled());
+    TEST(test_list_unrolled_with_entries());
+    TEST(test_list_insert_ordered());
+    TEST(test_list_delete_all_batch());
+    TEST(test_list_create_from_sorted_array());
+    TEST(test_list_merge());
+    TEST(test_list_split_at());
     TEST_SUMMARY();
 
     return 0;
@@ -198,6 +198,76 @@ bool rbt_key_exist(const Rbt * __restrict__ const tree, const void * __restrict_
 int rbt_to_array(const Rbt * __restrict__ const tree, void * __restrict__ array, size_t * __restrict__ size);
 
 
+/*
+    Copy RBT entries in order (from min) to buffer provided by caller (no allocation).
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @OUT buffer - pointer to buffer.
+    @IN capacity - number of entries which fit in buffer.
+    @OUT size - number of copied entries (required capacity if buffer is too small).
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure.
+*/
+int rbt_to_array_buffer(const Rbt * __restrict__ const tree, void * __restrict__ buffer, const size_t capacity, size_t * __restrict__ size);
+
+
+/*
+    Export RBT entries in order (from min) in chunks of @chunk_len entries.
+    Chunk buffer is filled and passed to @consume_f, last chunk can be shorter.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN chunk - pointer to chunk buffer provided by caller.
+    @IN chunk_len - number of entries which fit in chunk.
+    @IN consume_f - chunk consumer function.
+    @IN arg - user argument passed to consume_f.
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure.
+    %Value returned by consume_f if it stopped export.
+*/
+int rbt_to_array_chunks(const Rbt * __restrict__ const tree, void * __restrict__ chunk, const size_t chunk_len, const chunk_f consume_f, void *arg);
+
+
+/*
+    Save snapshot of RBT to file descriptor.
+    Snapshot is a small header (magic, size of data, number of entries)
+    followed by raw data of every node in order (from min).
+    Data is copied byte by byte, so pointers stored in tree are not followed.
+
+    PARAMS:
+    @IN tree - pointer to tree.
+    @IN fd - file descriptor opened for writing.
+
+    RETURN:
+    %0 if success.
+    %Negative value if failure.
+*/
+int rbt_save(const Rbt * const tree, const int fd);
+
+
+/*
+    Load RBT from snapshot saved by rbt_save.
+    Tree is built in O(n) from sorted stream, without any rotation.
+
+    PARAMS:
+    @IN fd - file descriptor opened for reading.
+    @IN size_of - size_of data in tree (has to match snapshot).
+    @IN cmp - compare function.
+    @IN destroy - your data destructor function.
+    @IN print_f - print function.
+
+    RETURN:
+    %NULL if failure or snapshot is corrupted / not sorted.
+    %Pointer to RBT if success.
+*/
+Rbt *rbt_load(const int fd, const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f, const data_print_f print_f);
+
+
 /*
     Get number of entries.
 
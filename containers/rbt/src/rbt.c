@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <stdbool.h>
+#include <errno.h>
+#include <unistd.h> /* read, write */
 
 
 /* RBT COLORS */
@@ -9,6 +11,37 @@
 #define RBT_RED    1
 
 
+/* "RBTSNAP1" */
+#define RBT_SNAPSHOT_MAGIC ((uint64_t)0x31504e5354425252ULL)
+
+
+/* Size of buffer used by rbt_save and rbt_load */
+#define RBT_IO_BUFFER_SIZE ((size_t)(1UL << 16))
+
+
+/* Header of snapshot saved by rbt_save */
+typedef struct Rbt_file_header
+{
+    uint64_t magic;                 /* RBT_SNAPSHOT_MAGIC   */
+    uint64_t size_of;               /* size of each node    */
+    uint64_t nodes;                 /* number of entries    */
+} Rbt_file_header;
+
+
+/* Buffered stream of node data read by rbt_load */
+typedef struct Rbt_reader
+{
+    int fd;                         /* file descriptor      */
+    BYTE *buffer;                   /* read buffer          */
+    size_t capacity;                /* size of buffer       */
+    size_t pos;                     /* offset of next data  */
+    size_t len;                     /* valid bytes in buffer */
+    size_t left;                    /* entries not read yet */
+    size_t size_of;                 /* size of each node    */
+    bool error;                     /* stream is corrupted  */
+} Rbt_reader;
+
+
 __extension__ static ___unused___ Rbt_node __sentinel =
 {
     .left_son   = (Rbt_node *)&__sentinel,
@@ -208,6 +241,67 @@ static void __rbt_destroy(Rbt *tree, bool destroy);
 */
 ___inline___ static void __rbt_transplant(Rbt * tree, Rbt_node *ptr1, Rbt_node *ptr2);
 
+/*
+    Read exactly @bytes from @fd (restart on partial reads and EINTR).
+
+    PARAMS:
+    @IN fd - file descriptor.
+    @OUT buffer - pointer to buffer.
+    @IN bytes - number of bytes to read.
+
+    RETURN:
+    %0 if success.
+    %-1 if failure or end of file.
+*/
+static int __rbt_read_all(const int fd, void *buffer, const size_t bytes);
+
+
+/*
+    Write exactly @bytes to @fd (restart on partial writes and EINTR).
+
+    PARAMS:
+    @IN fd - file descriptor.
+    @IN buffer - pointer to buffer.
+    @IN bytes - number of bytes to write.
+
+    RETURN:
+    %0 if success.
+    %-1 if failure.
+*/
+static int __rbt_write_all(const int fd, const void *buffer, const size_t bytes);
+
+
+/*
+    Get next node data from snapshot stream.
+
+    PARAMS:
+    @IN reader - pointer to reader.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to data in reader buffer if success.
+*/
+static const void *__rbt_reader_next(Rbt_reader *reader);
+
+
+/*
+    Build perfectly balanced subtree of @n nodes from sorted stream.
+    Nodes on level @red_depth (last, not full level) are red, others black.
+
+    PARAMS:
+    @IN tree - pointer to RBT.
+    @IN reader - pointer to reader.
+    @IN n - number of nodes in subtree.
+    @IN depth - depth of subtree root.
+    @IN red_depth - depth of red nodes.
+    @IN prev - last built node (to check if stream is sorted).
+
+    RETURN:
+    %Pointer to subtree root (sentinel if empty).
+*/
+static Rbt_node *__rbt_build(Rbt *tree, Rbt_reader *reader, const size_t n, const size_t depth, const size_t red_depth, Rbt_node **prev);
+
+
 /*
     Delete entry with key equals data_key using compare function.
 
@@ -599,31 +693,33 @@ static void __rbt_destroy(Rbt *tree, bool destroy)
     if (tree == NULL)
         return;
 
-    if (tree->root == NULL || tree->root == sentinel)
-    {
-        FREE(tree);
-        return;
-    }
-
-    // Possible stack overflow.
-    // It'll be refactored to BFS algorithm with fifo.
-    // fifo size 2*log2(height) + 2.
-    Rbt_node *array_of_nodes[tree->nodes];
-
-    Rbt_node *node = __rbt_min_node(tree->root);
+    Rbt_node *node = tree->root;
 
-    for (size_t i = 0; i < tree->nodes; ++i)
+    /* postorder walk with parent links, no extra memory even for huge trees */
+    while (node != NULL && node != sentinel)
     {
-        array_of_nodes[i] = node;
-        node = __rbt_successor(node);
-    }
+        if (node->left_son != sentinel)
+            node = node->left_son;
+        else if (node->right_son != sentinel)
+            node = node->right_son;
+        else
+        {
+            Rbt_node *parent = node->parent;
 
-    for (size_t i = 0; i < tree->nodes; ++i)
-    {
-        if (destroy == true && tree->destroy_f != NULL)
-            tree->destroy_f((void *)array_of_nodes[i]->data);
+            if (parent != sentinel)
+            {
+                if (parent->left_son == node)
+                    parent->left_son = (Rbt_node *)sentinel;
+                else
+                    parent->right_son = (Rbt_node *)sentinel;
+            }
 
-        FREE(array_of_nodes[i]);
+            if (destroy == true && tree->destroy_f != NULL)
+                tree->destroy_f((void *)node->data);
+
+            FREE(node);
+            node = parent;
+        }
     }
 
     FREE(tree);
@@ -647,6 +743,118 @@ ___inline___ static void __rbt_transplant(Rbt * tree, Rbt_node *ptr1, Rbt_node *
 }
 
 
+static int __rbt_read_all(const int fd, void *buffer, const size_t bytes)
+{
+    BYTE *ptr = (BYTE *)buffer;
+    size_t done = 0;
+
+    while (done < bytes)
+    {
+        const ssize_t ret = read(fd, (void *)(ptr + done), bytes - done);
+
+        if (ret < 0 && errno == EINTR)
+            continue;
+
+        if (ret <= 0)
+            return -1;
+
+        done += (size_t)ret;
+    }
+
+    return 0;
+}
+
+
+static int __rbt_write_all(const int fd, const void *buffer, const size_t bytes)
+{
+    const BYTE *ptr = (const BYTE *)buffer;
+    size_t done = 0;
+
+    while (done < bytes)
+    {
+        const ssize_t ret = write(fd, (const void *)(ptr + done), bytes - done);
+
+        if (ret < 0 && errno == EINTR)
+            continue;
+
+        if (ret <= 0)
+            return -1;
+
+        done += (size_t)ret;
+    }
+
+    return 0;
+}
+
+
+static const void *__rbt_reader_next(Rbt_reader *reader)
+{
+    assert(reader != NULL);
+
+    if (reader->pos == reader->len)
+    {
+        if (reader->left == 0)
+            return NULL;
+
+        const size_t to_read = MIN(reader->capacity / reader->size_of, reader->left);
+
+        if (__rbt_read_all(reader->fd, (void *)reader->buffer, to_read * reader->size_of) != 0)
+            return NULL;
+
+        reader->pos = 0;
+        reader->len = to_read * reader->size_of;
+        reader->left -= to_read;
+    }
+
+    const void *data = (const void *)(reader->buffer + reader->pos);
+    reader->pos += reader->size_of;
+
+    return data;
+}
+
+
+static Rbt_node *__rbt_build(Rbt *tree, Rbt_reader *reader, const size_t n, const size_t depth, const size_t red_depth, Rbt_node **prev)
+{
+    if (n == 0 || reader->error)
+        return (Rbt_node *)sentinel;
+
+    /* in order: left subtree, node, right subtree, the same order as in stream */
+    const size_t left_n = (n - 1) / 2;
+    Rbt_node *left_son = __rbt_build(tree, reader, left_n, depth + 1, red_depth, prev);
+
+    const void *data = __rbt_reader_next(reader);
+    Rbt_node *node = data == NULL ? NULL : __rbt_create_node(data, tree->size_of, sentinel);
+
+    /* keep already built nodes linked, so whole tree can be destroyed */
+    if (node == NULL)
+    {
+        reader->error = true;
+        return left_son;
+    }
+
+    node->left_son = left_son;
+
+    if (left_son != sentinel)
+        left_son->parent = node;
+
+    node->color = depth == red_depth ? RBT_RED : RBT_BLACK;
+
+    if (*prev != NULL && tree->cmp_f((*prev)->data, node->data) >= 0)
+        reader->error = true;
+
+    *prev = node;
+    ++tree->nodes;
+
+    Rbt_node *right_son = __rbt_build(tree, reader, n - 1 - left_n, depth + 1, red_depth, prev);
+    node->right_son = right_son;
+
+    if (right_son != sentinel)
+        right_son->parent = node;
+
+    return node;
+}
+
+
 static int __rbt_delete(Rbt * tree, const void * __restrict__ const data_key, bool destroy)
 {
     assert(tree != NULL);
@@ -945,6 +1153,214 @@ int rbt_to_array(const Rbt * __restrict__ const tree, void * __restrict__ array,
 }
 
 
+int rbt_to_array_buffer(const Rbt * __restrict__ const tree, void * __restrict__ buffer, const size_t capacity, size_t * __restrict__ size)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (buffer == NULL)
+        ERROR("buffer == NULL\n", -1);
+
+    if (size == NULL)
+        ERROR("size == NULL\n", -1);
+
+    if (capacity < tree->nodes)
+    {
+        *size = tree->nodes;
+        ERROR("capacity < tree->nodes\n", -1);
+    }
+
+    *size = tree->nodes;
+
+    if (tree->root == sentinel)
+        return 0;
+
+    BYTE *arr = (BYTE *)buffer;
+    Rbt_node *node = __rbt_min_node(tree->root);
+    size_t offset = 0;
+
+    while (node != sentinel && node != NULL)
+    {
+        __ASSIGN__(arr[offset], *(BYTE *)node->data, tree->size_of);
+        offset += tree->size_of;
+
+        node = __rbt_successor(node);
+    }
+
+    return 0;
+}
+
+
+int rbt_to_array_chunks(const Rbt * __restrict__ const tree, void * __restrict__ chunk, const size_t chunk_len, const chunk_f consume_f, void *arg)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (chunk == NULL)
+        ERROR("chunk == NULL\n", -1);
+
+    if (chunk_len == 0)
+        ERROR("chunk_len == 0\n", -1);
+
+    if (consume_f == NULL)
+        ERROR("consume_f == NULL\n", -1);
+
+    if (tree->root == sentinel)
+        return 0;
+
+    BYTE *arr = (BYTE *)chunk;
+    Rbt_node *node = __rbt_min_node(tree->root);
+    size_t entries = 0;
+
+    while (node != sentinel && node != NULL)
+    {
+        __ASSIGN__(arr[entries * tree->size_of], *(BYTE *)node->data, tree->size_of);
+        node = __rbt_successor(node);
+
+        if (++entries == chunk_len)
+        {
+            const int ret = consume_f(chunk, entries, arg);
+
+            if (ret != 0)
+                return ret;
+
+            entries = 0;
+        }
+    }
+
+    if (entries > 0)
+        return consume_f(chunk, entries, arg);
+
+    return 0;
+}
+
+
+int rbt_save(const Rbt * const tree, const int fd)
+{
+    if (tree == NULL)
+        ERROR("tree == NULL\n", -1);
+
+    if (fd < 0)
+        ERROR("fd < 0\n", -1);
+
+    const Rbt_file_header header =
+    {
+        .magic = RBT_SNAPSHOT_MAGIC,
+        .size_of = (uint64_t)tree->size_of,
+        .nodes = (uint64_t)tree->nodes
+    };
+
+    if (__rbt_write_all(fd, (const void *)&header, sizeof(header)) != 0)
+        ERROR("write error\n", -1);
+
+    if (tree->root == sentinel)
+        return 0;
+
+    const size_t capacity = MAX(RBT_IO_BUFFER_SIZE / tree->size_of, (size_t)1) * tree->size_of;
+    BYTE *buffer = (BYTE *)malloc(capacity);
+
+    if (buffer == NULL)
+        ERROR("malloc error\n", -1);
+
+    Rbt_node *node = __rbt_min_node(tree->root);
+    size_t offset = 0;
+
+    while (node != sentinel && node != NULL)
+    {
+        __ASSIGN__(buffer[offset], *(BYTE *)node->data, tree->size_of);
+        offset += tree->size_of;
+
+        if (offset == capacity)
+        {
+            if (__rbt_write_all(fd, (const void *)buffer, offset) != 0)
+            {
+                FREE(buffer);
+                ERROR("write error\n", -1);
+            }
+
+            offset = 0;
+        }
+
+        node = __rbt_successor(node);
+    }
+
+    if (offset > 0 && __rbt_write_all(fd, (const void *)buffer, offset) != 0)
+    {
+        FREE(buffer);
+        ERROR("write error\n", -1);
+    }
+
+    FREE(buffer);
+
+    return 0;
+}
+
+
+Rbt *rbt_load(const int fd, const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f, const data_print_f print_f)
+{
+    if (fd < 0)
+        ERROR("fd < 0\n", NULL);
+
+    Rbt_file_header header;
+
+    if (__rbt_read_all(fd, (void *)&header, sizeof(header)) != 0)
+        ERROR("read error\n", NULL);
+
+    if (header.magic != RBT_SNAPSHOT_MAGIC)
+        ERROR("header.magic != RBT_SNAPSHOT_MAGIC\n", NULL);
+
+    if (header.size_of != (uint64_t)size_of)
+        ERROR("header.size_of != size_of\n", NULL);
+
+    Rbt *tree = rbt_create(size_of, cmp_f, destroy_f, print_f);
+
+    if (tree == NULL)
+        ERROR("rbt_create error\n", NULL);
+
+    if (header.nodes == 0)
+        return tree;
+
+    Rbt_reader reader =
+    {
+        .fd = fd,
+        .buffer = NULL,
+        .capacity = MAX(RBT_IO_BUFFER_SIZE / size_of, (size_t)1) * size_of,
+        .pos = 0,
+        .len = 0,
+        .left = (size_t)header.nodes,
+        .size_of = size_of,
+        .error = false
+    };
+
+    reader.buffer = (BYTE *)malloc(reader.capacity);
+
+    if (reader.buffer == NULL)
+    {
+        rbt_destroy(tree);
+        ERROR("malloc error\n", NULL);
+    }
+
+    /* all levels above red_depth are full */
+    size_t red_depth = 0;
+
+    while (((size_t)2 << red_depth) - 1 <= (size_t)header.nodes)
+        ++red_depth;
+
+    Rbt_node *prev = NULL;
+    tree->root = __rbt_build(tree, &reader, (size_t)header.nodes, 0, red_depth, &prev);
+
+    FREE(reader.buffer);
+
+    if (reader.error)
+    {
+        rbt_destroy(tree);
+        ERROR("snapshot is corrupted\n", NULL);
+    }
+
+    return tree;
+}
+
+
 ssize_t rbt_get_num_entries(const Rbt * const tree)
 {
     if (tree == NULL)
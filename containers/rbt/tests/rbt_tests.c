@@ -6,6 +6,7 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <string.h>
+#include <unistd.h> /* lseek, write, ftruncate */
 
 
 typedef struct MyStruct
@@ -105,6 +106,178 @@ bool correct_height(int height, size_t n)
 }
 
 
+/* sentinel is the only node which is its own son */
+static int black_height(const Rbt_node *node)
+{
+    if (node->left_son == node)
+        return 1;
+
+    if (node->color == 1 && (node->left_son->color == 1 || node->right_son->color == 1))
+        return -1;
+
+    const int left = black_height(node->left_son);
+    const int right = black_height(node->right_son);
+
+    if (left < 0 || right < 0 || left != right)
+        return -1;
+
+    return left + (node->color == 0 ? 1 : 0);
+}
+
+
+static int sum_chunk(const void *chunk, size_t entries, void *arg)
+{
+    const int64_t *arr = (const int64_t *)chunk;
+    int64_t *sum = (int64_t *)arg;
+
+    /* entries have to come in order */
+    for (size_t i = 1; i < entries; ++i)
+        if (arr[i - 1] >= arr[i])
+            return -2;
+
+    for (size_t i = 0; i < entries; ++i)
+        *sum += arr[i];
+
+    return 0;
+}
+
+
+static void test_rbt_to_array_buffer_chunks(void)
+{
+    const size_t size = 1000;
+
+    int64_t *buffer = (int64_t *)malloc(sizeof(int64_t) * size);
+    T_ERROR(buffer == NULL);
+
+    int64_t chunk[64];
+    size_t rsize = 0;
+    int64_t sum = 0;
+
+    Rbt *tree = rbt_create(sizeof(int64_t), my_compare_int64_t, NULL, NULL);
+    T_ERROR(tree == NULL);
+
+    T_EXPECT(rbt_to_array_buffer(tree, (void *)buffer, size, &rsize), 0);
+    T_ASSERT(rsize, (size_t)0);
+    T_EXPECT(rbt_to_array_chunks(tree, (void *)&chunk[0], ARRAY_SIZE(chunk), sum_chunk, (void *)&sum), 0);
+    T_ASSERT(sum, (int64_t)0);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const int64_t val = (int64_t)(size - i);
+        T_EXPECT(rbt_insert(tree, (const void *)&val), 0);
+    }
+
+    T_EXPECT(rbt_to_array_buffer(tree, (void *)buffer, size - 1, &rsize), -1);
+    T_ASSERT(rsize, size);
+
+    T_EXPECT(rbt_to_array_buffer(tree, (void *)buffer, size, &rsize), 0);
+    T_ASSERT(rsize, size);
+
+    for (size_t i = 0; i < size; ++i)
+        T_ASSERT(buffer[i], (int64_t)(i + 1));
+
+    T_EXPECT(rbt_to_array_chunks(tree, (void *)&chunk[0], ARRAY_SIZE(chunk), sum_chunk, (void *)&sum), 0);
+    T_ASSERT(sum, (int64_t)(size * (size + 1) / 2));
+
+    T_EXPECT(rbt_to_array_buffer(NULL, (void *)buffer, size, &rsize), -1);
+    T_EXPECT(rbt_to_array_buffer(tree, NULL, size, &rsize), -1);
+    T_EXPECT(rbt_to_array_chunks(tree, (void *)&chunk[0], 0, sum_chunk, (void *)&sum), -1);
+    T_EXPECT(rbt_to_array_chunks(tree, (void *)&chunk[0], ARRAY_SIZE(chunk), NULL, (void *)&sum), -1);
+
+    FREE(buffer);
+    rbt_destroy(tree);
+}
+
+
+static void test_rbt_save_load(void)
+{
+    const size_t sizes[] = { 0, 1, 2, 3, 7, 8, 100, 10000, 100003 };
+
+    for (size_t s = 0; s < ARRAY_SIZE(sizes); ++s)
+    {
+        const size_t size = sizes[s];
+
+        FILE *file = tmpfile();
+        T_ERROR(file == NULL);
+        const int fd = fileno(file);
+
+        Rbt *tree = rbt_create(sizeof(int64_t), my_compare_int64_t, NULL, NULL);
+        T_ERROR(tree == NULL);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const int64_t val = (int64_t)((i * 7919) % size);
+            T_EXPECT(rbt_insert(tree, (const void *)&val), 0);
+        }
+
+        T_EXPECT(rbt_save(tree, fd), 0);
+        rbt_destroy(tree);
+
+        T_EXPECT(lseek(fd, 0, SEEK_SET), (off_t)0);
+        T_ASSERT(rbt_load(fd, sizeof(int32_t), my_compare_int64_t, NULL, NULL), NULL);
+
+        T_EXPECT(lseek(fd, 0, SEEK_SET), (off_t)0);
+        tree = rbt_load(fd, sizeof(int64_t), my_compare_int64_t, NULL, NULL);
+        T_ERROR(tree == NULL);
+
+        T_EXPECT(rbt_get_num_entries(tree), (ssize_t)size);
+        T_CHECK(black_height(tree->root) > 0);
+        T_EXPECT(correct_balanced_height(rbt_get_height(tree), size), (bool)true);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const int64_t key = (int64_t)i;
+            int64_t val = -1;
+
+            T_EXPECT(rbt_search(tree, (const void *)&key, (const void *)&val), 0);
+            T_ASSERT(val, key);
+        }
+
+        /* loaded tree has to be a proper RBT for further operations */
+        for (size_t i = 0; i < size; i += 2)
+        {
+            const int64_t key = (int64_t)i;
+            T_EXPECT(rbt_delete(tree, (const void *)&key), 0);
+        }
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            const int64_t key = (int64_t)(size + i);
+            T_EXPECT(rbt_insert(tree, (const void *)&key), 0);
+        }
+
+        T_CHECK(black_height(tree->root) > 0);
+        T_EXPECT(rbt_get_num_entries(tree), (ssize_t)(size + size / 2));
+
+        rbt_destroy(tree);
+        (void)fclose(file);
+    }
+
+    /* not sorted stream */
+    FILE *file = tmpfile();
+    T_ERROR(file == NULL);
+    const int fd = fileno(file);
+
+    const uint64_t header[] = { 0x31504e5354425252ULL, sizeof(int64_t), 3 };
+    const int64_t data[] = { 1, 3, 2 };
+
+    T_EXPECT(write(fd, (const void *)header, sizeof(header)), (ssize_t)sizeof(header));
+    T_EXPECT(write(fd, (const void *)data, sizeof(data)), (ssize_t)sizeof(data));
+    T_EXPECT(lseek(fd, 0, SEEK_SET), (off_t)0);
+    T_ASSERT(rbt_load(fd, sizeof(int64_t), my_compare_int64_t, NULL, NULL), NULL);
+
+    /* truncated stream */
+    T_EXPECT(ftruncate(fd, (off_t)(sizeof(header) + sizeof(int64_t))), 0);
+    T_EXPECT(lseek(fd, 0, SEEK_SET), (off_t)0);
+    T_ASSERT(rbt_load(fd, sizeof(int64_t), my_compare_int64_t, NULL, NULL), NULL);
+
+    (void)fclose(file);
+
+    T_EXPECT(rbt_save(NULL, 1), -1);
+    T_ASSERT(rbt_load(-1, sizeof(int64_t), my_compare_int64_t, NULL, NULL), NULL);
+}
+
+
 static void test_rbt_create(void)
 {
     Rbt *tree; 
@@ -1078,6 +1251,8 @@ int main(void)
     TEST(test_rbt_insert_delete());
     TEST(test_rbt_empty());
     TEST(test_rbt_print());
+    TEST(test_rbt_to_array_buffer_chunks());
+    TEST(test_rbt_save_load());
     TEST_SUMMARY();
 
     return 0;
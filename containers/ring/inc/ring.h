@@ -0,0 +1,256 @@
+#ifndef RING_H
+#define RING_H
+
+
+/*
+    Bounded lock-free ring queues
+
+    Spsc_ring - single producer / single consumer ring. Producer owns tail,
+    consumer owns head, each on own cache line. Each side keeps cached copy
+    of the other index, so shared line is read only when ring looks full / empty.
+    Batch push / pop publish many entries with one release store.
+
+    Mpmc_ring - many producers / many consumers ring (Dmitry Vyukov's bounded
+    queue). Every cell has sequence number which says if cell is ready for
+    producer or for consumer of given round, so producers and consumers
+    only race for their position counter with one CAS.
+
+    Both rings are allocated once in create, capacity is rounded up to power of 2.
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <stddef.h> /* size_t */
+#include <stdbool.h> /* bool */
+#include <sys/types.h> /* ssize_t */
+
+
+typedef struct Spsc_ring Spsc_ring;
+typedef struct Mpmc_ring Mpmc_ring;
+
+
+/*
+    Create new instance of spsc ring.
+
+    PARAMS:
+    @IN size_of - size of each element.
+    @IN capacity - max number of entries (rounded up to power of 2).
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to ring if success.
+*/
+Spsc_ring *spsc_ring_create(size_t size_of, size_t capacity);
+
+
+/*
+    Deallocate ring. (no other thread can use ring)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+
+    RETURN:
+    %This is void function.
+*/
+void spsc_ring_destroy(Spsc_ring *ring);
+
+
+/*
+    Push value to ring. (only one producer thread)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %1 if ring is full.
+    %negative value if failure.
+*/
+int spsc_ring_push(Spsc_ring * __restrict__ ring, const void * __restrict__ entry);
+
+
+/*
+    Pop value from ring. (only one consumer thread)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @OUT val_out - popped value.
+
+    RETURN:
+    %0 if success.
+    %1 if ring is empty.
+    %negative value if failure.
+*/
+int spsc_ring_pop(Spsc_ring * __restrict__ ring, void * __restrict__ val_out);
+
+
+/*
+    Push up to @num values to ring and publish them at once. (only one producer thread)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @IN entries - array of entries.
+    @IN num - number of entries.
+
+    RETURN:
+    %number of pushed entries (0 if ring is full) if success.
+    %-1 if failure.
+*/
+ssize_t spsc_ring_push_batch(Spsc_ring * __restrict__ ring, const void * __restrict__ entries, size_t num);
+
+
+/*
+    Pop up to @num values from ring at once. (only one consumer thread)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @OUT val_out - array for at least @num entries.
+    @IN num - max number of entries.
+
+    RETURN:
+    %number of popped entries (0 if ring is empty) if success.
+    %-1 if failure.
+*/
+ssize_t spsc_ring_pop_batch(Spsc_ring * __restrict__ ring, void * __restrict__ val_out, size_t num);
+
+
+/*
+    Get number of entries. (result can be outdated when returned)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+
+    RETURN:
+    %number of entries if success.
+    %-1 if failure.
+*/
+ssize_t spsc_ring_get_num_entries(const Spsc_ring *ring);
+
+
+/*
+    Get max number of entries.
+
+    PARAMS:
+    @IN ring - pointer to ring.
+
+    RETURN:
+    %capacity if success.
+    %-1 if failure.
+*/
+ssize_t spsc_ring_get_capacity(const Spsc_ring *ring);
+
+
+/*
+    Get size of data.
+
+    PARAMS:
+    @IN ring - pointer to ring.
+
+    RETURN:
+    %sizeof if success.
+    %-1 if failure.
+*/
+ssize_t spsc_ring_get_data_size(const Spsc_ring *ring);
+
+
+/*
+    Create new instance of mpmc ring.
+
+    PARAMS:
+    @IN size_of - size of each element.
+    @IN capacity - max number of entries (at least 2, rounded up to power of 2).
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to ring if success.
+*/
+Mpmc_ring *mpmc_ring_create(size_t size_of, size_t capacity);
+
+
+/*
+    Deallocate ring. (no other thread can use ring)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+
+    RETURN:
+    %This is void function.
+*/
+void mpmc_ring_destroy(Mpmc_ring *ring);
+
+
+/*
+    Push value to ring. (thread safe, lock-free)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @IN entry - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %1 if ring is full.
+    %negative value if failure.
+*/
+int mpmc_ring_push(Mpmc_ring * __restrict__ ring, const void * __restrict__ entry);
+
+
+/*
+    Pop value from ring. (thread safe, lock-free)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @OUT val_out - popped value.
+
+    RETURN:
+    %0 if success.
+    %1 if ring is empty.
+    %negative value if failure.
+*/
+int mpmc_ring_pop(Mpmc_ring * __restrict__ ring, void * __restrict__ val_out);
+
+
+/*
+    Get number of entries. (result can be outdated when returned)
+
+    PARAMS:
+    @IN ring - pointer to ring.
+
+    RETURN:
+    %number of entries if success.
+    %-1 if failure.
+*/
+ssize_t mpmc_ring_get_num_entries(const Mpmc_ring *ring);
+
+
+/*
+    Get max number of entries.
+
+    PARAMS:
+    @IN ring - pointer to ring.
+
+    RETURN:
+    %capacity if success.
+    %-1 if failure.
+*/
+ssize_t mpmc_ring_get_capacity(const Mpmc_ring *ring);
+
+
+/*
+    Get size of data.
+
+    PARAMS:
+    @IN ring - pointer to ring.
+
+    RETURN:
+    %sizeof if success.
+    %-1 if failure.
+*/
+ssize_t mpmc_ring_get_data_size(const Mpmc_ring *ring);
+
+
+#endif /* RING_H */
@@ -0,0 +1,499 @@
+#include <ring.h>
+#include <common.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* each side of spsc ring has own cache line */
+typedef struct Spsc_side
+{
+    size_t pos;                 /* own position, written only by this side */
+    size_t cached_pos;          /* last seen position of the other side */
+    BYTE pad[CACHE_LINE_SIZE - 2 * sizeof(size_t)];
+} Spsc_side;
+
+
+struct Spsc_ring
+{
+    Spsc_side producer;         /* pos is tail (next entry to write) */
+    Spsc_side consumer;         /* pos is head (next entry to read) */
+
+    BYTE *array;                /* entries */
+    size_t mask;                /* capacity - 1 */
+    size_t size_of;             /* size of element */
+    size_t capacity;            /* number of entries in array (power of 2) */
+};
+
+
+typedef struct Mpmc_cell
+{
+    size_t seq;                 /* pos when ready for producer, pos + 1 when ready for consumer */
+    size_t reserved;            /* keeps data 16 byte aligned */
+
+    BYTE data[];                /* placeholder for data */
+} Mpmc_cell;
+
+
+/* position counter on own cache line, producers and consumers don't false share */
+typedef struct Mpmc_pos
+{
+    size_t pos;
+    BYTE pad[CACHE_LINE_SIZE - sizeof(size_t)];
+} Mpmc_pos;
+
+
+struct Mpmc_ring
+{
+    Mpmc_pos enqueue;           /* next position to push */
+    Mpmc_pos dequeue;           /* next position to pop */
+
+    BYTE *cells;                /* cells */
+    size_t cell_size;           /* size of cell with data */
+    size_t mask;                /* capacity - 1 */
+    size_t size_of;             /* size of element */
+    size_t capacity;            /* number of cells (power of 2) */
+};
+
+
+/*
+    Round @capacity up to power of 2.
+
+    PARAMS:
+    @IN capacity - requested capacity.
+
+    RETURN:
+    %0 if @capacity is too big.
+    %Rounded capacity if success.
+*/
+static size_t __ring_round_capacity(size_t capacity);
+
+
+/*
+    Copy @num entries from contiguous @src to ring array starting at position @pos.
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @IN src - source array.
+    @IN pos - position in ring (not masked).
+    @IN num - number of entries.
+
+    RETURN:
+    %This is void function.
+*/
+static void __spsc_ring_copy_in(Spsc_ring * __restrict__ ring, const void * __restrict__ src, size_t pos, size_t num);
+
+
+/*
+    Copy @num entries from ring array starting at position @pos to contiguous @dst.
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @OUT dst - destination array.
+    @IN pos - position in ring (not masked).
+    @IN num - number of entries.
+
+    RETURN:
+    %This is void function.
+*/
+static void __spsc_ring_copy_out(const Spsc_ring * __restrict__ ring, void * __restrict__ dst, size_t pos, size_t num);
+
+
+/*
+    Get cell from mpmc ring.
+
+    PARAMS:
+    @IN ring - pointer to ring.
+    @IN pos - position in ring (not masked).
+
+    RETURN:
+    %Pointer to cell.
+*/
+static ___inline___ Mpmc_cell *__mpmc_ring_cell(const Mpmc_ring *ring, size_t pos);
+
+
+static size_t __ring_round_capacity(size_t capacity)
+{
+    size_t rounded = 1;
+
+    while (rounded < capacity)
+    {
+        if (rounded > SIZE_MAX / 2)
+            return 0;
+
+        rounded *= 2;
+    }
+
+    return rounded;
+}
+
+
+static void __spsc_ring_copy_in(Spsc_ring * __restrict__ ring, const void * __restrict__ src, size_t pos, size_t num)
+{
+    const size_t start = pos & ring->mask;
+    const size_t first = MIN(num, ring->capacity - start);
+
+    (void)memcpy(ring->array + start * ring->size_of, src, first * ring->size_of);
+    (void)memcpy(ring->array, (const BYTE *)src + first * ring->size_of, (num - first) * ring->size_of);
+}
+
+
+static void __spsc_ring_copy_out(const Spsc_ring * __restrict__ ring, void * __restrict__ dst, size_t pos, size_t num)
+{
+    const size_t start = pos & ring->mask;
+    const size_t first = MIN(num, ring->capacity - start);
+
+    (void)memcpy(dst, ring->array + start * ring->size_of, first * ring->size_of);
+    (void)memcpy((BYTE *)dst + first * ring->size_of, ring->array, (num - first) * ring->size_of);
+}
+
+
+static ___inline___ Mpmc_cell *__mpmc_ring_cell(const Mpmc_ring *ring, size_t pos)
+{
+    return (Mpmc_cell *)(void *)(ring->cells + (pos & ring->mask) * ring->cell_size);
+}
+
+
+Spsc_ring *spsc_ring_create(size_t size_of, size_t capacity)
+{
+    if (size_of < 1)
+        ERROR("size_of < 1\n", NULL);
+
+    if (capacity < 1)
+        ERROR("capacity < 1\n", NULL);
+
+    capacity = __ring_round_capacity(capacity);
+
+    if (capacity == 0 || capacity > SIZE_MAX / size_of)
+        ERROR("capacity is too big\n", NULL);
+
+    Spsc_ring *ring = (Spsc_ring *)calloc(1, sizeof(*ring));
+
+    if (ring == NULL)
+        ERROR("calloc error\n", NULL);
+
+    ring->array = (BYTE *)malloc(capacity * size_of);
+
+    if (ring->array == NULL)
+    {
+        FREE(ring);
+        ERROR("malloc error\n", NULL);
+    }
+
+    ring->mask = capacity - 1;
+    ring->size_of = size_of;
+    ring->capacity = capacity;
+
+    return ring;
+}
+
+
+void spsc_ring_destroy(Spsc_ring *ring)
+{
+    if (ring == NULL)
+        return;
+
+    FREE(ring->array);
+    FREE(ring);
+}
+
+
+int spsc_ring_push(Spsc_ring * __restrict__ ring, const void * __restrict__ entry)
+{
+    if (ring == NULL || entry == NULL)
+        ERROR("ring == NULL || entry == NULL\n", -1);
+
+    const size_t tail = ring->producer.pos;
+
+    /* shared head is read only when ring looks full */
+    if (tail - ring->producer.cached_pos == ring->capacity)
+    {
+        ring->producer.cached_pos = __atomic_load_n(&ring->consumer.pos, __ATOMIC_ACQUIRE);
+
+        if (tail - ring->producer.cached_pos == ring->capacity)
+            return 1;
+    }
+
+    (void)memcpy(ring->array + (tail & ring->mask) * ring->size_of, entry, ring->size_of);
+
+    /* release publishes entry to consumer */
+    __atomic_store_n(&ring->producer.pos, tail + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+
+int spsc_ring_pop(Spsc_ring * __restrict__ ring, void * __restrict__ val_out)
+{
+    if (ring == NULL || val_out == NULL)
+        ERROR("ring == NULL || val_out == NULL\n", -1);
+
+    const size_t head = ring->consumer.pos;
+
+    /* shared tail is read only when ring looks empty */
+    if (head == ring->consumer.cached_pos)
+    {
+        ring->consumer.cached_pos = __atomic_load_n(&ring->producer.pos, __ATOMIC_ACQUIRE);
+
+        if (head == ring->consumer.cached_pos)
+            return 1;
+    }
+
+    (void)memcpy(val_out, ring->array + (head & ring->mask) * ring->size_of, ring->size_of);
+
+    /* release gives slot back to producer after entry was copied */
+    __atomic_store_n(&ring->consumer.pos, head + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+
+ssize_t spsc_ring_push_batch(Spsc_ring * __restrict__ ring, const void * __restrict__ entries, size_t num)
+{
+    if (ring == NULL || entries == NULL)
+        ERROR("ring == NULL || entries == NULL\n", -1);
+
+    const size_t tail = ring->producer.pos;
+    size_t free_slots = ring->capacity - (tail - ring->producer.cached_pos);
+
+    if (free_slots < num)
+    {
+        ring->producer.cached_pos = __atomic_load_n(&ring->consumer.pos, __ATOMIC_ACQUIRE);
+        free_slots = ring->capacity - (tail - ring->producer.cached_pos);
+    }
+
+    num = MIN(num, free_slots);
+
+    if (num == 0)
+        return 0;
+
+    __spsc_ring_copy_in(ring, entries, tail, num);
+    __atomic_store_n(&ring->producer.pos, tail + num, __ATOMIC_RELEASE);
+
+    return (ssize_t)num;
+}
+
+
+ssize_t spsc_ring_pop_batch(Spsc_ring * __restrict__ ring, void * __restrict__ val_out, size_t num)
+{
+    if (ring == NULL || val_out == NULL)
+        ERROR("ring == NULL || val_out == NULL\n", -1);
+
+    const size_t head = ring->consumer.pos;
+    size_t entries = ring->consumer.cached_pos - head;
+
+    if (entries < num)
+    {
+        ring->consumer.cached_pos = __atomic_load_n(&ring->producer.pos, __ATOMIC_ACQUIRE);
+        entries = ring->consumer.cached_pos - head;
+    }
+
+    num = MIN(num, entries);
+
+    if (num == 0)
+        return 0;
+
+    __spsc_ring_copy_out(ring, val_out, head, num);
+    __atomic_store_n(&ring->consumer.pos, head + num, __ATOMIC_RELEASE);
+
+    return (ssize_t)num;
+}
+
+
+ssize_t spsc_ring_get_num_entries(const Spsc_ring *ring)
+{
+    if (ring == NULL)
+        ERROR("ring == NULL\n", -1);
+
+    /* head first, so tail - head is never below 0 */
+    const size_t head = __atomic_load_n(&ring->consumer.pos, __ATOMIC_ACQUIRE);
+    const size_t tail = __atomic_load_n(&ring->producer.pos, __ATOMIC_ACQUIRE);
+
+    return (ssize_t)(tail - head);
+}
+
+
+ssize_t spsc_ring_get_capacity(const Spsc_ring *ring)
+{
+    if (ring == NULL)
+        ERROR("ring == NULL\n", -1);
+
+    return (ssize_t)ring->capacity;
+}
+
+
+ssize_t spsc_ring_get_data_size(const Spsc_ring *ring)
+{
+    if (ring == NULL)
+        ERROR("ring == NULL\n", -1);
+
+    return (ssize_t)ring->size_of;
+}
+
+
+Mpmc_ring *mpmc_ring_create(size_t size_of, size_t capacity)
+{
+    if (size_of < 1)
+        ERROR("size_of < 1\n", NULL);
+
+    /* with 1 cell, seq of full cell and empty cell of next round are the same */
+    if (capacity < 2)
+        ERROR("capacity < 2\n", NULL);
+
+    capacity = __ring_round_capacity(capacity);
+
+    const size_t cell_size = ALIGN_UP(sizeof(Mpmc_cell) + size_of, sizeof(Mpmc_cell));
+
+    if (capacity == 0 || cell_size < size_of || capacity > SIZE_MAX / cell_size)
+        ERROR("capacity is too big\n", NULL);
+
+    Mpmc_ring *ring = (Mpmc_ring *)calloc(1, sizeof(*ring));
+
+    if (ring == NULL)
+        ERROR("calloc error\n", NULL);
+
+    ring->cells = (BYTE *)malloc(capacity * cell_size);
+
+    if (ring->cells == NULL)
+    {
+        FREE(ring);
+        ERROR("malloc error\n", NULL);
+    }
+
+    ring->cell_size = cell_size;
+    ring->mask = capacity - 1;
+    ring->size_of = size_of;
+    ring->capacity = capacity;
+
+    /* every cell is ready for producer of first round */
+    for (size_t i = 0; i < capacity; ++i)
+        __mpmc_ring_cell(ring, i)->seq = i;
+
+    return ring;
+}
+
+
+void mpmc_ring_destroy(Mpmc_ring *ring)
+{
+    if (ring == NULL)
+        return;
+
+    FREE(ring->cells);
+    FREE(ring);
+}
+
+
+int mpmc_ring_push(Mpmc_ring * __restrict__ ring, const void * __restrict__ entry)
+{
+    if (ring == NULL || entry == NULL)
+        ERROR("ring == NULL || entry == NULL\n", -1);
+
+    Mpmc_cell *cell;
+    size_t pos = __atomic_load_n(&ring->enqueue.pos, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        cell = __mpmc_ring_cell(ring, pos);
+
+        const size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0)
+        {
+            /* cell is free in this round, try to take position */
+            if (__atomic_compare_exchange_n(&ring->enqueue.pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if (diff < 0)
+        {
+            /* cell still has entry from previous round */
+            return 1;
+        }
+        else
+        {
+            /* other producer took position */
+            pos = __atomic_load_n(&ring->enqueue.pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    (void)memcpy((void *)cell->data, entry, ring->size_of);
+
+    /* release publishes entry to consumer of this round */
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+
+int mpmc_ring_pop(Mpmc_ring * __restrict__ ring, void * __restrict__ val_out)
+{
+    if (ring == NULL || val_out == NULL)
+        ERROR("ring == NULL || val_out == NULL\n", -1);
+
+    Mpmc_cell *cell;
+    size_t pos = __atomic_load_n(&ring->dequeue.pos, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        cell = __mpmc_ring_cell(ring, pos);
+
+        const size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&ring->dequeue.pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if (diff < 0)
+        {
+            /* producer of this round didn't publish entry yet */
+            return 1;
+        }
+        else
+        {
+            pos = __atomic_load_n(&ring->dequeue.pos, __ATOMIC_RELAXED);
+        }
+    }
+
+    (void)memcpy(val_out, (void *)cell->data, ring->size_of);
+
+    /* release gives cell to producer of next round */
+    __atomic_store_n(&cell->seq, pos + ring->mask + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+
+ssize_t mpmc_ring_get_num_entries(const Mpmc_ring *ring)
+{
+    if (ring == NULL)
+        ERROR("ring == NULL\n", -1);
+
+    const size_t dequeue = __atomic_load_n(&ring->dequeue.pos, __ATOMIC_RELAXED);
+    const size_t enqueue = __atomic_load_n(&ring->enqueue.pos, __ATOMIC_RELAXED);
+
+    /* positions are taken before entries are copied, so counter is approximated */
+    if (enqueue <= dequeue)
+        return 0;
+
+    return (ssize_t)MIN(enqueue - dequeue, ring->capacity);
+}
+
+
+ssize_t mpmc_ring_get_capacity(const Mpmc_ring *ring)
+{
+    if (ring == NULL)
+        ERROR("ring == NULL\n", -1);
+
+    return (ssize_t)ring->capacity;
+}
+
+
+ssize_t mpmc_ring_get_data_size(const Mpmc_ring *ring)
+{
+    if (ring == NULL)
+        ERROR("ring == NULL\n", -1);
+
+    return (ssize_t)ring->size_of;
+}
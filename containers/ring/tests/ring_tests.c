@@ -0,0 +1,436 @@
+#include <ring.h>
+#include <ctest.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h> /* sched_yield */
+
+
+#define THREADS 4
+#define ENTRIES_PER_THREAD 20000
+#define SPSC_ENTRIES 200000
+#define SPSC_BATCH 16
+
+
+/* shared state of spsc test */
+typedef struct Spsc_ctx
+{
+    Spsc_ring *ring;
+    bool batch;                                 /* use batch push / pop */
+    size_t bad;                                 /* entries popped out of order */
+} Spsc_ctx;
+
+
+/* shared state of mpmc test */
+typedef struct Mpmc_ctx
+{
+    Mpmc_ring *ring;
+    size_t popped;                              /* entries popped by all consumers */
+    uint8_t seen[THREADS * ENTRIES_PER_THREAD]; /* how many times each value was popped */
+} Mpmc_ctx;
+
+
+typedef struct Producer_arg
+{
+    Mpmc_ctx *ctx;
+    uint64_t first;
+} Producer_arg;
+
+
+/* functions needed for testing */
+static void *spsc_producer(void *arg);
+static void *spsc_consumer(void *arg);
+static void *mpmc_producer(void *arg);
+static void *mpmc_consumer(void *arg);
+
+
+/* unit tests function declaraions */
+static void test_spsc_ring_create(void);
+static void test_spsc_ring_push_pop(void);
+static void test_spsc_ring_batch(void);
+static void test_spsc_ring_threads(void);
+static void test_mpmc_ring_create(void);
+static void test_mpmc_ring_push_pop(void);
+static void test_mpmc_ring_threads(void);
+
+
+/* implementation */
+static void *spsc_producer(void *arg)
+{
+    Spsc_ctx *ctx = (Spsc_ctx *)arg;
+    uint64_t batch[SPSC_BATCH];
+    uint64_t next = 0;
+
+    while (next < SPSC_ENTRIES)
+    {
+        if (!ctx->batch)
+        {
+            if (spsc_ring_push(ctx->ring, (void *)&next) == 0)
+                ++next;
+            else
+                (void)sched_yield();
+
+            continue;
+        }
+
+        const size_t num = (size_t)MIN((uint64_t)SPSC_BATCH, SPSC_ENTRIES - next);
+
+        for (size_t i = 0; i < num; ++i)
+            batch[i] = next + i;
+
+        const ssize_t pushed = spsc_ring_push_batch(ctx->ring, (void *)&batch[0], num);
+
+        if (pushed > 0)
+            next += (uint64_t)pushed;
+        else
+            (void)sched_yield();
+    }
+
+    return NULL;
+}
+
+
+static void *spsc_consumer(void *arg)
+{
+    Spsc_ctx *ctx = (Spsc_ctx *)arg;
+    uint64_t batch[SPSC_BATCH];
+    uint64_t expt = 0;
+
+    while (expt < SPSC_ENTRIES)
+    {
+        ssize_t popped = 1;
+
+        if (!ctx->batch)
+        {
+            if (spsc_ring_pop(ctx->ring, (void *)&batch[0]) != 0)
+                popped = 0;
+        }
+        else
+        {
+            popped = spsc_ring_pop_batch(ctx->ring, (void *)&batch[0], SPSC_BATCH);
+        }
+
+        if (popped <= 0)
+        {
+            /* give cpu to producer, test can run on one core */
+            (void)sched_yield();
+            continue;
+        }
+
+        for (ssize_t i = 0; i < popped; ++i)
+        {
+            if (batch[i] != expt)
+                ++ctx->bad;
+
+            ++expt;
+        }
+    }
+
+    return NULL;
+}
+
+
+static void *mpmc_producer(void *arg)
+{
+    Producer_arg *parg = (Producer_arg *)arg;
+
+    for (uint64_t i = parg->first; i < parg->first + ENTRIES_PER_THREAD; ++i)
+        while (mpmc_ring_push(parg->ctx->ring, (void *)&i) != 0)
+            (void)sched_yield();
+
+    return NULL;
+}
+
+
+static void *mpmc_consumer(void *arg)
+{
+    Mpmc_ctx *ctx = (Mpmc_ctx *)arg;
+    uint64_t val = 0;
+
+    while (__atomic_load_n(&ctx->popped, __ATOMIC_RELAXED) < THREADS * ENTRIES_PER_THREAD)
+    {
+        if (mpmc_ring_pop(ctx->ring, (void *)&val) != 0)
+        {
+            (void)sched_yield();
+            continue;
+        }
+
+        (void)__atomic_add_fetch(&ctx->seen[val], 1, __ATOMIC_RELAXED);
+        (void)__atomic_add_fetch(&ctx->popped, 1, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+
+
+static void test_spsc_ring_create(void)
+{
+    Spsc_ring *ring = spsc_ring_create(sizeof(int), 10);
+    T_ERROR(ring == NULL);
+
+    /* capacity is rounded to power of 2 */
+    T_EXPECT(spsc_ring_get_capacity(ring), (ssize_t)16);
+    T_EXPECT(spsc_ring_get_num_entries(ring), (ssize_t)0);
+    T_EXPECT(spsc_ring_get_data_size(ring), (ssize_t)sizeof(int));
+
+    spsc_ring_destroy(ring);
+
+    T_ASSERT(spsc_ring_create(0, 10), NULL);
+    T_ASSERT(spsc_ring_create(sizeof(int), 0), NULL);
+    T_ASSERT(spsc_ring_create(sizeof(int), SIZE_MAX), NULL);
+
+    T_EXPECT(spsc_ring_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(spsc_ring_get_capacity(NULL), (ssize_t)-1);
+    T_EXPECT(spsc_ring_get_data_size(NULL), (ssize_t)-1);
+}
+
+
+static void test_spsc_ring_push_pop(void)
+{
+    #define ARRAY_TEST_SIZE 8
+
+    int64_t val = 0;
+
+    Spsc_ring *ring = spsc_ring_create(sizeof(int64_t), ARRAY_TEST_SIZE);
+    T_ERROR(ring == NULL);
+
+    T_EXPECT(spsc_ring_pop(ring, (void *)&val), 1);
+
+    /* positions run around ring many times */
+    for (int64_t round = 0; round < 100; ++round)
+    {
+        for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            val = round + i;
+            T_EXPECT(spsc_ring_push(ring, (void *)&val), 0);
+        }
+
+        T_EXPECT(spsc_ring_push(ring, (void *)&val), 1);
+        T_EXPECT(spsc_ring_get_num_entries(ring), (ssize_t)ARRAY_TEST_SIZE);
+
+        /* FIFO */
+        for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            T_EXPECT(spsc_ring_pop(ring, (void *)&val), 0);
+            T_ASSERT(val, round + i);
+        }
+
+        T_EXPECT(spsc_ring_pop(ring, (void *)&val), 1);
+    }
+
+    T_EXPECT(spsc_ring_push(NULL, (void *)&val), -1);
+    T_EXPECT(spsc_ring_push(ring, NULL), -1);
+    T_EXPECT(spsc_ring_pop(NULL, (void *)&val), -1);
+    T_EXPECT(spsc_ring_pop(ring, NULL), -1);
+
+    spsc_ring_destroy(ring);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_spsc_ring_batch(void)
+{
+    #define ARRAY_TEST_SIZE 16
+
+    int64_t arr[ARRAY_TEST_SIZE * 2];
+    int64_t out[ARRAY_TEST_SIZE * 2];
+    int64_t val = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(arr); ++i)
+        arr[i] = (int64_t)i;
+
+    Spsc_ring *ring = spsc_ring_create(sizeof(int64_t), ARRAY_TEST_SIZE);
+    T_ERROR(ring == NULL);
+
+    /* move positions to the middle, so batches wrap */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE / 2 + 3; ++i)
+    {
+        T_EXPECT(spsc_ring_push(ring, (void *)&arr[0]), 0);
+        T_EXPECT(spsc_ring_pop(ring, (void *)&val), 0);
+    }
+
+    T_EXPECT(spsc_ring_pop_batch(ring, (void *)&out[0], ARRAY_TEST_SIZE), (ssize_t)0);
+
+    /* only free slots are filled */
+    T_EXPECT(spsc_ring_push_batch(ring, (void *)&arr[0], ARRAY_SIZE(arr)), (ssize_t)ARRAY_TEST_SIZE);
+    T_EXPECT(spsc_ring_push_batch(ring, (void *)&arr[0], 1), (ssize_t)0);
+
+    T_EXPECT(spsc_ring_pop_batch(ring, (void *)&out[0], 5), (ssize_t)5);
+
+    for (size_t i = 0; i < 5; ++i)
+        T_ASSERT(out[i], arr[i]);
+
+    T_EXPECT(spsc_ring_push_batch(ring, (void *)&arr[ARRAY_TEST_SIZE], 5), (ssize_t)5);
+    T_EXPECT(spsc_ring_pop_batch(ring, (void *)&out[0], ARRAY_SIZE(out)), (ssize_t)ARRAY_TEST_SIZE);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_ASSERT(out[i], arr[i + 5]);
+
+    T_EXPECT(spsc_ring_get_num_entries(ring), (ssize_t)0);
+    T_EXPECT(spsc_ring_push_batch(NULL, (void *)&arr[0], 1), (ssize_t)-1);
+    T_EXPECT(spsc_ring_pop_batch(ring, NULL, 1), (ssize_t)-1);
+
+    spsc_ring_destroy(ring);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_spsc_ring_threads(void)
+{
+    pthread_t producer;
+    pthread_t consumer;
+    Spsc_ctx ctx;
+
+    for (int batch = 0; batch < 2; ++batch)
+    {
+        ctx.ring = spsc_ring_create(sizeof(uint64_t), 64);
+        T_ERROR(ctx.ring == NULL);
+
+        ctx.batch = batch == 1;
+        ctx.bad = 0;
+
+        T_EXPECT(pthread_create(&consumer, NULL, spsc_consumer, (void *)&ctx), 0);
+        T_EXPECT(pthread_create(&producer, NULL, spsc_producer, (void *)&ctx), 0);
+
+        T_EXPECT(pthread_join(producer, NULL), 0);
+        T_EXPECT(pthread_join(consumer, NULL), 0);
+
+        /* every value in order, exactly once */
+        T_ASSERT(ctx.bad, (size_t)0);
+        T_EXPECT(spsc_ring_get_num_entries(ctx.ring), (ssize_t)0);
+
+        spsc_ring_destroy(ctx.ring);
+    }
+}
+
+
+static void test_mpmc_ring_create(void)
+{
+    Mpmc_ring *ring = mpmc_ring_create(sizeof(int), 10);
+    T_ERROR(ring == NULL);
+
+    T_EXPECT(mpmc_ring_get_capacity(ring), (ssize_t)16);
+    T_EXPECT(mpmc_ring_get_num_entries(ring), (ssize_t)0);
+    T_EXPECT(mpmc_ring_get_data_size(ring), (ssize_t)sizeof(int));
+
+    mpmc_ring_destroy(ring);
+
+    T_ASSERT(mpmc_ring_create(0, 10), NULL);
+    T_ASSERT(mpmc_ring_create(sizeof(int), 1), NULL);
+    T_ASSERT(mpmc_ring_create(sizeof(int), SIZE_MAX), NULL);
+
+    T_EXPECT(mpmc_ring_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(mpmc_ring_get_capacity(NULL), (ssize_t)-1);
+    T_EXPECT(mpmc_ring_get_data_size(NULL), (ssize_t)-1);
+}
+
+
+static void test_mpmc_ring_push_pop(void)
+{
+    #define ARRAY_TEST_SIZE 4
+
+    typedef struct Record
+    {
+        int64_t key;
+        int64_t val;
+        int32_t flags;
+    } Record;
+
+    Record rec;
+
+    Mpmc_ring *ring = mpmc_ring_create(sizeof(Record), ARRAY_TEST_SIZE);
+    T_ERROR(ring == NULL);
+
+    T_EXPECT(mpmc_ring_pop(ring, (void *)&rec), 1);
+
+    /* cells are reused in many rounds */
+    for (int64_t round = 0; round < 1000; ++round)
+    {
+        for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            rec = (Record){ .key = round, .val = i, .flags = (int32_t)i };
+            T_EXPECT(mpmc_ring_push(ring, (void *)&rec), 0);
+        }
+
+        T_EXPECT(mpmc_ring_push(ring, (void *)&rec), 1);
+        T_EXPECT(mpmc_ring_get_num_entries(ring), (ssize_t)ARRAY_TEST_SIZE);
+
+        for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        {
+            T_EXPECT(mpmc_ring_pop(ring, (void *)&rec), 0);
+            T_ASSERT(rec.key, round);
+            T_ASSERT(rec.val, i);
+            T_ASSERT(rec.flags, (int32_t)i);
+        }
+
+        T_EXPECT(mpmc_ring_pop(ring, (void *)&rec), 1);
+    }
+
+    T_EXPECT(mpmc_ring_push(NULL, (void *)&rec), -1);
+    T_EXPECT(mpmc_ring_push(ring, NULL), -1);
+    T_EXPECT(mpmc_ring_pop(NULL, (void *)&rec), -1);
+    T_EXPECT(mpmc_ring_pop(ring, NULL), -1);
+
+    mpmc_ring_destroy(ring);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_mpmc_ring_threads(void)
+{
+    pthread_t producers[THREADS];
+    pthread_t consumers[THREADS];
+    Producer_arg args[THREADS];
+
+    Mpmc_ctx *ctx = (Mpmc_ctx *)calloc(1, sizeof(*ctx));
+    T_ERROR(ctx == NULL);
+
+    /* small ring, so producers often hit full ring */
+    ctx->ring = mpmc_ring_create(sizeof(uint64_t), 64);
+    T_ERROR(ctx->ring == NULL);
+
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        args[i].ctx = ctx;
+        args[i].first = (uint64_t)(i * ENTRIES_PER_THREAD);
+
+        T_EXPECT(pthread_create(&consumers[i], NULL, mpmc_consumer, (void *)ctx), 0);
+        T_EXPECT(pthread_create(&producers[i], NULL, mpmc_producer, (void *)&args[i]), 0);
+    }
+
+    for (size_t i = 0; i < THREADS; ++i)
+    {
+        T_EXPECT(pthread_join(producers[i], NULL), 0);
+        T_EXPECT(pthread_join(consumers[i], NULL), 0);
+    }
+
+    /* every value was popped exactly once */
+    size_t bad = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(ctx->seen); ++i)
+        if (ctx->seen[i] != 1)
+            ++bad;
+
+    T_ASSERT(bad, (size_t)0);
+    T_EXPECT(mpmc_ring_get_num_entries(ctx->ring), (ssize_t)0);
+
+    mpmc_ring_destroy(ctx->ring);
+    FREE(ctx);
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING LOCK-FREE RINGS");
+    TEST(test_spsc_ring_create());
+    TEST(test_spsc_ring_push_pop());
+    TEST(test_spsc_ring_batch());
+    TEST(test_spsc_ring_threads());
+    TEST(test_mpmc_ring_create());
+    TEST(test_mpmc_ring_push_pop());
+    TEST(test_mpmc_ring_threads());
+    TEST_SUMMARY();
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+
+/*
+    Skip list implementation (sorted list with expected O(log n) operations)
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+
+#include <stddef.h> /* size_t */
+#include <sys/types.h> /* ssize_t */
+#include <common.h> /* compare_f */
+
+
+typedef struct Skiplist Skiplist;
+typedef struct Skiplist_node Skiplist_node;
+
+
+/*
+    Create new instance of skip list.
+
+    PARAMS:
+    @IN size_of - size of element.
+    @IN cmp_f - pointer to compare function.
+    @IN destroy_f - pointer to destructor function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to skip list if success.
+*/
+Skiplist* skiplist_create(size_t size_of, compare_f cmp_f, destructor_f destroy_f);
+
+
+/*
+    Destroy skip list.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+
+    RETURN:
+    %This is void function.
+*/
+void skiplist_destroy(Skiplist* list_p);
+
+
+/*
+    Destroy skip list with all entires. (call destructor for each entires)
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+
+    RETURN:
+    %This is void function.
+*/
+void skiplist_destroy_with_entries(Skiplist* list_p);
+
+
+/*
+    Insert element to skip list (after all equal entries).
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int skiplist_insert(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p);
+
+
+/*
+    Delete the first entry which compare(list_p->entry_p, entry_p) == 0.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %1 if entry doesn't exist.
+    %negative value if failure.
+*/
+int skiplist_delete(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p);
+
+
+/*
+    Delete the first entry which compare(list_p->entry_p, entry_p) == 0. (call destructor)
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to entry.
+
+    RETURN:
+    %0 if success.
+    %1 if entry doesn't exist.
+    %negative value if failure.
+*/
+int skiplist_delete_with_entry(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p);
+
+
+/*
+    Delete the all entries which compare(list_p->entry_p, entry_p) == 0.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to entry.
+
+    RETURN:
+    %number of deleted (>0) if success.
+    %-1 if failure.
+*/
+int skiplist_delete_all(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p);
+
+
+/*
+    Delete the all entries which compare(list_p->entry_p, entry_p) == 0. (call destructor)
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to entry.
+
+    RETURN:
+    %number of deleted (>0) if success.
+    %-1 if failure.
+*/
+int skiplist_delete_all_with_entry(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p);
+
+
+/*
+    Search for the first entry which compare(list_p->entry_p, entry_p) == 0.
+    (Use `fake struct` with correct key like in list_search)
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to search value.
+    @OUT val_out_p - pointer to entry with found val.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int skiplist_search(const Skiplist* __restrict__ list_p, const void* entry_p, void* val_out_p);
+
+
+/*
+    Create array from list_p.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @OUT array - pointer to array.
+    @OUT size_p - pointer to returned size of array.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int skiplist_to_array(const Skiplist* __restrict__ list_p, void* __restrict__ array, size_t* __restrict__ size_p);
+
+
+/*
+    Get number of entries in skip list.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+
+    RETURN:
+    %-1 if failure
+    %number of entries.
+*/
+ssize_t skiplist_get_num_entries(const Skiplist* list_p);
+
+
+/*
+    Get size of data in skip list.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+
+    RETURN:
+    %-1 if failure
+    %size of data.
+*/
+ssize_t skiplist_get_data_size(const Skiplist* list_p);
+
+
+#endif /* SKIPLIST_H */
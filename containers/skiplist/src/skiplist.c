@@ -0,0 +1,593 @@
+#include <skiplist.h>
+#include <common.h>
+#include <stdlib.h>  /* calloc, malloc, free */
+#include <string.h>  /* memcpy */
+#include <stdbool.h> /* bool */
+#include <stdint.h>  /* uint64_t, uintptr_t */
+
+
+/* max level of node, with p = 1/4 it is enough for 2^64 entries */
+#define SKIPLIST_MAX_LEVEL ((size_t)32)
+
+/* first slab of node pool, next slabs are twice bigger up to SKIPLIST_SLAB_MAX_SIZE */
+#define SKIPLIST_SLAB_MIN_SIZE ((size_t)(1 << 12))
+#define SKIPLIST_SLAB_MAX_SIZE ((size_t)(1 << 20))
+
+
+struct Skiplist_node
+{
+    size_t level;                         /* number of forward pointers */
+
+    struct Skiplist_node* next_p[];       /* forward pointers, data_p is placed right after them */
+};
+
+
+typedef struct Skiplist_slab
+{
+    struct Skiplist_slab* next_p;         /* pointer to next slab */
+    size_t used;                          /* bytes taken from this slab */
+    size_t size;                          /* bytes available in this slab */
+
+    BYTE nodes_p[];                       /* placeholder for pooled nodes */
+} Skiplist_slab;
+
+
+struct Skiplist
+{
+    Skiplist_node* head_p;                /* guard node with SKIPLIST_MAX_LEVEL pointers */
+
+    Skiplist_node* free_p[SKIPLIST_MAX_LEVEL]; /* free lists of pooled nodes, one per level */
+    Skiplist_slab* slabs_p;               /* slabs owned by node pool, first is the current one */
+    size_t slab_size;                     /* size of next slab */
+
+    size_t level;                         /* the highest level in use */
+    uint64_t seed;                        /* state of level generator */
+
+    size_t length;                        /* num of nodes in list_p */
+    size_t size_of;                       /* size of element */
+
+    compare_f cmp_f;                      /* compare function */
+    destructor_f destroy_f;               /* destructor function */
+};
+
+
+/*
+    Get pointer to data stored in node.
+
+    PARAMS:
+    @IN node_p - pointer to node.
+
+    RETURN:
+    %Pointer to data.
+*/
+static ___inline___ BYTE* __skiplist_node_data(Skiplist_node* node_p);
+
+
+/*
+    Get size of node with @level forward pointers.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN level - level of node.
+
+    RETURN:
+    %Size of node.
+*/
+static ___inline___ size_t __skiplist_node_size(const Skiplist* list_p, size_t level);
+
+
+/*
+    Draw level of new node (P(level > k) = 1/4^k).
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+
+    RETURN:
+    %Level in [1, SKIPLIST_MAX_LEVEL].
+*/
+static ___inline___ size_t __skiplist_random_level(Skiplist* list_p);
+
+
+/*
+    Take node with @level pointers from pool.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN level - level of node.
+
+    RETURN:
+    %Pointer to node if success.
+    %NULL if failure.
+*/
+static Skiplist_node* __skiplist_node_alloc(Skiplist* list_p, size_t level);
+
+
+/*
+    Return node to pool.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN node_p - pointer to node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __skiplist_node_destroy(Skiplist* list_p, Skiplist_node* node_p);
+
+
+/*
+    For each level find the last node which doesn't satisfy the stop condition.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to entry.
+    @IN after_equal - false: stop at first entry >= entry_p, true: stop at first entry > entry_p.
+    @OUT update_p - predecessors on each level (may be NULL).
+
+    RETURN:
+    %Pointer to predecessor on level 0.
+*/
+static ___inline___ Skiplist_node* __skiplist_find(const Skiplist* __restrict__ list_p,
+                                                   const void* __restrict__ entry_p,
+                                                   bool after_equal,
+                                                   Skiplist_node** __restrict__ update_p);
+
+
+/*
+    Unlink node from skip list.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN update_p - predecessors on each level.
+    @IN node_p - pointer to unlinked node.
+
+    RETURN:
+    %This is void function.
+*/
+static ___inline___ void __skiplist_unlink(Skiplist* __restrict__ list_p,
+                                           Skiplist_node** __restrict__ update_p,
+                                           Skiplist_node* __restrict__ node_p);
+
+
+/*
+    Destroy whole skip list.
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN destroy - call destructor.
+
+    RETURN:
+    %This is void function.
+*/
+static void __skiplist_destroy(Skiplist* list_p, bool destroy);
+
+
+/*
+    Delete the first entry which compare(list_p->entry_p, entry_p) == 0
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to entry.
+    @IN destroy - call destructor.
+
+    RETURN:
+    %0 if success.
+    %1 if entry doesn't exist.
+    %negative value if failure.
+*/
+static int __skiplist_delete(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p, bool destroy);
+
+
+/*
+    Delete the all entries which compare(list_p->entry_p, entry_p) == 0
+
+    PARAMS:
+    @IN list_p - pointer to skip list.
+    @IN entry_p - pointer to entry.
+    @IN destroy - call destructor.
+
+    RETURN:
+    %number of deleted (>0) if success.
+    %-1 if failure.
+*/
+static int __skiplist_delete_all(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p, bool destroy);
+
+
+static ___inline___ BYTE* __skiplist_node_data(Skiplist_node* node_p)
+{
+    return (BYTE*)&node_p->next_p[node_p->level];
+}
+
+
+static ___inline___ size_t __skiplist_node_size(const Skiplist* list_p, size_t level)
+{
+    return ALIGN_UP(sizeof(Skiplist_node) + level * sizeof(Skiplist_node*) + list_p->size_of, sizeof(void*));
+}
+
+
+static ___inline___ size_t __skiplist_random_level(Skiplist* list_p)
+{
+    /* xorshift64 */
+    uint64_t r = list_p->seed;
+    r ^= r << 13;
+    r ^= r >> 7;
+    r ^= r << 17;
+    list_p->seed = r;
+
+    /* each pair of zero bits promotes node one level higher */
+    size_t level = 1;
+    while ((r & 3) == 0 && level < SKIPLIST_MAX_LEVEL)
+    {
+        ++level;
+        r >>= 2;
+    }
+
+    return level;
+}
+
+
+static Skiplist_node* __skiplist_node_alloc(Skiplist* list_p, size_t level)
+{
+    Skiplist_node* node_p = list_p->free_p[level - 1];
+
+    if (node_p != NULL)
+    {
+        list_p->free_p[level - 1] = node_p->next_p[0];
+        return node_p;
+    }
+
+    const size_t node_size = __skiplist_node_size(list_p, level);
+    Skiplist_slab* slab_p = list_p->slabs_p;
+
+    if (slab_p == NULL || slab_p->size - slab_p->used < node_size)
+    {
+        const size_t slab_size = MAX(list_p->slab_size, node_size);
+
+        slab_p = (Skiplist_slab*)malloc(sizeof(*slab_p) + slab_size);
+
+        if (slab_p == NULL)
+            ERROR("malloc error\n", NULL);
+
+        slab_p->next_p = list_p->slabs_p;
+        slab_p->used = 0;
+        slab_p->size = slab_size;
+        list_p->slabs_p = slab_p;
+
+        list_p->slab_size = MIN(list_p->slab_size * 2, SKIPLIST_SLAB_MAX_SIZE);
+    }
+
+    node_p = (Skiplist_node*)(void*)(slab_p->nodes_p + slab_p->used);
+    slab_p->used += node_size;
+
+    node_p->level = level;
+
+    return node_p;
+}
+
+
+static ___inline___ void __skiplist_node_destroy(Skiplist* list_p, Skiplist_node* node_p)
+{
+    if (node_p == NULL)
+        VERROR("node_p == NULL\n");
+
+    node_p->next_p[0] = list_p->free_p[node_p->level - 1];
+    list_p->free_p[node_p->level - 1] = node_p;
+}
+
+
+static ___inline___ Skiplist_node* __skiplist_find(const Skiplist* __restrict__ list_p,
+                                                   const void* __restrict__ entry_p,
+                                                   bool after_equal,
+                                                   Skiplist_node** __restrict__ update_p)
+{
+    Skiplist_node* ptr_p = list_p->head_p;
+
+    /* entry_p goes after ptr_p while cmp < limit */
+    const int limit = after_equal ? 1 : 0;
+
+    for (size_t i = list_p->level; i > 0; --i)
+    {
+        Skiplist_node* next_p = ptr_p->next_p[i - 1];
+
+        while (next_p != NULL && list_p->cmp_f(__skiplist_node_data(next_p), entry_p) < limit)
+        {
+            ptr_p = next_p;
+            next_p = ptr_p->next_p[i - 1];
+        }
+
+        if (update_p != NULL)
+            update_p[i - 1] = ptr_p;
+    }
+
+    return ptr_p;
+}
+
+
+static ___inline___ void __skiplist_unlink(Skiplist* __restrict__ list_p,
+                                           Skiplist_node** __restrict__ update_p,
+                                           Skiplist_node* __restrict__ node_p)
+{
+    for (size_t i = 0; i < node_p->level; ++i)
+        update_p[i]->next_p[i] = node_p->next_p[i];
+
+    while (list_p->level > 1 && list_p->head_p->next_p[list_p->level - 1] == NULL)
+        --list_p->level;
+
+    --list_p->length;
+}
+
+
+static void __skiplist_destroy(Skiplist* list_p, bool destroy)
+{
+    if (list_p == NULL)
+        VERROR("list_p == NULL\n");
+
+    if (list_p->destroy_f != NULL && destroy == true)
+    {
+        for (Skiplist_node* ptr_p = list_p->head_p->next_p[0]; ptr_p != NULL; ptr_p = ptr_p->next_p[0])
+            list_p->destroy_f((void*)__skiplist_node_data(ptr_p));
+    }
+
+    /* every node lives in some slab, so nodes are not freed one by one */
+    Skiplist_slab* slab_p = list_p->slabs_p;
+
+    while (slab_p != NULL)
+    {
+        Skiplist_slab* next_p = slab_p->next_p;
+        FREE(slab_p);
+        slab_p = next_p;
+    }
+
+    FREE(list_p);
+}
+
+
+static int __skiplist_delete(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p, bool destroy)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    if (entry_p == NULL)
+        ERROR("entry_p == NULL\n", -1);
+
+    Skiplist_node* update_p[SKIPLIST_MAX_LEVEL];
+    Skiplist_node* ptr_p = __skiplist_find(list_p, entry_p, false, update_p)->next_p[0];
+
+    /* this entry_p doesn't exist in list_p */
+    if (ptr_p == NULL || list_p->cmp_f(__skiplist_node_data(ptr_p), entry_p) != 0)
+        return 1;
+
+    __skiplist_unlink(list_p, update_p, ptr_p);
+
+    if (list_p->destroy_f != NULL && destroy == true)
+        list_p->destroy_f((void*)__skiplist_node_data(ptr_p));
+
+    __skiplist_node_destroy(list_p, ptr_p);
+
+    return 0;
+}
+
+
+static int __skiplist_delete_all(Skiplist* __restrict__ list_p, const void* __restrict__ entry_p, bool destroy)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    if (entry_p == NULL)
+        ERROR("entry_p == NULL\n", -1);
+
+    if (list_p->length == 0)
+        ERROR("list_p->length == 0\n", -1);
+
+    Skiplist_node* update_p[SKIPLIST_MAX_LEVEL];
+    Skiplist_node* prev_p = __skiplist_find(list_p, entry_p, false, update_p);
+    Skiplist_node* ptr_p = prev_p->next_p[0];
+
+    size_t deleted = 0;
+
+    /*
+        list_p is sorted, so all equal entries are next to each other
+        and predecessors from update_p stay valid for the whole run.
+    */
+    while (ptr_p != NULL && list_p->cmp_f(__skiplist_node_data(ptr_p), entry_p) == 0)
+    {
+        Skiplist_node* next_p = ptr_p->next_p[0];
+
+        __skiplist_unlink(list_p, update_p, ptr_p);
+
+        if (list_p->destroy_f != NULL && destroy == true)
+            list_p->destroy_f((void*)__skiplist_node_data(ptr_p));
+
+        __skiplist_node_destroy(list_p, ptr_p);
+        ptr_p = next_p;
+        ++deleted;
+    }
+
+    /* this entry_p doesn't exist in list_p */
+    if (deleted == 0)
+        return -1;
+
+    return (int)deleted;
+}
+
+
+Skiplist* skiplist_create(const size_t size_of, const compare_f cmp_f, const destructor_f destroy_f)
+{
+    if (size_of == 0)
+        ERROR("size_of == 0\n", NULL);
+
+    if (cmp_f == NULL)
+        ERROR("cmp_f == NULL\n", NULL);
+
+    /* head_p is embedded right after list_p, it has all levels and no data */
+    Skiplist* list_p = (Skiplist*)calloc(1, sizeof(*list_p) + sizeof(Skiplist_node) + SKIPLIST_MAX_LEVEL * sizeof(Skiplist_node*));
+
+    if (list_p == NULL)
+        ERROR("calloc error\n", NULL);
+
+    list_p->head_p = (Skiplist_node*)(list_p + 1);
+    list_p->head_p->level = SKIPLIST_MAX_LEVEL;
+
+    list_p->slabs_p = NULL;
+    list_p->slab_size = SKIPLIST_SLAB_MIN_SIZE;
+
+    list_p->level = 1;
+    list_p->seed = ((uint64_t)(uintptr_t)list_p ^ 0x9E3779B97F4A7C15ULL) | 1;
+
+    list_p->length = 0;
+    list_p->size_of = size_of;
+
+    list_p->cmp_f = cmp_f;
+    list_p->destroy_f = destroy_f;
+
+    return list_p;
+}
+
+
+void skiplist_destroy(Skiplist* list_p)
+{
+    __skiplist_destroy(list_p, false);
+}
+
+
+void skiplist_destroy_with_entries(Skiplist* list_p)
+{
+    __skiplist_destroy(list_p, true);
+}
+
+
+int skiplist_insert(Skiplist* __restrict__ list_p, const void* __restrict__ const entry_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    if (entry_p == NULL)
+        ERROR("entry_p == NULL\n", -1);
+
+    const size_t level = __skiplist_random_level(list_p);
+
+    Skiplist_node* new_node_p = __skiplist_node_alloc(list_p, level);
+
+    if (new_node_p == NULL)
+        ERROR("__skiplist_node_alloc error\n", -1);
+
+    __ASSIGN__(*__skiplist_node_data(new_node_p), *(BYTE*)entry_p, list_p->size_of);
+
+    Skiplist_node* update_p[SKIPLIST_MAX_LEVEL];
+
+    /* new entry_p goes after all equal entries */
+    (void)__skiplist_find(list_p, entry_p, true, update_p);
+
+    for (size_t i = list_p->level; i < level; ++i)
+        update_p[i] = list_p->head_p;
+
+    if (level > list_p->level)
+        list_p->level = level;
+
+    for (size_t i = 0; i < level; ++i)
+    {
+        new_node_p->next_p[i] = update_p[i]->next_p[i];
+        update_p[i]->next_p[i] = new_node_p;
+    }
+
+    ++list_p->length;
+    return 0;
+}
+
+
+int skiplist_delete(Skiplist* __restrict__ list_p, const void* __restrict__ const entry_p)
+{
+    return __skiplist_delete(list_p, entry_p, false);
+}
+
+
+int skiplist_delete_with_entry(Skiplist* __restrict__ list_p, const void* __restrict__ const entry_p)
+{
+    return __skiplist_delete(list_p, entry_p, true);
+}
+
+
+int skiplist_delete_all(Skiplist* __restrict__ list_p, const void* __restrict__ const entry_p)
+{
+    return __skiplist_delete_all(list_p, entry_p, false);
+}
+
+
+int skiplist_delete_all_with_entry(Skiplist* __restrict__ list_p, const void* __restrict__ const entry_p)
+{
+    return __skiplist_delete_all(list_p, entry_p, true);
+}
+
+
+int skiplist_search(const Skiplist* __restrict__ const list_p, const void* const entry_p, void* val_out_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    if (entry_p == NULL)
+        ERROR("entry_p == NULL\n", -1);
+
+    if (val_out_p == NULL)
+        ERROR("val_out_p == NULL\n", -1);
+
+    Skiplist_node* ptr_p = __skiplist_find(list_p, entry_p, false, NULL)->next_p[0];
+
+    if (ptr_p == NULL || list_p->cmp_f(__skiplist_node_data(ptr_p), entry_p) != 0)
+        return -1;
+
+    __ASSIGN__(*(BYTE*)val_out_p, *__skiplist_node_data(ptr_p), list_p->size_of);
+
+    return 0;
+}
+
+
+int skiplist_to_array(const Skiplist* __restrict__ const list_p, void* __restrict__ array, size_t* __restrict__ size_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    if (list_p->length == 0)
+        ERROR("list_p->length == 0\n", -1);
+
+    if (array == NULL)
+        ERROR("array == NULL\n", -1);
+
+    if (size_p == NULL)
+        ERROR("size_p == NULL\n", -1);
+
+    BYTE* arr_p = (BYTE*)malloc(list_p->length * list_p->size_of);
+
+    if (arr_p == NULL)
+        ERROR("malloc error\n", -1);
+
+    size_t offset = 0;
+
+    for (Skiplist_node* ptr_p = list_p->head_p->next_p[0]; ptr_p != NULL; ptr_p = ptr_p->next_p[0])
+    {
+        __ASSIGN__(arr_p[offset], *__skiplist_node_data(ptr_p), list_p->size_of);
+        offset += list_p->size_of;
+    }
+
+    *(void**)array = arr_p;
+    *size_p = list_p->length;
+
+    return 0;
+}
+
+
+ssize_t skiplist_get_num_entries(const Skiplist* const list_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    return (ssize_t)list_p->length;
+}
+
+
+ssize_t skiplist_get_data_size(const Skiplist* const list_p)
+{
+    if (list_p == NULL)
+        ERROR("list_p == NULL\n", -1);
+
+    return (ssize_t)list_p->size_of;
+}
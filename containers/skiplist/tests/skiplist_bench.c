@@ -0,0 +1,147 @@
+#include <skiplist.h>
+#include <list.h>
+#include <cbench.h>
+#include <stdint.h> /* int64_t */
+#include <stdlib.h> /* malloc, free */
+
+
+/*
+    Skiplist against List (linked and unrolled) with the same random keys:
+    insert all, search all, delete all. List walks from head, so it is run
+    only for sizes where O(n^2) still finishes in a moment.
+*/
+
+
+/* functions needed for benchmark */
+static int my_compare_int64_t(const void* a_p, const void* b_p);
+static int64_t* keys_create(size_t n);
+
+
+/* benchmark function declarations */
+static void bench_skiplist(const int64_t* keys_p, size_t n);
+static void bench_list(LIST_TYPE type, const int64_t* keys_p, size_t n);
+
+
+/* implementation */
+static int my_compare_int64_t(const void* a_p, const void* b_p)
+{
+    const int64_t a = *(const int64_t*)a_p;
+    const int64_t b = *(const int64_t*)b_p;
+
+    return (a > b) - (a < b);
+}
+
+
+static int64_t* keys_create(size_t n)
+{
+    int64_t* keys_p = (int64_t*)malloc(n * sizeof(*keys_p));
+
+    if (keys_p == NULL)
+        ERROR("malloc error\n", NULL);
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+
+    for (size_t i = 0; i < n; ++i)
+        keys_p[i] = (int64_t)(bench_rand(&state) >> 1);
+
+    return keys_p;
+}
+
+
+static void bench_skiplist(const int64_t* keys_p, size_t n)
+{
+    char name[64];
+    size_t found = 0;
+    int64_t val;
+
+    Skiplist* list_p = skiplist_create(sizeof(int64_t), my_compare_int64_t, NULL);
+
+    if (list_p == NULL)
+        VERROR("skiplist_create error\n");
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)skiplist_insert(list_p, &keys_p[i]);
+    (void)snprintf(name, sizeof(name), "skiplist insert n=%zu", n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        found += skiplist_search(list_p, &keys_p[i], &val) == 0;
+    (void)snprintf(name, sizeof(name), "skiplist search n=%zu", n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)skiplist_delete(list_p, &keys_p[i]);
+    (void)snprintf(name, sizeof(name), "skiplist delete n=%zu", n);
+    bench_report(name, n, start);
+
+    if (found != n || skiplist_get_num_entries(list_p) != 0)
+        (void)printf("skiplist lost entries\n");
+
+    skiplist_destroy(list_p);
+}
+
+
+static void bench_list(LIST_TYPE type, const int64_t* keys_p, size_t n)
+{
+    const char* type_name = type == LIST_UNROLLED ? "unrolled list" : "linked list";
+    char name[64];
+    size_t found = 0;
+    int64_t val;
+
+    List* list_p = list_create_with_type(type, sizeof(int64_t), my_compare_int64_t, NULL);
+
+    if (list_p == NULL)
+        VERROR("list_create_with_type error\n");
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)list_insert(list_p, &keys_p[i]);
+    (void)snprintf(name, sizeof(name), "%s insert n=%zu", type_name, n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        found += list_search(list_p, &keys_p[i], &val) == 0;
+    (void)snprintf(name, sizeof(name), "%s search n=%zu", type_name, n);
+    bench_report(name, n, start);
+
+    start = bench_now();
+    for (size_t i = 0; i < n; ++i)
+        (void)list_delete(list_p, &keys_p[i]);
+    (void)snprintf(name, sizeof(name), "%s delete n=%zu", type_name, n);
+    bench_report(name, n, start);
+
+    if (found != n || list_get_num_entries(list_p) != 0)
+        (void)printf("%s lost entries\n", type_name);
+
+    list_destroy(list_p);
+}
+
+
+int main(void)
+{
+    const size_t sizes[] = { 1000, 10000, 100000 };
+
+    for (size_t i = 0; i < ARRAY_SIZE(sizes); ++i)
+    {
+        int64_t* keys_p = keys_create(sizes[i]);
+
+        if (keys_p == NULL)
+            return 1;
+
+        bench_skiplist(keys_p, sizes[i]);
+
+        if (sizes[i] <= 10000)
+        {
+            bench_list(LIST_LINKED, keys_p, sizes[i]);
+            bench_list(LIST_UNROLLED, keys_p, sizes[i]);
+        }
+
+        FREE(keys_p);
+    }
+
+    return 0;
+}
@@ -0,0 +1,436 @@
+#include <skiplist.h>
+#include <ctest.h>
+#include <stdint.h>
+#include <assert.h>
+
+
+typedef struct MyStruct
+{
+    int64_t key;
+    int64_t a;
+    int64_t b;
+    int64_t c;
+} MyStruct;
+
+
+/* functions needed for testing */
+static ___inline___ MyStruct* my_struct_create(const int64_t key);
+static void my_struct_destroy(void* ptr_p);
+static int my_struct_compare(const void* a_p, const void* b_p);
+static int my_compare_int64_t(const void* a_p, const void* b_p);
+
+
+/* unit tests function declaraions */
+static void test_skiplist_create_destroy_empty(void);
+static void test_skiplist_insert(void);
+static void test_skiplist_delete(void);
+static void test_skiplist_delete_all(void);
+static void test_skiplist_delete_with_entries(void);
+static void test_skiplist_search(void);
+static void test_skiplist_node_reuse(void);
+static void test_skiplist_random(void);
+
+
+/* implementation */
+static ___inline___ MyStruct* my_struct_create(const int64_t key)
+{
+    MyStruct* ms_p = (MyStruct*)malloc(sizeof(*ms_p));
+
+    if (ms_p == NULL)
+        return NULL;
+
+    ms_p->key = key;
+    ms_p->a = 0;
+    ms_p->b = 0;
+    ms_p->c = 0;
+
+    return ms_p;
+}
+
+
+static void my_struct_destroy(void* ptr_p)
+{
+    MyStruct* ms_p = *(MyStruct**)ptr_p;
+    FREE(ms_p);
+}
+
+
+static int my_struct_compare(const void* a_p, const void* b_p)
+{
+    assert(a_p != NULL && b_p != NULL);
+
+    const MyStruct* ms1_p = *(const MyStruct**)a_p;
+    const MyStruct* ms2_p = *(const MyStruct**)b_p;
+
+    if (ms1_p->key > ms2_p->key) return 1;
+    if (ms1_p->key == ms2_p->key) return 0;
+    return -1;
+}
+
+
+static int my_compare_int64_t(const void* a_p, const void* b_p)
+{
+    assert(a_p != NULL && b_p != NULL);
+
+    const int64_t *iptr1_p = (const int64_t*)a_p;
+    const int64_t *iptr2_p = (const int64_t*)b_p;
+
+    if (*iptr1_p > *iptr2_p) return 1;
+    if (*iptr1_p == *iptr2_p) return 0;
+    return -1;
+}
+
+
+static void test_skiplist_create_destroy_empty(void)
+{
+    Skiplist* list_p = NULL;
+    int64_t val = 0;
+    int64_t* rarr_p = NULL;
+    size_t rsize = 0;
+
+    list_p = skiplist_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+    T_EXPECT(skiplist_get_num_entries(list_p), (ssize_t)0);
+    T_EXPECT(skiplist_get_data_size(list_p), (ssize_t)sizeof(int64_t));
+
+    T_EXPECT(skiplist_search(list_p, (void*)&val, (void*)&val), -1);
+    T_EXPECT(skiplist_delete(list_p, (void*)&val), 1);
+    T_EXPECT(skiplist_delete_all(list_p, (void*)&val), -1);
+    T_EXPECT(skiplist_to_array(list_p, &rarr_p, &rsize), -1);
+    skiplist_destroy(list_p);
+
+    list_p = skiplist_create(0, NULL, NULL);
+    T_ASSERT(list_p, NULL);
+
+    list_p = skiplist_create(0, my_compare_int64_t, NULL);
+    T_ASSERT(list_p, NULL);
+
+    list_p = skiplist_create(sizeof(double), NULL, NULL);
+    T_ASSERT(list_p, NULL);
+
+    T_EXPECT(skiplist_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(skiplist_get_data_size(NULL), (ssize_t)-1);
+}
+
+
+static void test_skiplist_insert(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE] = {0};
+    int64_t* rarr_p = NULL;
+    size_t rsize = 0;
+
+    Skiplist* list_p = skiplist_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    /* insert in reverse order, result has to be sorted */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)(ARRAY_TEST_SIZE - i - 1);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(skiplist_insert(list_p, (void*)&arr[i]), 0);
+
+    T_EXPECT(skiplist_get_num_entries(list_p), (ssize_t)ARRAY_TEST_SIZE);
+    T_EXPECT(skiplist_to_array(list_p, &rarr_p, &rsize), 0);
+    T_ASSERT(rsize, (size_t)ARRAY_TEST_SIZE);
+
+    for (size_t i = 0; i < rsize; ++i)
+        T_ASSERT(rarr_p[i], (int64_t)i);
+
+    FREE(rarr_p);
+
+    T_EXPECT(skiplist_insert(NULL, (void*)&arr[0]), -1);
+    T_EXPECT(skiplist_insert(list_p, NULL), -1);
+
+    skiplist_destroy(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_skiplist_delete(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE] = {0};
+    int64_t* rarr_p = NULL;
+    size_t rsize = 0;
+    int64_t val = 0;
+
+    Skiplist* list_p = skiplist_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)((i * 7919) % ARRAY_TEST_SIZE);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(skiplist_insert(list_p, (void*)&arr[i]), 0);
+
+    /* delete all odd entries */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        if (arr[i] & 1)
+            T_EXPECT(skiplist_delete(list_p, (void*)&arr[i]), 0);
+
+    T_EXPECT(skiplist_get_num_entries(list_p), (ssize_t)(ARRAY_TEST_SIZE / 2));
+
+    val = 1;
+    T_EXPECT(skiplist_delete(list_p, (void*)&val), 1);
+
+    val = ARRAY_TEST_SIZE;
+    T_EXPECT(skiplist_delete(list_p, (void*)&val), 1);
+
+    T_EXPECT(skiplist_to_array(list_p, &rarr_p, &rsize), 0);
+    T_ASSERT(rsize, (size_t)(ARRAY_TEST_SIZE / 2));
+
+    for (size_t i = 0; i < rsize; ++i)
+        T_ASSERT(rarr_p[i], (int64_t)(2 * i));
+
+    FREE(rarr_p);
+
+    T_EXPECT(skiplist_delete(NULL, (void*)&val), -1);
+    T_EXPECT(skiplist_delete(list_p, NULL), -1);
+
+    skiplist_destroy(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_skiplist_delete_all(void)
+{
+    int64_t arr[] = { 5, 1, 5, 2, 5, 3, 5, 4, 1, 5 };
+    int64_t arr_expt[] = { 2, 3, 4 };
+    int64_t* rarr_p = NULL;
+    size_t rsize = 0;
+    int64_t val = 0;
+
+    Skiplist* list_p = skiplist_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    for (size_t i = 0; i < ARRAY_SIZE(arr); ++i)
+        T_EXPECT(skiplist_insert(list_p, (void*)&arr[i]), 0);
+
+    val = 5;
+    T_EXPECT(skiplist_delete_all(list_p, (void*)&val), 5);
+    T_EXPECT(skiplist_delete_all(list_p, (void*)&val), -1);
+
+    val = 1;
+    T_EXPECT(skiplist_delete_all(list_p, (void*)&val), 2);
+
+    T_EXPECT(skiplist_to_array(list_p, &rarr_p, &rsize), 0);
+    T_ASSERT(rsize, ARRAY_SIZE(arr_expt));
+    T_EXPECT(memcmp((const void*)rarr_p, (const void*)&arr_expt[0], sizeof(arr_expt)), 0);
+
+    FREE(rarr_p);
+
+    T_EXPECT(skiplist_delete_all(NULL, (void*)&val), -1);
+    T_EXPECT(skiplist_delete_all(list_p, NULL), -1);
+
+    skiplist_destroy(list_p);
+}
+
+
+static void test_skiplist_delete_with_entries(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    MyStruct* ms_p = NULL;
+
+    Skiplist* list_p = skiplist_create(sizeof(MyStruct*), my_struct_compare, my_struct_destroy);
+    T_ERROR(list_p == NULL);
+
+    /* every key is inserted twice */
+    for (size_t i = 0; i < 2 * ARRAY_TEST_SIZE; ++i)
+    {
+        ms_p = my_struct_create((int64_t)(i % ARRAY_TEST_SIZE));
+        T_ERROR(ms_p == NULL);
+        T_EXPECT(skiplist_insert(list_p, (void*)&ms_p), 0);
+    }
+
+    MyStruct key = { 0, 0, 0, 0 };
+    MyStruct* key_p = &key;
+
+    key.key = 0;
+    T_EXPECT(skiplist_delete_with_entry(list_p, (void*)&key_p), 0);
+    T_EXPECT(skiplist_delete_with_entry(list_p, (void*)&key_p), 0);
+    T_EXPECT(skiplist_delete_with_entry(list_p, (void*)&key_p), 1);
+
+    key.key = 1;
+    T_EXPECT(skiplist_delete_all_with_entry(list_p, (void*)&key_p), 2);
+
+    T_EXPECT(skiplist_get_num_entries(list_p), (ssize_t)(2 * ARRAY_TEST_SIZE - 4));
+
+    /* the rest is freed by destructor */
+    skiplist_destroy_with_entries(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_skiplist_search(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t val = 0;
+
+    Skiplist* list_p = skiplist_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    /* only even keys are in list */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        val = (int64_t)(2 * ((i * 7919) % ARRAY_TEST_SIZE));
+        T_EXPECT(skiplist_insert(list_p, (void*)&val), 0);
+    }
+
+    for (int64_t i = 0; i < 2 * ARRAY_TEST_SIZE; ++i)
+    {
+        int64_t out = -1;
+
+        if (i & 1)
+        {
+            T_EXPECT(skiplist_search(list_p, (void*)&i, (void*)&out), -1);
+        }
+        else
+        {
+            T_EXPECT(skiplist_search(list_p, (void*)&i, (void*)&out), 0);
+            T_ASSERT(out, i);
+        }
+    }
+
+    T_EXPECT(skiplist_search(NULL, (void*)&val, (void*)&val), -1);
+    T_EXPECT(skiplist_search(list_p, NULL, (void*)&val), -1);
+    T_EXPECT(skiplist_search(list_p, (void*)&val, NULL), -1);
+
+    skiplist_destroy(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_skiplist_node_reuse(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    int64_t arr[ARRAY_TEST_SIZE] = {0};
+    int64_t* rarr_p = NULL;
+    size_t rsize = 0;
+    int64_t val = 0;
+
+    Skiplist* list_p = skiplist_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        arr[i] = (int64_t)((i * 7919) % ARRAY_TEST_SIZE);
+
+    /* nodes freed in first round are reused in next rounds */
+    for (size_t round = 0; round < 3; ++round)
+    {
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            T_EXPECT(skiplist_insert(list_p, (void*)&arr[i]), 0);
+
+        T_EXPECT(skiplist_get_num_entries(list_p), (ssize_t)ARRAY_TEST_SIZE);
+        T_EXPECT(skiplist_to_array(list_p, &rarr_p, &rsize), 0);
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            T_ASSERT(rarr_p[i], (int64_t)i);
+
+        FREE(rarr_p);
+
+        for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+            T_EXPECT(skiplist_delete(list_p, (void*)&arr[ARRAY_TEST_SIZE - 1 - i]), 0);
+
+        T_EXPECT(skiplist_get_num_entries(list_p), (ssize_t)0);
+        T_EXPECT(skiplist_search(list_p, (void*)&arr[0], (void*)&val), -1);
+    }
+
+    skiplist_destroy(list_p);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_skiplist_random(void)
+{
+    #define ARRAY_TEST_SIZE 10000
+    #define KEY_RANGE 512
+
+    /* counters are the reference model of skip list content */
+    size_t counters[KEY_RANGE] = {0};
+    size_t entries = 0;
+    int64_t* rarr_p = NULL;
+    size_t rsize = 0;
+
+    Skiplist* list_p = skiplist_create(sizeof(int64_t), my_compare_int64_t, NULL);
+    T_ERROR(list_p == NULL);
+
+    srand(1234);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        int64_t val = (int64_t)(rand() % KEY_RANGE);
+        int64_t out = -1;
+
+        switch (rand() % 4)
+        {
+            case 0:
+            {
+                const int ret = skiplist_delete(list_p, (void*)&val);
+
+                T_ASSERT(ret, counters[val] > 0 ? 0 : 1);
+
+                if (ret == 0)
+                {
+                    --counters[val];
+                    --entries;
+                }
+                break;
+            }
+            case 1:
+            {
+                T_EXPECT(skiplist_search(list_p, (void*)&val, (void*)&out), counters[val] > 0 ? 0 : -1);
+                break;
+            }
+            default:
+            {
+                T_EXPECT(skiplist_insert(list_p, (void*)&val), 0);
+                ++counters[val];
+                ++entries;
+                break;
+            }
+        }
+    }
+
+    T_EXPECT(skiplist_get_num_entries(list_p), (ssize_t)entries);
+    T_EXPECT(skiplist_to_array(list_p, &rarr_p, &rsize), 0);
+    T_ASSERT(rsize, entries);
+
+    size_t offset = 0;
+    for (size_t key = 0; key < KEY_RANGE; ++key)
+        for (size_t i = 0; i < counters[key]; ++i)
+            T_ASSERT(rarr_p[offset++], (int64_t)key);
+
+    FREE(rarr_p);
+    skiplist_destroy(list_p);
+
+    #undef KEY_RANGE
+    #undef ARRAY_TEST_SIZE
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING SKIP LIST");
+    TEST(test_skiplist_create_destroy_empty());
+    TEST(test_skiplist_insert());
+    TEST(test_skiplist_delete());
+    TEST(test_skiplist_delete_all());
+    TEST(test_skiplist_delete_with_entries());
+    TEST(test_skiplist_search());
+    TEST(test_skiplist_node_reuse());
+    TEST(test_skiplist_random());
+    TEST_SUMMARY();
+
+    return 0;
+}
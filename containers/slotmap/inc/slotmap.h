@@ -0,0 +1,225 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+/*
+    Slot map implementation (container with stable handles).
+
+    Index of entry in darray changes when entries are deleted, so it cannot be
+    kept as reference. Slot map returns handle (slot index + generation) for
+    each inserted entry. Handle stays valid until entry is deleted, then
+    generation of slot is incremented, so old handle is rejected even when
+    slot is reused. Insert, delete and lookup are O(1).
+
+    Entries are kept densely packed in darray (delete moves last entry to
+    the hole), so iteration over slotmap_get_array is as fast as over darray.
+    Slots of deleted entries are reused through free list.
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+#include <darray.h>
+#include <common.h>     /* destructor_f */
+#include <stddef.h>     /* size_t */
+#include <stdint.h>     /* uint32_t, uint64_t */
+#include <stdbool.h>    /* bool */
+#include <sys/types.h>  /* ssize_t */
+
+
+/* handle: generation in high 32 bits, slot index in low 32 bits */
+typedef uint64_t Slotmap_handle;
+
+/* handle which is never returned by slotmap_insert */
+#define SLOTMAP_INVALID_HANDLE ((Slotmap_handle)0)
+
+/* end of free list */
+#define SLOTMAP_NONE UINT32_MAX
+
+
+typedef struct Slotmap_slot
+{
+    uint32_t index;             /* index of entry in values or next free slot */
+    uint32_t generation;        /* odd if slot is used, even if slot is free */
+} Slotmap_slot;
+
+typedef struct Slotmap
+{
+    Darray *values;             /* densely packed entries */
+    Darray *dense_slots;        /* slot index (uint32_t) of each entry in values */
+    Darray *slots;              /* Slotmap_slot for each handle */
+
+    destructor_f destroy_f;     /* destroy function */
+    uint32_t free_head;         /* first free slot or SLOTMAP_NONE */
+} Slotmap;
+
+
+/*
+    Create new instance of slot map.
+
+    PARAMS:
+    @IN size_of - size of entry.
+    @IN destroy_f - your data destructor function.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to slot map if success.
+*/
+Slotmap *slotmap_create(const size_t size_of, const destructor_f destroy_f);
+
+
+/*
+    Destroy slot map.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+
+    RETURN:
+    %This is void function.
+*/
+void slotmap_destroy(Slotmap *map);
+
+
+/*
+    Destroy slot map with all entries (call destructor for each entry).
+
+    PARAMS:
+    @IN map - pointer to slot map.
+
+    RETURN:
+    %This is void function.
+*/
+void slotmap_destroy_with_entries(Slotmap *map);
+
+
+/*
+    Insert entry to slot map.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+    @IN entry - pointer to entry.
+    @OUT handle - handle of inserted entry.
+
+    RETURN:
+    %0 if success.
+    %-1 if failure.
+*/
+int slotmap_insert(Slotmap * __restrict__ map, const void * __restrict__ entry, Slotmap_handle * __restrict__ handle);
+
+
+/*
+    Delete entry with @handle from slot map.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+    @IN handle - handle of entry.
+    @OUT val_out - deleted entry (can be NULL).
+
+    RETURN:
+    %0 if success.
+    %1 if handle is not valid (entry was deleted).
+    %-1 if failure.
+*/
+int slotmap_delete(Slotmap * __restrict__ map, const Slotmap_handle handle, void * __restrict__ val_out);
+
+
+/*
+    Delete entry with @handle from slot map (destructor will be called).
+
+    PARAMS:
+    @IN map - pointer to slot map.
+    @IN handle - handle of entry.
+
+    RETURN:
+    %0 if success.
+    %1 if handle is not valid (entry was deleted).
+    %-1 if failure.
+*/
+int slotmap_delete_with_entry(Slotmap *map, const Slotmap_handle handle);
+
+
+/*
+    Get pointer to entry with @handle.
+    Pointer is valid until next insert or delete.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+    @IN handle - handle of entry.
+
+    RETURN:
+    %Pointer to entry if success.
+    %NULL if handle is not valid or failure.
+*/
+void *slotmap_get(const Slotmap * const map, const Slotmap_handle handle);
+
+
+/*
+    Check if handle is valid.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+    @IN handle - handle of entry.
+
+    RETURN:
+    %true if entry with @handle is in slot map.
+    %false if not or failure.
+*/
+bool slotmap_contains(const Slotmap * const map, const Slotmap_handle handle);
+
+
+/*
+    Get handle of entry from position @pos in dense array (slotmap_get_array).
+
+    PARAMS:
+    @IN map - pointer to slot map.
+    @IN pos - index in dense array.
+
+    RETURN:
+    %Handle if success.
+    %SLOTMAP_INVALID_HANDLE if failure.
+*/
+Slotmap_handle slotmap_get_handle(const Slotmap * const map, const size_t pos);
+
+
+/*
+    Get dense array of entries (order changes after delete).
+    Array is valid until next insert or delete.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+
+    RETURN:
+    %Pointer to array if success.
+    %NULL if slot map is empty or failure.
+*/
+void *slotmap_get_array(const Slotmap * const map);
+
+
+/*
+    Get number of entries.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+
+    RETURN:
+    %Number of entries if success.
+    %-1 if failure.
+*/
+ssize_t slotmap_get_num_entries(const Slotmap * const map);
+
+
+/*
+    Get size of entry.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+
+    RETURN:
+    %Size of entry if success.
+    %-1 if failure.
+*/
+ssize_t slotmap_get_data_size(const Slotmap * const map);
+
+
+#endif /* SLOTMAP_H */
@@ -0,0 +1,318 @@
+#include <slotmap.h>
+#include <common.h>
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memcpy */
+
+
+/*
+    Make handle from slot index and generation.
+
+    PARAMS:
+    @IN index - index of slot.
+    @IN generation - generation of slot.
+
+    RETURN:
+    %Handle.
+*/
+static ___inline___ Slotmap_handle __slotmap_make_handle(const uint32_t index, const uint32_t generation);
+
+
+/*
+    Find slot of valid handle.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+    @IN handle - handle of entry.
+
+    RETURN:
+    %Index of slot if handle is valid.
+    %SLOTMAP_NONE if handle is not valid.
+*/
+static ___inline___ uint32_t __slotmap_find(const Slotmap * const map, const Slotmap_handle handle);
+
+
+/*
+    Delete entry of used slot, last entry is moved to the hole.
+
+    PARAMS:
+    @IN map - pointer to slot map.
+    @IN index - index of slot.
+    @OUT val_out - deleted entry (can be NULL).
+
+    RETURN:
+    %This is void function.
+*/
+static void __slotmap_delete(Slotmap * __restrict__ map, const uint32_t index, void * __restrict__ val_out);
+
+
+static ___inline___ Slotmap_handle __slotmap_make_handle(const uint32_t index, const uint32_t generation)
+{
+    return ((Slotmap_handle)generation << 32) | (Slotmap_handle)index;
+}
+
+
+static ___inline___ uint32_t __slotmap_find(const Slotmap * const map, const Slotmap_handle handle)
+{
+    const uint32_t index = (uint32_t)(handle & UINT32_MAX);
+    const uint32_t generation = (uint32_t)(handle >> 32);
+
+    if (index >= map->slots->num_entries)
+        return SLOTMAP_NONE;
+
+    const Slotmap_slot *slot = (const Slotmap_slot *)map->slots->array + index;
+
+    /* free slot has even generation, so handle with even generation is never valid */
+    if (slot->generation != generation || (generation & 1) == 0)
+        return SLOTMAP_NONE;
+
+    return index;
+}
+
+
+static void __slotmap_delete(Slotmap * __restrict__ map, const uint32_t index, void * __restrict__ val_out)
+{
+    Slotmap_slot *slots = (Slotmap_slot *)map->slots->array;
+    uint32_t *dense_slots = (uint32_t *)map->dense_slots->array;
+    BYTE *values = (BYTE *)map->values->array;
+
+    const size_t size_of = map->values->size_of;
+    const size_t pos = slots[index].index;
+    const size_t last = map->values->num_entries - 1;
+
+    if (val_out != NULL)
+        (void)memcpy(val_out, values + pos * size_of, size_of);
+
+    /* keep values dense, last entry fills the hole and its slot is updated */
+    if (pos != last)
+    {
+        (void)memcpy(values + pos * size_of, values + last * size_of, size_of);
+
+        dense_slots[pos] = dense_slots[last];
+        slots[dense_slots[pos]].index = (uint32_t)pos;
+    }
+
+    (void)darray_delete(map->values, NULL);
+    (void)darray_delete(map->dense_slots, NULL);
+
+    ++slots[index].generation;
+
+    /* slot with wrapped generation would accept old handles, so it is never reused */
+    if (slots[index].generation == 0)
+        return;
+
+    slots[index].index = map->free_head;
+    map->free_head = index;
+}
+
+
+Slotmap *slotmap_create(const size_t size_of, const destructor_f destroy_f)
+{
+    if (size_of < 1)
+        ERROR("size_of < 1\n", NULL);
+
+    Slotmap *map = (Slotmap *)malloc(sizeof(Slotmap));
+
+    if (map == NULL)
+        ERROR("malloc error\n", NULL);
+
+    map->values = darray_create(DARRAY_UNSORTED, size_of, 0, NULL, NULL);
+    map->dense_slots = darray_create(DARRAY_UNSORTED, sizeof(uint32_t), 0, NULL, NULL);
+    map->slots = darray_create(DARRAY_UNSORTED, sizeof(Slotmap_slot), 0, NULL, NULL);
+
+    if (map->values == NULL || map->dense_slots == NULL || map->slots == NULL)
+    {
+        slotmap_destroy(map);
+        ERROR("darray_create error\n", NULL);
+    }
+
+    map->destroy_f = destroy_f;
+    map->free_head = SLOTMAP_NONE;
+
+    return map;
+}
+
+
+void slotmap_destroy(Slotmap *map)
+{
+    if (map == NULL)
+        return;
+
+    if (map->values != NULL)
+        darray_destroy(map->values);
+
+    if (map->dense_slots != NULL)
+        darray_destroy(map->dense_slots);
+
+    if (map->slots != NULL)
+        darray_destroy(map->slots);
+
+    FREE(map);
+}
+
+
+void slotmap_destroy_with_entries(Slotmap *map)
+{
+    if (map == NULL)
+        return;
+
+    if (map->destroy_f != NULL)
+    {
+        BYTE *values = (BYTE *)map->values->array;
+
+        for (size_t i = 0; i < map->values->num_entries; ++i)
+            map->destroy_f((void *)(values + i * map->values->size_of));
+    }
+
+    slotmap_destroy(map);
+}
+
+
+int slotmap_insert(Slotmap * __restrict__ map, const void * __restrict__ entry, Slotmap_handle * __restrict__ handle)
+{
+    if (map == NULL || entry == NULL || handle == NULL)
+        ERROR("map == NULL || entry == NULL || handle == NULL\n", -1);
+
+    uint32_t index = map->free_head;
+
+    if (index == SLOTMAP_NONE)
+    {
+        if (map->slots->num_entries >= SLOTMAP_NONE)
+            ERROR("too many slots\n", -1);
+
+        /* new slot goes to free list, so it is reused if insert fails below */
+        const Slotmap_slot slot = { SLOTMAP_NONE, 0 };
+
+        if (darray_insert(map->slots, (const void *)&slot) != 0)
+            ERROR("darray_insert error\n", -1);
+
+        index = (uint32_t)(map->slots->num_entries - 1);
+        map->free_head = index;
+    }
+
+    if (darray_insert(map->values, entry) != 0)
+        ERROR("darray_insert error\n", -1);
+
+    if (darray_insert(map->dense_slots, (const void *)&index) != 0)
+    {
+        (void)darray_delete(map->values, NULL);
+        ERROR("darray_insert error\n", -1);
+    }
+
+    Slotmap_slot *slot = (Slotmap_slot *)map->slots->array + index;
+
+    map->free_head = slot->index;
+    slot->index = (uint32_t)(map->values->num_entries - 1);
+    ++slot->generation;
+
+    *handle = __slotmap_make_handle(index, slot->generation);
+
+    return 0;
+}
+
+
+int slotmap_delete(Slotmap * __restrict__ map, const Slotmap_handle handle, void * __restrict__ val_out)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    const uint32_t index = __slotmap_find(map, handle);
+
+    if (index == SLOTMAP_NONE)
+        return 1;
+
+    __slotmap_delete(map, index, val_out);
+
+    return 0;
+}
+
+
+int slotmap_delete_with_entry(Slotmap *map, const Slotmap_handle handle)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    const uint32_t index = __slotmap_find(map, handle);
+
+    if (index == SLOTMAP_NONE)
+        return 1;
+
+    if (map->destroy_f != NULL)
+    {
+        const Slotmap_slot *slot = (const Slotmap_slot *)map->slots->array + index;
+        map->destroy_f((void *)((BYTE *)map->values->array + slot->index * map->values->size_of));
+    }
+
+    __slotmap_delete(map, index, NULL);
+
+    return 0;
+}
+
+
+void *slotmap_get(const Slotmap * const map, const Slotmap_handle handle)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", NULL);
+
+    const uint32_t index = __slotmap_find(map, handle);
+
+    if (index == SLOTMAP_NONE)
+        return NULL;
+
+    const Slotmap_slot *slot = (const Slotmap_slot *)map->slots->array + index;
+
+    return (void *)((BYTE *)map->values->array + slot->index * map->values->size_of);
+}
+
+
+bool slotmap_contains(const Slotmap * const map, const Slotmap_handle handle)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", false);
+
+    return __slotmap_find(map, handle) != SLOTMAP_NONE;
+}
+
+
+Slotmap_handle slotmap_get_handle(const Slotmap * const map, const size_t pos)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", SLOTMAP_INVALID_HANDLE);
+
+    if (pos >= map->values->num_entries)
+        ERROR("pos >= num_entries\n", SLOTMAP_INVALID_HANDLE);
+
+    const uint32_t index = ((const uint32_t *)map->dense_slots->array)[pos];
+    const Slotmap_slot *slot = (const Slotmap_slot *)map->slots->array + index;
+
+    return __slotmap_make_handle(index, slot->generation);
+}
+
+
+void *slotmap_get_array(const Slotmap * const map)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", NULL);
+
+    if (map->values->num_entries == 0)
+        return NULL;
+
+    return map->values->array;
+}
+
+
+ssize_t slotmap_get_num_entries(const Slotmap * const map)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    return (ssize_t)map->values->num_entries;
+}
+
+
+ssize_t slotmap_get_data_size(const Slotmap * const map)
+{
+    if (map == NULL)
+        ERROR("map == NULL\n", -1);
+
+    return (ssize_t)map->values->size_of;
+}
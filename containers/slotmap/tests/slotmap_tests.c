@@ -0,0 +1,265 @@
+#include <slotmap.h>
+#include <common.h>
+#include <ctest.h>
+#include <stdint.h> /* int64_t */
+#include <stdbool.h>
+#include <stdlib.h>
+
+
+/* functions needed for testing */
+static void my_ptr_destroy(void *ptr);
+
+
+/* unit tests function declaraions */
+static void test_slotmap_create(void);
+static void test_slotmap_insert_get(void);
+static void test_slotmap_delete(void);
+static void test_slotmap_dense_iteration(void);
+static void test_slotmap_with_entries(void);
+
+
+/* implementation */
+static void my_ptr_destroy(void *ptr)
+{
+    int64_t *p = *(int64_t **)ptr;
+    FREE(p);
+}
+
+
+static void test_slotmap_create(void)
+{
+    Slotmap *map = slotmap_create(sizeof(int64_t), NULL);
+    T_ERROR(map == NULL);
+
+    T_EXPECT(slotmap_get_num_entries(map), (ssize_t)0);
+    T_EXPECT(slotmap_get_data_size(map), (ssize_t)sizeof(int64_t));
+    T_ASSERT(slotmap_get_array(map) == NULL, true);
+    T_ASSERT(slotmap_get(map, SLOTMAP_INVALID_HANDLE) == NULL, true);
+    T_EXPECT(slotmap_contains(map, SLOTMAP_INVALID_HANDLE), (bool)false);
+    T_EXPECT(slotmap_delete(map, SLOTMAP_INVALID_HANDLE, NULL), 1);
+
+    slotmap_destroy(map);
+
+    T_ASSERT(slotmap_create(0, NULL) == NULL, true);
+
+    Slotmap_handle handle;
+    const int64_t val = 1;
+
+    T_EXPECT(slotmap_insert(NULL, &val, &handle), -1);
+    T_EXPECT(slotmap_delete(NULL, handle, NULL), -1);
+    T_EXPECT(slotmap_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(slotmap_get_data_size(NULL), (ssize_t)-1);
+}
+
+
+static void test_slotmap_insert_get(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    Slotmap_handle handles[ARRAY_TEST_SIZE];
+
+    Slotmap *map = slotmap_create(sizeof(int64_t), NULL);
+    T_ERROR(map == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(slotmap_insert(map, &i, &handles[i]), 0);
+        T_CHECK(handles[i] != SLOTMAP_INVALID_HANDLE);
+    }
+
+    T_EXPECT(slotmap_get_num_entries(map), (ssize_t)ARRAY_TEST_SIZE);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        const int64_t *val = (const int64_t *)slotmap_get(map, handles[i]);
+
+        T_ERROR(val == NULL);
+        T_EXPECT(*val, i);
+        T_EXPECT(slotmap_contains(map, handles[i]), (bool)true);
+    }
+
+    /* entry can be modified in place */
+    int64_t *val = (int64_t *)slotmap_get(map, handles[5]);
+    T_ERROR(val == NULL);
+    *val = -5;
+    T_EXPECT(*(int64_t *)slotmap_get(map, handles[5]), (int64_t)-5);
+
+    /* handle of slot which doesn't exist */
+    T_ASSERT(slotmap_get(map, handles[0] + ARRAY_TEST_SIZE), (void *)NULL);
+
+    slotmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_slotmap_delete(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    Slotmap_handle handles[ARRAY_TEST_SIZE];
+    bool present[ARRAY_TEST_SIZE];
+
+    Slotmap *map = slotmap_create(sizeof(int64_t), NULL);
+    T_ERROR(map == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        T_EXPECT(slotmap_insert(map, &i, &handles[i]), 0);
+        present[i] = true;
+    }
+
+    /* delete every third, handles of others stay valid */
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; i += 3)
+    {
+        int64_t val;
+
+        T_EXPECT(slotmap_delete(map, handles[i], &val), 0);
+        T_EXPECT(val, i);
+        present[i] = false;
+
+        /* old handle is rejected */
+        T_EXPECT(slotmap_delete(map, handles[i], NULL), 1);
+        T_ASSERT(slotmap_get(map, handles[i]), (void *)NULL);
+    }
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        const int64_t *val = (const int64_t *)slotmap_get(map, handles[i]);
+
+        T_EXPECT((bool)(val != NULL), present[i]);
+
+        if (val != NULL)
+            T_EXPECT(*val, i);
+    }
+
+    /* deleted slots are reused with new generation */
+    const Slotmap_handle old_handle = handles[0];
+    ssize_t num_entries = slotmap_get_num_entries(map);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; i += 3)
+    {
+        const int64_t val = i + ARRAY_TEST_SIZE;
+        T_EXPECT(slotmap_insert(map, &val, &handles[i]), 0);
+        ++num_entries;
+    }
+
+    T_EXPECT(slotmap_get_num_entries(map), (ssize_t)ARRAY_TEST_SIZE);
+    T_EXPECT(slotmap_get_num_entries(map), num_entries);
+    T_EXPECT(map->slots->num_entries, (size_t)ARRAY_TEST_SIZE);
+
+    /* free list is LIFO, so slot of first deleted entry was taken by last insert, with new generation */
+    T_CHECK((uint32_t)old_handle == (uint32_t)handles[ARRAY_TEST_SIZE - 1]);
+    T_CHECK(old_handle != handles[ARRAY_TEST_SIZE - 1]);
+    T_EXPECT(slotmap_contains(map, old_handle), (bool)false);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        const int64_t *val = (const int64_t *)slotmap_get(map, handles[i]);
+
+        T_ERROR(val == NULL);
+        T_EXPECT(*val, i % 3 == 0 ? i + ARRAY_TEST_SIZE : i);
+    }
+
+    /* delete all */
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(slotmap_delete(map, handles[i], NULL), 0);
+
+    T_EXPECT(slotmap_get_num_entries(map), (ssize_t)0);
+
+    slotmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_slotmap_dense_iteration(void)
+{
+    #define ARRAY_TEST_SIZE 500
+
+    Slotmap_handle handles[ARRAY_TEST_SIZE];
+
+    Slotmap *map = slotmap_create(sizeof(int64_t), NULL);
+    T_ERROR(map == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+        T_EXPECT(slotmap_insert(map, &i, &handles[i]), 0);
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; i += 2)
+        T_EXPECT(slotmap_delete(map, handles[i], NULL), 0);
+
+    /* dense array has only odd values and handle of each entry leads back to it */
+    const int64_t *array = (const int64_t *)slotmap_get_array(map);
+    T_ERROR(array == NULL);
+
+    const size_t num_entries = (size_t)slotmap_get_num_entries(map);
+    T_EXPECT(num_entries, (size_t)(ARRAY_TEST_SIZE / 2));
+
+    int64_t sum = 0;
+
+    for (size_t i = 0; i < num_entries; ++i)
+    {
+        T_EXPECT(array[i] % 2, (int64_t)1);
+        sum += array[i];
+
+        const Slotmap_handle handle = slotmap_get_handle(map, i);
+        T_CHECK(handle == handles[array[i]]);
+        T_CHECK(slotmap_get(map, handle) == (const void *)&array[i]);
+    }
+
+    T_EXPECT(sum, (int64_t)(ARRAY_TEST_SIZE / 2) * (ARRAY_TEST_SIZE / 2));
+    T_EXPECT(slotmap_get_handle(map, num_entries), SLOTMAP_INVALID_HANDLE);
+
+    slotmap_destroy(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_slotmap_with_entries(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    Slotmap_handle handles[ARRAY_TEST_SIZE];
+
+    Slotmap *map = slotmap_create(sizeof(int64_t *), my_ptr_destroy);
+    T_ERROR(map == NULL);
+
+    for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        int64_t *ptr = (int64_t *)malloc(sizeof(int64_t));
+        T_ERROR(ptr == NULL);
+
+        *ptr = i;
+        T_EXPECT(slotmap_insert(map, (void *)&ptr, &handles[i]), 0);
+    }
+
+    /* entries are freed by destroy_f */
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; i += 2)
+        T_EXPECT(slotmap_delete_with_entry(map, handles[i]), 0);
+
+    T_EXPECT(slotmap_delete_with_entry(map, handles[0]), 1);
+    T_EXPECT(slotmap_get_num_entries(map), (ssize_t)(ARRAY_TEST_SIZE / 2));
+
+    const int64_t *ptr = *(int64_t **)slotmap_get(map, handles[1]);
+    T_EXPECT(*ptr, (int64_t)1);
+
+    /* rest of entries freed by destroy_f */
+    slotmap_destroy_with_entries(map);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING SLOTMAP");
+    TEST(test_slotmap_create());
+    TEST(test_slotmap_insert_get());
+    TEST(test_slotmap_delete());
+    TEST(test_slotmap_dense_iteration());
+    TEST(test_slotmap_with_entries());
+    TEST_SUMMARY();
+
+    return 0;
+}
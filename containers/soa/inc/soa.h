@@ -0,0 +1,187 @@
+#ifndef SOA_H
+#define SOA_H
+
+/*
+    Struct of arrays (columnar) container.
+
+    Darray keeps whole records one after another (array of structs), so scan
+    of one field reads every byte of every record. Soa keeps each field in its
+    own contiguous column aligned to CACHE_LINE_SIZE, so scan of one field
+    reads only this field and simple loop over raw column can be vectorised.
+
+    Fields are described by offset and size in user record, so records are
+    pushed and read as normal structs:
+
+    typedef struct Particle { double x; double y; int32_t id; } Particle;
+
+    const Soa_field fields[] = { SOA_FIELD(Particle, x), SOA_FIELD(Particle, y), SOA_FIELD(Particle, id) };
+    Soa *soa = soa_create(fields, ARRAY_SIZE(fields), 0);
+
+    Particle p = { 1.0, 2.0, 7 };
+    soa_push(soa, &p);
+
+    double *xs = soa_get_column(soa, 0);
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+#include <common.h>     /* BYTE */
+#include <stddef.h>     /* size_t, offsetof */
+#include <sys/types.h>  /* ssize_t */
+
+
+/* describe field @member of struct @type */
+#define SOA_FIELD(type, member) { offsetof(type, member), sizeof(((type *)0)->member) }
+
+/* minimal number of records allocated in each column */
+#define SOA_MIN_SIZE ((size_t)8)
+
+
+typedef struct Soa_field
+{
+    size_t offset;              /* offset of field in record */
+    size_t size;                /* size of field */
+} Soa_field;
+
+typedef struct Soa
+{
+    BYTE *data;                 /* one block with all columns */
+    BYTE **columns;             /* pointer to each column (in data) */
+    Soa_field *fields;          /* fields of record */
+
+    size_t num_fields;          /* number of fields (columns) */
+    size_t num_entries;         /* number of records */
+    size_t size;                /* number of allocated records in each column */
+} Soa;
+
+
+/*
+    Create new instance of Soa.
+
+    PARAMS:
+    @IN fields - array of field descriptors (SOA_FIELD).
+    @IN num_fields - number of fields.
+    @IN size - beginning number of records.
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to Soa if success.
+*/
+Soa *soa_create(const Soa_field * const fields, const size_t num_fields, const size_t size);
+
+
+/*
+    Destroy Soa.
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+
+    RETURN:
+    %This is void function.
+*/
+void soa_destroy(Soa *soa);
+
+
+/*
+    Make place for at least @size records.
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+    @IN size - number of records.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int soa_reserve(Soa *soa, const size_t size);
+
+
+/*
+    Insert record at the end (fields are scattered to columns).
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+    @IN record - pointer to record.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int soa_push(Soa * __restrict__ soa, const void * __restrict__ const record);
+
+
+/*
+    Get record from position @pos (fields are gathered from columns).
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+    @IN pos - index of record.
+    @OUT record - pointer to record.
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int soa_get(const Soa * __restrict__ const soa, const size_t pos, void * __restrict__ record);
+
+
+/*
+    Delete record from position @pos in O(1), last record is moved to @pos.
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+    @IN pos - index of record.
+    @OUT record - pointer to deleted record (can be NULL).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+int soa_swap_remove(Soa * __restrict__ soa, const size_t pos, void * __restrict__ record);
+
+
+/*
+    Get raw column of field, i-th value is i-th record field.
+    Column is aligned to CACHE_LINE_SIZE and it is valid until next push or reserve.
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+    @IN field - index of field.
+
+    RETURN:
+    %pointer to column if success.
+    %NULL if failure.
+*/
+void *soa_get_column(const Soa * const soa, const size_t field);
+
+
+/*
+    Get number of records.
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+
+    RETURN:
+    %number of records if success.
+    %-1 if failure.
+*/
+ssize_t soa_get_num_entries(const Soa * const soa);
+
+
+/*
+    Get number of fields.
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+
+    RETURN:
+    %number of fields if success.
+    %-1 if failure.
+*/
+ssize_t soa_get_num_fields(const Soa * const soa);
+
+
+#endif /* SOA_H */
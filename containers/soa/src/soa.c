@@ -0,0 +1,232 @@
+#include <soa.h>
+#include <common.h>
+#include <stdlib.h> /* malloc, posix_memalign, free */
+#include <string.h> /* memcpy */
+
+
+/*
+    Move columns to new block with place for @size records in each column.
+    Every column starts at CACHE_LINE_SIZE aligned offset.
+
+    PARAMS:
+    @IN soa - pointer to Soa.
+    @IN size - new number of records in column (not less than num_entries).
+
+    RETURN:
+    %0 if success.
+    %negative value if failure.
+*/
+static int __soa_resize(Soa *soa, const size_t size);
+
+
+static int __soa_resize(Soa *soa, const size_t size)
+{
+    size_t bytes = 0;
+
+    for (size_t i = 0; i < soa->num_fields; ++i)
+    {
+        if (size > (SIZE_MAX - CACHE_LINE_SIZE) / soa->fields[i].size)
+            ERROR("size is too big\n", -1);
+
+        const size_t column_bytes = ALIGN_UP(size * soa->fields[i].size, CACHE_LINE_SIZE);
+
+        if (bytes > SIZE_MAX - column_bytes)
+            ERROR("size is too big\n", -1);
+
+        bytes += column_bytes;
+    }
+
+    void *ptr = NULL;
+
+    if (posix_memalign(&ptr, CACHE_LINE_SIZE, bytes) != 0)
+        ERROR("posix_memalign error\n", -1);
+
+    BYTE *column = (BYTE *)ptr;
+
+    for (size_t i = 0; i < soa->num_fields; ++i)
+    {
+        if (soa->num_entries > 0)
+            (void)memcpy(column, soa->columns[i], soa->num_entries * soa->fields[i].size);
+
+        soa->columns[i] = column;
+        column += ALIGN_UP(size * soa->fields[i].size, CACHE_LINE_SIZE);
+    }
+
+    FREE(soa->data);
+
+    soa->data = (BYTE *)ptr;
+    soa->size = size;
+
+    return 0;
+}
+
+
+Soa *soa_create(const Soa_field * const fields, const size_t num_fields, const size_t size)
+{
+    if (fields == NULL)
+        ERROR("fields == NULL\n", NULL);
+
+    if (num_fields < 1)
+        ERROR("num_fields < 1\n", NULL);
+
+    for (size_t i = 0; i < num_fields; ++i)
+    {
+        if (fields[i].size < 1)
+            ERROR("fields[i].size < 1\n", NULL);
+    }
+
+    if (num_fields > (SIZE_MAX - sizeof(Soa)) / (sizeof(BYTE *) + sizeof(Soa_field)))
+        ERROR("num_fields is too big\n", NULL);
+
+    /* columns and fields are in the same allocation as Soa */
+    Soa *soa = (Soa *)malloc(sizeof(Soa) + num_fields * (sizeof(BYTE *) + sizeof(Soa_field)));
+
+    if (soa == NULL)
+        ERROR("malloc error\n", NULL);
+
+    soa->columns = (BYTE **)(void *)(soa + 1);
+    soa->fields = (Soa_field *)(void *)(soa->columns + num_fields);
+    (void)memcpy(soa->fields, fields, num_fields * sizeof(Soa_field));
+
+    soa->data = NULL;
+    soa->num_fields = num_fields;
+    soa->num_entries = 0;
+    soa->size = 0;
+
+    if (__soa_resize(soa, MAX(size, SOA_MIN_SIZE)) != 0)
+    {
+        FREE(soa);
+        ERROR("__soa_resize error\n", NULL);
+    }
+
+    return soa;
+}
+
+
+void soa_destroy(Soa *soa)
+{
+    if (soa == NULL)
+        return;
+
+    FREE(soa->data);
+    FREE(soa);
+}
+
+
+int soa_reserve(Soa *soa, const size_t size)
+{
+    if (soa == NULL)
+        ERROR("soa == NULL\n", -1);
+
+    if (size <= soa->size)
+        return 0;
+
+    return __soa_resize(soa, size);
+}
+
+
+int soa_push(Soa * __restrict__ soa, const void * __restrict__ const record)
+{
+    if (soa == NULL || record == NULL)
+        ERROR("soa == NULL || record == NULL\n", -1);
+
+    if (soa->num_entries == soa->size)
+    {
+        if (soa->size > SIZE_MAX / 2)
+            ERROR("soa is too big\n", -1);
+
+        if (__soa_resize(soa, soa->size * 2) != 0)
+            ERROR("__soa_resize error\n", -1);
+    }
+
+    const BYTE *src = (const BYTE *)record;
+
+    for (size_t i = 0; i < soa->num_fields; ++i)
+    {
+        const size_t field_size = soa->fields[i].size;
+        (void)memcpy(soa->columns[i] + soa->num_entries * field_size, src + soa->fields[i].offset, field_size);
+    }
+
+    ++soa->num_entries;
+
+    return 0;
+}
+
+
+int soa_get(const Soa * __restrict__ const soa, const size_t pos, void * __restrict__ record)
+{
+    if (soa == NULL || record == NULL)
+        ERROR("soa == NULL || record == NULL\n", -1);
+
+    if (pos >= soa->num_entries)
+        ERROR("pos >= num_entries\n", -1);
+
+    BYTE *dst = (BYTE *)record;
+
+    for (size_t i = 0; i < soa->num_fields; ++i)
+    {
+        const size_t field_size = soa->fields[i].size;
+        (void)memcpy(dst + soa->fields[i].offset, soa->columns[i] + pos * field_size, field_size);
+    }
+
+    return 0;
+}
+
+
+int soa_swap_remove(Soa * __restrict__ soa, const size_t pos, void * __restrict__ record)
+{
+    if (soa == NULL)
+        ERROR("soa == NULL\n", -1);
+
+    if (pos >= soa->num_entries)
+        ERROR("pos >= num_entries\n", -1);
+
+    if (record != NULL)
+        (void)soa_get(soa, pos, record);
+
+    const size_t last = soa->num_entries - 1;
+
+    /* columns are independent, so last record is moved field by field */
+    if (pos != last)
+    {
+        for (size_t i = 0; i < soa->num_fields; ++i)
+        {
+            const size_t field_size = soa->fields[i].size;
+            (void)memcpy(soa->columns[i] + pos * field_size, soa->columns[i] + last * field_size, field_size);
+        }
+    }
+
+    --soa->num_entries;
+
+    return 0;
+}
+
+
+void *soa_get_column(const Soa * const soa, const size_t field)
+{
+    if (soa == NULL)
+        ERROR("soa == NULL\n", NULL);
+
+    if (field >= soa->num_fields)
+        ERROR("field >= num_fields\n", NULL);
+
+    return (void *)soa->columns[field];
+}
+
+
+ssize_t soa_get_num_entries(const Soa * const soa)
+{
+    if (soa == NULL)
+        ERROR("soa == NULL\n", -1);
+
+    return (ssize_t)soa->num_entries;
+}
+
+
+ssize_t soa_get_num_fields(const Soa * const soa)
+{
+    if (soa == NULL)
+        ERROR("soa == NULL\n", -1);
+
+    return (ssize_t)soa->num_fields;
+}
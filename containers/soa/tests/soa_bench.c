@@ -0,0 +1,159 @@
+#include <soa.h>
+#include <darray.h>
+#include <cbench.h>
+#include <stdint.h> /* int32_t */
+
+
+/*
+    Soa against Darray of structs (array of structs) with the same 64 byte
+    records: push all records, then sum one field and two fields SCANS times.
+    Darray scan reads whole records, Soa scan reads only used columns.
+*/
+
+
+#define NUM_RECORDS ((size_t)1 << 20)
+#define SCANS ((size_t)20)
+
+
+typedef struct Particle
+{
+    double x;
+    double y;
+    double z;
+    double vx;
+    double vy;
+    double vz;
+    float mass;
+    int32_t id;
+    int64_t flags;
+} Particle;
+
+
+static const Soa_field particle_fields[] =
+{
+    SOA_FIELD(Particle, x),
+    SOA_FIELD(Particle, y),
+    SOA_FIELD(Particle, z),
+    SOA_FIELD(Particle, vx),
+    SOA_FIELD(Particle, vy),
+    SOA_FIELD(Particle, vz),
+    SOA_FIELD(Particle, mass),
+    SOA_FIELD(Particle, id),
+    SOA_FIELD(Particle, flags)
+};
+
+
+/* functions needed for benchmark */
+static Particle make_particle(size_t i);
+
+
+/* benchmark function declarations */
+static double bench_darray(void);
+static double bench_soa(void);
+
+
+/* implementation */
+static Particle make_particle(size_t i)
+{
+    Particle p;
+
+    p.x = (double)i;
+    p.y = (double)i * 0.5;
+    p.z = (double)i * 0.25;
+    p.vx = 1.0;
+    p.vy = -1.0;
+    p.vz = 0.5;
+    p.mass = 1.0f;
+    p.id = (int32_t)i;
+    p.flags = 0;
+
+    return p;
+}
+
+
+static double bench_darray(void)
+{
+    double sum = 0.0;
+
+    Darray *darray = darray_create(DARRAY_UNSORTED, sizeof(Particle), 0, NULL, NULL);
+
+    if (darray == NULL)
+        ERROR("darray_create error\n", 0.0);
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < NUM_RECORDS; ++i)
+    {
+        const Particle p = make_particle(i);
+        (void)darray_insert(darray, &p);
+    }
+    bench_report("darray push", NUM_RECORDS, start);
+
+    const Particle *particles = (const Particle *)darray_get_array(darray);
+
+    start = bench_now();
+    for (size_t scan = 0; scan < SCANS; ++scan)
+        for (size_t i = 0; i < NUM_RECORDS; ++i)
+            sum += particles[i].x;
+    bench_report("darray scan x (per record)", NUM_RECORDS * SCANS, start);
+
+    start = bench_now();
+    for (size_t scan = 0; scan < SCANS; ++scan)
+        for (size_t i = 0; i < NUM_RECORDS; ++i)
+            sum += particles[i].x * particles[i].vx;
+    bench_report("darray scan x * vx (per record)", NUM_RECORDS * SCANS, start);
+
+    darray_destroy(darray);
+
+    return sum;
+}
+
+
+static double bench_soa(void)
+{
+    double sum = 0.0;
+
+    Soa *soa = soa_create(particle_fields, ARRAY_SIZE(particle_fields), 0);
+
+    if (soa == NULL)
+        ERROR("soa_create error\n", 0.0);
+
+    uint64_t start = bench_now();
+    for (size_t i = 0; i < NUM_RECORDS; ++i)
+    {
+        const Particle p = make_particle(i);
+        (void)soa_push(soa, &p);
+    }
+    bench_report("soa push", NUM_RECORDS, start);
+
+    const double *xs = (const double *)soa_get_column(soa, 0);
+    const double *vxs = (const double *)soa_get_column(soa, 3);
+
+    start = bench_now();
+    for (size_t scan = 0; scan < SCANS; ++scan)
+        for (size_t i = 0; i < NUM_RECORDS; ++i)
+            sum += xs[i];
+    bench_report("soa scan x (per record)", NUM_RECORDS * SCANS, start);
+
+    start = bench_now();
+    for (size_t scan = 0; scan < SCANS; ++scan)
+        for (size_t i = 0; i < NUM_RECORDS; ++i)
+            sum += xs[i] * vxs[i];
+    bench_report("soa scan x * vx (per record)", NUM_RECORDS * SCANS, start);
+
+    soa_destroy(soa);
+
+    return sum;
+}
+
+
+int main(void)
+{
+    const double darray_sum = bench_darray();
+    const double soa_sum = bench_soa();
+
+    /* both scans add the same values in the same order */
+    if (darray_sum != soa_sum)
+        (void)printf("soa and darray sums differ\n");
+
+    return 0;
+}
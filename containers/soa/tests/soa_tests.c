@@ -0,0 +1,242 @@
+#include <soa.h>
+#include <common.h>
+#include <ctest.h>
+#include <stdint.h> /* int64_t, uintptr_t */
+#include <stdbool.h>
+
+
+/* record with padding and fields of different sizes */
+typedef struct Particle
+{
+    double x;
+    int8_t flag;
+    double y;
+    int32_t id;
+} Particle;
+
+
+static const Soa_field particle_fields[] =
+{
+    SOA_FIELD(Particle, x),
+    SOA_FIELD(Particle, flag),
+    SOA_FIELD(Particle, y),
+    SOA_FIELD(Particle, id)
+};
+
+
+/* functions needed for testing */
+static Particle make_particle(int32_t i);
+static bool particle_equal(const Particle *a, const Particle *b);
+
+
+/* unit tests function declaraions */
+static void test_soa_create(void);
+static void test_soa_push_get(void);
+static void test_soa_columns(void);
+static void test_soa_swap_remove(void);
+
+
+/* implementation */
+static Particle make_particle(int32_t i)
+{
+    Particle p;
+
+    p.x = (double)i * 0.5;
+    p.flag = (int8_t)(i % 100);
+    p.y = (double)i * -2.0;
+    p.id = i;
+
+    return p;
+}
+
+
+static bool particle_equal(const Particle *a, const Particle *b)
+{
+    return a->x == b->x && a->flag == b->flag && a->y == b->y && a->id == b->id;
+}
+
+
+static void test_soa_create(void)
+{
+    Soa *soa = soa_create(particle_fields, ARRAY_SIZE(particle_fields), 0);
+    T_ERROR(soa == NULL);
+
+    T_EXPECT(soa_get_num_entries(soa), (ssize_t)0);
+    T_EXPECT(soa_get_num_fields(soa), (ssize_t)ARRAY_SIZE(particle_fields));
+    T_ASSERT(soa_get_column(soa, ARRAY_SIZE(particle_fields)) == NULL, true);
+
+    Particle p;
+    T_EXPECT(soa_get(soa, 0, &p), -1);
+    T_EXPECT(soa_swap_remove(soa, 0, NULL), -1);
+
+    soa_destroy(soa);
+
+    const Soa_field bad_fields[] = { { 0, 8 }, { 8, 0 } };
+
+    T_ASSERT(soa_create(NULL, 1, 0) == NULL, true);
+    T_ASSERT(soa_create(particle_fields, 0, 0) == NULL, true);
+    T_ASSERT(soa_create(bad_fields, ARRAY_SIZE(bad_fields), 0) == NULL, true);
+
+    T_EXPECT(soa_push(NULL, &p), -1);
+    T_EXPECT(soa_get_num_entries(NULL), (ssize_t)-1);
+    T_EXPECT(soa_get_num_fields(NULL), (ssize_t)-1);
+    T_EXPECT(soa_reserve(NULL, 10), -1);
+}
+
+
+static void test_soa_push_get(void)
+{
+    #define ARRAY_TEST_SIZE 1000
+
+    Soa *soa = soa_create(particle_fields, ARRAY_SIZE(particle_fields), 0);
+    T_ERROR(soa == NULL);
+
+    for (int32_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        const Particle p = make_particle(i);
+        T_EXPECT(soa_push(soa, &p), 0);
+    }
+
+    T_EXPECT(soa_get_num_entries(soa), (ssize_t)ARRAY_TEST_SIZE);
+
+    for (int32_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        const Particle expected = make_particle(i);
+        Particle p;
+
+        T_EXPECT(soa_get(soa, (size_t)i, &p), 0);
+        T_ASSERT(particle_equal(&p, &expected), true);
+    }
+
+    Particle p;
+    T_EXPECT(soa_get(soa, ARRAY_TEST_SIZE, &p), -1);
+    T_EXPECT(soa_get(soa, 0, NULL), -1);
+
+    /* reserve keeps records */
+    T_EXPECT(soa_reserve(soa, 10 * ARRAY_TEST_SIZE), 0);
+    T_EXPECT(soa_get(soa, ARRAY_TEST_SIZE - 1, &p), 0);
+    T_EXPECT(p.id, (int32_t)(ARRAY_TEST_SIZE - 1));
+
+    soa_destroy(soa);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_soa_columns(void)
+{
+    #define ARRAY_TEST_SIZE 777
+
+    Soa *soa = soa_create(particle_fields, ARRAY_SIZE(particle_fields), 0);
+    T_ERROR(soa == NULL);
+
+    for (int32_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        const Particle p = make_particle(i);
+        T_EXPECT(soa_push(soa, &p), 0);
+    }
+
+    const double *xs = (const double *)soa_get_column(soa, 0);
+    const int8_t *flags = (const int8_t *)soa_get_column(soa, 1);
+    const double *ys = (const double *)soa_get_column(soa, 2);
+    const int32_t *ids = (const int32_t *)soa_get_column(soa, 3);
+
+    T_ERROR(xs == NULL || flags == NULL || ys == NULL || ids == NULL);
+
+    /* every column is aligned to cache line */
+    T_EXPECT((uintptr_t)xs % CACHE_LINE_SIZE, (uintptr_t)0);
+    T_EXPECT((uintptr_t)flags % CACHE_LINE_SIZE, (uintptr_t)0);
+    T_EXPECT((uintptr_t)ys % CACHE_LINE_SIZE, (uintptr_t)0);
+    T_EXPECT((uintptr_t)ids % CACHE_LINE_SIZE, (uintptr_t)0);
+
+    /* columns are dense */
+    double sum_x = 0.0;
+    int64_t sum_id = 0;
+
+    for (size_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        sum_x += xs[i];
+        sum_id += ids[i];
+
+        T_EXPECT(flags[i], (int8_t)(i % 100));
+        T_ASSERT(ys[i] == (double)i * -2.0, true);
+    }
+
+    T_ASSERT(sum_x == 0.5 * (ARRAY_TEST_SIZE - 1) * ARRAY_TEST_SIZE / 2, true);
+    T_EXPECT(sum_id, (int64_t)(ARRAY_TEST_SIZE - 1) * ARRAY_TEST_SIZE / 2);
+
+    soa_destroy(soa);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+static void test_soa_swap_remove(void)
+{
+    #define ARRAY_TEST_SIZE 100
+
+    bool present[ARRAY_TEST_SIZE];
+
+    Soa *soa = soa_create(particle_fields, ARRAY_SIZE(particle_fields), ARRAY_TEST_SIZE);
+    T_ERROR(soa == NULL);
+
+    for (int32_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+    {
+        const Particle p = make_particle(i);
+        T_EXPECT(soa_push(soa, &p), 0);
+        present[i] = true;
+    }
+
+    /* remove from the middle, last record takes its place */
+    Particle p;
+    T_EXPECT(soa_swap_remove(soa, 10, &p), 0);
+    T_EXPECT(p.id, (int32_t)10);
+    present[10] = false;
+
+    T_EXPECT(soa_get(soa, 10, &p), 0);
+    T_EXPECT(p.id, (int32_t)(ARRAY_TEST_SIZE - 1));
+
+    /* remove last */
+    T_EXPECT(soa_swap_remove(soa, (size_t)soa_get_num_entries(soa) - 1, &p), 0);
+    present[p.id] = false;
+
+    /* remove rest from the front */
+    while (soa_get_num_entries(soa) > 10)
+    {
+        T_EXPECT(soa_swap_remove(soa, 0, &p), 0);
+        T_ASSERT(present[p.id], true);
+        present[p.id] = false;
+    }
+
+    /* every record left is whole and was not removed */
+    for (size_t i = 0; i < 10; ++i)
+    {
+        T_EXPECT(soa_get(soa, i, &p), 0);
+
+        const Particle expected = make_particle(p.id);
+        T_ASSERT(particle_equal(&p, &expected), true);
+        T_ASSERT(present[p.id], true);
+    }
+
+    T_EXPECT(soa_swap_remove(soa, 10, NULL), -1);
+
+    while (soa_get_num_entries(soa) > 0)
+        T_EXPECT(soa_swap_remove(soa, 0, NULL), 0);
+
+    soa_destroy(soa);
+
+    #undef ARRAY_TEST_SIZE
+}
+
+
+int main(void)
+{
+    TEST_INIT("TESTING SOA");
+    TEST(test_soa_create());
+    TEST(test_soa_push_get());
+    TEST(test_soa_columns());
+    TEST(test_soa_swap_remove());
+    TEST_SUMMARY();
+
+    return 0;
+}
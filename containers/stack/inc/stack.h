@@ -3,6 +3,14 @@
 
 /*
     Stack implementation
+
+    Stack is created as growing darray (stack_create) or as fixed darray
+    over caller or embedded buffer (stack_create_fixed). Fixed stack never
+    allocates in push / pop. Push, pop and top are inlined, common case is
+    bounds check and copy, darray is called only to grow or shrink array.
+
+    Arguments of inlined functions are checked (NULL) only in debug build,
+    compile with -DSTACK_DEBUG to enable checks.
   
     Author: Kamil Kiełbasa
     email: kamilkielbasa73@gmail.com
@@ -11,14 +19,20 @@
 */
 
 #include <darray.h>
+#include <common.h>
 #include <stddef.h> /* size_t */
 #include <stdbool.h> /* bool */
+#include <string.h> /* memcpy */
 #include <sys/types.h> /* ssize_t */
 
 
 typedef Darray Stack;
 
 
+/* darray shrinks array when only quarter of it is used */
+#define STACK_SHRINK_RATIO ((size_t)4)
+
+
 /*
     Create new instance of stack.
 
@@ -32,6 +46,22 @@ typedef Darray Stack;
 Stack *stack_create(size_t size_of);
 
 
+/*
+    Create new instance of stack with fixed capacity.
+    Push and pop never allocate, push fails when stack is full.
+
+    PARAMS:
+    @IN size_of - size of each element.
+    @IN capacity - max number of entries.
+    @IN buffer - caller buffer for @capacity entries or NULL (buffer embedded in stack).
+
+    RETURN:
+    %NULL if failure.
+    %Pointer to stack if success.
+*/
+Stack *stack_create_fixed(size_t size_of, size_t capacity, void *buffer);
+
+
 /*
     Deallocate stack with all entries.
 
@@ -55,7 +85,7 @@ void stack_destroy(Stack *stack);
     %0 if success.
     %negative value if failure.
 */
-int stack_push(Stack * __restrict__ stack, const void * __restrict__ const entry);
+static inline int stack_push(Stack * __restrict__ stack, const void * __restrict__ const entry);
 
 
 /*
@@ -69,7 +99,7 @@ int stack_push(Stack * __restrict__ stack, const void * __restrict__ const entry
     %0 if success.
     %negative value if failure.
 */
-int stack_pop(Stack * __restrict__ stack, void * __restrict__ val_out);
+static inline int stack_pop(Stack * __restrict__ stack, void * __restrict__ val_out);
 
 
 /*
@@ -97,7 +127,7 @@ bool stack_is_empty(const Stack * const stack);
     %0 if success.
     %negative value if failure.
 */
-int stack_get_top(const Stack * __restrict__ const stack, void * __restrict__ val);
+static inline int stack_get_top(const Stack * __restrict__ const stack, void * __restrict__ val_out);
 
 
 /*
@@ -152,4 +182,64 @@ ssize_t stack_get_data_size(const Stack * const stack);
 void *stack_get_array(const Stack * const stack);
 
 
+static inline int stack_push(Stack * __restrict__ stack, const void * __restrict__ const entry)
+{
+#ifdef STACK_DEBUG
+	if (stack == NULL || entry == NULL)
+		ERROR("stack == NULL || entry == NULL\n", -1);
+#endif
+
+	/* array has to grow or fixed stack is full */
+	if (stack->num_entries == stack->size)
+		return darray_insert(stack, entry);
+
+	(void)memcpy((char *)stack->array + stack->num_entries * stack->size_of, entry, stack->size_of);
+	++stack->num_entries;
+
+	return 0;
+}
+
+
+static inline int stack_pop(Stack * __restrict__ stack, void * __restrict__ val_out)
+{
+#ifdef STACK_DEBUG
+	if (stack == NULL || val_out == NULL)
+		ERROR("stack == NULL || val_out == NULL\n", -1);
+#endif
+
+	if (stack->num_entries == 0)
+		ERROR("stack is empty\n", -1);
+
+	/*
+		Growing stack lets darray shrink array. Last entry is popped here,
+		so array is kept and push / pop around empty stack don't malloc / free.
+	*/
+	if ((stack->flags & DARRAY_FIXED) == 0 && stack->num_entries > 1 && stack->num_entries <= stack->size / STACK_SHRINK_RATIO)
+		return darray_delete(stack, val_out);
+
+	--stack->num_entries;
+
+	(void)memcpy(val_out, (const char *)stack->array + stack->num_entries * stack->size_of, stack->size_of);
+
+	return 0;
+}
+
+
+
+static inline int stack_get_top(const Stack * __restrict__ const stack, void * __restrict__ val_out)
+{
+#ifdef STACK_DEBUG
+	if (stack == NULL || val_out == NULL)
+		ERROR("stack == NULL || val_out == NULL\n", -1);
+#endif
+
+	if (stack->num_entries == 0)
+		ERROR("stack is empty\n", -1);
+
+	(void)memcpy(val_out, (const char *)stack->array + (stack->num_entries - 1) * stack->size_of, stack->size_of);
+
+	return 0;
+}
+
+
 #endif /* STACK_H */
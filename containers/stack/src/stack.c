@@ -11,21 +11,24 @@ Stack *stack_create(size_t size_of)
 }
 
 
-void stack_destroy(Stack *stack)
+Stack *stack_create_fixed(size_t size_of, size_t capacity, void *buffer)
 {
-	if (stack == NULL)
-        return;
+	if (size_of < 1)
+		ERROR("size_of < 1\n", NULL);
 
-	darray_destroy(stack);
+	if (capacity < 1)
+		ERROR("capacity < 1\n", NULL);
+
+	return darray_create_fixed(DARRAY_UNSORTED, size_of, capacity, buffer, NULL, NULL);
 }
 
 
-int stack_push(Stack * restrict stack, const void * restrict val_in)
+void stack_destroy(Stack *stack)
 {
-	if (stack == NULL || val_in == NULL)
-		ERROR("stack == NULL || val_in == NULL\n", -1);
+	if (stack == NULL)
+        return;
 
-	return darray_insert(stack, val_in);
+	darray_destroy(stack);
 }
 
 
@@ -38,29 +41,6 @@ bool stack_is_empty(const Stack *stack)
 }
 
 
-int stack_pop(Stack * restrict stack, void * restrict val_out)
-{
-	if (stack == NULL || val_out == NULL)
-		ERROR("stack == NULL || val_out == NULL\n", -1);
-
-	if (stack_is_empty(stack))
-		ERROR("stack is empty\n", -1);
-
-	return darray_delete(stack, val_out);
-}
-
-
-int stack_get_top(const Stack * restrict stack, void * restrict val_out)
-{
-	if (stack == NULL || val_out == NULL)
-		ERROR("stack == NULL || val_out == NULL\n", -1);
-
-	if (stack_is_empty(stack))
-		ERROR("stack is empty\n", -1);
-
-	return darray_get_data(stack, val_out, (size_t)darray_get_num_entries(stack) - 1);
-}
-
 ssize_t stack_get_size(const Stack *stack)
 {
 	if (stack == NULL)
@@ -78,6 +58,15 @@ ssize_t stack_get_num_entries(const Stack *stack)
 }
 
 
+ssize_t stack_get_data_size(const Stack *stack)
+{
+	if (stack == NULL)
+		ERROR("stack == NULL\n", -1);
+
+	return darray_get_data_size(stack);
+}
+
+
 void *stack_get_array(const Stack *stack)
 {
 	if (stack == NULL)
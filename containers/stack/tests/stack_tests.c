@@ -2,9 +2,260 @@
 #include <ctest.h>
 #include <stdint.h>
 
+
+/* nodes of implicit binary tree walked by dfs, node i has children 2i + 1 and 2i + 2 */
+#define DFS_TREE_NODES ((uint32_t)1 << 22)
+
+
+/* functions needed for testing */
+static int dfs(Stack *stack, uint64_t *sum);
+
+
+/* unit tests function declaraions */
+static void test_stack_create(void);
+static void test_stack_push_pop(void);
+static void test_stack_fixed(void);
+static void test_stack_fixed_embedded(void);
+static void test_stack_dfs(void);
+
+
+/* implementation */
+static int dfs(Stack *stack, uint64_t *sum)
+{
+	uint32_t node = 0;
+	*sum = 0;
+
+	if (stack_push(stack, (void *)&node) != 0)
+		return 1;
+
+	while (stack_get_num_entries(stack) > 0)
+	{
+		if (stack_pop(stack, (void *)&node) != 0)
+			return 1;
+
+		*sum += node;
+
+		/* right child first, so left subtree is visited first */
+		for (uint32_t child = 2 * node + 2; child > 2 * node; --child)
+			if (child < DFS_TREE_NODES && stack_push(stack, (void *)&child) != 0)
+				return 1;
+	}
+
+	return 0;
+}
+
+
+static void test_stack_create(void)
+{
+	Stack *stack = stack_create(sizeof(int));
+	T_ERROR(stack == NULL);
+
+	T_EXPECT(stack_is_empty(stack), (bool)true);
+	T_EXPECT(stack_get_num_entries(stack), (ssize_t)0);
+	T_EXPECT(stack_get_data_size(stack), (ssize_t)sizeof(int));
+
+	stack_destroy(stack);
+
+	T_ASSERT(stack_create(0), NULL);
+	T_ASSERT(stack_create_fixed(0, 10, NULL), NULL);
+	T_ASSERT(stack_create_fixed(sizeof(int), 0, NULL), NULL);
+
+	T_EXPECT(stack_is_empty(NULL), (bool)false);
+	T_EXPECT(stack_get_num_entries(NULL), (ssize_t)-1);
+	T_EXPECT(stack_get_data_size(NULL), (ssize_t)-1);
+}
+
+
+static void test_stack_push_pop(void)
+{
+	#define ARRAY_TEST_SIZE 1000
+
+	int64_t val = 0;
+
+	Stack *stack = stack_create(sizeof(int64_t));
+	T_ERROR(stack == NULL);
+
+	T_CHECK(stack_pop(stack, (void *)&val) != 0);
+	T_CHECK(stack_get_top(stack, (void *)&val) != 0);
+
+	for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+	{
+		T_EXPECT(stack_push(stack, (void *)&i), 0);
+		T_EXPECT(stack_get_top(stack, (void *)&val), 0);
+		T_ASSERT(val, i);
+	}
+
+	T_EXPECT(stack_get_num_entries(stack), (ssize_t)ARRAY_TEST_SIZE);
+	T_EXPECT(stack_is_empty(stack), (bool)false);
+
+	/* LIFO, array shrinks on the way down */
+	for (int64_t i = ARRAY_TEST_SIZE - 1; i >= 0; --i)
+	{
+		T_EXPECT(stack_pop(stack, (void *)&val), 0);
+		T_ASSERT(val, i);
+	}
+
+	T_EXPECT(stack_is_empty(stack), (bool)true);
+	T_CHECK(stack_pop(stack, (void *)&val) != 0);
+
+	/* stack can be used again after became empty */
+	val = 7;
+	T_EXPECT(stack_push(stack, (void *)&val), 0);
+	val = 0;
+	T_EXPECT(stack_pop(stack, (void *)&val), 0);
+	T_ASSERT(val, (int64_t)7);
+
+#ifdef STACK_DEBUG
+	T_CHECK(stack_push(NULL, (void *)&val) != 0);
+	T_CHECK(stack_push(stack, NULL) != 0);
+	T_CHECK(stack_pop(NULL, (void *)&val) != 0);
+	T_CHECK(stack_pop(stack, NULL) != 0);
+	T_CHECK(stack_get_top(NULL, (void *)&val) != 0);
+	T_CHECK(stack_get_top(stack, NULL) != 0);
+#endif
+
+	stack_destroy(stack);
+
+	#undef ARRAY_TEST_SIZE
+}
+
+
+static void test_stack_fixed(void)
+{
+	#define ARRAY_TEST_SIZE 100
+
+	int buffer[ARRAY_TEST_SIZE];
+	int val = 0;
+
+	Stack *stack = stack_create_fixed(sizeof(int), ARRAY_TEST_SIZE, (void *)&buffer[0]);
+	T_ERROR(stack == NULL);
+
+	T_ASSERT(stack_get_array(stack), (void *)&buffer[0]);
+	T_EXPECT(stack_get_size(stack), (ssize_t)ARRAY_TEST_SIZE);
+
+	/* array is never reallocated */
+	for (int round = 0; round < 10; ++round)
+	{
+		for (int i = 0; i < ARRAY_TEST_SIZE; ++i)
+		{
+			val = round + i;
+			T_EXPECT(stack_push(stack, (void *)&val), 0);
+		}
+
+		T_CHECK(stack_push(stack, (void *)&val) != 0);
+		T_EXPECT(stack_get_num_entries(stack), (ssize_t)ARRAY_TEST_SIZE);
+		T_ASSERT(buffer[0], round);
+
+		for (int i = ARRAY_TEST_SIZE - 1; i >= 0; --i)
+		{
+			T_EXPECT(stack_pop(stack, (void *)&val), 0);
+			T_ASSERT(val, round + i);
+		}
+
+		T_CHECK(stack_pop(stack, (void *)&val) != 0);
+		T_EXPECT(stack_get_size(stack), (ssize_t)ARRAY_TEST_SIZE);
+		T_ASSERT(stack_get_array(stack), (void *)&buffer[0]);
+	}
+
+	/* caller buffer stays valid after destroy */
+	stack_destroy(stack);
+	buffer[0] = 0;
+
+	#undef ARRAY_TEST_SIZE
+}
+
+
+static void test_stack_fixed_embedded(void)
+{
+	#define ARRAY_TEST_SIZE 10
+
+	typedef struct Frame
+	{
+		int64_t a;
+		int64_t b;
+		int32_t c;
+	} Frame;
+
+	Frame val;
+
+	Stack *stack = stack_create_fixed(sizeof(Frame), ARRAY_TEST_SIZE, NULL);
+	T_ERROR(stack == NULL);
+
+	void *array = stack_get_array(stack);
+	T_ERROR(array == NULL);
+	T_CHECK(((uintptr_t)array % (2 * sizeof(void *))) == 0);
+
+	for (int64_t i = 0; i < ARRAY_TEST_SIZE; ++i)
+	{
+		val = (Frame){ .a = i, .b = -i, .c = (int32_t)i };
+		T_EXPECT(stack_push(stack, (void *)&val), 0);
+	}
+
+	T_CHECK(stack_push(stack, (void *)&val) != 0);
+
+	T_EXPECT(stack_get_top(stack, (void *)&val), 0);
+	T_ASSERT(val.a, (int64_t)(ARRAY_TEST_SIZE - 1));
+
+	for (int64_t i = ARRAY_TEST_SIZE - 1; i >= 0; --i)
+	{
+		T_EXPECT(stack_pop(stack, (void *)&val), 0);
+		T_ASSERT(val.a, i);
+		T_ASSERT(val.b, -i);
+		T_ASSERT(val.c, (int32_t)i);
+	}
+
+	T_EXPECT(stack_is_empty(stack), (bool)true);
+
+	stack_destroy(stack);
+
+	#undef ARRAY_TEST_SIZE
+}
+
+
+static void test_stack_dfs(void)
+{
+	/* every node is visited once */
+	const uint64_t expt_sum = (uint64_t)DFS_TREE_NODES * (DFS_TREE_NODES - 1) / 2;
+	uint64_t sum = 0;
+
+	Stack *stack = stack_create(sizeof(uint32_t));
+	T_ERROR(stack == NULL);
+
+	T_EXPECT(dfs(stack, &sum), 0);
+	T_ASSERT(sum, expt_sum);
+	T_EXPECT(stack_is_empty(stack), (bool)true);
+
+	stack_destroy(stack);
+
+	/* depth of tree is 22, so at most 23 nodes wait on stack */
+	uint32_t buffer[32];
+
+	stack = stack_create_fixed(sizeof(uint32_t), ARRAY_SIZE(buffer), (void *)&buffer[0]);
+	T_ERROR(stack == NULL);
+
+	T_EXPECT(dfs(stack, &sum), 0);
+	T_ASSERT(sum, expt_sum);
+
+	stack_destroy(stack);
+
+	/* too small stack is detected */
+	stack = stack_create_fixed(sizeof(uint32_t), (size_t)8, NULL);
+	T_ERROR(stack == NULL);
+
+	T_EXPECT(dfs(stack, &sum), 1);
+
+	stack_destroy(stack);
+}
+
+
 int main(void)
 {
 	TEST_INIT("TESTING STACK");
+	TEST(test_stack_create());
+	TEST(test_stack_push_pop());
+	TEST(test_stack_fixed());
+	TEST(test_stack_fixed_embedded());
+	TEST(test_stack_dfs());
 	TEST_SUMMARY();
 
 	return 0;
@@ -0,0 +1,95 @@
+#ifndef _CBENCH_H_
+#define _CBENCH_H_
+
+/*
+    cbench - helpers for benchmark programs
+
+    Benchmarks are timed loops built next to tests of container
+    (tests/<container>_bench.c). Every loop prints its name, number of
+    operations and time per operation. Numbers depend on machine, so they
+    are useful only to compare containers in one run.
+
+    Author: Kamil Kiełbasa
+    email: kamilkielbasa73@gmail.com
+
+    LICENCE: GPL 3.0
+*/
+
+#include <stdio.h> /* printf */
+#include <stdint.h> /* uint64_t */
+#include <stddef.h> /* size_t */
+#include <time.h> /* clock_gettime */
+#include <common.h>
+
+
+/*
+    Get monotonic time.
+
+    PARAMS:
+    NO PARAMS.
+
+    RETURN:
+    %time in nanoseconds.
+*/
+static inline uint64_t bench_now(void);
+
+
+/*
+    Get next pseudo random number (xorshift64), input of benchmark is the same in every run.
+
+    PARAMS:
+    @IN state - pointer to state (not 0).
+
+    RETURN:
+    %pseudo random number.
+*/
+static inline uint64_t bench_rand(uint64_t *state);
+
+
+/*
+    Print result of loop.
+
+    PARAMS:
+    @IN name - name of loop.
+    @IN ops - number of operations done in loop.
+    @IN start - bench_now() taken before loop.
+
+    RETURN:
+    %This is void function.
+*/
+static inline void bench_report(const char *name, size_t ops, uint64_t start);
+
+
+static inline uint64_t bench_now(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+
+static inline uint64_t bench_rand(uint64_t *state)
+{
+    uint64_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    *state = x;
+
+    return x;
+}
+
+
+static inline void bench_report(const char *name, size_t ops, uint64_t start)
+{
+    const uint64_t ns = bench_now() - start;
+
+    (void)printf("%-48s %10zu ops %10.2f ns/op\n", name, ops, ops == 0 ? 0.0 : (double)ns / (double)ops);
+}
+
+
+#endif /* _CBENCH_H_ */
@@ -9,7 +9,23 @@ cmake ..
 make
 ./containers/array/tests/array_tests 2>/dev/null
 ./containers/darray/tests/darray_tests 2>/dev/null
+./containers/stack/tests/stack_tests 2>/dev/null
+./containers/stack/tests/stack_debug_tests 2>/dev/null
 ./containers/rbt/tests/rbt_tests 2>/dev/null
 ./containers/list/tests/list_tests 2>/dev/null
+./containers/skiplist/tests/skiplist_tests 2>/dev/null
+./containers/ilist/tests/ilist_tests 2>/dev/null
+./containers/ilist/tests/ilist_debug_tests 2>/dev/null
+./containers/cstack/tests/cstack_tests 2>/dev/null
+./containers/deque/tests/deque_tests 2>/dev/null
+./containers/ring/tests/ring_tests 2>/dev/null
+./containers/heap/tests/heap_tests 2>/dev/null
+./containers/hashmap/tests/hashmap_tests 2>/dev/null
+./containers/hashset/tests/hashset_tests 2>/dev/null
+./containers/btree/tests/btree_tests 2>/dev/null
+./containers/bitset/tests/bitset_tests 2>/dev/null
+./containers/bitset/tests/bitset_debug_tests 2>/dev/null
+./containers/soa/tests/soa_tests 2>/dev/null
+./containers/slotmap/tests/slotmap_tests 2>/dev/null
 popd
 rm -r build